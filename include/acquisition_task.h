@@ -0,0 +1,75 @@
+#ifndef ACQUISITION_TASK_H
+#define ACQUISITION_TASK_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "clock.h"
+#include "deadline_scheduler.h"
+
+// ============================================================================
+// esp_timer Clock
+// ============================================================================
+
+class EspTimerClock : public Clock {
+public:
+  int64_t nowUs() override { return esp_timer_get_time(); }
+};
+
+// ============================================================================
+// Timer-Driven Acquisition Task
+// ============================================================================
+// A high-priority task pinned to its own core, woken by a periodic esp_timer.
+// Each wakeup is checked against an absolute deadline and the sample callback
+// runs once per wakeup, independent of loop() and network work. In triggered
+// mode the timer is stopped and wakeups come from wake()/wakeFromISR().
+
+class AcquisitionTask {
+public:
+  // Sample callback, runs in the acquisition task
+  typedef void (*SampleCallback)(void* arg);
+
+  // Constructor
+  AcquisitionTask();
+
+  // Create the task and start the timer
+  bool begin(uint32_t periodUs, SampleCallback callback, void* arg);
+
+  // Change the sampling period at runtime
+  void setPeriod(uint32_t periodUs);
+  uint32_t getPeriodUs() const { return _scheduler.getPeriodUs(); }
+
+  // Triggered mode: the timer stops and the callback runs once per wake()
+  // instead (host-triggered sampling, see trigger_sampler.h)
+  void setTriggered(bool triggered);
+  bool isTriggered() const { return _triggered; }
+
+  // Wake the task from another task / from an interrupt handler
+  void wake();
+  void wakeFromISR();
+
+  // Copy of the current timing statistics (safe from any task)
+  DeadlineScheduler::Stats getStats();
+
+  // Clear timing statistics
+  void resetStats();
+
+  bool isRunning() const { return _task != nullptr; }
+
+private:
+  EspTimerClock _clock;
+  DeadlineScheduler _scheduler;
+  esp_timer_handle_t _timer;
+  TaskHandle_t _task;
+  SampleCallback _callback;
+  void* _callbackArg;
+  volatile bool _triggered;
+  portMUX_TYPE _statsMux;
+
+  static void timerCallback(void* arg);
+  static void taskEntry(void* arg);
+  void run();
+};
+
+#endif // ACQUISITION_TASK_H
@@ -0,0 +1,100 @@
+#ifndef ANGLE_CALIBRATION_H
+#define ANGLE_CALIBRATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Nonlinearity Calibration
+// ============================================================================
+// Magnet misalignment gives a harmonic error over one revolution. The model
+// is MODEL_POINTS corrections (Q4 counts, 1/16 count) at evenly spaced
+// angles; it is small enough to store in flash and is expanded into a
+// 4096-entry table so the hot path is one lookup per sample.
+//
+// AngleCalibrator captures the model while the shaft turns at constant speed
+// (e.g. motor driven): time is the reference. Samples are binned by angle
+// over exactly one revolution; the reference is the line through the start
+// and end of that revolution, and each bin's correction is the reference
+// position minus the measured one. Direction of rotation does not matter.
+
+class AngleCalibrator {
+public:
+  static const size_t MODEL_POINTS = 64;
+  static const uint16_t BIN_WIDTH = 4096 / MODEL_POINTS;
+
+  AngleCalibrator();
+
+  // Start a new capture
+  void begin();
+
+  // Feed one raw sample with its timestamp (us); ignored once complete
+  void addSample(uint16_t rawAngle, uint32_t timestampUs);
+
+  bool isActive() const { return _active; }
+  bool isComplete() const { return _complete; }
+
+  // Revolution covered so far (0-100 %)
+  uint8_t getProgress() const;
+
+  // Compute the model; false if the capture is incomplete or degenerate.
+  // The capture stays active (addSample() ignores it) until this returns,
+  // so a new begin() can be held off while the sums are read.
+  bool finish(int16_t model[MODEL_POINTS]);
+
+  // Stop without producing a model
+  void cancel() { _active = false; _complete = false; }
+
+private:
+  int64_t _sumPosition[MODEL_POINTS];
+  int64_t _sumTime[MODEL_POINTS];
+  uint32_t _count[MODEL_POINTS];
+  int64_t _position;        // Unwrapped position (counts)
+  int64_t _startPosition;
+  uint16_t _lastAngle;
+  uint32_t _startUs;
+  int64_t _endPosition;
+  uint32_t _endUs;          // Revolution duration
+  bool _haveLast;
+  bool _started;
+  volatile bool _active;
+  volatile bool _complete;
+
+  bool computeModel(int16_t model[MODEL_POINTS]) const;
+};
+
+// The active table is a single pointer (nullptr = no correction), so a new
+// table is built off to the side and published with one store; apply()
+// reads the pointer once. A replaced table may still be in use by an apply()
+// running on the other core, so the caller must not reuse it until that
+// can no longer happen (SensorManager publishes and applies under one lock).
+class AngleCorrection {
+public:
+  static const size_t TABLE_SIZE = 4096;
+
+  AngleCorrection() : _table(nullptr) {}
+
+  // Expand a model into `table` (TABLE_SIZE entries)
+  static void build(const int16_t model[AngleCalibrator::MODEL_POINTS], uint16_t* table);
+
+  // Switch to `table` (caller-owned, nullptr disables); returns the table
+  // it replaces
+  uint16_t* publish(uint16_t* table) {
+    uint16_t* previous = _table;
+    _table = table;
+    return previous;
+  }
+
+  bool isEnabled() const { return _table != nullptr; }
+
+  // Corrected angle: one table lookup, no floating point
+  uint16_t apply(uint16_t rawAngle) const {
+    const uint16_t* table = _table;
+    return table != nullptr ? table[rawAngle & 0x0FFF] : rawAngle;
+  }
+
+private:
+  uint16_t* volatile _table;
+};
+
+#endif // ANGLE_CALIBRATION_H
@@ -0,0 +1,88 @@
+#ifndef ANGLE_DECIMATOR_H
+#define ANGLE_DECIMATOR_H
+
+#include <stdint.h>
+#include <math.h>
+
+// ============================================================================
+// Wrap-Aware Angle Decimator
+// ============================================================================
+// Averages N consecutive 12-bit angles into one output (boxcar / first-order
+// CIC), in integer arithmetic. Samples are accumulated as signed offsets from
+// the first sample of the window, so a window straddling the 4095 -> 0
+// crossing averages to ~0/4095 instead of ~2048. Movement within one window
+// must stay below half a turn.
+//
+// The output carries FRACTION_BITS extra bits; averaging N samples of white
+// noise gains 0.5 * log2(N) bits of effective resolution.
+
+class AngleDecimator {
+public:
+  static const uint8_t FRACTION_BITS = 4;
+  static const uint32_t FIXED_FULL_TURN = 4096UL << FRACTION_BITS;
+
+  explicit AngleDecimator(uint16_t factor = 1)
+    : _factor(factor > 0 ? factor : 1), _count(0), _reference(0), _sum(0), _outputFixed(0) {}
+
+  void setFactor(uint16_t factor) {
+    _factor = factor > 0 ? factor : 1;
+    reset();
+  }
+  uint16_t getFactor() const { return _factor; }
+
+  // Drop a partially accumulated window
+  void reset() {
+    _count = 0;
+    _sum = 0;
+  }
+
+  // Add one sample; returns true when a decimated output is ready
+  bool push(uint16_t angle) {
+    angle &= 0x0FFF;
+    if (_count == 0) {
+      _reference = angle;
+    }
+    _sum += wrapDelta(angle, _reference);
+    if (++_count < _factor) {
+      return false;
+    }
+
+    // Mean offset in fixed point, rounded to nearest
+    int32_t scaled = _sum * (int32_t)(1 << FRACTION_BITS);
+    int32_t half = _factor / 2;
+    int32_t mean = (scaled >= 0 ? scaled + half : scaled - half) / (int32_t)_factor;
+    int32_t fixed = ((int32_t)_reference << FRACTION_BITS) + mean;
+    _outputFixed = (uint32_t)fixed & (FIXED_FULL_TURN - 1);
+
+    reset();
+    return true;
+  }
+
+  // Last output, 0-4095 (rounded)
+  uint16_t getAngle() const {
+    return (uint16_t)(((_outputFixed + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS) & 0x0FFF);
+  }
+
+  // Last output with FRACTION_BITS fractional bits (0 .. FIXED_FULL_TURN-1)
+  uint32_t getAngleFixed() const { return _outputFixed; }
+
+  // Resolution gained by averaging `factor` samples (bits, for reporting)
+  static float effectiveBitsGained(uint16_t factor) {
+    return factor > 1 ? 0.5f * log2f((float)factor) : 0.0f;
+  }
+
+  // Signed shortest distance from `from` to `to`, in [-2048, 2047]
+  static int32_t wrapDelta(uint16_t to, uint16_t from) {
+    int32_t delta = (int32_t)((to - from) & 0x0FFF);
+    return delta >= 2048 ? delta - 4096 : delta;
+  }
+
+private:
+  uint16_t _factor;
+  uint16_t _count;
+  uint16_t _reference;
+  int32_t _sum;
+  uint32_t _outputFixed;
+};
+
+#endif // ANGLE_DECIMATOR_H
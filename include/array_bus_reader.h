@@ -0,0 +1,253 @@
+#ifndef ARRAY_BUS_READER_H
+#define ARRAY_BUS_READER_H
+
+#include <stdint.h>
+#include "as5600_fast_reader.h"
+#include "clock.h"
+#include "sensor_health.h"
+
+// ============================================================================
+// Sensor Array: One Bus Pass
+// ============================================================================
+// Reads the AS5600s SensorArray has on one I2C bus, each behind a TCA9548A
+// channel or wired directly. Slots are kept in (mux, channel) order so a mux
+// is only reprogrammed when the next sensor is on a different channel, and
+// a mux is only released when moving to another mux. Each AS5600 keeps its
+// own register pointer, so after the select a sample is a single 2-byte
+// read.
+//
+// Every slot tracks its link with SensorHealth: after repeated errors it is
+// no longer read, and it is re-probed (fresh select + read) on the backoff
+// schedule, so a sensor that was missing at boot or dropped out is picked up
+// again. A failed transaction also forces the next select to rewrite the
+// mux, in case the mux itself was reset.
+//
+// Templated on the bus type, with time from a Clock, and Arduino-free, so a
+// pass can be run against a fake bus and fake multiplexers on a host.
+
+template <typename Wire>
+class ArrayBusReader {
+public:
+  static const uint8_t MAX_SENSORS = 16;
+  static const uint8_t NO_MUX = 0;    // Sensor wired directly to the bus
+
+  // Last result for one slot
+  struct Reading {
+    uint16_t angle;           // Last good angle
+    uint32_t timeUs;          // Instant of that angle (start of its read)
+    bool fresh;               // Read in the last pass
+    bool online;
+  };
+
+  // Everything a pass produces, handed over as one unit
+  struct Snapshot {
+    Reading readings[MAX_SENSORS];   // Slot order
+    uint32_t muxWrites;       // Mux selects and releases issued (total)
+    uint32_t reads;           // Successful reads (total)
+  };
+
+  ArrayBusReader(Wire& wire, Clock& clock, uint8_t address, uint8_t angleRegister,
+                 uint32_t minBackoffMs = 100, uint32_t maxBackoffMs = 5000)
+    : _wire(wire), _clock(clock), _address(address), _register(angleRegister),
+      _minBackoffMs(minBackoffMs), _maxBackoffMs(maxBackoffMs), _count(0) {
+    _selection.mux = NO_MUX;
+    _selection.channel = 0;
+    _snapshot = Snapshot();
+  }
+
+  ~ArrayBusReader() {
+    for (uint8_t n = 0; n < _count; n++) delete _slots[n].reader;
+  }
+
+  // Add a sensor (`index` is its position in the whole array). Returns
+  // false when the bus is full.
+  bool add(uint8_t index, uint8_t muxAddress, uint8_t channel) {
+    if (_count >= MAX_SENSORS) return false;
+    Slot slot;
+    slot.index = index;
+    slot.mux = muxAddress;
+    slot.channel = muxAddress == NO_MUX ? 0 : (channel & 0x07);
+    slot.reader = new FastReader(_wire, _address, _register);
+    slot.health = SensorHealth(_minBackoffMs, _maxBackoffMs);
+
+    uint8_t pos = _count++;
+    while (pos > 0 && key(_slots[pos - 1]) > key(slot)) {
+      _slots[pos] = _slots[pos - 1];
+      pos--;
+    }
+    _slots[pos] = slot;
+    return true;
+  }
+
+  uint8_t getCount() const { return _count; }
+  uint8_t indexOf(uint8_t slot) const { return _slots[slot].index; }
+  uint8_t muxOf(uint8_t slot) const { return _slots[slot].mux; }
+  uint8_t channelOf(uint8_t slot) const { return _slots[slot].channel; }
+  const SensorHealth::Stats& getHealth(uint8_t slot) const {
+    return _slots[slot].health.getStats();
+  }
+
+  // Presence check of every slot (at startup)
+  void begin() {
+    uint32_t nowMs = (uint32_t)(_clock.nowUs() / 1000);
+    for (uint8_t n = 0; n < _count; n++) {
+      Reading& reading = _snapshot.readings[n];
+      reading.fresh = readSlot(n);
+      reading.online = reading.fresh;
+      _slots[n].health.begin(reading.online, nowMs);
+    }
+  }
+
+  // Read every slot once; offline slots are re-probed when due
+  void readPass() {
+    for (uint8_t n = 0; n < _count; n++) {
+      Slot& slot = _slots[n];
+      Reading& reading = _snapshot.readings[n];
+      reading.fresh = false;
+
+      if (!slot.health.isOnline()) {
+        uint32_t nowMs = (uint32_t)(_clock.nowUs() / 1000);
+        if (!slot.health.shouldProbe(nowMs)) continue;
+        slot.reader->invalidatePointer();
+        forceReselect();
+        reading.fresh = readSlot(n);
+        slot.health.onProbeResult(reading.fresh, nowMs);
+      } else if (readSlot(n)) {
+        reading.fresh = true;
+        slot.health.onReadOk();
+      } else {
+        slot.health.onReadError((uint32_t)(_clock.nowUs() / 1000));
+      }
+      reading.online = slot.health.isOnline();
+    }
+  }
+
+  const Snapshot& snapshot() const { return _snapshot; }
+
+  // Bus time of one steady-state pass at `freq` Hz: the mux writes the
+  // select batching leaves (address + control byte) and one 2-byte read
+  // (address + 2 data bytes) per sensor, 9 clocks per byte plus START/STOP.
+  // Driver overhead between transactions is not included.
+  uint32_t estimatePassUs(uint32_t freq) const {
+    if (freq == 0 || _count == 0) return 0;
+    // Walk the order twice; the second pass starts from where the first
+    // one left the muxes, as every pass after the first does
+    Selection selection = { NO_MUX, 0 };
+    uint32_t muxWrites = 0;
+    for (uint8_t pass = 0; pass < 2; pass++) {
+      muxWrites = 0;
+      for (uint8_t n = 0; n < _count; n++) {
+        Route route = routeTo(selection, _slots[n]);
+        muxWrites += (route.release ? 1 : 0) + (route.select ? 1 : 0);
+        apply(selection, _slots[n], route);
+      }
+    }
+    uint64_t clocks = (uint64_t)muxWrites * transactionClocks(2) +
+                      (uint64_t)_count * transactionClocks(3);
+    return (uint32_t)(clocks * 1000000ULL / freq);
+  }
+
+  // Bus clocks of one transaction carrying `bytes` bytes (address included)
+  static uint32_t transactionClocks(uint32_t bytes) { return 9 * bytes + 2; }
+
+private:
+  typedef AS5600FastReader<Wire> FastReader;
+
+  struct Slot {
+    uint8_t index;
+    uint8_t mux;
+    uint8_t channel;
+    FastReader* reader;
+    SensorHealth health;
+  };
+
+  struct Selection {
+    uint8_t mux;              // Active mux, NO_MUX if none
+    uint8_t channel;          // 0xFF: unknown, rewrite on next select
+  };
+
+  // Mux writes needed to route the bus from `current` to a slot
+  struct Route {
+    bool release;             // Write 0 to the active mux
+    bool select;              // Write the slot's channel bit to its mux
+  };
+
+  Wire& _wire;
+  Clock& _clock;
+  uint8_t _address;
+  uint8_t _register;
+  uint32_t _minBackoffMs;
+  uint32_t _maxBackoffMs;
+  Slot _slots[MAX_SENSORS];
+  uint8_t _count;
+  Selection _selection;
+  Snapshot _snapshot;
+
+  static uint16_t key(const Slot& slot) { return ((uint16_t)slot.mux << 8) | slot.channel; }
+
+  static Route routeTo(const Selection& current, const Slot& slot) {
+    Route route;
+    // Release the previous mux so its sensor does not collide at 0x36
+    route.release = current.mux != NO_MUX && current.mux != slot.mux;
+    route.select = slot.mux != NO_MUX &&
+                   !(current.mux == slot.mux && current.channel == slot.channel);
+    return route;
+  }
+
+  static void apply(Selection& selection, const Slot& slot, const Route& route) {
+    if (route.release) selection.mux = NO_MUX;
+    if (route.select) {
+      selection.mux = slot.mux;
+      selection.channel = slot.channel;
+    }
+  }
+
+  void forceReselect() { _selection.channel = 0xFF; }
+
+  // Route the bus to a slot's mux channel (skipped if already selected)
+  bool select(const Slot& slot) {
+    Route route = routeTo(_selection, slot);
+    if (route.release) {
+      writeMux(_selection.mux, 0);
+      _selection.mux = NO_MUX;
+    }
+    if (!route.select) return true;
+    if (!writeMux(slot.mux, (uint8_t)(1 << slot.channel))) {
+      _selection.mux = NO_MUX;
+      return false;
+    }
+    _selection.mux = slot.mux;
+    _selection.channel = slot.channel;
+    return true;
+  }
+
+  bool writeMux(uint8_t muxAddress, uint8_t value) {
+    _snapshot.muxWrites++;
+    _wire.beginTransmission(muxAddress);
+    _wire.write(value);
+    return _wire.endTransmission() == 0;
+  }
+
+  // Select and read one slot; on success the reading gets the angle and
+  // the instant the read started
+  bool readSlot(uint8_t n) {
+    Slot& slot = _slots[n];
+    if (!select(slot)) {
+      forceReselect();
+      return false;
+    }
+    uint32_t startUs = (uint32_t)_clock.nowUs();
+    uint16_t angle;
+    if (!slot.reader->read(angle)) {
+      forceReselect();
+      return false;
+    }
+    Reading& reading = _snapshot.readings[n];
+    reading.angle = angle;
+    reading.timeUs = startUs;
+    _snapshot.reads++;
+    return true;
+  }
+};
+
+#endif // ARRAY_BUS_READER_H
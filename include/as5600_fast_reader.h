@@ -0,0 +1,93 @@
+#ifndef AS5600_FAST_READER_H
+#define AS5600_FAST_READER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// AS5600 Pointer-Retained Fast Angle Reader
+// ============================================================================
+// The AS5600 keeps its register address pointer between transactions, and for
+// the ANGLE/RAW ANGLE registers the pointer wraps back to the high byte after
+// the low byte is read. Once the pointer is set, each sample is a single
+// 2-byte read (3 bytes on the bus) instead of a register write followed by a
+// read (5 bytes, two transactions).
+//
+// Templated on the bus type so any TwoWire-compatible bus can be used
+// (Wire/Wire1 on the device, a fake bus on a host). The pointer must be
+// invalidated after any other register access on the same sensor.
+
+template <typename Bus>
+class AS5600FastReader {
+public:
+  // AS5600 output registers
+  static const uint8_t REG_RAW_ANGLE = 0x0C;
+  static const uint8_t REG_ANGLE = 0x0E;
+
+  // Bus usage counters (address bytes included)
+  struct Stats {
+    uint32_t transactions;    // START..STOP sequences issued
+    uint32_t bytesOnBus;      // Address + register + data bytes
+    uint32_t pointerWrites;   // Register pointer (re)programming
+    uint32_t reads;           // Successful angle reads
+    uint32_t errors;          // NACKs / short reads
+  };
+
+  AS5600FastReader(Bus& bus, uint8_t address, uint8_t angleRegister = REG_ANGLE)
+    : _bus(bus), _address(address), _register(angleRegister), _pointerValid(false) {
+    resetStats();
+  }
+
+  // Force the next read to reprogram the register pointer
+  void invalidatePointer() { _pointerValid = false; }
+  bool isPointerValid() const { return _pointerValid; }
+
+  // Read the 12-bit angle. Returns false on a bus error.
+  bool read(uint16_t& angle) {
+    if (!_pointerValid && !setPointer()) {
+      return false;
+    }
+
+    _stats.transactions++;
+    _stats.bytesOnBus += 1;   // Address byte
+    uint8_t received = _bus.requestFrom(_address, (uint8_t)2);
+    if (received != 2) {
+      while (_bus.available()) _bus.read();
+      _stats.errors++;
+      _pointerValid = false;
+      return false;
+    }
+
+    uint8_t high = _bus.read();
+    uint8_t low = _bus.read();
+    _stats.bytesOnBus += 2;
+    _stats.reads++;
+    angle = (((uint16_t)high << 8) | low) & 0x0FFF;
+    return true;
+  }
+
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  Bus& _bus;
+  uint8_t _address;
+  uint8_t _register;
+  bool _pointerValid;
+  Stats _stats;
+
+  bool setPointer() {
+    _stats.transactions++;
+    _stats.pointerWrites++;
+    _stats.bytesOnBus += 2;   // Address + register byte
+    _bus.beginTransmission(_address);
+    _bus.write(_register);
+    if (_bus.endTransmission() != 0) {
+      _stats.errors++;
+      return false;
+    }
+    _pointerValid = true;
+    return true;
+  }
+};
+
+#endif // AS5600_FAST_READER_H
@@ -0,0 +1,104 @@
+#ifndef BUS_WORKER_H
+#define BUS_WORKER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Bus Worker Hand-Off
+// ============================================================================
+// Runs a read on a second bus in a worker task while the caller reads the
+// first bus. Two binary semaphores order the hand-off: the caller gives
+// `start`, the worker reads into a shared Result and gives `done`. The
+// caller copies the shared Result only after it has taken `done`, so angle
+// and timestamp always come from the same read.
+//
+// A read that takes longer than the caller waits (overrun) stays pending:
+// the caller reports the last completed Result, leaves the shared one to
+// the worker, and restarts the worker only after it has signalled `done`.
+//
+// Semaphore is a binary semaphore type with
+//   bool begin();                      create it
+//   void give();
+//   bool take(uint32_t timeoutMs);     WAIT_FOREVER blocks, 0 polls
+// (FreeRTOS on the device, a std::condition_variable on a host). Result is
+// any copyable type. Arduino-free so the hand-off can be run against a fake
+// bus on a host.
+
+template <typename Semaphore, typename Result>
+class BusWorker {
+public:
+  static const uint32_t WAIT_FOREVER = 0xFFFFFFFF;
+
+  struct Stats {
+    uint32_t dispatched;      // Reads started
+    uint32_t overruns;        // Reads not finished within the caller's wait
+    uint32_t skipped;         // Cycles the worker was still busy (not started)
+  };
+
+  BusWorker() : _pending(false), _dispatched(false), _latest(), _shared() {
+    resetStats();
+  }
+
+  bool begin() { return _start.begin() && _done.begin(); }
+
+  // Caller: start a read unless the previous one is still running. A late
+  // read that finished since counts as the latest result.
+  bool dispatch() {
+    if (_pending) {
+      if (!_done.take(0)) {
+        _stats.skipped++;
+        return false;
+      }
+      _latest = _shared;
+      _pending = false;
+    }
+    _dispatched = true;
+    _stats.dispatched++;
+    _start.give();
+    return true;
+  }
+
+  // Caller: wait up to `timeoutMs` for the dispatched read. Returns true
+  // when latest() holds its result; false on overrun (or nothing
+  // dispatched), latest() then still holds the previous one.
+  bool collect(uint32_t timeoutMs) {
+    if (!_dispatched) return false;
+    _dispatched = false;
+    if (!_done.take(timeoutMs)) {
+      _pending = true;
+      _stats.overruns++;
+      return false;
+    }
+    _latest = _shared;
+    return true;
+  }
+
+  // Caller: result of the last completed read
+  const Result& latest() const { return _latest; }
+  // Caller: what latest() reports until the first read completes
+  void setLatest(const Result& result) { _latest = result; }
+  bool isPending() const { return _pending; }
+
+  // Worker: wait for a start signal, run `read` (Result read()) and
+  // publish its result
+  template <typename ReadFn>
+  void serve(ReadFn read) {
+    _start.take(WAIT_FOREVER);
+    _shared = read();
+    _done.give();
+  }
+
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  Semaphore _start;
+  Semaphore _done;
+  bool _pending;              // Caller only
+  bool _dispatched;           // Caller only
+  Result _latest;             // Caller only
+  Result _shared;             // Worker between start and done
+  Stats _stats;               // Caller only
+};
+
+#endif // BUS_WORKER_H
@@ -0,0 +1,33 @@
+#ifndef CALIBRATION_STORE_H
+#define CALIBRATION_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "angle_calibration.h"
+
+// ============================================================================
+// Calibration Persistence (NVS)
+// ============================================================================
+// Stores one AngleCalibrator model per sensor (MODEL_POINTS x int16, 128
+// bytes) in flash. The 4096-entry lookup tables are rebuilt from it at boot.
+
+class CalibrationStore {
+public:
+  static const uint8_t SENSORS = 2;
+
+  CalibrationStore();
+
+  // Open the NVS namespace
+  bool begin();
+
+  // Load / save / erase a model for sensor 0 or 1
+  bool load(uint8_t sensor, int16_t model[AngleCalibrator::MODEL_POINTS]);
+  bool save(uint8_t sensor, const int16_t model[AngleCalibrator::MODEL_POINTS]);
+  void erase(uint8_t sensor);
+
+private:
+  Preferences _prefs;
+  bool _open;
+};
+
+#endif // CALIBRATION_STORE_H
@@ -0,0 +1,89 @@
+#ifndef CHANGE_DETECTOR_H
+#define CHANGE_DETECTOR_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Change-Driven Output Gate
+// ============================================================================
+// Decides whether a sample set is worth sending: it is sent when any angle
+// moved beyond its deadband since the last sent value, or when the heartbeat
+// interval elapsed (so receivers can tell an idle shaft from a dead link).
+// Counts sent and suppressed samples and the bytes saved.
+
+template <uint8_t Sensors>
+class ChangeDetector {
+public:
+  struct Stats {
+    uint32_t sent;            // Samples sent because of motion
+    uint32_t heartbeats;      // Samples sent because of the heartbeat
+    uint32_t suppressed;      // Samples not sent
+    uint32_t bytesSent;
+    uint32_t bytesSaved;
+  };
+
+  ChangeDetector() : _heartbeatMs(1000), _lastSentMs(0), _initialized(false) {
+    for (uint8_t i = 0; i < Sensors; i++) {
+      _deadband[i] = 0;
+      _lastSent[i] = 0;
+    }
+    resetStats();
+  }
+
+  // Deadband per sensor (counts); a move of more than this triggers a send
+  void setDeadband(uint8_t sensor, uint16_t counts) {
+    if (sensor < Sensors) _deadband[sensor] = counts;
+  }
+
+  // Maximum time between sends (ms)
+  void setHeartbeat(uint32_t intervalMs) { _heartbeatMs = intervalMs; }
+
+  // Returns true if `angles` should be sent now; on true the angles become
+  // the new reference. `bytes` is the size of one output message.
+  bool shouldSend(const uint16_t* angles, uint32_t nowMs, uint32_t bytes) {
+    bool moved = !_initialized;
+    for (uint8_t i = 0; i < Sensors && !moved; i++) {
+      int32_t delta = (int32_t)((angles[i] - _lastSent[i]) & 0x0FFF);
+      if (delta >= 2048) delta -= 4096;
+      if (delta > (int32_t)_deadband[i] || delta < -(int32_t)_deadband[i]) {
+        moved = true;
+      }
+    }
+
+    bool heartbeat = !moved && (nowMs - _lastSentMs >= _heartbeatMs);
+    if (!moved && !heartbeat) {
+      _stats.suppressed++;
+      _stats.bytesSaved += bytes;
+      return false;
+    }
+
+    if (moved) {
+      _stats.sent++;
+    } else {
+      _stats.heartbeats++;
+    }
+    _stats.bytesSent += bytes;
+    for (uint8_t i = 0; i < Sensors; i++) {
+      _lastSent[i] = angles[i] & 0x0FFF;
+    }
+    _lastSentMs = nowMs;
+    _initialized = true;
+    return true;
+  }
+
+  // Force the next call to send (e.g. a new receiver connected)
+  void invalidate() { _initialized = false; }
+
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  uint16_t _deadband[Sensors];
+  uint16_t _lastSent[Sensors];
+  uint32_t _heartbeatMs;
+  uint32_t _lastSentMs;
+  bool _initialized;
+  Stats _stats;
+};
+
+#endif // CHANGE_DETECTOR_H
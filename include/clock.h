@@ -0,0 +1,37 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Monotonic Clock Interface
+// ============================================================================
+// Time source for scheduling logic. The firmware uses esp_timer_get_time();
+// host builds can substitute a fake clock to drive the logic deterministically.
+
+class Clock {
+public:
+  virtual ~Clock() {}
+
+  // Microseconds since an arbitrary fixed origin (monotonic)
+  virtual int64_t nowUs() = 0;
+};
+
+// ============================================================================
+// 32-bit Sample Timestamps
+// ============================================================================
+// Samples carry the low 32 bits of the microsecond clock. The counter wraps
+// every ~71.6 minutes, so timestamps are only compared through these helpers
+// (valid while the two instants are less than ~35 minutes apart).
+
+// Signed time from `earlier` to `later` (us)
+inline int32_t timestampDiffUs(uint32_t later, uint32_t earlier) {
+  return (int32_t)(later - earlier);
+}
+
+// Instant halfway between two timestamps
+inline uint32_t timestampMidpoint(uint32_t first, uint32_t last) {
+  return first + (uint32_t)(timestampDiffUs(last, first) / 2);
+}
+
+#endif // CLOCK_H
@@ -0,0 +1,250 @@
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Sender/Receiver Clock Synchronization
+// ============================================================================
+// Receiver-side estimate of the sender's clock from NTP-style ping/pong
+// exchanges over the command channel (Command::PING):
+//
+//   t1  receiver sends the ping          (receiver clock)
+//   t2  sender receives it               (sender clock)
+//   t3  sender sends the pong            (sender clock)
+//   t4  receiver receives the pong       (receiver clock)
+//
+//   offset = ((t2 - t1) + (t3 - t4)) / 2     sender minus receiver
+//   delay  = (t4 - t1) - (t3 - t2)           round trip on the wire
+//
+// The offset error of one exchange is up to half the delay asymmetry
+// (queueing on one path only), so only the lowest-delay exchange of every
+// BUCKET is kept, and those are weighted down the further their delay is
+// above the smallest in the window. Offset and drift come from a weighted
+// least-squares line through them, which converts sender timestamps to the
+// receiver's time base (and back). Until the window spans enough time to fit
+// the drift, the offset comes from the newest bucket alone.
+//
+// All times are wrapping uint32_t microseconds; the window must span less
+// than half the wrap (35 min: WINDOW x BUCKET exchanges) and more than
+// MIN_DRIFT_SPAN_US, so pings go out between 80 ms and 16 s apart.
+// Arduino-free so it can be checked on a host with simulated skewed clocks
+// (tools/clock_sync_check.cpp).
+
+class ClockSync {
+public:
+  static const size_t WINDOW = 16;                // Buckets kept
+  static const size_t BUCKET = 8;                 // Exchanges per bucket
+  static const uint32_t MAX_DELAY_US = 100000;    // Slower exchanges are discarded
+  static const uint32_t MIN_DRIFT_SPAN_US = 10000000; // Span needed to fit drift
+  static const int32_t MAX_DRIFT_PPB = 1000000;   // 1000 ppm sanity limit
+
+  // One-way latency histogram: bin i counts latencies < LATENCY_EDGES_US[i],
+  // the last bin counts everything beyond the last edge
+  static const size_t HISTOGRAM_BINS = 8;
+
+  struct Stats {
+    uint32_t exchanges;       // Exchanges accepted into the window
+    uint32_t rejected;        // Negative or excessive delay
+    uint32_t lastDelayUs;
+    uint32_t minDelayUs;      // Smallest delay in the window
+  };
+
+  struct LatencyStats {
+    uint32_t count;
+    int32_t minUs;
+    int32_t maxUs;
+    int64_t totalUs;          // For the mean
+    uint32_t negative;        // Samples that seemed to arrive before they were taken
+    uint32_t histogram[HISTOGRAM_BINS];
+  };
+
+  explicit ClockSync(uint32_t delayMarginUs = 200)
+    : _delayMarginUs(delayMarginUs) {
+    reset();
+  }
+
+  static uint32_t latencyEdge(size_t bin) {
+    static const uint32_t EDGES_US[HISTOGRAM_BINS - 1] = {
+      250, 500, 1000, 2000, 5000, 10000, 20000
+    };
+    return EDGES_US[bin];
+  }
+
+  void reset() {
+    _count = 0;
+    _next = 0;
+    _bucketCount = 0;
+    _driftKnown = false;
+    _refLocalUs = 0;
+    _refOffsetUs = 0;
+    _driftPpb = 0;
+    _stats = Stats();
+    resetLatency();
+  }
+
+  // Add one exchange. Returns false if it was rejected.
+  bool addExchange(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4) {
+    int32_t roundTrip = (int32_t)(t4 - t1);
+    int32_t processing = (int32_t)(t3 - t2);
+    int32_t delay = roundTrip - processing;
+    if (roundTrip < 0 || processing < 0 || delay < 0 || (uint32_t)delay > MAX_DELAY_US) {
+      _stats.rejected++;
+      return false;
+    }
+
+    Exchange e;
+    e.localUs = t1 + (uint32_t)roundTrip / 2;
+    // (t2 - t1) - (t3 - t4) is the delay, so this is the mean of both
+    // halves in modular arithmetic
+    e.offsetUs = (t2 - t1) - (uint32_t)delay / 2;
+    e.delayUs = (uint32_t)delay;
+    _stats.exchanges++;
+    _stats.lastDelayUs = e.delayUs;
+
+    // Keep the best exchange of the open bucket; close it when full
+    if (_bucketCount == 0 || e.delayUs <= _bucket.delayUs) _bucket = e;
+    if (++_bucketCount >= BUCKET) {
+      _window[_next] = _bucket;
+      _next = (_next + 1) % WINDOW;
+      if (_count < WINDOW) _count++;
+      _bucketCount = 0;
+    }
+    solve(e.localUs);
+    return true;
+  }
+
+  // True once the drift has been fitted (before that, conversions use the
+  // offset alone)
+  bool isSynced() const { return _driftKnown; }
+  bool hasOffset() const { return _stats.exchanges > 0; }
+
+  // Sender minus receiver clock at a receiver time (modular)
+  uint32_t getOffsetUs(uint32_t localUs) const {
+    int32_t elapsed = (int32_t)(localUs - _refLocalUs);
+    return _refOffsetUs + (uint32_t)(int32_t)(((int64_t)elapsed * _driftPpb) / 1000000000LL);
+  }
+
+  // Sender clock rate relative to the receiver's (parts per billion)
+  int32_t getDriftPpb() const { return _driftPpb; }
+
+  // Convert a sender timestamp to the receiver's clock, and back
+  uint32_t toLocal(uint32_t remoteUs) const {
+    uint32_t local = remoteUs - _refOffsetUs;
+    return remoteUs - getOffsetUs(local);
+  }
+
+  uint32_t toRemote(uint32_t localUs) const {
+    return localUs + getOffsetUs(localUs);
+  }
+
+  // Age of a sample taken at sender time `remoteUs` when it was received at
+  // `localUs`; recorded in the latency statistics
+  int32_t recordLatency(uint32_t remoteUs, uint32_t localUs) {
+    int32_t latency = (int32_t)(localUs - toLocal(remoteUs));
+    _latency.count++;
+    if (latency < _latency.minUs) _latency.minUs = latency;
+    if (latency > _latency.maxUs) _latency.maxUs = latency;
+    _latency.totalUs += latency;
+    if (latency < 0) _latency.negative++;
+    size_t bin = 0;
+    while (bin < HISTOGRAM_BINS - 1 && latency >= (int32_t)latencyEdge(bin)) bin++;
+    _latency.histogram[bin]++;
+    return latency;
+  }
+
+  int32_t getMeanLatencyUs() const {
+    return _latency.count > 0 ? (int32_t)(_latency.totalUs / _latency.count) : 0;
+  }
+
+  const Stats& getStats() const { return _stats; }
+  const LatencyStats& getLatencyStats() const { return _latency; }
+  void resetLatency() {
+    _latency = LatencyStats();
+    _latency.minUs = INT32_MAX;
+    _latency.maxUs = INT32_MIN;
+  }
+
+private:
+  struct Exchange {
+    uint32_t localUs;         // Receiver time at the exchange midpoint
+    uint32_t offsetUs;        // Sender minus receiver (modular)
+    uint32_t delayUs;
+  };
+
+  uint32_t _delayMarginUs;
+  Exchange _window[WINDOW];
+  size_t _count;
+  size_t _next;
+  Exchange _bucket;           // Best exchange of the open bucket
+  size_t _bucketCount;
+  bool _driftKnown;
+  uint32_t _refLocalUs;       // Fit reference point
+  uint32_t _refOffsetUs;      // Offset at _refLocalUs
+  int32_t _driftPpb;
+  Stats _stats;
+  LatencyStats _latency;
+
+  // Fit offset and drift through the closed buckets plus the open one,
+  // relative to the newest exchange (keeps every term a small signed
+  // difference)
+  void solve(uint32_t nowUs) {
+    const Exchange* points[WINDOW + 1];
+    size_t count = 0;
+    for (size_t i = 0; i < _count; i++) points[count++] = &_window[i];
+    if (_bucketCount > 0) points[count++] = &_bucket;
+
+    uint32_t minDelay = UINT32_MAX;
+    int32_t minX = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (points[i]->delayUs < minDelay) minDelay = points[i]->delayUs;
+      int32_t x = (int32_t)(points[i]->localUs - nowUs);
+      if (x < minX) minX = x;
+    }
+    _stats.minDelayUs = minDelay;
+
+    bool fitDrift = count >= 3 && (uint32_t)(-minX) >= MIN_DRIFT_SPAN_US;
+    if (!fitDrift && !_driftKnown) {
+      // Not enough history: newest bucket only, no slope
+      const Exchange* newest = (_bucketCount > 0) ? &_bucket
+                                                  : &_window[(_next + WINDOW - 1) % WINDOW];
+      _refLocalUs = newest->localUs;
+      _refOffsetUs = newest->offsetUs;
+      return;
+    }
+
+    uint32_t refOffset = points[count - 1]->offsetUs;
+    double margin = _delayMarginUs > 0 ? _delayMarginUs : 1;
+    double w = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < count; i++) {
+      double excess = (points[i]->delayUs - minDelay) / margin;
+      double weight = 1.0 / (1.0 + excess * excess);
+      double x = (int32_t)(points[i]->localUs - nowUs);
+      double y = (int32_t)(points[i]->offsetUs - refOffset);
+      w += weight;
+      sx += weight * x;
+      sy += weight * y;
+      sxx += weight * x * x;
+      sxy += weight * x * y;
+    }
+
+    double drift = _driftPpb / 1e9;
+    double denominator = w * sxx - sx * sx;
+    if (fitDrift && denominator > 0) {
+      drift = (w * sxy - sx * sy) / denominator;
+      if (drift > MAX_DRIFT_PPB / 1e9) drift = MAX_DRIFT_PPB / 1e9;
+      if (drift < -MAX_DRIFT_PPB / 1e9) drift = -MAX_DRIFT_PPB / 1e9;
+      _driftKnown = true;
+    }
+    // Offset now with the fitted (or kept) slope
+    double intercept = (sy - drift * sx) / w;
+
+    _refLocalUs = nowUs;
+    _refOffsetUs = refOffset + (uint32_t)(int32_t)(intercept < 0 ? intercept - 0.5
+                                                                 : intercept + 0.5);
+    _driftPpb = (int32_t)(drift * 1e9);
+  }
+};
+
+#endif // CLOCK_SYNC_H
@@ -0,0 +1,152 @@
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "protocol_v2.h"
+
+// ============================================================================
+// UART Command Channel
+// ============================================================================
+// Host-to-device commands travel in v2 frames (COBS + CRC-16) of type
+// TYPE_COMMAND with payload [command id][arguments]. The device answers each
+// one with TYPE_ACK [command sequence u16][command id][result...] or
+// TYPE_NACK [command sequence u16][command id][status], framed like the
+// selected output (a v1 extended frame or a v2 frame). A lone 0x00 (a delimiter ending no frame) is
+// reported as a sample trigger.
+//
+// The parser wraps the incremental v2 decoder: no allocation, constant work
+// per byte plus one bounded decode (at most MAX_ENCODED bytes) per frame
+// delimiter. Arduino-free so it can be fuzzed on a host.
+
+namespace Command {
+
+// Frame types
+static const uint8_t TYPE_COMMAND = 0x20;
+static const uint8_t TYPE_ACK = 0x21;
+static const uint8_t TYPE_NACK = 0x22;
+
+// Command ids
+enum Id : uint8_t {
+  SET_RATE = 0x01,          // [rate u16 Hz] output sample rate
+  SET_SENSORS = 0x02,       // [mask u8] bit n = read sensor n+1
+  SET_OUTPUT = 0x03,        // [protocol version u8][batch samples u8]
+  GET_COUNTERS = 0x04,      // -> [counter u32] x n (see PROTOCOL.md)
+  PING = 0x05               // [receiver time u32] -> [receiver time u32]
+                            //    [receive time u32][reply time u32] (clock_sync.h)
+};
+
+// NACK status codes
+enum Status : uint8_t {
+  OK = 0x00,
+  UNKNOWN_COMMAND = 0x01,
+  BAD_LENGTH = 0x02,
+  BAD_VALUE = 0x03
+};
+
+// Maximum result size in an ACK
+static const size_t MAX_RESULT = ProtocolV2::MAX_PAYLOAD - 3;
+
+// One received command (args point into the parser's buffer)
+struct Request {
+  uint16_t sequence;
+  uint8_t id;
+  const uint8_t* args;
+  uint8_t length;
+  uint32_t receivedUs;      // Arrival time, if the transport stamps it (else 0)
+};
+
+class Parser {
+public:
+  enum Event {
+    NONE,
+    COMMAND,        // A command is ready in request()
+    TRIGGER         // Lone frame delimiter (sample trigger in triggered mode)
+  };
+
+  struct Stats {
+    uint32_t commands;        // Valid command frames
+    uint32_t ignored;         // Valid frames of other types, or empty
+    uint32_t triggers;        // Lone delimiters
+  };
+
+  Parser() : _inFrame(false) { resetStats(); }
+
+  // Feed one received byte
+  Event push(uint8_t byte) {
+    if (byte == ProtocolV2::DELIMITER && !_inFrame) {
+      // A delimiter that ends no frame: COBS never produces it inside a
+      // frame, so one byte on the line is an unambiguous trigger
+      _decoder.push(byte);
+      _stats.triggers++;
+      return TRIGGER;
+    }
+    _inFrame = (byte != ProtocolV2::DELIMITER);
+    if (!_decoder.push(byte)) return NONE;
+    const ProtocolV2::Frame& frame = _decoder.frame();
+    if (frame.type != TYPE_COMMAND || frame.length == 0) {
+      _stats.ignored++;
+      return NONE;
+    }
+    _request.sequence = frame.sequence;
+    _request.id = frame.payload[0];
+    _request.args = frame.payload + 1;
+    _request.length = frame.length - 1;
+    _request.receivedUs = 0;
+    _stats.commands++;
+    return COMMAND;
+  }
+
+  const Request& request() const { return _request; }
+  const Stats& getStats() const { return _stats; }
+  const ProtocolV2::Decoder::Stats& getFrameStats() const { return _decoder.getStats(); }
+  void resetStats() {
+    _stats = Stats();
+    _decoder.resetStats();
+  }
+
+private:
+  ProtocolV2::Decoder _decoder;
+  bool _inFrame;            // Bytes received since the last delimiter
+  Request _request;
+  Stats _stats;
+};
+
+// ----------------------------------------------------------------------------
+// Host side
+// ----------------------------------------------------------------------------
+// Encode a command frame (including the trailing delimiter) into `out`
+// (ProtocolV2::MAX_ENCODED bytes). Returns its size, 0 if too long.
+inline size_t encodeCommand(uint16_t sequence, uint8_t id, const uint8_t* args,
+                            uint8_t length, uint8_t* out) {
+  uint8_t payload[ProtocolV2::MAX_PAYLOAD];
+  if (length + 1u > sizeof(payload)) return 0;
+  payload[0] = id;
+  for (uint8_t i = 0; i < length; i++) payload[1 + i] = args[i];
+  return ProtocolV2::encodeFrame(TYPE_COMMAND, sequence, 0, payload, length + 1, out);
+}
+
+// Ping carrying the host's send time t1
+inline size_t encodePing(uint16_t sequence, uint32_t localUs, uint8_t* out) {
+  const uint8_t args[4] = {
+    (uint8_t)localUs, (uint8_t)(localUs >> 8), (uint8_t)(localUs >> 16), (uint8_t)(localUs >> 24)
+  };
+  return encodeCommand(sequence, PING, args, sizeof(args), out);
+}
+
+// Parse a TYPE_ACK payload answering a ping: t1 (host), t2 and t3 (device)
+inline bool parsePong(const uint8_t* payload, size_t length,
+                      uint32_t& t1, uint32_t& t2, uint32_t& t3) {
+  if (length != 3 + 12 || payload[2] != PING) return false;
+  const uint8_t* p = payload + 3;
+  uint32_t* times[3] = { &t1, &t2, &t3 };
+  for (uint8_t i = 0; i < 3; i++, p += 4) {
+    *times[i] = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+                ((uint32_t)p[3] << 24);
+  }
+  return true;
+}
+
+} // namespace Command
+
+#endif // COMMAND_PARSER_H
@@ -12,14 +12,14 @@
 // ----------------------------------------------------------------------------
 #define I2C_BUS0_SDA_PIN    5       // GPIO 5 - I2C Bus 0 SDA
 #define I2C_BUS0_SCL_PIN    6       // GPIO 6 - I2C Bus 0 SCL
-#define I2C_BUS0_FREQ       400000  // 400kHz (Fast Mode)
+#define I2C_BUS0_FREQ       400000  // 400kHz (Fast Mode), 1000000 for Fast-mode Plus
 
 // ----------------------------------------------------------------------------
 // I2C Bus 1 Configuration (Second AS5600 Sensor)
 // ----------------------------------------------------------------------------
 #define I2C_BUS1_SDA_PIN    7       // GPIO 7 - I2C Bus 1 SDA
 #define I2C_BUS1_SCL_PIN    8       // GPIO 8 - I2C Bus 1 SCL
-#define I2C_BUS1_FREQ       400000  // 400kHz (Fast Mode)
+#define I2C_BUS1_FREQ       400000  // 400kHz (Fast Mode), 1000000 for Fast-mode Plus
 
 // ----------------------------------------------------------------------------
 // Serial Communication Configuration
@@ -29,6 +29,24 @@
 #define SERIAL_TX_PIN       43      // GPIO 43 - UART TX (U0TXD)
 #define SERIAL_RX_PIN       44      // GPIO 44 - UART RX (U0RXD)
 #define SERIAL_BAUD_RATE    115200  // Baud rate for serial communication
+                                    // (UART1 runs up to 5 Mbaud, e.g. 921600,
+                                    // 2000000; the receiver must match)
+#define UART_PROTOCOL_VERSION 1     // 1 = 7-byte packets, 2 = COBS/CRC-16 frames
+                                    // with sequence + timestamp (PROTOCOL.md)
+#define UART_TX_QUEUE           true    // Queue frames for a drain task (never blocks sampling)
+#define UART_TX_OVERFLOW        UartTxQueue::Ring::DROP_OLDEST  // or DROP_NEWEST, COALESCE_LATEST
+#define UART_TX_DRIVER_BUFFER   1024    // UART driver TX buffer (bytes)
+#define UART_TX_TASK_CORE       1       // Beside acquisition (its producer), away from Wi-Fi
+#define UART_TX_TASK_PRIORITY   (configMAX_PRIORITIES - 4)  // Below acquisition: drains in its gaps
+#define UART_TX_TASK_STACK_SIZE 2048
+#define UART_BATCH_SAMPLES  1       // >1: delta-encoded batches of up to N samples
+#define UART_BATCH_FLUSH_US 20000   // Max age of a batch's first sample (us)
+#define UART_BATCH_MAX_SAMPLES  32  // Upper limit accepted by SET_OUTPUT
+
+// Command channel on the UART RX pin (set rate/sensors/output, read counters)
+#define UART_COMMANDS_ENABLED   true
+#define UART_RX_BYTES_PER_TICK  64      // Max bytes parsed per acquisition tick
+#define MAX_ACQ_RATE_HZ         4000    // Upper limit accepted by SET_RATE
 
 // ----------------------------------------------------------------------------
 // RGB LED Configuration (for status indication)
@@ -46,12 +64,102 @@
 
 // Calculate sampling interval in milliseconds
 #define SAMPLE_INTERVAL_MS  (1000 / SAMPLE_RATE_HZ)
+#define SAMPLE_INTERVAL_US  (1000000UL / SAMPLE_RATE_HZ)
+
+// Oversampling: sensors are read OVERSAMPLE_FACTOR times per output sample and
+// averaged (wrap-aware) down to SAMPLE_RATE_HZ. 1 = off, e.g. 20 = 1 kHz reads
+// at 50 Hz output (+2.2 bits effective resolution on white noise)
+#define OVERSAMPLE_FACTOR   1
+#define ACQ_INTERVAL_US     (SAMPLE_INTERVAL_US / OVERSAMPLE_FACTOR)
+
+// Tracking observer (alpha-beta-gamma) per sensor, run at the acquisition rate.
+// Smoothing 0..0.99: higher = less noise, slower response
+#define OBSERVER_THETA      0.8f
+#define UART_SEND_MOTION    false   // Also send angle/velocity/acceleration frames
+
+// Multi-turn tracking: positions are unwrapped at the acquisition rate and
+// saved to NVS so the turn count survives a reset. A save happens every
+// MULTI_TURN_SAVE_DELTA counts of travel (must be < 2048, half a turn), once
+// the shaft has been still for MULTI_TURN_REST_MS, and on software restart.
+// Restore is exact after a stop; while moving it holds up to the speed limit
+// in position_store.h.
+#define MULTI_TURN_PERSIST          true
+#define MULTI_TURN_SAVE_DELTA       1024    // Counts (1/4 turn)
+#define MULTI_TURN_REST_MS          500     // Stillness before a rest save
+#define UART_SEND_POSITION          false   // Also send 64-bit position frames
+#define UART_SEND_TIMESTAMPS        false   // Also send per-sensor sample instants (us)
+
+// Acquisition task (woken by esp_timer, independent of loop())
+#define ACQ_TASK_CORE           1       // Core for sampling + UART output
+#define ACQ_TASK_PRIORITY       (configMAX_PRIORITIES - 3)
+#define ACQ_TASK_STACK_SIZE     4096    // Task stack (bytes)
+#define ACQ_LATE_THRESHOLD_US   500     // Wakeups later than this count as late
+#define ACQ_STATS_LOG_MS        10000   // Timing statistics log interval
+
+// Host-triggered sampling: the receiver requests each sample and the reply
+// goes out as soon as both sensors are read, instead of being up to one
+// period old. Trigger-to-response latency is logged with the timing stats.
+// 0 = free-running (timer), 1 = UART trigger (a lone 0x00 byte on RX),
+// 2 = GPIO edge on SAMPLE_TRIGGER_PIN
+#define SAMPLE_TRIGGER              0
+#define SAMPLE_TRIGGER_PIN          4       // GPIO for SAMPLE_TRIGGER 2
+#define SAMPLE_TRIGGER_EDGE         RISING  // RISING, FALLING or CHANGE
+#define SAMPLE_TRIGGER_HOLDOFF_US   50      // Ignore re-triggers (bounce) closer than this
 
 // ----------------------------------------------------------------------------
 // AS5600 Sensor Configuration
 // ----------------------------------------------------------------------------
 #define AS5600_I2C_ADDRESS  0x36    // Fixed I2C address for AS5600
 
+// Fast read path: set the register pointer once, then issue 2-byte reads only
+// (3 bytes on the bus per sample instead of 5)
+#define AS5600_FAST_READ           true
+#define AS5600_FAST_READ_REGISTER  0x0E    // 0x0E = ANGLE, 0x0C = RAW ANGLE
+
+// Startup check of each bus clock: fast reads are compared with library
+// reads; a clock above 400 kHz that fails falls back to 400 kHz
+#define I2C_VERIFY_READS        8
+#define I2C_VERIFY_TOLERANCE    16      // Counts (allows for shaft movement)
+
+// PWM backend: the AS5600 OUT pin is switched to PWM (CONF register, once over
+// I2C) and both edges are timestamped by the MCPWM capture unit, so reading an
+// angle costs no I2C transaction. OUT pins must be wired to the GPIOs below.
+#define SENSOR_BACKEND_PWM      false
+#define PWM_SENSOR1_PIN         9       // GPIO for sensor 1 OUT
+#define PWM_SENSOR2_PIN         10      // GPIO for sensor 2 OUT
+#define PWM_FREQ_SETTING        3       // CONF PWMF: 0=115, 1=230, 2=460, 3=920 Hz
+#define PWM_PERIOD_TOLERANCE    15      // Accepted period deviation (%)
+
+// Sensor array: more than two AS5600s behind TCA9548A I2C multiplexers.
+// When enabled, SENSOR_ARRAY_LAYOUT replaces the two direct sensors.
+// Each entry is { bus (0/1), mux address (0 = direct), mux channel }
+#define SENSOR_ARRAY_ENABLED    false
+#define SENSOR_ARRAY_LAYOUT     { \
+  {0, 0x70, 0}, {0, 0x70, 1}, {0, 0x70, 2}, {0, 0x70, 3}, \
+  {1, 0x70, 0}, {1, 0x70, 1}, {1, 0x70, 2}, {1, 0x70, 3}  \
+}
+
+// Read both buses concurrently: bus 1 is read by a worker task while the
+// caller reads bus 0, so a pair costs max(bus0, bus1) instead of the sum.
+// The worker runs on core 0 so the reads overlap fully, which puts it beside
+// the network task, AsyncTCP and Wi-Fi: it preempts the first two for every
+// bus 1 read, and it shares its priority with the Wi-Fi task (23), so heavy
+// Wi-Fi traffic can delay a read; past I2C_WORKER_TIMEOUT_MS the previous
+// bus 1 value is reported. I2C_WORKER_CORE 1 leaves core 0 to networking,
+// but the reads then only overlap while the acquisition task waits on bus 0.
+#define I2C_PARALLEL_READS      true
+#define I2C_WORKER_CORE         0       // Core for the bus 1 worker task (see above)
+#define I2C_WORKER_PRIORITY     (configMAX_PRIORITIES - 2)
+#define I2C_WORKER_STACK_SIZE   3072    // Worker task stack (bytes)
+#define I2C_WORKER_TIMEOUT_MS   5       // Max wait for the bus 1 worker
+
+// Fault recovery: per-transaction timeout, and re-probe backoff for sensors
+// that went offline (or were missing at boot). Each re-probe clears the bus
+// (SCL pulses + STOP) and restarts the controller.
+#define I2C_TIMEOUT_MS          2       // Wire timeout per transaction (ms)
+#define I2C_REPROBE_MIN_MS      100     // First re-probe delay (ms)
+#define I2C_REPROBE_MAX_MS      5000    // Backoff cap (ms)
+
 // ----------------------------------------------------------------------------
 // Data Protocol Configuration
 // ----------------------------------------------------------------------------
@@ -61,6 +169,18 @@
 #define PACKET_START_BYTE   0xAA    // Packet start marker
 #define PACKET_END_BYTE     0x55    // Packet end marker
 
+// Extended frames (sensor array and other message types):
+// [0xAB][TYPE][LENGTH][PAYLOAD...][CHECKSUM][END_BYTE]
+#define PACKET_EXT_START_BYTE 0xAB  // Extended frame start marker
+
+// Change-driven output: send (UART and WebSocket) only when an angle moved
+// more than its deadband since the last sent value, plus a heartbeat so the
+// receiver can detect liveness while the shafts are still
+#define OUTPUT_CHANGE_DRIVEN    false
+#define OUTPUT_DEADBAND_1       2       // Sensor 1 deadband (counts)
+#define OUTPUT_DEADBAND_2       2       // Sensor 2 deadband (counts)
+#define OUTPUT_HEARTBEAT_MS     1000    // Max interval between sends (ms)
+
 // ----------------------------------------------------------------------------
 // WiFi Configuration
 // ----------------------------------------------------------------------------
@@ -86,7 +206,18 @@
 #endif
 
 #define WEB_SERVER_PORT     80          // Web server port (default: 80)
-#define WEBSOCKET_UPDATE_MS 100         // WebSocket update interval in milliseconds
+#define WEBSOCKET_UPDATE_MS 100         // Default interval for clients that never subscribe
+#define WEBSOCKET_JSON      true        // Also serve JSON messages on /ws/json
+                                        // (false: binary /ws only)
+#define WEBSOCKET_MAX_CLIENTS 4         // Concurrent WebSocket clients (more are refused)
+#define WEBSOCKET_QUEUE_LIMIT 4         // Frames queued to a client before it counts as congested
+
+// Network task: web server, WebSocket and OTA run here instead of loop(),
+// away from the acquisition core
+#define NET_TASK_CORE       0
+#define NET_TASK_PRIORITY   2
+#define NET_TASK_STACK_SIZE 8192        // Task stack (bytes)
+#define NET_TASK_INTERVAL_MS 1          // Service period
 
 // ----------------------------------------------------------------------------
 // Logging Configuration
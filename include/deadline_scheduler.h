@@ -0,0 +1,68 @@
+#ifndef DEADLINE_SCHEDULER_H
+#define DEADLINE_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "clock.h"
+
+// ============================================================================
+// Fixed-Period Deadline Scheduler
+// ============================================================================
+// Keeps absolute deadlines (start + n * period) so the schedule never drifts,
+// and measures how late each wakeup is against its deadline. A wakeup that is
+// more than one period late counts the skipped deadlines as missed.
+// Platform independent: time comes from the Clock interface.
+
+class DeadlineScheduler {
+public:
+  // Lateness histogram: bin i counts wakeups with lateness < HISTOGRAM_EDGES_US[i],
+  // the last bin counts everything beyond the last edge
+  static const size_t HISTOGRAM_BINS = 8;
+  static const uint32_t HISTOGRAM_EDGES_US[HISTOGRAM_BINS - 1];
+
+  struct Stats {
+    uint32_t wakeups;           // Deadlines serviced
+    uint32_t lateCount;         // Wakeups later than the late threshold
+    uint32_t missedDeadlines;   // Deadlines skipped entirely
+    uint32_t maxLatenessUs;     // Worst lateness seen
+    uint32_t histogram[HISTOGRAM_BINS];
+  };
+
+  // Constructor
+  DeadlineScheduler(Clock& clock, uint32_t periodUs, uint32_t lateThresholdUs);
+
+  // Start the schedule: first deadline is one period from now
+  void start();
+
+  // Change the period; the schedule restarts from now
+  void setPeriod(uint32_t periodUs);
+  uint32_t getPeriodUs() const { return _periodUs; }
+
+  // Account for a wakeup. Returns the number of deadlines that elapsed
+  // (1 when on time, >1 when deadlines were missed), or 0 for a spurious
+  // wakeup well ahead of the next deadline.
+  uint32_t onWake();
+
+  // Absolute time of the next deadline (us)
+  int64_t getNextDeadlineUs() const { return _nextDeadlineUs; }
+
+  // Lateness of the last serviced wakeup (us)
+  uint32_t getLastLatenessUs() const { return _lastLatenessUs; }
+
+  // Statistics
+  const Stats& getStats() const { return _stats; }
+  void resetStats();
+
+private:
+  Clock& _clock;
+  uint32_t _periodUs;
+  uint32_t _lateThresholdUs;
+  int64_t _nextDeadlineUs;
+  uint32_t _lastLatenessUs;
+  Stats _stats;
+
+  // Histogram bin for a lateness value
+  static size_t histogramBin(uint32_t latenessUs);
+};
+
+#endif // DEADLINE_SCHEDULER_H
@@ -0,0 +1,211 @@
+#ifndef FILTER_CHAIN_H
+#define FILTER_CHAIN_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Compile-Time Angle Filter Pipeline
+// ============================================================================
+// Filters operate on 12-bit angles (0-4095) and are wrap-aware: differences
+// are taken along the shortest way around the circle, so nothing jumps at the
+// 4095 -> 0 crossing. Every filter provides
+//
+//   uint16_t process(uint16_t angle);
+//   void reset();
+//
+// FilterChain<A, B, C> runs A, then B, then C. The chain is a plain nested
+// object with inline calls: no virtual dispatch, no heap, and the compiler
+// sees the whole pipeline as one function.
+//
+//   FilterChain<Median3, IIR<3>, Deadband<2> > chain;
+//   uint16_t filtered = chain.process(raw);
+
+namespace filters {
+
+// Signed shortest distance from `from` to `to`, in [-2048, 2047]
+inline int32_t wrapDelta(uint16_t to, uint16_t from) {
+  int32_t delta = (int32_t)((to - from) & 0x0FFF);
+  return delta >= 2048 ? delta - 4096 : delta;
+}
+
+inline uint16_t wrapAngle(int32_t angle) {
+  return (uint16_t)(angle & 0x0FFF);
+}
+
+} // namespace filters
+
+// ----------------------------------------------------------------------------
+// Median of the last three samples (spike rejection)
+// ----------------------------------------------------------------------------
+class Median3 {
+public:
+  Median3() { _history[0] = _history[1] = 0; reset(); }
+
+  void reset() { _count = 0; }
+
+  uint16_t process(uint16_t angle) {
+    angle &= 0x0FFF;
+    if (_count < 2) {
+      _history[_count++] = angle;
+      return angle;
+    }
+    // Offsets of the two previous samples relative to the current one
+    int32_t a = filters::wrapDelta(_history[0], angle);
+    int32_t b = filters::wrapDelta(_history[1], angle);
+    _history[0] = _history[1];
+    _history[1] = angle;
+
+    int32_t median;
+    if ((a <= 0 && b >= 0) || (b <= 0 && a >= 0)) {
+      median = 0;
+    } else if (a > 0) {
+      median = a < b ? a : b;
+    } else {
+      median = a > b ? a : b;
+    }
+    return filters::wrapAngle(angle + median);
+  }
+
+private:
+  uint16_t _history[2];
+  uint8_t _count;
+};
+
+// ----------------------------------------------------------------------------
+// First-order IIR low-pass: y += (x - y) / 2^Shift, state in Q8
+// ----------------------------------------------------------------------------
+template <uint8_t Shift>
+class IIR {
+public:
+  IIR() : _state(0) { reset(); }
+
+  void reset() { _initialized = false; }
+
+  uint16_t process(uint16_t angle) {
+    int32_t input = (int32_t)(angle & 0x0FFF) << 8;
+    if (!_initialized) {
+      _state = input;
+      _initialized = true;
+    } else {
+      int32_t error = (input - _state) & ((4096 << 8) - 1);
+      if (error >= (2048 << 8)) error -= (4096 << 8);
+      _state = (_state + (error >> Shift)) & ((4096 << 8) - 1);
+    }
+    return filters::wrapAngle((_state + 128) >> 8);
+  }
+
+private:
+  int32_t _state;
+  bool _initialized;
+};
+
+// ----------------------------------------------------------------------------
+// Deadband: output only moves when the input is more than Counts away
+// ----------------------------------------------------------------------------
+template <uint16_t Counts>
+class Deadband {
+public:
+  Deadband() : _output(0) { reset(); }
+
+  void reset() { _initialized = false; }
+
+  uint16_t process(uint16_t angle) {
+    angle &= 0x0FFF;
+    if (!_initialized) {
+      _output = angle;
+      _initialized = true;
+      return angle;
+    }
+    int32_t delta = filters::wrapDelta(angle, _output);
+    if (delta > (int32_t)Counts || delta < -(int32_t)Counts) {
+      _output = angle;
+    }
+    return _output;
+  }
+
+private:
+  uint16_t _output;
+  bool _initialized;
+};
+
+// ----------------------------------------------------------------------------
+// Moving average over the last Length samples (wrap-aware)
+// ----------------------------------------------------------------------------
+template <uint8_t Length>
+class MovingAverage {
+public:
+  MovingAverage() : _position(0), _sum(0), _index(0) { reset(); }
+
+  void reset() { _count = 0; }
+
+  uint16_t process(uint16_t angle) {
+    angle &= 0x0FFF;
+    if (_count == 0) {
+      // Seed the window with the first sample
+      _position = angle;
+      for (uint8_t i = 0; i < Length; i++) _window[i] = angle;
+      _sum = (int32_t)angle * Length;
+      _index = 0;
+      _count = 1;
+      return angle;
+    }
+
+    // Samples are kept unwrapped so the window can straddle 4095 -> 0
+    _position += filters::wrapDelta(angle, filters::wrapAngle(_position));
+    _sum += _position - _window[_index];
+    _window[_index] = _position;
+    if (++_index == Length) _index = 0;
+
+    // Keep the unwrapped values small
+    if (_position > (1L << 20) || _position < -(1L << 20)) {
+      int32_t shift = _position & ~0x0FFF;
+      _position -= shift;
+      for (uint8_t i = 0; i < Length; i++) _window[i] -= shift;
+      _sum -= shift * Length;
+    }
+
+    int32_t half = Length / 2;
+    int32_t mean = (_sum >= 0 ? _sum + half : _sum - half) / Length;
+    return filters::wrapAngle(mean);
+  }
+
+private:
+  int32_t _window[Length];
+  int32_t _position;
+  int32_t _sum;
+  uint8_t _index;
+  uint8_t _count;
+};
+
+// ----------------------------------------------------------------------------
+// Filter chain
+// ----------------------------------------------------------------------------
+template <typename... Filters>
+class FilterChain;
+
+// Empty chain: pass-through
+template <>
+class FilterChain<> {
+public:
+  uint16_t process(uint16_t angle) { return angle; }
+  void reset() {}
+};
+
+template <typename First, typename... Rest>
+class FilterChain<First, Rest...> {
+public:
+  uint16_t process(uint16_t angle) {
+    return _rest.process(_first.process(angle));
+  }
+
+  void reset() {
+    _first.reset();
+    _rest.reset();
+  }
+
+private:
+  First _first;
+  FilterChain<Rest...> _rest;
+};
+
+#endif // FILTER_CHAIN_H
@@ -0,0 +1,24 @@
+#ifndef FILTER_CONFIG_H
+#define FILTER_CONFIG_H
+
+#include "filter_chain.h"
+
+// ============================================================================
+// Per-Sensor Filter Chains
+// ============================================================================
+// Applied to each output sample (after oversampling/decimation, before UART
+// and WebSocket output). Edit these to match the rig; an empty chain is a
+// pass-through and compiles to nothing. Available filters (filter_chain.h):
+//
+//   Median3             median of the last 3 samples (spike rejection)
+//   IIR<shift>          first-order low-pass, y += (x - y) / 2^shift
+//   Deadband<counts>    hold output until input moves more than counts
+//   MovingAverage<n>    wrap-aware mean of the last n samples
+//
+// Example:
+//   typedef FilterChain<Median3, IIR<2>, Deadband<1> > Sensor1Filter;
+
+typedef FilterChain<> Sensor1Filter;
+typedef FilterChain<> Sensor2Filter;
+
+#endif // FILTER_CONFIG_H
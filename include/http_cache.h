@@ -0,0 +1,60 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// HTTP Conditional GET
+// ============================================================================
+// If-None-Match handling for the embedded dashboard assets (web_assets.h):
+// a request whose header lists the asset's current ETag gets 304 Not
+// Modified instead of the body. The header is "*" or a comma-separated
+// list of quoted entity tags, each optionally weak ("W/"); If-None-Match
+// uses weak comparison, so the W/ prefix is ignored on both sides
+// (RFC 9110, 13.1.2).
+//
+// Arduino-free so it can be checked on a host (tools/http_cache_check.cpp).
+
+namespace HttpCache {
+
+// Skip a "W/" weak prefix
+inline const char* stripWeak(const char* tag) {
+  return (tag[0] == 'W' && tag[1] == '/') ? tag + 2 : tag;
+}
+
+// True if the If-None-Match value `ifNoneMatch` matches `etag` (quoted).
+// nullptr or empty matches nothing.
+inline bool etagMatches(const char* ifNoneMatch, const char* etag) {
+  if (ifNoneMatch == nullptr || etag == nullptr) return false;
+  etag = stripWeak(etag);
+  size_t etagLength = strlen(etag);
+
+  const char* p = ifNoneMatch;
+  while (*p) {
+    while (*p == ' ' || *p == '\t' || *p == ',') p++;
+    if (*p == '\0') break;
+    if (*p == '*') return true;
+
+    // One entity tag: up to the closing quote (a tag cannot contain one)
+    const char* tag = stripWeak(p);
+    const char* end = tag;
+    if (*end == '"') {
+      end = strchr(end + 1, '"');
+      if (end == nullptr) return false;
+      end++;
+    } else {
+      // Unquoted (malformed): up to the next separator
+      while (*end && *end != ',' && *end != ' ' && *end != '\t') end++;
+    }
+    if ((size_t)(end - tag) == etagLength && strncmp(tag, etag, etagLength) == 0) return true;
+
+    p = end;
+    while (*p && *p != ',') p++;
+  }
+  return false;
+}
+
+} // namespace HttpCache
+
+#endif // HTTP_CACHE_H
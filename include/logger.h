@@ -2,6 +2,8 @@
 #define LOGGER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <vector>
 
 // Log levels
@@ -42,18 +44,34 @@ public:
   void warnf(const char* format, ...);
   void errorf(const char* format, ...);
   
-  // Get stored log entries
-  const std::vector<LogEntry>& getEntries() const { return entries; }
+  // Entries are numbered from boot. The stored ones are numbers first to
+  // end - 1, so a reader that resumes later can tell which entries were
+  // dropped in between.
+  uint32_t getEntryCount() const;
+  void getEntryRange(uint32_t& first, uint32_t& end) const;
+  
+  // Copy entry `number`, or the oldest stored one if it has been dropped
+  // (`number` is updated). False when no entry from `number` on is stored.
+  // Entries are only ever copied out: log() runs in several tasks.
+  bool copyEntry(uint32_t& number, LogEntry& entry) const;
   
   // Get log entries as JSON string
   String getEntriesJSON() const;
   
+  // One entry as a JSON object
+  String getEntryJSON(const LogEntry& entry) const;
+  
   // Clear all stored entries
   void clear();
 
 private:
   std::vector<LogEntry> entries;
   size_t maxEntries;
+  uint32_t entryCount;
+  SemaphoreHandle_t mutex;    // Guards entries and entryCount
+  
+  void lock() const;
+  void unlock() const;
   
   // Core logging function
   void log(LogLevel level, const String& message);
@@ -0,0 +1,73 @@
+#ifndef MULTI_TURN_TRACKER_H
+#define MULTI_TURN_TRACKER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Multi-Turn Position Tracker
+// ============================================================================
+// Unwraps 12-bit single-turn angles into a signed 64-bit position in counts
+// (4096 per turn). Each sample adds the shortest wrapped distance from the
+// previous one, so the shaft must move less than half a turn between samples
+// (Nyquist). Steps above NEAR_ALIAS_COUNTS are counted as near-aliasing so
+// the margin can be monitored.
+
+class MultiTurnTracker {
+public:
+  static const int32_t COUNTS_PER_TURN = 4096;
+  static const int32_t NEAR_ALIAS_COUNTS = 1536;   // 3/8 turn per sample
+
+  MultiTurnTracker() : _position(0), _lastAngle(0), _nearAlias(0), _initialized(false) {}
+
+  // Resume from a saved position: the current angle is placed within half a
+  // turn of the saved one
+  void restore(int64_t savedPosition, uint16_t currentAngle) {
+    currentAngle &= 0x0FFF;
+    uint16_t savedAngle = (uint16_t)(savedPosition & 0x0FFF);
+    _position = savedPosition + wrapDelta(currentAngle, savedAngle);
+    _lastAngle = currentAngle;
+    _initialized = true;
+  }
+
+  // Feed one sample (0-4095)
+  void update(uint16_t angle) {
+    angle &= 0x0FFF;
+    if (!_initialized) {
+      _position = angle;
+      _lastAngle = angle;
+      _initialized = true;
+      return;
+    }
+    int32_t delta = wrapDelta(angle, _lastAngle);
+    if (delta > NEAR_ALIAS_COUNTS || delta < -NEAR_ALIAS_COUNTS) {
+      _nearAlias++;
+    }
+    _position += delta;
+    _lastAngle = angle;
+  }
+
+  bool isInitialized() const { return _initialized; }
+  int64_t getPosition() const { return _position; }
+
+  // Whole turns (floor division, so -1 count is turn -1)
+  int32_t getTurns() const {
+    return (int32_t)(_position >= 0 ? _position / COUNTS_PER_TURN
+                                    : -((-_position + COUNTS_PER_TURN - 1) / COUNTS_PER_TURN));
+  }
+
+  uint32_t getNearAliasCount() const { return _nearAlias; }
+
+  // Signed shortest distance from `from` to `to`, in [-2048, 2047]
+  static int32_t wrapDelta(uint16_t to, uint16_t from) {
+    int32_t delta = (int32_t)((to - from) & 0x0FFF);
+    return delta >= 2048 ? delta - 4096 : delta;
+  }
+
+private:
+  int64_t _position;
+  uint16_t _lastAngle;
+  uint32_t _nearAlias;
+  bool _initialized;
+};
+
+#endif // MULTI_TURN_TRACKER_H
@@ -0,0 +1,49 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// ============================================================================
+// Network Service Task
+// ============================================================================
+// Runs the web server, WebSocket and OTA handling in a task pinned to the
+// network core (core 0, next to the WiFi stack), so a slow page load or a
+// stalled client never delays the acquisition task or UART output on core 1.
+// The service callback runs every NET_TASK_INTERVAL_MS; sensor data reaches
+// it through seqlock snapshots only (see seqlock.h).
+
+class NetworkTask {
+public:
+  // Service callback, runs in the network task
+  typedef void (*ServiceCallback)(void* arg);
+
+  struct Stats {
+    uint32_t iterations;
+    uint32_t lastServiceUs;   // Duration of the last callback
+    uint32_t maxServiceUs;    // Longest callback since the last reset
+  };
+
+  NetworkTask();
+
+  // Create the task. Returns false if it could not be created (the caller
+  // then keeps servicing the network from loop()).
+  bool begin(ServiceCallback callback, void* arg);
+  bool isRunning() const { return _task != nullptr; }
+
+  // Timing statistics (written by the network task; read for reporting)
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  TaskHandle_t _task;
+  ServiceCallback _callback;
+  void* _callbackArg;
+  Stats _stats;
+
+  static void taskEntry(void* arg);
+  void run();
+};
+
+#endif // NETWORK_TASK_H
@@ -0,0 +1,70 @@
+#ifndef POSITION_STORE_H
+#define POSITION_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stdint.h>
+
+// ============================================================================
+// Multi-Turn Position Persistence (NVS)
+// ============================================================================
+// Saves the 64-bit positions of both sensors to NVS so the turn count
+// survives a reset. The restore places the current angle within half a turn
+// of the stored position, so it is only right while the shaft is less than
+// half a turn (2048 counts) from the last write:
+//   - while moving, a position is written every `minDelta` counts of travel
+//     (minDelta < 2048), with no time limit. The stored value lags by
+//     minDelta plus the travel during one service() call and its NVS write
+//     (a few ms, more when NVS erases a page), so the restore holds up to
+//     roughly (2048 - minDelta) / 10 ms = 100k counts/s (~1500 rpm) at the
+//     default 1/4 turn. Faster shafts can come back a turn off;
+//   - once the position has been still (within REST_JITTER_COUNTS) for
+//     `restMs`, it is written exactly, so a shaft that stopped before the
+//     reset restores exactly;
+//   - flush() saves everything, e.g. from a shutdown handler on a software
+//     restart. A brown-out resets the chip without warning; what counts then
+//     is the last travel or rest write.
+// Continuous rotation writes 4096 / minDelta entries per turn; NVS spreads
+// them over its pages (it appends, it does not rewrite a key in place).
+//
+// NVS writes stall flash access on both cores; call service() from loop(),
+// never from the acquisition task.
+
+class PositionStore {
+public:
+  static const uint8_t SENSORS = 2;
+
+  PositionStore();
+
+  static const int32_t REST_JITTER_COUNTS = 2;   // Still despite this much noise
+
+  // Open the NVS namespace and load stored positions
+  void begin(uint32_t minDelta, uint32_t restMs);
+
+  // Stored position; false if none was saved
+  bool load(uint8_t sensor, int64_t& position) const;
+
+  // Save positions that travelled minDelta, or came to rest
+  void service(const int64_t* positions, uint8_t count);
+
+  // Force-save (e.g. before a planned restart)
+  void flush(const int64_t* positions, uint8_t count);
+
+  uint32_t getWriteCount() const { return _writes; }
+
+private:
+  Preferences _prefs;
+  int64_t _stored[SENSORS];
+  bool _valid[SENSORS];
+  int64_t _lastSeen[SENSORS];       // Position at the last movement
+  unsigned long _stillSince[SENSORS];
+  bool _restSaved[SENSORS];         // Rest write done since the last movement
+  uint32_t _minDelta;
+  uint32_t _restMs;
+  uint32_t _writes;
+  bool _open;
+
+  void write(uint8_t sensor, int64_t position);
+};
+
+#endif // POSITION_STORE_H
@@ -0,0 +1,289 @@
+#ifndef PROTOCOL_V2_H
+#define PROTOCOL_V2_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Binary Protocol v2 (COBS framed, CRC-16)
+// ============================================================================
+// Frame before encoding (all fields little-endian):
+//
+//   [version=2][type][sequence u16][timestamp u32][payload 0..N][CRC-16 u16]
+//
+// The CRC (CRC-16/CCITT-FALSE: poly 0x1021, init 0xFFFF) covers everything
+// from the version byte to the end of the payload. The frame is then COBS
+// encoded, so it contains no zero bytes, and terminated with 0x00. A receiver
+// resynchronizes at the next zero byte whatever was lost or corrupted.
+//
+// Header-only and Arduino-free so the same code encodes on the device and
+// decodes/tests on a host.
+
+namespace ProtocolV2 {
+
+static const uint8_t VERSION = 2;
+static const uint8_t DELIMITER = 0x00;
+static const size_t HEADER_SIZE = 8;
+static const size_t CRC_SIZE = 2;
+static const size_t MAX_PAYLOAD = 64;
+static const size_t MAX_FRAME = HEADER_SIZE + MAX_PAYLOAD + CRC_SIZE;
+// COBS adds one byte per started 254-byte block, plus the delimiter
+static const size_t MAX_ENCODED = MAX_FRAME + MAX_FRAME / 254 + 2;
+
+// Message types. 0x01-0x06 carry the same payloads as the v1 extended frames.
+enum Type : uint8_t {
+  TYPE_ANGLE_ARRAY = 0x01,    // [count][angle u16] x count
+  TYPE_MOTION = 0x02,         // [count][angle u16, velocity i32, accel i32] x count
+  TYPE_POSITION = 0x03,       // [count][position i64] x count
+  TYPE_TIMESTAMP = 0x04,      // [count][sample time u32] x count
+  TYPE_ARRAY_TIMESTAMP = 0x06,  // [count][newest time u32][age u16] x count
+  TYPE_ANGLES = 0x10          // [count][angle u16, time offset i16] x count
+};
+
+// Decoded frame (payload points into the decoder's buffer)
+struct Frame {
+  uint8_t type;
+  uint16_t sequence;
+  uint32_t timestampUs;
+  const uint8_t* payload;
+  uint8_t length;
+};
+
+// ----------------------------------------------------------------------------
+// CRC-16/CCITT-FALSE, one table lookup per byte
+// ----------------------------------------------------------------------------
+inline const uint16_t* crc16Table() {
+  static const uint16_t table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+  };
+  return table;
+}
+
+inline uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF) {
+  const uint16_t* table = crc16Table();
+  for (size_t i = 0; i < length; i++) {
+    crc = (uint16_t)((crc << 8) ^ table[(uint8_t)((crc >> 8) ^ data[i])]);
+  }
+  return crc;
+}
+
+// ----------------------------------------------------------------------------
+// COBS
+// ----------------------------------------------------------------------------
+// Encode `length` bytes into `out` (no delimiter). Returns the encoded size,
+// or 0 if `outSize` is too small.
+inline size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* out, size_t outSize) {
+  if (outSize < length + length / 254 + 1) return 0;
+  size_t codeIndex = 0;
+  size_t write = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] != 0) {
+      out[write++] = data[i];
+      code++;
+    }
+    if (data[i] == 0 || code == 0xFF) {
+      out[codeIndex] = code;
+      code = 1;
+      codeIndex = write++;
+    }
+  }
+  out[codeIndex] = code;
+  return write;
+}
+
+// Decode one block (`out` may equal `data`). Returns the decoded
+// size, or 0 on a malformed block.
+inline size_t cobsDecode(const uint8_t* data, size_t length, uint8_t* out) {
+  size_t read = 0;
+  size_t write = 0;
+  while (read < length) {
+    uint8_t code = data[read++];
+    if (code == 0 || read + code - 1 > length) return 0;
+    for (uint8_t i = 1; i < code; i++) {
+      out[write++] = data[read++];
+    }
+    if (code != 0xFF && read < length) {
+      out[write++] = 0;
+    }
+  }
+  return write;
+}
+
+// ----------------------------------------------------------------------------
+// Frame encoder
+// ----------------------------------------------------------------------------
+// Builds, CRCs and COBS-encodes one frame including the trailing delimiter.
+// Returns the number of bytes to send, or 0 if the payload is too long.
+inline size_t encodeFrame(uint8_t type, uint16_t sequence, uint32_t timestampUs,
+                          const uint8_t* payload, size_t length,
+                          uint8_t out[MAX_ENCODED]) {
+  if (length > MAX_PAYLOAD) return 0;
+
+  uint8_t raw[MAX_FRAME];
+  raw[0] = VERSION;
+  raw[1] = type;
+  raw[2] = sequence & 0xFF;
+  raw[3] = (sequence >> 8) & 0xFF;
+  for (uint8_t b = 0; b < 4; b++) raw[4 + b] = (timestampUs >> (8 * b)) & 0xFF;
+  for (size_t i = 0; i < length; i++) raw[HEADER_SIZE + i] = payload[i];
+  uint16_t crc = crc16(raw, HEADER_SIZE + length);
+  raw[HEADER_SIZE + length] = crc & 0xFF;
+  raw[HEADER_SIZE + length + 1] = (crc >> 8) & 0xFF;
+
+  size_t encoded = cobsEncode(raw, HEADER_SIZE + length + CRC_SIZE, out, MAX_ENCODED - 1);
+  out[encoded] = DELIMITER;
+  return encoded + 1;
+}
+
+// ----------------------------------------------------------------------------
+// Incremental stream decoder
+// ----------------------------------------------------------------------------
+// Feed received bytes one at a time; push() returns true when a valid frame
+// has been completed (available through frame() until the next push()).
+class Decoder {
+public:
+  struct Stats {
+    uint32_t frames;          // Valid frames
+    uint32_t crcErrors;       // Frames failing the CRC
+    uint32_t framingErrors;   // Malformed COBS, short frames, wrong version
+    uint32_t overruns;        // Frames longer than MAX_ENCODED (discarded)
+    uint32_t lost;            // Frames missing according to the sequence
+    uint32_t duplicates;      // Frames repeating the previous sequence
+    uint32_t sequenceResets;  // Sequence stepped back (sender restarted)
+  };
+
+  Decoder() : _length(0), _discard(false), _haveSequence(false), _lastSequence(0) {
+    resetStats();
+  }
+
+  bool push(uint8_t byte) {
+    if (byte != DELIMITER) {
+      if (_length < sizeof(_buffer)) {
+        _buffer[_length++] = byte;
+      } else if (!_discard) {
+        _discard = true;
+        _stats.overruns++;
+      }
+      return false;
+    }
+
+    // Delimiter: decode what was collected
+    size_t length = _length;
+    bool discard = _discard;
+    _length = 0;
+    _discard = false;
+    if (discard) return false;
+    if (length == 0) return false;    // Back-to-back delimiters (idle/resync)
+    return decode(_buffer, length);
+  }
+
+  // True when no partial frame is buffered: the next byte starts a frame
+  bool isIdle() const { return _length == 0; }
+
+  // Decode one whole encoded frame (the bytes between two delimiters)
+  // straight from the caller's buffer, without collecting it first. Same
+  // result as push()ing those bytes and the delimiter while idle.
+  bool decodeFrame(const uint8_t* encoded, size_t length) {
+    if (length == 0) return false;
+    if (length > sizeof(_buffer)) {
+      _stats.overruns++;
+      return false;
+    }
+    return decode(encoded, length);
+  }
+
+  // Drop a partially received frame (e.g. after a line error)
+  void reset() {
+    _length = 0;
+    _discard = false;
+  }
+
+  const Frame& frame() const { return _frame; }
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  uint8_t _buffer[MAX_ENCODED];
+  uint8_t _decoded[MAX_ENCODED];
+  size_t _length;
+  bool _discard;
+  bool _haveSequence;
+  uint16_t _lastSequence;
+  Frame _frame;
+  Stats _stats;
+
+  bool decode(const uint8_t* encoded, size_t length) {
+    size_t size = cobsDecode(encoded, length, _decoded);
+    if (size < HEADER_SIZE + CRC_SIZE || size > MAX_FRAME || _decoded[0] != VERSION) {
+      _stats.framingErrors++;
+      return false;
+    }
+
+    size_t body = size - CRC_SIZE;
+    uint16_t received = (uint16_t)(_decoded[body] | (_decoded[body + 1] << 8));
+    if (crc16(_decoded, body) != received) {
+      _stats.crcErrors++;
+      return false;
+    }
+
+    _frame.type = _decoded[1];
+    _frame.sequence = (uint16_t)(_decoded[2] | (_decoded[3] << 8));
+    _frame.timestampUs = (uint32_t)_decoded[4] | ((uint32_t)_decoded[5] << 8) |
+                         ((uint32_t)_decoded[6] << 16) | ((uint32_t)_decoded[7] << 24);
+    _frame.payload = _decoded + HEADER_SIZE;
+    _frame.length = (uint8_t)(body - HEADER_SIZE);
+
+    // Steps of up to half the sequence range forward are gaps; a repeat is
+    // not a loss of 65535, and a step back restarts the count from there
+    if (_haveSequence) {
+      int16_t step = (int16_t)(uint16_t)(_frame.sequence - _lastSequence);
+      if (step > 0) {
+        _stats.lost += (uint32_t)(step - 1);
+      } else if (step == 0) {
+        _stats.duplicates++;
+      } else {
+        _stats.sequenceResets++;
+      }
+    }
+    _lastSequence = _frame.sequence;
+    _haveSequence = true;
+    _stats.frames++;
+    return true;
+  }
+};
+
+} // namespace ProtocolV2
+
+#endif // PROTOCOL_V2_H
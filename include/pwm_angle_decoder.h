@@ -0,0 +1,143 @@
+#ifndef PWM_ANGLE_DECODER_H
+#define PWM_ANGLE_DECODER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// AS5600 PWM Output Decoder
+// ============================================================================
+// Decodes the AS5600 PWM output from edge timestamps. One PWM frame is 4351
+// clock periods: 128 HIGH (start), 4095 data, 128 LOW (end). The high time is
+// 128 + angle clock periods, so the angle follows from the duty cycle without
+// knowing the (±10% tolerant) oscillator frequency:
+//
+//   angle = round(high * 4351 / period) - 128
+//
+// A frame completes on each rising edge. Frames whose period is outside the
+// expected range or whose high time is outside the valid band are rejected,
+// as are edges closer together than the minimum pulse width (glitches).
+// Timestamps are free-running capture ticks; wraparound is handled.
+
+class PwmAngleDecoder {
+public:
+  static const uint32_t FRAME_CLOCKS = 4351;
+  static const uint32_t START_CLOCKS = 128;
+  static const uint16_t MAX_ANGLE = 4095;
+
+  struct Stats {
+    uint32_t frames;        // Valid frames decoded
+    uint32_t glitches;      // Edges dropped as too short
+    uint32_t rejected;      // Frames with invalid period or duty
+  };
+
+  // nominalPeriodTicks: expected PWM period in capture ticks
+  // tolerancePercent: accepted period deviation (AS5600 oscillator is ±10%)
+  PwmAngleDecoder(uint32_t nominalPeriodTicks = 1, uint8_t tolerancePercent = 15)
+    : _riseTicks(0), _fallTicks(0), _lastEdgeTicks(0), _frameTicks(0), _angle(0), _hasAngle(false) {
+    configure(nominalPeriodTicks, tolerancePercent);
+  }
+
+  void configure(uint32_t nominalPeriodTicks, uint8_t tolerancePercent) {
+    uint32_t margin = (uint32_t)(((uint64_t)nominalPeriodTicks * tolerancePercent) / 100);
+    _minPeriod = nominalPeriodTicks - margin;
+    _maxPeriod = nominalPeriodTicks + margin;
+    // Shortest legal pulse is the 128-clock start/end marker; allow half
+    _minPulse = (uint32_t)(((uint64_t)_minPeriod * START_CLOCKS) / FRAME_CLOCKS / 2);
+    reset();
+  }
+
+  // Forget edge history (keeps the last decoded angle)
+  void reset() {
+    _haveRise = false;
+    _haveFall = false;
+    _lastEdgeValid = false;
+    _stats = Stats();
+  }
+
+  // Feed one edge. Returns true when a new angle was decoded.
+  bool onEdge(bool rising, uint32_t ticks) {
+    // Glitch rejection: an edge too close to the previous one cancels both
+    if (_lastEdgeValid && (uint32_t)(ticks - _lastEdgeTicks) < _minPulse) {
+      _stats.glitches++;
+      _lastEdgeValid = false;
+      _haveRise = false;
+      _haveFall = false;
+      return false;
+    }
+    _lastEdgeTicks = ticks;
+    _lastEdgeValid = true;
+
+    if (!rising) {
+      if (_haveRise) {
+        _fallTicks = ticks;
+        _haveFall = true;
+      }
+      return false;
+    }
+
+    bool decoded = false;
+    if (_haveRise && _haveFall) {
+      uint32_t period = ticks - _riseTicks;
+      uint32_t high = _fallTicks - _riseTicks;
+      decoded = decodeFrame(high, period, ticks);
+    }
+    _riseTicks = ticks;
+    _haveRise = true;
+    _haveFall = false;
+    return decoded;
+  }
+
+  // Last decoded angle (0-4095) and the tick of the rising edge that completed it
+  uint16_t getAngle() const { return _angle; }
+  uint32_t getFrameTicks() const { return _frameTicks; }
+  bool hasAngle() const { return _hasAngle; }
+
+  const Stats& getStats() const { return _stats; }
+
+  // Convert a duty cycle to an angle (exposed for reuse/testing)
+  static bool dutyToAngle(uint32_t high, uint32_t period, uint16_t& angle) {
+    if (period == 0) return false;
+    // Scaled high time in clock periods, rounded
+    uint32_t clocks = (uint32_t)(((uint64_t)high * FRAME_CLOCKS + period / 2) / period);
+    // Allow a couple of clocks of jitter outside the data band
+    if (clocks + 2 < START_CLOCKS || clocks > START_CLOCKS + MAX_ANGLE + 2) {
+      return false;
+    }
+    int32_t value = (int32_t)clocks - (int32_t)START_CLOCKS;
+    if (value < 0) value = 0;
+    if (value > MAX_ANGLE) value = MAX_ANGLE;
+    angle = (uint16_t)value;
+    return true;
+  }
+
+private:
+  uint32_t _minPeriod;
+  uint32_t _maxPeriod;
+  uint32_t _minPulse;
+  uint32_t _riseTicks;
+  uint32_t _fallTicks;
+  uint32_t _lastEdgeTicks;
+  uint32_t _frameTicks;
+  uint16_t _angle;
+  bool _hasAngle;
+  bool _haveRise;
+  bool _haveFall;
+  bool _lastEdgeValid;
+  Stats _stats;
+
+  bool decodeFrame(uint32_t high, uint32_t period, uint32_t ticks) {
+    uint16_t angle;
+    if (period < _minPeriod || period > _maxPeriod || high >= period ||
+        !dutyToAngle(high, period, angle)) {
+      _stats.rejected++;
+      return false;
+    }
+    _angle = angle;
+    _frameTicks = ticks;
+    _hasAngle = true;
+    _stats.frames++;
+    return true;
+  }
+};
+
+#endif // PWM_ANGLE_DECODER_H
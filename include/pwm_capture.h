@@ -0,0 +1,66 @@
+#ifndef PWM_CAPTURE_H
+#define PWM_CAPTURE_H
+
+#include <Arduino.h>
+#include <driver/mcpwm.h>
+#include <stdint.h>
+#include "pwm_angle_decoder.h"
+
+// ============================================================================
+// AS5600 PWM Capture (MCPWM hardware capture)
+// ============================================================================
+// Timestamps both edges of up to two AS5600 OUT pins with the MCPWM capture
+// unit (APB clock, 12.5 ns resolution). The ISR only stores the edge in a
+// small ring; frames are decoded by PwmAngleDecoder when an angle is read,
+// so there is no CPU polling of the pins.
+
+class PwmCapture {
+public:
+  static const uint8_t CHANNELS = 2;
+  static const uint32_t CAPTURE_CLOCK_HZ = 80000000UL;  // APB clock
+
+  PwmCapture();
+
+  // Start capturing on the given pins (255 = channel unused)
+  bool begin(uint8_t pin1, uint8_t pin2, uint32_t pwmFreqHz);
+
+  // Latest angle for a channel; false if no valid frame yet
+  bool readAngle(uint8_t channel, uint16_t& angle);
+
+  // Age of the frame behind the last readAngle() (us), and worst seen
+  uint32_t getLatencyUs(uint8_t channel) const { return channel < CHANNELS ? _latencyUs[channel] : 0; }
+  uint32_t getMaxLatencyUs(uint8_t channel) const { return channel < CHANNELS ? _maxLatencyUs[channel] : 0; }
+
+  const PwmAngleDecoder::Stats& getDecoderStats(uint8_t channel) const { return _decoders[channel].getStats(); }
+  uint32_t getOverruns(uint8_t channel) const { return channel < CHANNELS ? _rings[channel].overruns : 0; }
+
+  bool isRunning() const { return _running; }
+
+private:
+  static const uint8_t EDGE_RING_SIZE = 64;   // Power of two, ~35 ms of edges at 920 Hz
+
+  struct Edge {
+    uint32_t ticks;       // Capture timer value
+    uint32_t timeUs;      // esp_timer time (low 32 bits)
+    bool rising;
+  };
+
+  struct EdgeRing {
+    Edge edges[EDGE_RING_SIZE];
+    volatile uint8_t head;      // Written by ISR
+    uint8_t tail;               // Written by reader
+    volatile uint32_t overruns;
+  };
+
+  EdgeRing _rings[CHANNELS];
+  PwmAngleDecoder _decoders[CHANNELS];
+  uint32_t _frameUs[CHANNELS];
+  uint32_t _latencyUs[CHANNELS];
+  uint32_t _maxLatencyUs[CHANNELS];
+  bool _running;
+
+  static bool IRAM_ATTR captureCallback(mcpwm_unit_t unit, mcpwm_capture_channel_id_t channel,
+                                        const cap_event_data_t* edata, void* arg);
+};
+
+#endif // PWM_CAPTURE_H
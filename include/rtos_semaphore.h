@@ -0,0 +1,34 @@
+#ifndef RTOS_SEMAPHORE_H
+#define RTOS_SEMAPHORE_H
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// ============================================================================
+// FreeRTOS Binary Semaphore
+// ============================================================================
+// The semaphore interface BusWorker expects (bus_worker.h), on FreeRTOS.
+
+class RtosSemaphore {
+public:
+  RtosSemaphore() : _handle(nullptr) {}
+
+  bool begin() {
+    if (_handle == nullptr) _handle = xSemaphoreCreateBinary();
+    return _handle != nullptr;
+  }
+
+  void give() { xSemaphoreGive(_handle); }
+
+  // 0xFFFFFFFF waits forever, 0 polls
+  bool take(uint32_t timeoutMs) {
+    TickType_t ticks = (timeoutMs == 0xFFFFFFFF) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return xSemaphoreTake(_handle, ticks) == pdTRUE;
+  }
+
+private:
+  SemaphoreHandle_t _handle;
+};
+
+#endif // RTOS_SEMAPHORE_H
@@ -0,0 +1,186 @@
+#ifndef SAMPLE_BATCH_H
+#define SAMPLE_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Delta-Encoded Sample Batches
+// ============================================================================
+// Packs consecutive samples of up to MAX_SENSORS sensors into one frame
+// payload so the per-frame overhead is paid once per batch:
+//
+//   [sensors u8][samples u8][base time u32][interval u16]
+//   [angle u16] x sensors                          (first sample, absolute)
+//   then per further sample:
+//   [time jitter varint][angle delta varint] x sensors
+//
+// Multi-byte fields are little-endian. Varints are zigzag-encoded LEB128.
+// The time jitter is the sample interval minus the nominal interval (us),
+// so it is 0 for a steady rate. Angle deltas are wrap-aware in [-2048, 2047].
+// A slow-moving shaft costs 1 byte per sensor per sample.
+//
+// Arduino-free: the same header encodes on the device and decodes on a host.
+
+class SampleBatch {
+public:
+  static const uint8_t MAX_SENSORS = 4;
+  static const size_t HEADER_SIZE = 8;
+  static const size_t MAX_PAYLOAD = 64;   // Fits one extended / v2 frame
+
+  // One decoded sample
+  struct Sample {
+    uint32_t timeUs;
+    uint16_t angles[MAX_SENSORS];
+  };
+
+  SampleBatch()
+    : _sensors(2), _maxSamples(16), _intervalUs(1000), _flushUs(20000),
+      _count(0), _length(0), _startUs(0), _lastUs(0) {
+    for (uint8_t i = 0; i < MAX_SENSORS; i++) _last[i] = 0;
+  }
+
+  // Batch up to `maxSamples` samples of `sensors` angles taken every
+  // `intervalUs`; a batch is also closed once its first sample is
+  // `flushUs` old, which bounds the added latency.
+  void configure(uint8_t sensors, uint8_t maxSamples, uint16_t intervalUs, uint32_t flushUs) {
+    _sensors = (sensors == 0 || sensors > MAX_SENSORS) ? MAX_SENSORS : sensors;
+    _maxSamples = maxSamples == 0 ? 1 : maxSamples;
+    _intervalUs = intervalUs;
+    _flushUs = flushUs;
+    clear();
+  }
+
+  uint8_t getSampleCount() const { return _count; }
+  bool isEmpty() const { return _count == 0; }
+
+  // Append one sample. Returns false if the batch is full or the sample's
+  // deltas do not fit; send and clear() the batch, then add it again.
+  bool add(const uint16_t* angles, uint32_t timeUs) {
+    if (_count >= _maxSamples) return false;
+    if (_count == 0) {
+      _payload[0] = _sensors;
+      _payload[1] = 0;
+      putU32(_payload + 2, timeUs);
+      _payload[6] = _intervalUs & 0xFF;
+      _payload[7] = (_intervalUs >> 8) & 0xFF;
+      size_t p = HEADER_SIZE;
+      for (uint8_t i = 0; i < _sensors; i++) {
+        _last[i] = angles[i] & 0x0FFF;
+        _payload[p++] = _last[i] & 0xFF;
+        _payload[p++] = (_last[i] >> 8) & 0xFF;
+      }
+      _length = p;
+      _startUs = timeUs;
+    } else {
+      uint8_t scratch[5 * (MAX_SENSORS + 1)];
+      size_t n = 0;
+      int32_t jitter = (int32_t)(timeUs - _lastUs) - (int32_t)_intervalUs;
+      n += putVarint(scratch + n, zigzag(jitter));
+      for (uint8_t i = 0; i < _sensors; i++) {
+        uint16_t angle = angles[i] & 0x0FFF;
+        int32_t delta = (int32_t)((angle - _last[i]) & 0x0FFF);
+        if (delta >= 2048) delta -= 4096;
+        n += putVarint(scratch + n, zigzag(delta));
+      }
+      if (_length + n > MAX_PAYLOAD) return false;
+      for (size_t i = 0; i < n; i++) _payload[_length + i] = scratch[i];
+      _length += n;
+      for (uint8_t i = 0; i < _sensors; i++) _last[i] = angles[i] & 0x0FFF;
+    }
+    _lastUs = timeUs;
+    _payload[1] = ++_count;
+    return true;
+  }
+
+  // True when the batch should be sent: full, or its first sample reached
+  // the flush deadline
+  bool isReady(uint32_t nowUs) const {
+    if (_count == 0) return false;
+    return _count >= _maxSamples || (uint32_t)(nowUs - _startUs) >= _flushUs;
+  }
+
+  const uint8_t* getPayload() const { return _payload; }
+  size_t getLength() const { return _length; }
+  void clear() { _count = 0; _length = 0; }
+
+  // Decode a batch payload into `out` (up to `maxOut` samples). Returns the
+  // number of samples, or -1 if the payload is malformed.
+  static int decode(const uint8_t* payload, size_t length, Sample* out, size_t maxOut,
+                    uint8_t& sensors) {
+    if (length < HEADER_SIZE) return -1;
+    sensors = payload[0];
+    uint8_t samples = payload[1];
+    if (sensors == 0 || sensors > MAX_SENSORS || samples > maxOut) return -1;
+    if (length < HEADER_SIZE + 2u * sensors) return -1;
+    uint32_t timeUs = getU32(payload + 2);
+    uint16_t intervalUs = (uint16_t)(payload[6] | (payload[7] << 8));
+
+    size_t p = HEADER_SIZE;
+    for (uint8_t s = 0; s < samples; s++) {
+      if (s == 0) {
+        out[0].timeUs = timeUs;
+        for (uint8_t i = 0; i < sensors; i++, p += 2) {
+          out[0].angles[i] = (uint16_t)(payload[p] | (payload[p + 1] << 8)) & 0x0FFF;
+        }
+        continue;
+      }
+      uint32_t value;
+      if (!getVarint(payload, length, p, value)) return -1;
+      timeUs += intervalUs + (uint32_t)unzigzag(value);
+      out[s].timeUs = timeUs;
+      for (uint8_t i = 0; i < sensors; i++) {
+        if (!getVarint(payload, length, p, value)) return -1;
+        out[s].angles[i] = (uint16_t)((out[s - 1].angles[i] + unzigzag(value)) & 0x0FFF);
+      }
+    }
+    return p == length ? samples : -1;
+  }
+
+private:
+  uint8_t _sensors;
+  uint8_t _maxSamples;
+  uint16_t _intervalUs;
+  uint32_t _flushUs;
+  uint8_t _count;
+  size_t _length;
+  uint32_t _startUs;
+  uint32_t _lastUs;
+  uint16_t _last[MAX_SENSORS];
+  uint8_t _payload[MAX_PAYLOAD];
+
+  static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+  static int32_t unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+  static size_t putVarint(uint8_t* out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+      out[n++] = (uint8_t)(v | 0x80);
+      v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+  }
+
+  static bool getVarint(const uint8_t* in, size_t length, size_t& p, uint32_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+      if (p >= length) return false;
+      uint8_t b = in[p++];
+      v |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+
+  static void putU32(uint8_t* out, uint32_t v) {
+    for (uint8_t b = 0; b < 4; b++) out[b] = (v >> (8 * b)) & 0xFF;
+  }
+
+  static uint32_t getU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+           ((uint32_t)in[3] << 24);
+  }
+};
+
+#endif // SAMPLE_BATCH_H
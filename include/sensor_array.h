@@ -0,0 +1,99 @@
+#ifndef SENSOR_ARRAY_H
+#define SENSOR_ARRAY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "acquisition_task.h"
+#include "array_bus_reader.h"
+#include "bus_worker.h"
+#include "rtos_semaphore.h"
+
+// ============================================================================
+// AS5600 Sensor Array over TCA9548A I2C Multiplexers
+// ============================================================================
+// Spreads up to MAX_SENSORS AS5600s across multiplexer channels on Wire and
+// Wire1 (buses initialized by SensorManager::begin()). Each bus is read by
+// an ArrayBusReader (array_bus_reader.h: batched mux selects, per-sensor
+// health and re-probe, sample timestamps). Bus 1 is read by a worker task
+// while the caller reads bus 0; its results are handed over as one snapshot
+// after the pass completes, and a pass that overruns I2C_WORKER_TIMEOUT_MS
+// leaves bus 1's previous values in place, reported as not fresh.
+
+class SensorArray {
+public:
+  static const uint8_t MAX_SENSORS = 16;
+  static const uint8_t NO_MUX = 0;    // Sensor wired directly to the bus
+
+  // Where a sensor is wired
+  struct SensorConfig {
+    uint8_t bus;          // 0 = Wire, 1 = Wire1
+    uint8_t muxAddress;   // TCA9548A address (0x70-0x77), NO_MUX if direct
+    uint8_t channel;      // Mux channel (0-7)
+  };
+
+  // Constructor
+  SensorArray();
+
+  // Probe all sensors in the layout (buses must already be initialized)
+  void begin(const SensorConfig* layout, uint8_t count);
+
+  // Read all sensors; returns once both buses are done or the bus 1 wait
+  // timed out
+  void readAll();
+
+  // Results
+  uint8_t getCount() const { return _count; }
+  uint8_t getConnectedCount() const;
+  const uint16_t* getAngles() const { return _angles; }
+  uint16_t getAngle(uint8_t index) const { return index < _count ? _angles[index] : 0; }
+  bool isConnected(uint8_t index) const { return index < _count && _connected[index]; }
+
+  // Sample instant of each angle (esp_timer us, low 32 bits); a stale
+  // angle keeps the instant it was read at
+  const uint32_t* getTimes() const { return _timesUs; }
+
+  // Freshness: true if the sensor was read successfully in the last cycle,
+  // age is time since its last successful read
+  bool isFresh(uint8_t index) const { return index < _count && _fresh[index]; }
+  uint32_t getAgeUs(uint8_t index) const;
+
+  // Duration of the last readAll() (us)
+  uint32_t getCycleUs() const { return _cycleUs; }
+
+  // Mux writes actually issued (after batching), sensors read, and bus 1
+  // passes that overran the caller's wait
+  uint32_t getMuxSelects() const { return _muxWrites[0] + _muxWrites[1]; }
+  uint32_t getReads() const { return _reads[0] + _reads[1]; }
+  uint32_t getOverruns() const { return _bus1Worker.getStats().overruns; }
+
+private:
+  typedef ArrayBusReader<TwoWire> BusReader;
+
+  EspTimerClock _clock;
+  BusReader _bus0;
+  BusReader _bus1;
+  uint16_t _angles[MAX_SENSORS];
+  uint32_t _timesUs[MAX_SENSORS];
+  bool _connected[MAX_SENSORS];
+  bool _fresh[MAX_SENSORS];
+  uint8_t _count;
+  bool _started;                    // begin() done: log link changes
+  uint32_t _cycleUs;
+  uint32_t _muxWrites[2];          // Per bus, from the last snapshot
+  uint32_t _reads[2];
+
+  // Bus 1 worker task
+  TaskHandle_t _bus1Task;
+  BusWorker<RtosSemaphore, BusReader::Snapshot> _bus1Worker;
+
+  // Copy one bus's results into the array (fresh = the pass completed)
+  void merge(uint8_t busIndex, const BusReader& bus, const BusReader::Snapshot& snapshot,
+             bool completed);
+
+  static void bus1WorkerTask(void* arg);
+};
+
+#endif // SENSOR_ARRAY_H
@@ -0,0 +1,95 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Sensor Health / Re-Probe Scheduler
+// ============================================================================
+// Tracks one sensor's link state from read results. After FAULT_THRESHOLD
+// consecutive failed reads the sensor goes offline and reads stop touching
+// the bus; a re-probe (bus clear + presence check) is then allowed at
+// exponentially growing intervals, so a missing sensor costs one short
+// transaction every few seconds at most. Arduino-free; times are in ms and
+// wrap safely.
+
+class SensorHealth {
+public:
+  static const uint8_t FAULT_THRESHOLD = 3;
+
+  struct Stats {
+    uint32_t errors;        // Failed reads (NACK, timeout, short read)
+    uint32_t dropouts;      // Online -> offline transitions
+    uint32_t probes;        // Re-probe attempts while offline
+    uint32_t recoveries;    // Successful re-probes
+    uint32_t busClears;     // SCL recovery sequences issued
+  };
+
+  SensorHealth(uint32_t minBackoffMs = 100, uint32_t maxBackoffMs = 5000)
+    : _minBackoffMs(minBackoffMs), _maxBackoffMs(maxBackoffMs),
+      _backoffMs(minBackoffMs), _nextProbeMs(0), _consecutive(0), _online(false) {
+    resetStats();
+  }
+
+  bool isOnline() const { return _online; }
+
+  // Result of a presence check at startup
+  void begin(bool online, uint32_t nowMs) {
+    _online = online;
+    _consecutive = 0;
+    _backoffMs = _minBackoffMs;
+    _nextProbeMs = nowMs + _backoffMs;
+  }
+
+  void onReadOk() { _consecutive = 0; }
+
+  // Returns true when this failure took the sensor offline
+  bool onReadError(uint32_t nowMs) {
+    _stats.errors++;
+    if (!_online) return false;
+    if (++_consecutive < FAULT_THRESHOLD) return false;
+    _online = false;
+    _consecutive = 0;
+    _stats.dropouts++;
+    _backoffMs = _minBackoffMs;
+    _nextProbeMs = nowMs;     // First re-probe right away
+    return true;
+  }
+
+  // True when an offline sensor is due for a re-probe
+  bool shouldProbe(uint32_t nowMs) const {
+    return !_online && (int32_t)(nowMs - _nextProbeMs) >= 0;
+  }
+
+  void onBusClear() { _stats.busClears++; }
+
+  // Returns true when the probe brought the sensor back
+  bool onProbeResult(bool found, uint32_t nowMs) {
+    _stats.probes++;
+    if (found) {
+      _online = true;
+      _consecutive = 0;
+      _backoffMs = _minBackoffMs;
+      _stats.recoveries++;
+      return true;
+    }
+    _nextProbeMs = nowMs + _backoffMs;
+    _backoffMs = (_backoffMs >= _maxBackoffMs / 2) ? _maxBackoffMs : _backoffMs * 2;
+    return false;
+  }
+
+  uint32_t getBackoffMs() const { return _backoffMs; }
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  uint32_t _minBackoffMs;
+  uint32_t _maxBackoffMs;
+  uint32_t _backoffMs;
+  uint32_t _nextProbeMs;
+  uint8_t _consecutive;
+  bool _online;
+  Stats _stats;
+};
+
+#endif // SENSOR_HEALTH_H
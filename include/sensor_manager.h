@@ -4,6 +4,19 @@
 #include <AS5600.h>
 #include <Wire.h>
 #include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "as5600_fast_reader.h"
+#include "bus_worker.h"
+#include "rtos_semaphore.h"
+#include "angle_decimator.h"
+#include "pwm_capture.h"
+#include "tracking_observer.h"
+#include "multi_turn_tracker.h"
+#include "angle_calibration.h"
+#include "sensor_health.h"
+#include "clock.h"
 
 // ============================================================================
 // AS5600 Sensor Manager
@@ -11,6 +24,29 @@
 
 class SensorManager {
 public:
+  // One pair of readings taken together on both buses
+  struct AngleSample {
+    uint16_t angle1;        // Sensor 1 angle (0-4095)
+    uint16_t angle2;        // Sensor 2 angle (0-4095)
+    int32_t skewUs;         // Bus 1 read start minus bus 0 read start (us)
+    uint32_t cycleUs;       // Time to complete both reads (us)
+    uint32_t time1Us;       // Sensor 1 sample instant (esp_timer, low 32 bits)
+    uint32_t time2Us;       // Sensor 2 sample instant (esp_timer, low 32 bits)
+  };
+
+  // Observer estimate for one sensor
+  struct Motion {
+    uint16_t angle;         // Filtered angle (0-4095)
+    int32_t velocity;       // counts/s
+    int32_t acceleration;   // counts/s^2
+  };
+
+  // Acquisition backend
+  enum Backend {
+    BACKEND_I2C,    // Angle registers read over I2C
+    BACKEND_PWM     // AS5600 OUT pin in PWM mode, decoded by MCPWM capture
+  };
+
   // Constructor
   SensorManager();
 
@@ -18,35 +54,201 @@ public:
   void begin(uint8_t sda0, uint8_t scl0, uint32_t freq0,
              uint8_t sda1, uint8_t scl1, uint32_t freq1);
 
-  // Check if sensors are connected
-  bool isSensor1Connected() const { return _sensor1Connected; }
-  bool isSensor2Connected() const { return _sensor2Connected; }
-  bool areBothConnected() const { return _sensor1Connected && _sensor2Connected; }
-  bool isAnyConnected() const { return _sensor1Connected || _sensor2Connected; }
+  // Check if sensors are connected. Tracks runtime state: a sensor goes
+  // offline after repeated bus errors and comes back through background
+  // re-probing (also picks up sensors plugged in after boot).
+  bool isSensor1Connected() const { return _health[0].isOnline(); }
+  bool isSensor2Connected() const { return _health[1].isOnline(); }
+  bool areBothConnected() const { return isSensor1Connected() && isSensor2Connected(); }
+  bool isAnyConnected() const { return isSensor1Connected() || isSensor2Connected(); }
+  const SensorHealth::Stats& getHealth1() const { return _health[0].getStats(); }
+  const SensorHealth::Stats& getHealth2() const { return _health[1].getStats(); }
+
+  // Disabled sensors are not read (no bus traffic) and keep their last angle
+  void setSensorEnabled(uint8_t sensor, bool enabled);
+  bool isSensorEnabled(uint8_t sensor) const { return sensor < 2 && _enabled[sensor]; }
 
-  // Read angles from sensors (0-4095)
+  // Read angles from sensors (0-4095); a failed or missing read returns the
+  // sensor's last good angle (both backends)
   uint16_t readAngle1();
   uint16_t readAngle2();
 
   // Read both angles at once
   void readAngles(uint16_t& angle1, uint16_t& angle2);
 
+  // Read both angles with both bus transactions in flight together.
+  // Returns once both reads have finished.
+  void readAngles(AngleSample& sample);
+
+  // Switch connected sensors to PWM output and start capture on the given
+  // pins. Falls back to I2C if capture cannot be started.
+  bool beginPwmBackend(uint8_t pin1, uint8_t pin2, uint8_t freqSetting);
+  Backend getBackend() const { return _backend; }
+  const PwmCapture& getPwmCapture() const { return _pwm; }
+
+  // Oversampling: read at factor x the output rate and decimate.
+  // Call once per oversampled tick; returns true when `sample` holds a
+  // decimated pair (angles rounded to 12 bits).
+  void setOversampling(uint16_t factor);
+  uint16_t getOversampling() const { return _decimator1.getFactor(); }
+  bool sampleOversampled(AngleSample& sample);
+
+  // One immediate read for host-triggered sampling: calibrated angles and
+  // multi-turn tracking (valid while triggers come faster than half a turn
+  // of shaft movement), but no decimation or observer update since triggers
+  // arrive at no fixed rate
+  void sampleTriggered(AngleSample& sample);
+
+  // Last decimated angles with AngleDecimator::FRACTION_BITS extra bits
+  uint32_t getFineAngle1() const { return _decimator1.getAngleFixed(); }
+  uint32_t getFineAngle2() const { return _decimator2.getAngleFixed(); }
+
+  // Tracking observers, updated on every acquisition tick (before
+  // decimation). Velocity/acceleration are scaled by the acquisition rate
+  // measured from sample timestamps; setAcquisitionRate() sets the nominal
+  // rate used until enough ticks were seen.
+  void setAcquisitionRate(uint32_t rateHz);
+  uint32_t getMeasuredRateHz() const { return _acqRateHz; }
+  void setObserverSmoothing(float theta);
+  Motion getMotion1() const { return motionOf(_observer1); }
+  Motion getMotion2() const { return motionOf(_observer2); }
+
+  // Multi-turn positions (counts, 4096 per turn), unwrapped on every
+  // acquisition tick. restorePosition() resumes from a saved position using
+  // the sensor's current angle. Getters are safe from any task.
+  void restorePosition(uint8_t sensor, int64_t savedPosition);
+  int64_t getPosition1();
+  int64_t getPosition2();
+  int32_t getTurns1();
+  int32_t getTurns2();
+  uint32_t getNearAliasCount1() const { return _turns1.getNearAliasCount(); }
+  uint32_t getNearAliasCount2() const { return _turns2.getNearAliasCount(); }
+
+  // Nonlinearity calibration (sensor 0 or 1). Capture runs while the shaft
+  // turns at constant speed; serviceCalibration() (call from loop) turns a
+  // completed capture into the lookup table and returns the model so it can
+  // be stored. Corrections are applied in readAngles() with one lookup.
+  // startCalibration() may be called from any task: the acquisition task
+  // restarts the capture on its next read. applyCalibration() builds the
+  // table in a spare buffer and swaps it in; call it and serviceCalibration()
+  // from one task (setup/loop).
+  bool startCalibration(uint8_t sensor);
+  uint8_t getCalibrationProgress(uint8_t sensor) const;
+  bool isCalibrating(uint8_t sensor) const;
+  bool serviceCalibration(uint8_t sensor, int16_t model[AngleCalibrator::MODEL_POINTS]);
+  bool applyCalibration(uint8_t sensor, const int16_t model[AngleCalibrator::MODEL_POINTS]);
+  bool isCalibrated(uint8_t sensor) const;
+
   // Check magnet status
   bool isMagnet1Detected();
   bool isMagnet2Detected();
 
-  // Get sensor objects (for advanced usage)
-  AS5600& getSensor1() { return _sensor1; }
-  AS5600& getSensor2() { return _sensor2; }
+  // Fast read mode: register pointer set once, then 2-byte reads only
+  typedef AS5600FastReader<TwoWire> FastReader;
+  void setFastRead(bool enabled);
+  bool isFastRead() const { return _fastRead; }
+  const FastReader::Stats& getBusStats1() const { return _fast1.getStats(); }
+  const FastReader::Stats& getBusStats2() const { return _fast2.getStats(); }
+
+  // Get sensor objects (for advanced usage). Any register access through
+  // them moves the AS5600 address pointer, so the fast path re-arms.
+  AS5600& getSensor1() { _fast1.invalidatePointer(); return _sensor1; }
+  AS5600& getSensor2() { _fast2.invalidatePointer(); return _sensor2; }
 
 private:
   AS5600 _sensor1;
   AS5600 _sensor2;
-  bool _sensor1Connected;
-  bool _sensor2Connected;
+
+  // Link state, bus pins for recovery and last good angle per sensor
+  struct BusConfig {
+    uint8_t sda;
+    uint8_t scl;
+    uint32_t freq;
+    bool verified;          // verifyBus() has run on this bus
+  };
+  SensorHealth _health[2];
+  BusConfig _busConfig[2];
+  uint16_t _lastAngle[2];
+  volatile bool _enabled[2];
+
+  // Fast read path
+  FastReader _fast1;
+  FastReader _fast2;
+  bool _fastRead;
+
+  // Acquisition backend
+  Backend _backend;
+  PwmCapture _pwm;
+
+  // Oversampling decimators
+  AngleDecimator _decimator1;
+  AngleDecimator _decimator2;
+
+  // Tracking observers
+  TrackingObserver _observer1;
+  TrackingObserver _observer2;
+  uint32_t _acqRateHz;
+  uint32_t _tickUsQ4;       // Averaged tick interval (us, Q4)
+  uint32_t _lastTickUs;
+  bool _haveTick;
+
+  // Sample instants of the last fresh value per sensor, and of the first
+  // raw sample in the current decimation window
+  volatile uint32_t _sampleUs[2];
+  uint32_t _windowStartUs[2];
+  bool _windowOpen;
+
+  // Calibration
+  AngleCalibrator _calibrator[2];
+  AngleCorrection _correction[2];
+  uint16_t* _spareTable[2];                 // Next table is built here
+  volatile bool _calibrationRequested[2];   // Taken up by readAngles()
+
+  // Multi-turn tracking
+  MultiTurnTracker _turns1;
+  MultiTurnTracker _turns2;
+  portMUX_TYPE _positionMux;
+
+  // Bus 1 worker task (parallel reads). A read's angle and timestamps
+  // are published together and only read back after its done signal.
+  struct Bus1Result {
+    uint16_t angle;
+    uint32_t startUs;       // Worker picked up the start signal
+    uint32_t sampleUs;      // Instant of the angle (stale angles keep theirs)
+  };
+  TaskHandle_t _bus1Task;
+  BusWorker<RtosSemaphore, Bus1Result> _bus1Worker;
 
   // Initialize individual sensor
   bool initSensor(AS5600& sensor, const char* name);
+
+  // Read one sensor over I2C with fault tracking; offline sensors return
+  // their last good angle and are re-probed when their backoff expires
+  uint16_t readSensor(uint8_t index, TwoWire& bus, AS5600& sensor, FastReader& fast);
+
+  // Bus clear (SCL pulses + STOP), bus restart and presence check; the
+  // first sensor found on a bus not verified at boot verifies it
+  void probeSensor(uint8_t index, TwoWire& bus, AS5600& sensor, FastReader& fast);
+
+  // Check the bus clock and that fast reads agree with library reads;
+  // falls back to 400 kHz if a faster clock does not verify
+  void verifyBus(TwoWire& bus, AS5600& sensor, FastReader& fast,
+                 uint32_t requestedFreq, const char* name);
+
+  Motion motionOf(const TrackingObserver& observer) const;
+  void measureTick(uint32_t timeUs);
+
+  // Read both sensors without calibration
+  void readRawAngles(AngleSample& sample);
+
+  // Allocate a spare lookup table for a sensor (internal RAM, PSRAM
+  // fallback)
+  bool allocateSpareTable(uint8_t sensor);
+
+  // Start the bus 1 worker task
+  void startBus1Worker();
+  static void bus1WorkerTask(void* arg);
+  Bus1Result readBus1();
 };
 
 #endif // SENSOR_MANAGER_H
@@ -0,0 +1,88 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// Seqlock Snapshot
+// ============================================================================
+// Latest-value cell with one writer and any number of readers. The writer
+// never waits: it makes the sequence odd, stores the value, and makes it even
+// again. A reader copies the value between two loads of the sequence and
+// keeps the copy only if both were the same even number, so it never sees a
+// half-written (torn) value; otherwise it retries.
+//
+// The value is stored as relaxed atomic words, which keeps the concurrent
+// copy well-defined; T must be trivially copyable. A reader that can preempt
+// the writer on the writer's core must not spin forever, so read() gives up
+// after a bounded number of attempts.
+//
+// Arduino-free (std::atomic only) so it can be stress-tested on a host.
+
+template <typename T>
+class Seqlock {
+public:
+  static const uint32_t DEFAULT_TRIES = 64;
+
+  Seqlock() : _sequence(0) {
+    for (size_t i = 0; i < WORDS; i++) {
+      _words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Writer only: publish a new value
+  void write(const T& value) {
+    uint32_t words[WORDS];
+    words[WORDS - 1] = 0;
+    memcpy(words, &value, sizeof(T));
+
+    uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) {
+      _words[i].store(words[i], std::memory_order_relaxed);
+    }
+    _sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // One read attempt; false if a write was in progress or overlapped it
+  bool tryRead(T& value) const {
+    uint32_t before = _sequence.load(std::memory_order_acquire);
+    if (before & 1) return false;
+
+    uint32_t words[WORDS];
+    for (size_t i = 0; i < WORDS; i++) {
+      words[i] = _words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_sequence.load(std::memory_order_relaxed) != before) return false;
+
+    memcpy(&value, words, sizeof(T));
+    return true;
+  }
+
+  // Read a consistent copy, retrying up to `tries` times. Returns false
+  // (value untouched) if every attempt overlapped a write.
+  bool read(T& value, uint32_t tries = DEFAULT_TRIES) const {
+    for (uint32_t i = 0; i < tries; i++) {
+      if (tryRead(value)) return true;
+    }
+    return false;
+  }
+
+  // Number of completed writes (changes whenever a new value is published)
+  uint32_t version() const {
+    return _sequence.load(std::memory_order_acquire) >> 1;
+  }
+
+private:
+  static const size_t WORDS = (sizeof(T) + 3) / 4;
+
+  std::atomic<uint32_t> _sequence;
+  std::atomic<uint32_t> _words[WORDS];
+};
+
+#endif // SEQLOCK_H
@@ -0,0 +1,369 @@
+#ifndef STREAM_DECODER_H
+#define STREAM_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "protocol_v2.h"
+#include "sample_batch.h"
+
+// ============================================================================
+// Stream Receiver / Decoder
+// ============================================================================
+// Decodes the sender's UART stream from byte chunks of any size (one byte, a
+// DMA buffer, a whole capture file) and reports validated samples through a
+// callback. Handles both wire formats:
+//
+//   v1  7-byte 0xAA packets and 0xAB extended frames; bad checksums or end
+//       markers resync at the next start marker inside the buffered bytes
+//   v2  COBS frames with CRC-16; resync at the next 0x00, lost frames
+//       counted from the sequence numbers
+//
+// Frames that lie wholly inside a chunk are parsed where they are: v1
+// frames are checked and decoded in place, v2 frames are COBS-decoded
+// straight from the chunk (one pass into the frame buffer, which undoing
+// the byte stuffing needs anyway). Only a frame split across chunks is
+// collected byte by byte until it completes.
+//
+// Angle pairs, sensor-array frames and batches all arrive as Sample. Other
+// frames (motion, positions, timestamps, command replies) go to an optional
+// frame callback. Header-only, no allocation, no dependencies beyond the C
+// library: builds for ESP32 receivers and Linux tools alike.
+
+class StreamDecoder {
+public:
+  static const uint8_t MAX_SENSORS = 16;
+
+  struct Sample {
+    uint8_t sensors;                // Valid entries in angles[]
+    uint16_t angles[MAX_SENSORS];   // 0-4095
+    bool hasTime;
+    uint32_t timeUs;                // Sender clock (v2 and batches)
+    int16_t offsetsUs[MAX_SENSORS]; // Per-sensor offset from timeUs (v2 angles)
+    bool hasSequence;
+    uint16_t sequence;              // v2 frame sequence
+  };
+
+  struct Stats {
+    uint32_t bytes;
+    uint32_t frames;          // Valid frames/packets of any type
+    uint32_t samples;         // Samples delivered
+    uint32_t checksumErrors;  // v1 checksum/end marker or v2 CRC failures
+    uint32_t resyncs;         // Times the decoder lost and regained framing
+    uint32_t lostFrames;      // v2 sequence gaps
+    uint32_t malformed;       // Valid framing but undecodable payload
+  };
+
+  typedef void (*SampleCallback)(const Sample& sample, void* context);
+  typedef void (*FrameCallback)(uint8_t type, const uint8_t* payload, size_t length,
+                                void* context);
+
+  explicit StreamDecoder(uint8_t protocolVersion = 1)
+    : _version(protocolVersion == 2 ? 2 : 1), _onSample(nullptr), _onFrame(nullptr),
+      _context(nullptr), _length(0), _synced(true) {
+    resetStats();
+  }
+
+  void setCallbacks(SampleCallback onSample, FrameCallback onFrame, void* context) {
+    _onSample = onSample;
+    _onFrame = onFrame;
+    _context = context;
+  }
+
+  void setProtocolVersion(uint8_t version) {
+    _version = (version == 2) ? 2 : 1;
+    _length = 0;
+    _v2 = ProtocolV2::Decoder();
+  }
+
+  // Consume a chunk of received bytes
+  void feed(const uint8_t* data, size_t length) {
+    _stats.bytes += length;
+    if (_version == 2) {
+      feedV2(data, length);
+      syncV2Stats();
+    } else {
+      feedV1(data, length);
+    }
+  }
+
+  const Stats& getStats() const { return _stats; }
+  void resetStats() {
+    _stats = Stats();
+    _v2.resetStats();
+  }
+
+private:
+  // v1 framing
+  static const uint8_t V1_START = 0xAA;
+  static const uint8_t V1_EXT_START = 0xAB;
+  static const uint8_t V1_END = 0x55;
+  static const size_t V1_PACKET_SIZE = 7;
+  static const size_t V1_MAX_FRAME = 64 + 5;
+
+  uint8_t _version;
+  SampleCallback _onSample;
+  FrameCallback _onFrame;
+  void* _context;
+  Stats _stats;
+
+  uint8_t _buffer[V1_MAX_FRAME];
+  size_t _length;
+  bool _synced;
+
+  ProtocolV2::Decoder _v2;
+
+  // ---------------------------------------------------------------- v1 ----
+  void feedV1(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+      // Finish a frame split across chunks
+      if (_length > 0) {
+        pushV1(data[i++]);
+        continue;
+      }
+      size_t used = parseV1(data + i, length - i);
+      if (used == 0) {
+        // Frame incomplete at the end of the chunk: collect the rest
+        for (; i < length; i++) pushV1(data[i]);
+        return;
+      }
+      i += used;
+    }
+  }
+
+  // Parse at `data` in place. Returns the bytes consumed (a whole frame, or
+  // one byte that does not start a valid frame), 0 if the frame is cut off.
+  size_t parseV1(const uint8_t* data, size_t available) {
+    if (data[0] != V1_START && data[0] != V1_EXT_START) {
+      loseSync();
+      return 1;
+    }
+    size_t needed = frameLengthV1(data, available);
+    if (needed == 0) {
+      // Impossible length: not a real start marker
+      loseSync();
+      return 1;
+    }
+    if (available < needed) return 0;
+    if (!validateV1(data, needed)) {
+      _stats.checksumErrors++;
+      loseSync();
+      return 1;
+    }
+    _synced = true;
+    deliverV1(data, needed);
+    return needed;
+  }
+
+  void pushV1(uint8_t byte) {
+    if (_length == 0 && byte != V1_START && byte != V1_EXT_START) {
+      loseSync();
+      return;
+    }
+    _buffer[_length++] = byte;
+
+    for (;;) {
+      size_t needed = frameLengthV1(_buffer, _length);
+      if (needed == 0) {
+        // Impossible length: not a real start marker
+        if (!rescanV1()) return;
+        continue;
+      }
+      if (_length < needed) return;
+      if (validateV1(_buffer, needed)) {
+        _synced = true;
+        deliverV1(_buffer, needed);
+        // A frame found by a rescan may be followed by more buffered bytes;
+        // parse those like fresh input, keeping a cut-off frame buffered
+        size_t used = needed;
+        while (used > 0) {
+          _length -= used;
+          memmove(_buffer, _buffer + used, _length);
+          used = _length > 0 ? parseV1(_buffer, _length) : 0;
+        }
+        return;
+      }
+      _stats.checksumErrors++;
+      if (!rescanV1()) return;
+    }
+  }
+
+  // Total length of the frame starting at `frame` (`available` bytes of it
+  // present), once known (0 = invalid)
+  static size_t frameLengthV1(const uint8_t* frame, size_t available) {
+    if (frame[0] == V1_START) return V1_PACKET_SIZE;
+    if (available < 3) return V1_MAX_FRAME;   // Length byte not seen yet
+    if (frame[2] > 64) return 0;
+    return (size_t)frame[2] + 5;
+  }
+
+  static bool validateV1(const uint8_t* frame, size_t length) {
+    if (frame[length - 1] != V1_END) return false;
+    // XOR of everything between the start marker and the checksum
+    uint8_t checksum = 0;
+    for (size_t i = 1; i < length - 2; i++) checksum ^= frame[i];
+    return checksum == frame[length - 2];
+  }
+
+  // Drop the current start byte and restart at the next start marker among
+  // the buffered bytes. Returns false when none is left.
+  bool rescanV1() {
+    loseSync();
+    size_t next = 1;
+    while (next < _length && _buffer[next] != V1_START && _buffer[next] != V1_EXT_START) {
+      next++;
+    }
+    _length -= next;
+    memmove(_buffer, _buffer + next, _length);
+    return _length > 0;
+  }
+
+  void deliverV1(const uint8_t* frame, size_t length) {
+    _stats.frames++;
+    if (frame[0] == V1_START) {
+      Sample sample;
+      initSample(sample);
+      sample.sensors = 2;
+      sample.angles[0] = (uint16_t)(frame[1] | (frame[2] << 8)) & 0x0FFF;
+      sample.angles[1] = (uint16_t)(frame[3] | (frame[4] << 8)) & 0x0FFF;
+      emit(sample);
+      return;
+    }
+    handlePayload(frame[1], frame + 3, length - 5, nullptr);
+  }
+
+  // ---------------------------------------------------------------- v2 ----
+  void feedV2(const uint8_t* data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+      // Finish a frame split across chunks
+      if (!_v2.isIdle()) {
+        if (_v2.push(data[i++])) handleV2(_v2.frame());
+        continue;
+      }
+      const uint8_t* end = (const uint8_t*)memchr(data + i, ProtocolV2::DELIMITER, length - i);
+      if (end == nullptr) {
+        // Frame incomplete at the end of the chunk: collect the rest
+        for (; i < length; i++) _v2.push(data[i]);
+        return;
+      }
+      size_t frameLength = (size_t)(end - (data + i));
+      if (_v2.decodeFrame(data + i, frameLength)) handleV2(_v2.frame());
+      i += frameLength + 1;
+    }
+  }
+
+  void handleV2(const ProtocolV2::Frame& frame) {
+    _stats.frames++;
+    if (frame.type == ProtocolV2::TYPE_ANGLES) {
+      if (frame.length < 1 || frame.payload[0] == 0 || frame.payload[0] > MAX_SENSORS ||
+          frame.length != 1 + 4u * frame.payload[0]) {
+        _stats.malformed++;
+        return;
+      }
+      Sample sample;
+      initSample(sample);
+      sample.sensors = frame.payload[0];
+      sample.hasTime = true;
+      sample.timeUs = frame.timestampUs;
+      sample.hasSequence = true;
+      sample.sequence = frame.sequence;
+      for (uint8_t i = 0; i < sample.sensors; i++) {
+        const uint8_t* p = frame.payload + 1 + 4 * i;
+        sample.angles[i] = (uint16_t)(p[0] | (p[1] << 8)) & 0x0FFF;
+        sample.offsetsUs[i] = (int16_t)(uint16_t)(p[2] | (p[3] << 8));
+      }
+      emit(sample);
+      return;
+    }
+    handlePayload(frame.type, frame.payload, frame.length, &frame);
+  }
+
+  void syncV2Stats() {
+    const ProtocolV2::Decoder::Stats& s = _v2.getStats();
+    _stats.checksumErrors = s.crcErrors;
+    _stats.resyncs = s.framingErrors + s.overruns;
+    _stats.lostFrames = s.lost;
+  }
+
+  // --------------------------------------------------------- payloads ----
+  // Frame types shared by v1 extended frames and v2
+  void handlePayload(uint8_t type, const uint8_t* payload, size_t length,
+                     const ProtocolV2::Frame* frame) {
+    if (type == ProtocolV2::TYPE_ANGLE_ARRAY) {
+      if (length < 1 || payload[0] > MAX_SENSORS || length != 1 + 2u * payload[0]) {
+        _stats.malformed++;
+        return;
+      }
+      Sample sample;
+      initSample(sample);
+      stampV2(sample, frame);
+      sample.sensors = payload[0];
+      for (uint8_t i = 0; i < sample.sensors; i++) {
+        sample.angles[i] = (uint16_t)(payload[1 + 2 * i] | (payload[2 + 2 * i] << 8)) & 0x0FFF;
+      }
+      emit(sample);
+      return;
+    }
+
+    if (type == BATCH_TYPE) {
+      SampleBatch::Sample batch[MAX_BATCH];
+      uint8_t sensors;
+      int count = SampleBatch::decode(payload, length, batch, MAX_BATCH, sensors);
+      if (count < 0) {
+        _stats.malformed++;
+        return;
+      }
+      for (int s = 0; s < count; s++) {
+        Sample sample;
+        initSample(sample);
+        stampV2(sample, frame);
+        sample.sensors = sensors;
+        sample.hasTime = true;
+        sample.timeUs = batch[s].timeUs;
+        for (uint8_t i = 0; i < sensors; i++) sample.angles[i] = batch[s].angles[i];
+        emit(sample);
+      }
+      return;
+    }
+
+    if (_onFrame != nullptr) _onFrame(type, payload, length, _context);
+  }
+
+  // Batch frame type (UartProtocol::FRAME_BATCH) and the most samples one
+  // 64-byte payload can hold
+  static const uint8_t BATCH_TYPE = 0x05;
+  static const size_t MAX_BATCH = SampleBatch::MAX_PAYLOAD;
+
+  static void initSample(Sample& sample) {
+    sample.sensors = 0;
+    sample.hasTime = false;
+    sample.timeUs = 0;
+    sample.hasSequence = false;
+    sample.sequence = 0;
+    for (uint8_t i = 0; i < MAX_SENSORS; i++) sample.offsetsUs[i] = 0;
+  }
+
+  static void stampV2(Sample& sample, const ProtocolV2::Frame* frame) {
+    if (frame == nullptr) return;
+    sample.hasTime = true;
+    sample.timeUs = frame->timestampUs;
+    sample.hasSequence = true;
+    sample.sequence = frame->sequence;
+  }
+
+  void emit(const Sample& sample) {
+    _stats.samples++;
+    if (_onSample != nullptr) _onSample(sample, _context);
+  }
+
+  void loseSync() {
+    if (_synced) {
+      _stats.resyncs++;
+      _synced = false;
+    }
+  }
+};
+
+#endif // STREAM_DECODER_H
@@ -0,0 +1,109 @@
+#ifndef TRACKING_OBSERVER_H
+#define TRACKING_OBSERVER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Wrap-Aware Fixed-Point Tracking Observer (alpha-beta-gamma)
+// ============================================================================
+// Estimates angle, angular velocity and acceleration from 12-bit angle
+// samples taken at a fixed rate. State is kept in Q16 counts per sample
+// (period), so an update is a handful of integer adds and three 32x32->64
+// multiplies. The residual is wrapped to [-2048, 2048) counts, so the
+// observer tracks straight through the 4095 -> 0 crossing.
+//
+// Gains come from a single smoothing parameter theta (0 < theta < 1, larger
+// = smoother, slower), using the critically damped fading-memory design:
+//   alpha = 1 - theta^3
+//   beta  = 1.5 * (1 - theta)^2 * (1 + theta)
+//   gamma = 0.5 * (1 - theta)^3
+//
+// Gain products are rounded, but residuals too small to move the Q16 state
+// still go uncorrected: after a step a still shaft may read a small
+// velocity (about 0.1 count/s at theta 0.8 and 1 kHz). The dead zone grows
+// with theta and sample rate, passing a few counts/s at theta 0.95. The
+// acceleration estimate is also coarse above a few kHz, outside theta 0.8
+// (see tools/observer_check.cpp).
+
+class TrackingObserver {
+public:
+  static const uint8_t Q = 16;
+  static const uint32_t TURN_Q = 4096UL << Q;     // One turn in Q16 counts
+
+  explicit TrackingObserver(float theta = 0.8f)
+    : _pos(0), _vel(0), _acc(0), _initialized(false) {
+    setSmoothing(theta);
+  }
+
+  // Configure gains (not for the hot path)
+  void setSmoothing(float theta) {
+    if (theta < 0.0f) theta = 0.0f;
+    if (theta > 0.99f) theta = 0.99f;
+    float t1 = 1.0f - theta;
+    _alpha = toQ(1.0f - theta * theta * theta);
+    _beta = toQ(1.5f * t1 * t1 * (1.0f + theta));
+    _gamma2 = toQ(2.0f * 0.5f * t1 * t1 * t1);    // 2 * gamma (acc update)
+  }
+
+  void reset() { _initialized = false; }
+
+  // Feed one sample (0-4095)
+  void update(uint16_t angle) {
+    int32_t measured = (int32_t)(angle & 0x0FFF) << Q;
+    if (!_initialized) {
+      _pos = measured;
+      _vel = 0;
+      _acc = 0;
+      _initialized = true;
+      return;
+    }
+
+    // Predict one period ahead
+    int32_t predicted = _pos + _vel + (_acc >> 1);
+    int32_t velPredicted = _vel + _acc;
+
+    // Wrapped residual in [-TURN/2, TURN/2)
+    int32_t residual = (int32_t)((uint32_t)(measured - predicted) & (TURN_Q - 1));
+    if (residual >= (int32_t)(TURN_Q / 2)) residual -= (int32_t)TURN_Q;
+
+    _pos = (int32_t)((uint32_t)(predicted + mulQ(_alpha, residual)) & (TURN_Q - 1));
+    _vel = velPredicted + mulQ(_beta, residual);
+    _acc = _acc + mulQ(_gamma2, residual);
+  }
+
+  // Angle estimate, 0-4095 (rounded) and in Q16 counts
+  uint16_t getAngle() const {
+    return (uint16_t)(((_pos + (1 << (Q - 1))) >> Q) & 0x0FFF);
+  }
+  int32_t getAngleQ16() const { return _pos; }
+
+  // Velocity in counts per second at the given sample rate
+  int32_t getVelocity(uint32_t sampleRateHz) const {
+    return (int32_t)(((int64_t)_vel * sampleRateHz) >> Q);
+  }
+
+  // Acceleration in counts per second^2 at the given sample rate
+  int32_t getAcceleration(uint32_t sampleRateHz) const {
+    return (int32_t)(((int64_t)_acc * sampleRateHz * sampleRateHz) >> Q);
+  }
+
+  // Raw state (Q16 counts per sample, per sample^2)
+  int32_t getVelocityQ16() const { return _vel; }
+  int32_t getAccelerationQ16() const { return _acc; }
+
+private:
+  int32_t _pos;       // Q16 counts, 0 .. TURN_Q-1
+  int32_t _vel;       // Q16 counts / sample
+  int32_t _acc;       // Q16 counts / sample^2
+  int32_t _alpha;     // Q16 gains
+  int32_t _beta;
+  int32_t _gamma2;
+  bool _initialized;
+
+  static int32_t toQ(float value) { return (int32_t)(value * (float)(1L << Q) + 0.5f); }
+  static int32_t mulQ(int32_t gain, int32_t value) {
+    return (int32_t)(((int64_t)gain * value + (1 << (Q - 1))) >> Q);
+  }
+};
+
+#endif // TRACKING_OBSERVER_H
@@ -0,0 +1,141 @@
+#ifndef TRIGGER_SAMPLER_H
+#define TRIGGER_SAMPLER_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Host-Triggered Sampling
+// ============================================================================
+// In triggered mode the receiver asks for each sample (trigger byte on RX or
+// a GPIO edge) instead of the timer producing them, so the reply is as fresh
+// as the bus read allows. One trigger is handled at a time:
+//
+//   IDLE --onTrigger()--> TRIGGERED --begin()--> SAMPLING --complete()--> IDLE
+//
+// onTrigger() runs in the trigger context (GPIO interrupt or UART event) and
+// begin()/complete() in the sampling task; the state is the only shared
+// variable. A trigger that arrives while one is pending or being answered is
+// an overrun (the receiver gets one reply). Triggers closer than the holdoff
+// to the last accepted one are ignored as edge bounce.
+//
+// complete() records the trigger-to-response latency in a histogram.
+// Arduino-free (std::atomic only) so the state machine runs on a host.
+
+class TriggerSampler {
+public:
+  enum State : uint8_t {
+    IDLE,
+    TRIGGERED,
+    SAMPLING
+  };
+
+  // Latency histogram: bin i counts responses with latency < HISTOGRAM_EDGES_US[i],
+  // the last bin counts everything beyond the last edge
+  static const size_t HISTOGRAM_BINS = 8;
+
+  struct Stats {
+    uint32_t triggers;        // Triggers accepted
+    uint32_t overruns;        // Triggers while one was pending or in progress
+    uint32_t ignored;         // Triggers inside the holdoff
+    uint32_t responses;       // Triggers answered (complete() calls)
+    uint32_t minLatencyUs;
+    uint32_t maxLatencyUs;
+    uint64_t totalLatencyUs;  // For the mean
+    uint32_t histogram[HISTOGRAM_BINS];
+  };
+
+  explicit TriggerSampler(uint32_t holdoffUs = 0)
+    : _holdoffUs(holdoffUs), _state(IDLE), _triggerUs(0), _lastTriggerUs(0),
+      _haveTrigger(false), _startUs(0) {
+    resetStats();
+  }
+
+  void setHoldoff(uint32_t holdoffUs) { _holdoffUs = holdoffUs; }
+
+  static uint32_t histogramEdge(size_t bin) {
+    static const uint32_t EDGES_US[HISTOGRAM_BINS - 1] = {
+      50, 100, 150, 200, 300, 500, 1000
+    };
+    return EDGES_US[bin];
+  }
+
+  // Trigger context: returns true if the trigger was accepted and the
+  // sampling task should be woken
+  bool onTrigger(uint32_t nowUs) {
+    if (_haveTrigger && (uint32_t)(nowUs - _lastTriggerUs) < _holdoffUs) {
+      _stats.ignored++;
+      return false;
+    }
+    if (_state.load() != IDLE) {
+      _stats.overruns++;
+      return false;
+    }
+    _triggerUs = nowUs;
+    _lastTriggerUs = nowUs;
+    _haveTrigger = true;
+    _stats.triggers++;
+    _state.store(TRIGGERED);
+    return true;
+  }
+
+  // Trigger context: triggers that arrived together with an accepted or
+  // rejected one (several trigger bytes read in one go) get no reply of
+  // their own, so they count as overruns
+  void addOverruns(uint32_t count) {
+    _stats.overruns += count;
+  }
+
+  // Sampling task: claim a pending trigger. Returns false if there is none.
+  bool begin(uint32_t& triggerUs) {
+    if (_state.load() != TRIGGERED) return false;
+    triggerUs = _triggerUs;
+    _startUs = triggerUs;
+    _state.store(SAMPLING);
+    return true;
+  }
+
+  // Sampling task: the response for the claimed trigger has been sent
+  void complete(uint32_t nowUs) {
+    if (_state.load() != SAMPLING) return;
+    uint32_t latency = nowUs - _startUs;
+    _stats.responses++;
+    if (latency < _stats.minLatencyUs) _stats.minLatencyUs = latency;
+    if (latency > _stats.maxLatencyUs) _stats.maxLatencyUs = latency;
+    _stats.totalLatencyUs += latency;
+    _stats.histogram[histogramBin(latency)]++;
+    _state.store(IDLE);
+  }
+
+  State getState() const { return (State)_state.load(); }
+
+  uint32_t getMeanLatencyUs() const {
+    return _stats.responses > 0 ? (uint32_t)(_stats.totalLatencyUs / _stats.responses) : 0;
+  }
+
+  // Counters are written from the trigger context and the sampling task;
+  // read them from any task for reporting
+  const Stats& getStats() const { return _stats; }
+  void resetStats() {
+    _stats = Stats();
+    _stats.minLatencyUs = UINT32_MAX;
+  }
+
+private:
+  uint32_t _holdoffUs;
+  std::atomic<uint8_t> _state;
+  uint32_t _triggerUs;        // Written before the state becomes TRIGGERED
+  uint32_t _lastTriggerUs;    // Trigger context only
+  bool _haveTrigger;
+  uint32_t _startUs;          // Sampling task only
+  Stats _stats;
+
+  static size_t histogramBin(uint32_t latencyUs) {
+    size_t bin = 0;
+    while (bin < HISTOGRAM_BINS - 1 && latencyUs >= histogramEdge(bin)) bin++;
+    return bin;
+  }
+};
+
+#endif // TRIGGER_SAMPLER_H
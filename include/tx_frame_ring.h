@@ -0,0 +1,165 @@
+#ifndef TX_FRAME_RING_H
+#define TX_FRAME_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// Lock-Free Transmit Frame Ring
+// ============================================================================
+// Single producer (the sampling task) / single consumer (the UART drain task)
+// ring of whole frames, so a frame is never split or torn on the wire.
+// push() never blocks; when the ring is full the overflow policy decides
+// what is lost:
+//
+//   DROP_NEWEST      the new frame is discarded
+//   DROP_OLDEST      the oldest queued frame is discarded (tail moved by CAS)
+//   COALESCE_LATEST  the newest queued frame is replaced by the new one
+//
+// The producer may move the tail or rewrite a queued slot, so each slot
+// carries a sequence stamp (odd while being written). The consumer copies a
+// slot, re-checks the stamp, and claims it with a CAS on the tail; if any of
+// that raced with the producer it simply retries.
+//
+// Arduino-free (std::atomic only) so the policy logic runs on a host.
+
+template <size_t Slots, size_t SlotSize>
+class TxFrameRing {
+  // Free-running 32-bit indices map to slots by modulo, which only stays
+  // continuous across the index wrap for a power of two
+  static_assert(Slots > 0 && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+
+public:
+  enum Policy {
+    DROP_NEWEST,
+    DROP_OLDEST,
+    COALESCE_LATEST
+  };
+
+  struct Stats {
+    uint32_t framesQueued;
+    uint32_t bytesQueued;
+    uint32_t framesDropped;     // Frames lost to the overflow policy
+    uint32_t bytesDropped;
+    uint32_t framesOversize;    // Frames longer than SlotSize (never queued)
+    uint32_t peakFrames;        // Highest occupancy seen (frames)
+  };
+
+  explicit TxFrameRing(Policy policy = DROP_OLDEST) : _policy(policy), _head(0), _tail(0) {
+    for (size_t i = 0; i < Slots; i++) {
+      _slots[i].sequence.store(0);
+      _slots[i].length = 0;
+    }
+    resetStats();
+  }
+
+  void setPolicy(Policy policy) { _policy = policy; }
+  Policy getPolicy() const { return _policy; }
+
+  static size_t capacity() { return Slots; }
+
+  size_t size() const {
+    return (size_t)(_head.load() - _tail.load());
+  }
+
+  // Producer: queue one frame. Returns false if this frame was dropped.
+  bool push(const uint8_t* data, size_t length) {
+    if (length > SlotSize) {
+      _stats.framesOversize++;
+      return false;
+    }
+
+    uint32_t head = _head.load();
+    uint32_t tail = _tail.load();
+    if (head - tail >= Slots) {
+      switch (_policy) {
+        case DROP_NEWEST:
+          drop(length);
+          return false;
+
+        case DROP_OLDEST:
+          // If the CAS fails the consumer just took that frame: space either way
+          if (_tail.compare_exchange_strong(tail, tail + 1)) {
+            drop(_slots[tail % Slots].length);
+          }
+          break;
+
+        case COALESCE_LATEST: {
+          uint32_t newest = head - 1;
+          size_t replaced = _slots[newest % Slots].length;
+          write(_slots[newest % Slots], data, length);
+          // The consumer may have claimed the old contents meanwhile; then
+          // those were sent and the replacement is the frame lost
+          if ((int32_t)(_tail.load() - newest) > 0) {
+            drop(length);
+            return false;
+          }
+          drop(replaced);
+          _stats.framesQueued++;
+          _stats.bytesQueued += length;
+          return true;
+        }
+      }
+    }
+
+    write(_slots[head % Slots], data, length);
+    _head.store(head + 1);
+    _stats.framesQueued++;
+    _stats.bytesQueued += length;
+    uint32_t occupancy = head + 1 - _tail.load();
+    if (occupancy > _stats.peakFrames) _stats.peakFrames = occupancy;
+    return true;
+  }
+
+  // Consumer: copy out the oldest frame. Returns its length, 0 if empty.
+  size_t pop(uint8_t out[SlotSize]) {
+    for (;;) {
+      uint32_t tail = _tail.load();
+      if (tail == _head.load()) return 0;
+
+      Slot& slot = _slots[tail % Slots];
+      uint32_t before = slot.sequence.load();
+      if (before & 1) continue;     // Being rewritten
+      size_t length = slot.length;
+      memcpy(out, slot.data, length);
+      if (slot.sequence.load() != before) continue;
+
+      if (_tail.compare_exchange_strong(tail, tail + 1)) {
+        return length;
+      }
+    }
+  }
+
+  // Counters are written by the producer only; read them from any task
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence;
+    size_t length;
+    uint8_t data[SlotSize];
+  };
+
+  Policy _policy;
+  std::atomic<uint32_t> _head;    // Next slot to write (producer)
+  std::atomic<uint32_t> _tail;    // Oldest queued slot (consumer; producer on overflow)
+  Slot _slots[Slots];
+  Stats _stats;
+
+  static void write(Slot& slot, const uint8_t* data, size_t length) {
+    slot.sequence.fetch_add(1);     // Odd: write in progress
+    memcpy(slot.data, data, length);
+    slot.length = length;
+    slot.sequence.fetch_add(1);
+  }
+
+  void drop(size_t length) {
+    _stats.framesDropped++;
+    _stats.bytesDropped += length;
+  }
+};
+
+#endif // TX_FRAME_RING_H
@@ -3,6 +3,11 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "change_detector.h"
+#include "protocol_v2.h"
+#include "sample_batch.h"
+#include "uart_tx_queue.h"
+#include "command_parser.h"
 
 // ============================================================================
 // UART Binary Protocol Manager
@@ -25,8 +30,93 @@ public:
   // Initialize UART
   void begin(uint32_t baudRate, uint8_t txPin, uint8_t rxPin);
 
-  // Transmit sensor data
-  void transmit(uint16_t angle1, uint16_t angle2);
+  // Queue frames for a drain task instead of writing them from the caller,
+  // so a full UART never blocks sampling (see uart_tx_queue.h)
+  bool beginTxQueue(UartTxQueue::Ring::Policy policy);
+  const UartTxQueue& getTxQueue() const { return _txQueue; }
+
+  // Command channel on RX (command_parser.h). serviceCommands() must run in
+  // the task that transmits, since responses share the TX queue (single
+  // producer). The handler fills `result` and returns a Command::Status:
+  // OK sends an ACK carrying the result, anything else a NACK.
+  typedef uint8_t (*CommandHandler)(const Command::Request& request, uint8_t* result,
+                                    uint8_t& resultLength, void* arg);
+  void setCommandHandler(CommandHandler handler, void* arg);
+  // Returns the number of sample triggers (lone 0x00 bytes) seen
+  size_t serviceCommands(size_t maxBytes);
+
+  // Call `handler` from the UART event task as soon as a byte arrives
+  // (RX FIFO threshold 1), e.g. to wake a triggered sampling task
+  typedef void (*ReceiveHandler)(void* arg);
+  void setReceiveHandler(ReceiveHandler handler, void* arg);
+
+  // Time of the last receive event (esp_timer us). Commands carry it as
+  // Request::receivedUs.
+  uint32_t getLastRxUs() const { return _lastRxUs; }
+  const Command::Parser& getCommandParser() const { return _commands; }
+
+  // Wire format: 1 = 7-byte packet + 0xAB extended frames, 2 = COBS framed
+  // v2 frames with sequence, timestamp and CRC-16 (protocol_v2.h)
+  void setProtocolVersion(uint8_t version);
+  uint8_t getProtocolVersion() const { return _version; }
+
+  // Extended frame types (see PROTOCOL.md)
+  enum FrameType : uint8_t {
+    FRAME_ANGLE_ARRAY = 0x01,   // [count][angle LE] x count
+    FRAME_MOTION = 0x02,        // [count][angle u16, velocity i32, accel i32] x count
+    FRAME_POSITION = 0x03,      // [count][position i64] x count
+    FRAME_TIMESTAMP = 0x04,     // [count][sample time u32 us] x count
+    FRAME_BATCH = 0x05,         // Delta-encoded samples (sample_batch.h)
+    FRAME_ARRAY_TIMESTAMP = 0x06  // [count][newest time u32][age u16 us] x count
+  };
+
+  // Maximum extended frame payload
+  static const size_t MAX_FRAME_PAYLOAD = 64;
+
+  // Batch mode: angle pairs are collected into delta-encoded FRAME_BATCH
+  // frames of up to `samples` samples (0 = off), sent when full, when the
+  // next sample does not fit, or `flushUs` after the batch's first sample
+  void setBatching(uint8_t samples, uint32_t intervalUs, uint32_t flushUs);
+  bool isBatching() const { return _batching; }
+
+  // Send a partially filled batch now
+  void flushBatch();
+
+  // Change-driven output: only send when an angle leaves its deadband or
+  // the heartbeat interval elapsed
+  typedef ChangeDetector<2> OutputGate;
+  void setChangeDriven(bool enabled, uint16_t deadband1, uint16_t deadband2,
+                       uint32_t heartbeatMs);
+  const OutputGate::Stats& getOutputStats() const { return _gate.getStats(); }
+
+  // Transmit sensor data. Returns false if suppressed by the change gate.
+  // Sample instants (esp_timer us, low 32 bits) are part of the v2 angles
+  // frame; with v1 they are logged and sent separately with
+  // transmitTimestamps().
+  bool transmit(uint16_t angle1, uint16_t angle2,
+                uint32_t time1Us = 0, uint32_t time2Us = 0);
+
+  // Transmit N angles (sensor array) as an extended frame
+  void transmitArray(const uint16_t* angles, uint8_t count);
+
+  // Transmit observer estimates (angle, counts/s, counts/s^2) per sensor
+  void transmitMotion(const uint16_t* angles, const int32_t* velocities,
+                      const int32_t* accelerations, uint8_t count);
+
+  // Transmit multi-turn positions (counts, 4096 per turn)
+  void transmitPositions(const int64_t* positions, uint8_t count);
+
+  // Transmit per-sensor sample instants (us, wraps every ~71.6 min)
+  void transmitTimestamps(const uint32_t* times, uint8_t count);
+
+  // Transmit sensor array sample instants as ages from the newest one, so
+  // all 16 fit one frame (ages of 65535 us and more are sent as 0xFFFF)
+  void transmitArrayTimestamps(const uint32_t* times, uint8_t count);
+
+  // Transmit an extended frame:
+  // v1: [0xAB][type][length][payload...][XOR of type, length, payload][0x55]
+  // v2: COBS framed, stamped with the last sample time
+  void transmitFrame(uint8_t type, const uint8_t* payload, uint8_t length);
 
   // Get packet size
   static constexpr size_t getPacketSize() { return sizeof(SensorData); }
@@ -37,6 +127,35 @@ public:
 private:
   HardwareSerial& _serial;
   SensorData _packet;
+  OutputGate _gate;
+  bool _changeDriven;
+  uint8_t _version;
+  uint16_t _sequence;       // v2 frame counter (wraps)
+  uint32_t _lastTimeUs;     // Timestamp of the last angle sample
+  SampleBatch _batch;
+  bool _batching;
+  UartTxQueue _txQueue;
+  Command::Parser _commands;
+  CommandHandler _commandHandler;
+  void* _commandArg;
+  ReceiveHandler _receiveHandler;
+  void* _receiveArg;
+  volatile uint32_t _lastRxUs;
+
+  // UART event task: stamp received bytes
+  void onReceive();
+
+  // Send one complete frame (queued when the TX queue runs)
+  void writeFrame(const uint8_t* data, size_t length);
+
+  // v2 angles frame for two sensors: payload, and encoded size on the wire
+  // (COBS code byte + delimiter; no overhead block for frames this short)
+  static const size_t V2_ANGLES_PAYLOAD = 1 + 2 * 4;
+  static const size_t V2_ANGLES_FRAME_SIZE =
+      ProtocolV2::HEADER_SIZE + V2_ANGLES_PAYLOAD + ProtocolV2::CRC_SIZE + 2;
+
+  // Encode and write one v2 frame; returns bytes written
+  size_t transmitV2(uint8_t type, const uint8_t* payload, size_t length, uint32_t timeUs);
 
   // Build packet
   void buildPacket(uint16_t angle1, uint16_t angle2);
@@ -0,0 +1,47 @@
+#ifndef UART_TX_QUEUE_H
+#define UART_TX_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "tx_frame_ring.h"
+#include "protocol_v2.h"
+
+// ============================================================================
+// Non-Blocking UART Transmit Queue
+// ============================================================================
+// The sampling task queues whole frames into a lock-free ring and returns
+// immediately; a drain task writes them to the UART driver, whose interrupt
+// driven TX buffer feeds the FIFO. A slow or saturated link therefore costs
+// frames (per the overflow policy), never sampling time.
+
+class UartTxQueue {
+public:
+  static const size_t SLOTS = 32;
+  static const size_t SLOT_SIZE = ProtocolV2::MAX_ENCODED;
+  typedef TxFrameRing<SLOTS, SLOT_SIZE> Ring;
+
+  UartTxQueue();
+
+  // Start the drain task for `serial` (already initialized)
+  bool begin(HardwareSerial& serial, Ring::Policy policy);
+  bool isRunning() const { return _task != nullptr; }
+
+  // Queue one frame (never blocks). Returns false if it was dropped.
+  bool write(const uint8_t* data, size_t length);
+
+  const Ring::Stats& getStats() const { return _ring.getStats(); }
+  uint32_t getBytesSent() const { return _bytesSent; }
+  size_t getOccupancy() const { return _ring.size(); }
+
+private:
+  Ring _ring;
+  HardwareSerial* _serial;
+  TaskHandle_t _task;
+  volatile uint32_t _bytesSent;
+
+  static void taskEntry(void* arg);
+  void run();
+};
+
+#endif // UART_TX_QUEUE_H
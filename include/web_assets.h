@@ -0,0 +1,300 @@
+// Generated by tools/embed_web_assets.py from web/ - do not edit
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace WebAssets {
+
+struct Asset {
+  const char* path;           // URL path
+  const char* contentType;
+  const char* etag;           // Quoted content hash
+  const char* cacheControl;
+  const uint8_t* data;        // gzip
+  size_t size;
+  size_t originalSize;
+};
+
+// app.css: 4038 bytes, 1261 gzipped
+static const uint8_t APP_CSS_GZ[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xAD, 0x57, 0x49, 0x6F, 0xEB, 0x36,
+  0x10, 0xBE, 0xE7, 0x57, 0x10, 0x08, 0x82, 0xE7, 0x14, 0x96, 0x21, 0x59, 0x96, 0xEC, 0x38, 0x97,
+  0x02, 0x05, 0x5A, 0xF4, 0xD2, 0x4B, 0xFB, 0x0A, 0xF4, 0x48, 0x89, 0x43, 0x89, 0x0D, 0x25, 0x0A,
+  0x14, 0x65, 0x27, 0x7D, 0x78, 0xFF, 0xBD, 0x43, 0xED, 0x9B, 0xE3, 0x1E, 0x9A, 0x04, 0x8E, 0xCC,
+  0x65, 0x96, 0x6F, 0xBE, 0x59, 0xF4, 0x03, 0xF9, 0xF6, 0x40, 0xF0, 0x27, 0xA3, 0x3A, 0x11, 0xF9,
+  0x99, 0xB8, 0xAF, 0xF5, 0xD7, 0x82, 0x32, 0x26, 0xF2, 0xA4, 0xFF, 0x1E, 0xA9, 0x77, 0xA7, 0x14,
+  0xFF, 0xD4, 0x4B, 0x91, 0xD2, 0x0C, 0xB4, 0x83, 0x4B, 0xAF, 0x0F, 0xDF, 0x1F, 0x1E, 0x22, 0xC5,
+  0x3E, 0x5A, 0x21, 0x5C, 0xE5, 0xC6, 0xE1, 0x34, 0x13, 0xF2, 0xE3, 0x4C, 0xBE, 0xFC, 0x0E, 0x89,
+  0x02, 0xF2, 0xF5, 0xD7, 0x2F, 0x5B, 0xF2, 0x07, 0x4D, 0x55, 0x46, 0xB7, 0xE4, 0x17, 0xC8, 0xE1,
+  0x82, 0xFF, 0xFF, 0x04, 0xCD, 0x68, 0x8E, 0x0F, 0x25, 0xCD, 0x4B, 0xA7, 0x04, 0x2D, 0x78, 0xAB,
+  0x87, 0xC6, 0x6F, 0x89, 0x56, 0x55, 0xCE, 0xCE, 0x44, 0x8A, 0x1C, 0xA8, 0x76, 0x12, 0x4D, 0x99,
+  0x80, 0xDC, 0x6C, 0x3C, 0x3F, 0x60, 0x90, 0x6C, 0xC9, 0x63, 0x18, 0x1E, 0x01, 0x28, 0x71, 0x9F,
+  0xF0, 0xF9, 0x18, 0x1E, 0x22, 0xBA, 0x27, 0x9E, 0xEB, 0x3E, 0x3D, 0x37, 0x22, 0x32, 0x91, 0x3B,
+  0x29, 0x88, 0x24, 0x35, 0x67, 0xBB, 0x7C, 0x49, 0x9B, 0x65, 0x26, 0xCA, 0x42, 0x52, 0xB4, 0x8B,
+  0x4B, 0x78, 0x6F, 0x96, 0xFE, 0xAE, 0x4A, 0x23, 0xF8, 0x87, 0x13, 0xA3, 0xD9, 0xA8, 0xE0, 0x4C,
+  0x62, 0xFC, 0x04, 0xDD, 0x6C, 0x52, 0x29, 0x92, 0xDC, 0x11, 0x06, 0xB2, 0x72, 0xBA, 0xD1, 0x43,
+  0xB3, 0x77, 0x8B, 0x06, 0x81, 0x9D, 0x15, 0x40, 0xD1, 0x5A, 0xDD, 0xE2, 0x30, 0xF6, 0x42, 0x27,
+  0x11, 0xDD, 0xEC, 0x83, 0x60, 0x4B, 0x86, 0x0F, 0x77, 0xF7, 0x12, 0x3C, 0x77, 0xC0, 0xD6, 0x60,
+  0x5A, 0x1F, 0xAB, 0xB2, 0x93, 0x39, 0x51, 0x73, 0xE8, 0x97, 0xEA, 0x20, 0xA4, 0x94, 0xA9, 0x2B,
+  0xC6, 0xA5, 0x3E, 0x4A, 0x42, 0xFB, 0x51, 0xAB, 0x70, 0x51, 0x6C, 0xF3, 0xB7, 0xF3, 0x3B, 0x24,
+  0xE8, 0xBB, 0x73, 0x15, 0xCC, 0xA4, 0x67, 0x72, 0x72, 0x7B, 0x29, 0xED, 0x8A, 0x45, 0x6C, 0xC0,
+  0x9C, 0x69, 0x55, 0x38, 0x5C, 0x48, 0xF4, 0x12, 0x03, 0x2C, 0x2B, 0xBD, 0xF1, 0xF0, 0xC2, 0x73,
+  0xED, 0x5E, 0xEA, 0xB5, 0x6E, 0xC5, 0x4A, 0x2A, 0xDC, 0x7E, 0xF4, 0x7D, 0xBF, 0xB9, 0x69, 0xE0,
+  0xDD, 0x38, 0x35, 0x50, 0x53, 0x88, 0x1A, 0x32, 0x21, 0x43, 0x8C, 0x51, 0x99, 0x55, 0xD5, 0xE9,
+  0xAE, 0x09, 0x82, 0x3C, 0x02, 0xF4, 0x74, 0x17, 0x40, 0xF6, 0xBF, 0x05, 0xDD, 0xB9, 0x42, 0xF4,
+  0x26, 0x8C, 0x33, 0x88, 0x72, 0x62, 0x29, 0x8A, 0x73, 0x6D, 0xE2, 0xF4, 0x48, 0x6D, 0x34, 0xBA,
+  0x2A, 0x9D, 0xD6, 0x1F, 0xA3, 0x91, 0x84, 0x05, 0xD5, 0xA8, 0x6E, 0x6E, 0xCF, 0x44, 0x88, 0x8D,
+  0x74, 0x59, 0x45, 0x46, 0x18, 0x09, 0x2D, 0x22, 0xB7, 0x00, 0xE8, 0x90, 0x0A, 0xC3, 0x70, 0x15,
+  0x91, 0xC3, 0x1A, 0x22, 0xDE, 0xCE, 0xB3, 0x88, 0xD4, 0x6A, 0x0C, 0x35, 0x55, 0x79, 0x47, 0x49,
+  0xCF, 0x10, 0x6F, 0x3F, 0x30, 0x64, 0xC2, 0xA6, 0x01, 0xF8, 0x99, 0x7E, 0x7F, 0xAA, 0xFF, 0xDA,
+  0xA6, 0x4B, 0xE8, 0xB6, 0xE9, 0x5E, 0x43, 0x22, 0x8C, 0x50, 0xA8, 0x92, 0x4A, 0x69, 0x39, 0x55,
+  0x12, 0xA0, 0x25, 0x8C, 0xCD, 0xB3, 0xB4, 0xCF, 0x21, 0x36, 0xC0, 0x56, 0x68, 0xFF, 0xC8, 0x0E,
+  0xC0, 0x18, 0x9D, 0xC2, 0xE1, 0x05, 0xC1, 0x71, 0x7F, 0x18, 0x9B, 0x8A, 0x3C, 0x40, 0x02, 0x97,
+  0x4A, 0x0A, 0x46, 0x1E, 0x63, 0x1F, 0xC2, 0x38, 0x9A, 0xA8, 0xC0, 0xAC, 0xFD, 0x54, 0x0B, 0x3F,
+  0xB1, 0xE3, 0x5C, 0xCB, 0x71, 0xEF, 0xC5, 0x9F, 0x68, 0xE1, 0x41, 0x3C, 0x68, 0x81, 0xBC, 0x54,
+  0xBA, 0x03, 0xBA, 0x2F, 0x11, 0x89, 0x16, 0xAC, 0xB9, 0x6F, 0x9F, 0x90, 0x31, 0x19, 0xAE, 0x1B,
+  0xB0, 0x84, 0xA9, 0xB2, 0x1C, 0x81, 0xD5, 0x50, 0x00, 0x35, 0x1B, 0x5A, 0x19, 0x85, 0x54, 0x32,
+  0x5B, 0x5B, 0x74, 0x30, 0xDB, 0x36, 0xBE, 0x4D, 0xB3, 0x2D, 0xF1, 0xB8, 0x7E, 0x6E, 0x89, 0x99,
+  0xD0, 0x62, 0x0C, 0xF7, 0x6A, 0x1C, 0x06, 0x4B, 0x9C, 0x98, 0xEA, 0x35, 0x3F, 0x6F, 0x66, 0x05,
+  0x0F, 0xF8, 0x91, 0xB7, 0x59, 0x11, 0xFB, 0x31, 0x87, 0x49, 0x56, 0xCC, 0xE9, 0x10, 0x2C, 0x8A,
+  0x8B, 0x7F, 0xA3, 0xB8, 0x58, 0xE6, 0xD4, 0x9B, 0x8B, 0xE2, 0xE2, 0x3D, 0x2F, 0x29, 0x52, 0x3F,
+  0x73, 0xA5, 0xB3, 0x81, 0x28, 0xDB, 0x91, 0xC0, 0x05, 0x7D, 0x06, 0x5F, 0xCF, 0xA9, 0xBA, 0xF4,
+  0x65, 0xB3, 0x17, 0xD3, 0x4A, 0xB4, 0x98, 0xFF, 0xB5, 0x71, 0x82, 0xBA, 0x10, 0xAD, 0xD8, 0x88,
+  0x1B, 0x75, 0x26, 0x2D, 0x6C, 0xDC, 0x3F, 0x2F, 0x41, 0x4D, 0xF7, 0xB3, 0x2A, 0xD6, 0x14, 0x94,
+  0xD5, 0xB0, 0xEC, 0xD7, 0xD3, 0xB3, 0x2F, 0x58, 0x6B, 0x19, 0x69, 0xF5, 0xD1, 0x3C, 0x91, 0xE0,
+  0xB4, 0x34, 0xBA, 0x93, 0xBD, 0xAB, 0x2A, 0x07, 0x21, 0x17, 0x2A, 0x2B, 0x18, 0xB7, 0xD5, 0xC6,
+  0x08, 0x7F, 0x30, 0x62, 0x92, 0xB9, 0x91, 0x92, 0xEC, 0x75, 0xBD, 0x48, 0xF7, 0xAC, 0x8E, 0xA4,
+  0x8A, 0xDF, 0x56, 0x95, 0x07, 0x53, 0xDD, 0x55, 0x2E, 0xCC, 0x52, 0xB5, 0xB7, 0xDB, 0x77, 0xAA,
+  0x27, 0xE5, 0x6D, 0xB8, 0x17, 0xD1, 0x2E, 0x92, 0x8B, 0x1E, 0xD3, 0x35, 0xE4, 0x11, 0xDF, 0xC6,
+  0x69, 0x0C, 0xAE, 0xFD, 0xBD, 0x43, 0x5A, 0xCB, 0x14, 0x2E, 0x6D, 0xEC, 0x53, 0xC1, 0x18, 0xE4,
+  0x2D, 0x95, 0x55, 0xC7, 0x42, 0x0D, 0x48, 0x18, 0x71, 0x81, 0xB1, 0x49, 0xB6, 0xCE, 0xB7, 0x36,
+  0x8D, 0x66, 0x82, 0xA7, 0xFB, 0x7D, 0xE7, 0xC5, 0xFD, 0x2F, 0x6D, 0x67, 0x9C, 0x04, 0xB5, 0xCF,
+  0x63, 0xAA, 0xDF, 0x74, 0xC6, 0x9A, 0xA7, 0xE9, 0x75, 0x12, 0xE3, 0x3B, 0x34, 0x31, 0xAA, 0x18,
+  0x43, 0xB1, 0xE8, 0x2F, 0xA3, 0x38, 0xE1, 0x70, 0xD1, 0xB5, 0x11, 0x91, 0x73, 0xB5, 0x56, 0x35,
+  0xE1, 0xC8, 0x7D, 0xCE, 0x27, 0x16, 0x4A, 0xE0, 0x88, 0xCD, 0x61, 0x28, 0x93, 0x7B, 0xEF, 0x25,
+  0xFC, 0xD9, 0x9F, 0x77, 0x9A, 0xE0, 0x46, 0xA7, 0x09, 0x66, 0x05, 0xAE, 0xB6, 0x77, 0xE0, 0x74,
+  0x6D, 0x48, 0x31, 0x4B, 0x40, 0x37, 0x0E, 0x0E, 0xA1, 0xFB, 0x3A, 0x19, 0x3F, 0x6D, 0x4A, 0xBB,
+  0x6B, 0x2E, 0x05, 0xAD, 0x4F, 0x3F, 0xBE, 0xC1, 0x07, 0xD7, 0x34, 0x83, 0x92, 0x14, 0x95, 0x2C,
+  0x3B, 0xF8, 0x6C, 0x7C, 0x6C, 0x5C, 0xC8, 0x37, 0xA2, 0x0A, 0x1A, 0x0B, 0x83, 0x7C, 0xF7, 0x5E,
+  0xC9, 0xF7, 0x7A, 0x33, 0x98, 0xAE, 0xBB, 0xBB, 0xC0, 0xEE, 0x58, 0xBB, 0xAA, 0x82, 0x21, 0x65,
+  0xF2, 0xA4, 0x95, 0x42, 0x73, 0x91, 0xD1, 0x26, 0x9A, 0x8D, 0x70, 0xAF, 0x89, 0xA5, 0x83, 0x1E,
+  0xA9, 0xCA, 0x10, 0x74, 0x43, 0x60, 0x6E, 0xB4, 0x0C, 0x93, 0x2A, 0xB1, 0xB3, 0x6B, 0x6C, 0x2F,
+  0xAC, 0xF7, 0x26, 0xFE, 0xC2, 0xE9, 0x9D, 0xC6, 0x3C, 0x9B, 0x26, 0xE7, 0x10, 0x8E, 0x3B, 0xC7,
+  0x7B, 0x3F, 0xD6, 0x1E, 0x86, 0x69, 0xAE, 0x4B, 0x0A, 0x07, 0x1D, 0xB3, 0xED, 0x68, 0xC5, 0xB4,
+  0xD4, 0xBF, 0x35, 0xBF, 0xCD, 0xE7, 0xB4, 0x60, 0xB5, 0xEC, 0xF9, 0x1D, 0x9D, 0x50, 0xAA, 0x83,
+  0xD4, 0xD4, 0xEB, 0xE3, 0xFE, 0x4F, 0xAA, 0xD2, 0x02, 0x6B, 0xF9, 0x6F, 0x70, 0xC5, 0x89, 0x3F,
+  0x53, 0xB9, 0xC2, 0xA1, 0x2A, 0x86, 0x95, 0x60, 0x9E, 0xFA, 0x1A, 0xD6, 0x7B, 0x6F, 0xE3, 0x3E,
+  0x9F, 0x56, 0xD0, 0xFB, 0x81, 0x0D, 0x33, 0x00, 0xFD, 0xB5, 0x32, 0x72, 0x4D, 0xEB, 0xD8, 0x2C,
+  0x58, 0xED, 0x8F, 0x46, 0x8C, 0x38, 0x9E, 0xF9, 0x32, 0x49, 0x92, 0xE1, 0x56, 0x37, 0x1C, 0xF6,
+  0x79, 0x30, 0xBD, 0x74, 0xA5, 0x3A, 0xFF, 0xE4, 0x12, 0xE7, 0x2F, 0xA7, 0x6E, 0x96, 0x9A, 0x72,
+  0x82, 0xF3, 0x13, 0x78, 0x73, 0x69, 0xA0, 0xB5, 0xD2, 0x9F, 0x89, 0x3B, 0x1C, 0x7C, 0x3F, 0x5C,
+  0x15, 0x07, 0x11, 0x0C, 0x74, 0x74, 0x8C, 0xC0, 0xC4, 0x30, 0x34, 0x2B, 0x16, 0xBD, 0x6E, 0x3A,
+  0x87, 0xEA, 0xAE, 0x14, 0x76, 0x09, 0x6A, 0x2F, 0x4B, 0xB8, 0x80, 0x1C, 0x87, 0x76, 0xD9, 0x5C,
+  0xEE, 0x5E, 0x1F, 0xA3, 0x79, 0x0B, 0xC1, 0xE6, 0xE0, 0x08, 0xC1, 0x39, 0x6A, 0xD3, 0x83, 0x63,
+  0x70, 0xE6, 0x80, 0x74, 0x27, 0xD1, 0xEB, 0x92, 0x26, 0xB0, 0xC6, 0x73, 0x5B, 0x33, 0x32, 0x60,
+  0x82, 0x92, 0xCD, 0xE8, 0x7D, 0xE8, 0x18, 0x9E, 0x70, 0xAA, 0x68, 0xCF, 0x2F, 0xDE, 0xDF, 0x6E,
+  0x24, 0x26, 0x8A, 0xAA, 0x1B, 0x89, 0x37, 0x3A, 0x36, 0x7E, 0xA3, 0xE9, 0x58, 0xDD, 0x9E, 0x5B,
+  0xE9, 0xE4, 0xB7, 0xDF, 0x81, 0xBA, 0x3B, 0xD3, 0x89, 0xF4, 0x93, 0x11, 0x14, 0x67, 0xCC, 0xEE,
+  0xE6, 0xF7, 0x87, 0x7F, 0x01, 0xA8, 0x21, 0xEE, 0x7F, 0xC6, 0x0F, 0x00, 0x00,
+};
+
+// app.js: 5790 bytes, 1916 gzipped
+static const uint8_t APP_JS_GZ[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xAD, 0x58, 0xCD, 0x72, 0xDB, 0x36,
+  0x10, 0xBE, 0xEB, 0x29, 0x10, 0x8F, 0x1B, 0x92, 0xB1, 0x4C, 0x49, 0xB4, 0xEB, 0x49, 0xAD, 0x9F,
+  0x4E, 0xE2, 0x38, 0x93, 0x74, 0x5C, 0xA7, 0x13, 0x3B, 0xED, 0x21, 0x93, 0xA9, 0x20, 0x12, 0x92,
+  0x91, 0x50, 0x24, 0x0B, 0x80, 0x52, 0x54, 0x87, 0x33, 0xBD, 0xF4, 0xDC, 0x7B, 0xA7, 0x87, 0x4E,
+  0x9F, 0xA0, 0xC7, 0x9E, 0xFB, 0x28, 0x79, 0x81, 0xBE, 0x42, 0x17, 0xE0, 0x1F, 0xF8, 0x23, 0xC7,
+  0xEE, 0x94, 0x07, 0x89, 0x02, 0x76, 0x3F, 0xEC, 0xFF, 0x2E, 0xE4, 0x13, 0x81, 0xD6, 0x7C, 0xD8,
+  0xF1, 0xE1, 0x9B, 0x11, 0x37, 0x0C, 0x02, 0xE2, 0x8A, 0xE7, 0x81, 0x20, 0x6C, 0x85, 0xFD, 0x61,
+  0xA7, 0x33, 0x8F, 0x03, 0x57, 0xD0, 0x30, 0x40, 0xD9, 0xD6, 0x77, 0x64, 0x76, 0x11, 0xBA, 0xEF,
+  0x88, 0x30, 0x2D, 0x74, 0xDD, 0x41, 0xF0, 0xC0, 0x06, 0x17, 0x28, 0x62, 0xA1, 0x08, 0xDD, 0xD0,
+  0x47, 0x63, 0xB4, 0xA6, 0x81, 0x17, 0xAE, 0x6D, 0x3F, 0x74, 0xB1, 0xE4, 0xB4, 0xCB, 0xAD, 0xF1,
+  0x18, 0x19, 0x57, 0x42, 0x44, 0xFC, 0xD8, 0x40, 0x5F, 0x22, 0x63, 0xCD, 0xE5, 0xCB, 0xB1, 0x7C,
+  0x39, 0x36, 0x86, 0x1A, 0xD8, 0x9A, 0xBF, 0x62, 0x12, 0x69, 0xBA, 0x7B, 0x9D, 0x33, 0x27, 0xBD,
+  0xDE, 0xEE, 0x75, 0x1D, 0xF9, 0x2A, 0xE4, 0x22, 0xE9, 0xAD, 0xF9, 0x14, 0x04, 0x95, 0xDC, 0x6B,
+  0x0E, 0x4C, 0x01, 0x59, 0xA3, 0x52, 0x4A, 0x05, 0x65, 0x0D, 0xB3, 0x6D, 0x7B, 0x46, 0x03, 0xCC,
+  0x36, 0x97, 0x9B, 0x88, 0x00, 0xA5, 0x81, 0x19, 0xC3, 0x9B, 0x59, 0x3C, 0x9F, 0x13, 0x66, 0x14,
+  0x10, 0x76, 0x18, 0x84, 0x11, 0x09, 0x60, 0x3F, 0xD7, 0xBD, 0x50, 0x35, 0x97, 0x30, 0xF4, 0x09,
+  0x08, 0xB1, 0x30, 0x8D, 0xE2, 0x9C, 0xDC, 0x3C, 0xC4, 0x33, 0xB2, 0xC3, 0xE4, 0xE3, 0x85, 0x6E,
+  0xBC, 0x24, 0x81, 0xB0, 0x17, 0x44, 0x9C, 0xFA, 0x44, 0xBE, 0x3E, 0xDE, 0x3C, 0xF7, 0x4C, 0x83,
+  0x0B, 0x2C, 0x62, 0x6E, 0x58, 0xB6, 0xEB, 0x63, 0xCE, 0xCF, 0xF1, 0x52, 0x89, 0x93, 0xAE, 0x6A,
+  0x50, 0x77, 0x41, 0xA2, 0xC0, 0xC4, 0x9E, 0x5D, 0x7E, 0x7D, 0x26, 0x91, 0x3E, 0xFE, 0xF6, 0x33,
+  0x3A, 0x69, 0x81, 0x71, 0x7D, 0x82, 0x59, 0xEE, 0x5D, 0xB3, 0xE1, 0x6F, 0x4D, 0x74, 0x1E, 0xCF,
+  0xB8, 0xCB, 0xE8, 0x8C, 0x98, 0xD9, 0x62, 0xA2, 0x1B, 0x68, 0x49, 0x38, 0xC7, 0x0B, 0xA2, 0xDB,
+  0x88, 0xAC, 0x40, 0x26, 0xDD, 0x50, 0x82, 0x6D, 0xB4, 0x5F, 0xA5, 0x73, 0x3D, 0x2C, 0x30, 0x30,
+  0x9A, 0x02, 0x9C, 0x10, 0xCE, 0x91, 0xE2, 0xB3, 0xD3, 0xC5, 0xB1, 0x32, 0x02, 0xA3, 0xC1, 0xC2,
+  0xB0, 0x2A, 0x9C, 0xF2, 0xF9, 0x12, 0x7D, 0x75, 0xF1, 0xE2, 0xDC, 0x8E, 0x30, 0xE3, 0xC4, 0x2C,
+  0xB9, 0x2C, 0x08, 0x20, 0x0F, 0x14, 0xF1, 0xC8, 0x63, 0xE5, 0x5B, 0x7D, 0x6B, 0x58, 0x01, 0xA1,
+  0x73, 0x64, 0xDE, 0x4B, 0x59, 0x18, 0x11, 0x31, 0x0B, 0x9A, 0xDB, 0x72, 0xD7, 0x5E, 0xE2, 0xF7,
+  0x2F, 0xB1, 0x20, 0xE8, 0x1E, 0x88, 0x13, 0x07, 0x1E, 0x99, 0xD3, 0x80, 0x78, 0x56, 0x4D, 0x17,
+  0xF9, 0xF4, 0x7A, 0xE8, 0x22, 0x35, 0x53, 0xA4, 0x52, 0x84, 0x91, 0xC8, 0xDF, 0x34, 0xA8, 0xB6,
+  0xBA, 0x8E, 0xC1, 0x21, 0xFB, 0x0B, 0x86, 0x03, 0x15, 0x35, 0xB6, 0x20, 0xEF, 0x05, 0xF8, 0x4C,
+  0xC0, 0x3E, 0x1A, 0x37, 0x50, 0xE4, 0x33, 0x35, 0x77, 0xAF, 0x95, 0x84, 0x92, 0x33, 0x41, 0x60,
+  0x3C, 0x10, 0x15, 0x65, 0x6B, 0x99, 0xD4, 0x09, 0x7A, 0xF6, 0xA3, 0x35, 0x1D, 0x36, 0xF8, 0xDB,
+  0x34, 0x4E, 0x2A, 0xBF, 0xE2, 0x08, 0x70, 0xC8, 0x05, 0x81, 0xF0, 0x66, 0xE6, 0xA0, 0xAB, 0xFC,
+  0x64, 0xE3, 0x60, 0xE1, 0x93, 0xFC, 0x07, 0xC3, 0xEB, 0x41, 0xCD, 0xA6, 0x15, 0x26, 0x47, 0x67,
+  0x72, 0x4A, 0x26, 0xA7, 0x9D, 0x29, 0x22, 0xC4, 0x2B, 0x0E, 0x5A, 0x11, 0x7F, 0x70, 0x03, 0x99,
+  0x53, 0x92, 0x39, 0xD6, 0x16, 0xBF, 0x49, 0x05, 0xF9, 0xE0, 0xD3, 0x6E, 0xDB, 0xEA, 0x90, 0x14,
+  0xA0, 0xEE, 0x0A, 0xA4, 0x81, 0x0F, 0xEF, 0x08, 0xE6, 0xDC, 0x00, 0xE6, 0xDC, 0xE4, 0x0C, 0xA9,
+  0xD4, 0x23, 0x59, 0x9D, 0x6C, 0xCA, 0xD5, 0xB7, 0x99, 0x1B, 0xD3, 0x6A, 0x53, 0x29, 0x35, 0x55,
+  0x8D, 0x70, 0x1B, 0x7E, 0x82, 0xA0, 0x7C, 0xBA, 0x57, 0xC8, 0x24, 0x56, 0x4B, 0x82, 0xCA, 0xDA,
+  0x46, 0x18, 0x03, 0x77, 0x1A, 0xA7, 0xF2, 0x0B, 0xC9, 0x84, 0x83, 0x8C, 0x2C, 0x6B, 0xAA, 0xD2,
+  0xE1, 0xD8, 0xE8, 0x22, 0xA2, 0x1D, 0x91, 0x34, 0x8B, 0x84, 0xEB, 0x87, 0x9C, 0xDC, 0xB1, 0x8C,
+  0x7A, 0x94, 0xFF, 0x8F, 0x95, 0xB4, 0x82, 0xF6, 0xDF, 0x8B, 0xE9, 0xAF, 0xBF, 0xFF, 0xF3, 0xD7,
+  0x2F, 0xE8, 0x89, 0x06, 0x86, 0xF6, 0xD1, 0xCB, 0xBC, 0x78, 0x82, 0x6D, 0x6C, 0xDB, 0xCE, 0xFB,
+  0x47, 0x56, 0x17, 0x2E, 0xA1, 0xF8, 0x89, 0xB0, 0xEC, 0xA8, 0xB2, 0xCC, 0xC1, 0xD2, 0x01, 0xE2,
+  0x72, 0xC5, 0xE3, 0x9D, 0x32, 0x2F, 0x6B, 0x35, 0x18, 0x4E, 0xE4, 0xA4, 0xF8, 0x65, 0xD6, 0xDB,
+  0x6E, 0x17, 0x1D, 0xF4, 0xFB, 0xFD, 0xB6, 0x9A, 0xAC, 0x9C, 0x56, 0xA9, 0xC8, 0x72, 0xA1, 0xCD,
+  0xE6, 0x99, 0x7B, 0x4B, 0xAB, 0xAB, 0x05, 0xE5, 0x51, 0xC5, 0x52, 0x80, 0x27, 0x5A, 0xFF, 0xD7,
+  0x1A, 0x42, 0x06, 0x29, 0x63, 0x14, 0x3A, 0xEE, 0xFD, 0xFB, 0xF2, 0x7C, 0x46, 0xB0, 0xB7, 0xB9,
+  0x10, 0xB2, 0x6E, 0xCA, 0x32, 0x5E, 0x60, 0xDB, 0x2F, 0xBE, 0x39, 0x3D, 0xAF, 0x0B, 0x01, 0xA3,
+  0x86, 0x22, 0x54, 0xB1, 0x45, 0x40, 0x57, 0xF3, 0xC6, 0x22, 0x09, 0x0E, 0x01, 0x53, 0xC4, 0x7A,
+  0xB8, 0xC1, 0x89, 0x9C, 0x04, 0x9E, 0xA9, 0x5A, 0x42, 0xDA, 0x32, 0xE8, 0x7C, 0x63, 0x5E, 0x2B,
+  0xE0, 0xE3, 0x14, 0x3E, 0xB1, 0x72, 0x4D, 0xA4, 0x22, 0xE0, 0x94, 0xB4, 0x41, 0x80, 0x79, 0x65,
+  0xB5, 0x42, 0x79, 0x0F, 0x03, 0x1D, 0xBE, 0xCF, 0xDE, 0xED, 0x2B, 0xAB, 0x8B, 0x7C, 0x2A, 0x84,
+  0x4F, 0xF6, 0x01, 0x9D, 0xE2, 0xA0, 0xD4, 0xBF, 0xD2, 0x63, 0xD2, 0x99, 0xA1, 0x3A, 0x01, 0xAD,
+  0xB2, 0xD9, 0xE3, 0x09, 0x64, 0xC7, 0xB7, 0x94, 0xAC, 0x73, 0xA2, 0x61, 0x61, 0xAC, 0x95, 0x3D,
+  0xDB, 0x08, 0x72, 0x46, 0x82, 0x85, 0xB8, 0x42, 0x23, 0x74, 0xD8, 0x47, 0x1F, 0x3E, 0xA0, 0x95,
+  0x54, 0xF9, 0x15, 0x0D, 0xC4, 0x43, 0xB3, 0x6F, 0xA9, 0xE2, 0xE5, 0xE4, 0xFD, 0x09, 0x05, 0xB1,
+  0xEF, 0xEB, 0x73, 0x91, 0x1B, 0xC6, 0xAA, 0x88, 0x68, 0x3C, 0x79, 0xD1, 0xAC, 0xF4, 0xD6, 0xD2,
+  0xDA, 0x9C, 0xFC, 0x70, 0x5C, 0x92, 0x0F, 0x8E, 0x64, 0x21, 0x15, 0x0C, 0x4C, 0xD9, 0x2D, 0xFB,
+  0xF4, 0x40, 0xA3, 0x38, 0x70, 0xCC, 0xC3, 0x26, 0x85, 0x53, 0xA5, 0x78, 0xD8, 0xA0, 0x90, 0x9D,
+  0xA1, 0x7A, 0xCE, 0xC0, 0x69, 0x23, 0x72, 0x6A, 0x44, 0xCD, 0xB3, 0x64, 0x1F, 0xC8, 0x88, 0x9E,
+  0xAB, 0xC3, 0x06, 0x47, 0x6D, 0x34, 0x4E, 0x85, 0xC6, 0xE9, 0x37, 0x68, 0xB0, 0xEB, 0x56, 0x71,
+  0x9C, 0xC3, 0x36, 0x9A, 0x1A, 0x4E, 0x53, 0xB3, 0xB4, 0xEE, 0x57, 0xA8, 0x0E, 0x9C, 0x76, 0xAA,
+  0x2A, 0xD6, 0x41, 0x2E, 0x77, 0x9E, 0x4C, 0x79, 0x14, 0xA4, 0x4E, 0x9C, 0xA0, 0xBE, 0xCC, 0x9C,
+  0x4A, 0x48, 0x4C, 0xC6, 0x32, 0x26, 0xF6, 0xD0, 0x11, 0x7A, 0x90, 0xBA, 0x5A, 0xCF, 0x9B, 0xBC,
+  0xAC, 0x83, 0x7B, 0x5F, 0xBF, 0x19, 0x56, 0x97, 0x45, 0x6D, 0x71, 0x0E, 0xE1, 0x6D, 0xCA, 0x89,
+  0x9E, 0xC2, 0x46, 0x7F, 0x08, 0x5F, 0xA3, 0x14, 0x10, 0x5E, 0xF7, 0xF6, 0xEA, 0x55, 0x3F, 0x47,
+  0xB6, 0xA3, 0x98, 0x5F, 0x99, 0xBA, 0x7F, 0x94, 0x34, 0x0E, 0x48, 0x43, 0x33, 0x5D, 0x6A, 0x3D,
+  0x25, 0x3D, 0xBC, 0xC6, 0x27, 0x43, 0x28, 0xE7, 0x4B, 0x75, 0xDD, 0x43, 0x87, 0xED, 0x18, 0x59,
+  0xD3, 0xE8, 0x94, 0x03, 0x8A, 0x82, 0xAC, 0x16, 0x9E, 0xCA, 0x88, 0x91, 0xE6, 0xEE, 0x79, 0xBC,
+  0xEC, 0x22, 0x35, 0x65, 0x74, 0x65, 0x54, 0x55, 0xF3, 0x50, 0xAD, 0x67, 0x35, 0x44, 0x36, 0xDC,
+  0x2D, 0x95, 0x65, 0xAA, 0xE8, 0x76, 0xAF, 0x0B, 0xC4, 0x64, 0x5A, 0x49, 0x25, 0xC0, 0xBD, 0x05,
+  0x08, 0x50, 0x6D, 0x87, 0x98, 0x61, 0x76, 0x0B, 0x08, 0xA0, 0xAA, 0x43, 0x74, 0xB2, 0x2E, 0x02,
+  0x63, 0x03, 0xB4, 0x0D, 0x25, 0x0B, 0x52, 0x15, 0x10, 0x99, 0xFD, 0xFD, 0xC3, 0xFE, 0x17, 0x9F,
+  0x5B, 0xB2, 0xB9, 0x78, 0x64, 0xC1, 0x08, 0xE1, 0x72, 0xED, 0xE0, 0xA8, 0x6F, 0xE9, 0x65, 0x20,
+  0xDB, 0x81, 0x29, 0xDB, 0x94, 0xBC, 0x3D, 0x94, 0x32, 0x3D, 0x40, 0x92, 0xD0, 0x16, 0xE1, 0x53,
+  0xFA, 0x5E, 0xCE, 0x5E, 0x15, 0x69, 0x23, 0xC2, 0x5C, 0x10, 0x2A, 0x1D, 0xEB, 0x35, 0x36, 0xE0,
+  0x1A, 0xF4, 0x6B, 0x5C, 0x8A, 0x4D, 0x37, 0x74, 0x7D, 0xCA, 0x49, 0x05, 0x48, 0xE1, 0x4B, 0x4B,
+  0xD6, 0xA8, 0x60, 0x23, 0xA5, 0x28, 0x0D, 0x05, 0xB5, 0x7C, 0x03, 0x1D, 0x6A, 0x4D, 0x3D, 0xC8,
+  0x87, 0xB1, 0x2E, 0xD3, 0x1E, 0x32, 0x3E, 0x33, 0x4A, 0xD3, 0x3C, 0xF2, 0x3C, 0x14, 0xC5, 0x3E,
+  0x0C, 0x18, 0x38, 0xA0, 0x4B, 0x75, 0x1D, 0x44, 0x45, 0xB0, 0x34, 0xC5, 0x53, 0xD3, 0xC1, 0x19,
+  0xE5, 0xC2, 0xC6, 0x1E, 0x74, 0x15, 0x45, 0xA6, 0xAE, 0x19, 0xA9, 0x00, 0xD0, 0x71, 0x2F, 0xE9,
+  0x92, 0x84, 0xB1, 0x30, 0xA1, 0xBD, 0x8D, 0x27, 0xDB, 0x98, 0x19, 0x59, 0x86, 0x2B, 0xA2, 0xF3,
+  0xAB, 0x7E, 0x6C, 0xB5, 0x46, 0xAC, 0x1A, 0x5C, 0xB5, 0x80, 0x85, 0xB2, 0x15, 0xBA, 0x54, 0x6C,
+  0xF4, 0xFE, 0x99, 0xAF, 0xA9, 0xA6, 0xA9, 0x4D, 0xAD, 0xFA, 0xB8, 0x0E, 0xDA, 0xAA, 0x3C, 0xE2,
+  0x3D, 0x8E, 0xF6, 0x27, 0xB0, 0xB5, 0x0A, 0xFD, 0x58, 0x1E, 0xC4, 0xA5, 0x7D, 0xD0, 0x92, 0x06,
+  0x71, 0xA6, 0xF2, 0xF6, 0x30, 0x8D, 0x96, 0xD5, 0x18, 0xDB, 0x72, 0xDB, 0x28, 0xE5, 0x79, 0x80,
+  0x8E, 0xFA, 0x69, 0x00, 0x1C, 0x55, 0x5D, 0xDF, 0x54, 0x34, 0x1D, 0x3B, 0xB5, 0x3C, 0xDC, 0xDA,
+  0xCC, 0xD5, 0x7D, 0x7B, 0x9F, 0x13, 0xC5, 0x0D, 0x5D, 0x3D, 0x75, 0x36, 0x4C, 0x69, 0x91, 0x8F,
+  0x37, 0x72, 0xD4, 0x9A, 0xC1, 0xE9, 0xEF, 0xB2, 0x49, 0xED, 0x13, 0x28, 0x2A, 0x1F, 0xEA, 0xB3,
+  0x1A, 0x08, 0x51, 0xE8, 0x02, 0x37, 0xA2, 0x08, 0xC2, 0xBF, 0x8B, 0xA8, 0xF2, 0xE8, 0x74, 0x14,
+  0x4D, 0x3E, 0xFE, 0xF4, 0x07, 0x4A, 0x0B, 0x09, 0xDC, 0x9A, 0x28, 0x84, 0xD4, 0x20, 0x39, 0x86,
+  0x37, 0xA0, 0xDA, 0x9E, 0x22, 0xC9, 0xDF, 0x7F, 0xA6, 0xD9, 0xB0, 0x7B, 0xCD, 0x12, 0x6B, 0xD4,
+  0x8B, 0x26, 0xD3, 0xF2, 0x6E, 0x6A, 0xBF, 0x0D, 0x69, 0x60, 0x1A, 0x46, 0x6A, 0x17, 0x70, 0xD4,
+  0x59, 0x88, 0x3D, 0x08, 0x1E, 0x0F, 0xE5, 0x4A, 0xF1, 0x0D, 0x17, 0x64, 0x89, 0x60, 0xCC, 0xE5,
+  0xA5, 0xDD, 0x7C, 0xA0, 0x3A, 0x83, 0x95, 0x62, 0x94, 0x9A, 0x13, 0x18, 0xC8, 0x4D, 0xA3, 0x27,
+  0xC9, 0xB4, 0xAB, 0xAF, 0x2D, 0xAE, 0x48, 0x00, 0xD7, 0x74, 0x1E, 0x81, 0xB3, 0x89, 0xD4, 0x22,
+  0x7F, 0xB7, 0xDF, 0x72, 0x39, 0x50, 0xD7, 0x49, 0x25, 0xBF, 0x24, 0x6B, 0xBB, 0x77, 0xC3, 0xA7,
+  0xC0, 0x10, 0x5D, 0xEC, 0x86, 0x62, 0x64, 0x48, 0x80, 0xFD, 0x82, 0xD2, 0xB0, 0xB4, 0xA9, 0x36,
+  0x0F, 0x59, 0x49, 0x62, 0xFB, 0x69, 0xC7, 0x92, 0x51, 0xDB, 0x6F, 0xBB, 0x90, 0x14, 0x10, 0xD5,
+  0x51, 0x7A, 0xE4, 0xD1, 0x15, 0x52, 0xE9, 0x34, 0xDE, 0x01, 0x1C, 0x18, 0xB2, 0x04, 0xDB, 0xEC,
+  0x4C, 0xCE, 0x43, 0x65, 0x20, 0x84, 0x57, 0x98, 0xFA, 0x78, 0xE6, 0x93, 0x51, 0x0F, 0x08, 0x27,
+  0xC6, 0x6D, 0xAF, 0xB1, 0x9D, 0x5B, 0x1C, 0x6D, 0xD4, 0x54, 0x01, 0x67, 0x3D, 0xC9, 0x7C, 0xA4,
+  0xCE, 0xA6, 0xF2, 0xFE, 0x0E, 0xD5, 0x16, 0xEC, 0x1C, 0x32, 0x0F, 0xAC, 0x64, 0xC2, 0x30, 0x47,
+  0xC0, 0x6E, 0x73, 0xCA, 0xB8, 0xA8, 0xFE, 0x1D, 0xA1, 0x4C, 0x90, 0x51, 0x9B, 0x96, 0x0D, 0xED,
+  0xF6, 0x14, 0x83, 0xFF, 0x60, 0xB9, 0x69, 0xFC, 0xD2, 0x01, 0x4A, 0x59, 0xDD, 0xF8, 0x2E, 0x0C,
+  0xCD, 0x22, 0xAF, 0x32, 0xA6, 0x01, 0x2A, 0x1B, 0xD6, 0x70, 0x0B, 0xB3, 0x0F, 0xA7, 0xF9, 0x27,
+  0xD2, 0x72, 0x80, 0x00, 0x07, 0xD9, 0x6A, 0xC1, 0x86, 0xC9, 0x77, 0x69, 0xCA, 0x70, 0x3D, 0x0B,
+  0xD7, 0x84, 0x9D, 0x60, 0x5E, 0xFC, 0x5F, 0xA3, 0x3F, 0xEA, 0xE4, 0xCA, 0x0D, 0x69, 0x5A, 0x58,
+  0x1F, 0xE2, 0xBA, 0xC4, 0x4E, 0xA6, 0x35, 0x2B, 0x95, 0xDC, 0xBA, 0x31, 0xA7, 0xAD, 0x7F, 0x4F,
+  0x8C, 0x78, 0x84, 0x03, 0xDD, 0xBB, 0x02, 0x4A, 0x2A, 0x5C, 0xA9, 0x96, 0xD1, 0xCE, 0x04, 0x0E,
+  0x01, 0x99, 0x8B, 0x85, 0x64, 0xD4, 0x93, 0xC4, 0x93, 0xDB, 0xE1, 0x28, 0xF9, 0xAA, 0x72, 0xEE,
+  0x4C, 0x5E, 0xA7, 0x90, 0xBA, 0x19, 0x92, 0x37, 0x77, 0x82, 0xCD, 0x86, 0xFE, 0x5C, 0xB8, 0xEC,
+  0xE7, 0x56, 0xD1, 0xDA, 0x4C, 0x53, 0xC6, 0x1A, 0x8E, 0x22, 0xB8, 0x31, 0x9C, 0x5C, 0x51, 0xDF,
+  0x33, 0x95, 0xC1, 0xEA, 0xD7, 0x6F, 0x7D, 0xEC, 0xD1, 0xD2, 0x56, 0x5D, 0xC5, 0xCD, 0xEC, 0xEE,
+  0x36, 0xB9, 0xCD, 0x7D, 0x5C, 0x16, 0x0F, 0x79, 0x1F, 0x97, 0x41, 0x58, 0xBF, 0xB3, 0x7D, 0xF2,
+  0x86, 0x5B, 0xCF, 0xEF, 0x8A, 0x5B, 0x1B, 0xEA, 0xB5, 0xE7, 0x6B, 0x7A, 0xE2, 0xCE, 0xE4, 0x29,
+  0x24, 0x2B, 0x5C, 0x85, 0x45, 0xA8, 0x44, 0x52, 0xF2, 0x34, 0xF2, 0x36, 0x29, 0x2A, 0x63, 0xF6,
+  0x77, 0xA4, 0x6C, 0xD2, 0x91, 0xEC, 0xE7, 0x92, 0xA7, 0xD3, 0xFC, 0x53, 0x79, 0xD8, 0x29, 0x8B,
+  0xE3, 0xB0, 0xF3, 0x2F, 0x62, 0x47, 0x75, 0xEB, 0x9E, 0x16, 0x00, 0x00,
+};
+
+// index.html: 3390 bytes, 955 gzipped
+static const uint8_t INDEX_HTML_GZ[] = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xD5, 0x57, 0x4F, 0x8F, 0xE3, 0x34,
+  0x14, 0xBF, 0xCF, 0xA7, 0x78, 0x44, 0x42, 0xDA, 0x95, 0x48, 0xDB, 0x64, 0x69, 0x77, 0xA9, 0x92,
+  0xA0, 0xD5, 0x32, 0x08, 0xA4, 0x1D, 0xB1, 0x9A, 0xCE, 0x82, 0x38, 0x3A, 0xF1, 0x6B, 0x6B, 0xD6,
+  0xB5, 0x23, 0xDB, 0x6D, 0x55, 0x4E, 0x1C, 0xB8, 0x71, 0xE0, 0xC0, 0x8D, 0x0B, 0x88, 0x0B, 0x27,
+  0x24, 0x8E, 0x70, 0xE5, 0xA3, 0xCC, 0x17, 0x80, 0x8F, 0xC0, 0xB3, 0xDB, 0x4E, 0xDB, 0x4C, 0x3A,
+  0xB3, 0xB3, 0xD2, 0x68, 0xA1, 0x97, 0x2A, 0xF6, 0xF3, 0xFB, 0xFD, 0xDE, 0xBF, 0xE4, 0xE7, 0xEC,
+  0x9D, 0x8F, 0x3E, 0x7B, 0x76, 0xF1, 0xE5, 0x8B, 0x53, 0x98, 0xBA, 0x99, 0x2C, 0x4E, 0x32, 0xFF,
+  0x07, 0x92, 0xA9, 0x49, 0x1E, 0xA1, 0x8A, 0xFC, 0x02, 0x32, 0x5E, 0x9C, 0x00, 0xFD, 0xB2, 0x19,
+  0x3A, 0x06, 0xD5, 0x94, 0x19, 0x8B, 0x2E, 0x8F, 0x5E, 0x5E, 0x7C, 0x1C, 0x3F, 0x89, 0xF6, 0xB7,
+  0x14, 0x9B, 0x61, 0x1E, 0x2D, 0x04, 0x2E, 0x6B, 0x6D, 0x5C, 0x04, 0x95, 0x56, 0x0E, 0x15, 0x99,
+  0x2E, 0x05, 0x77, 0xD3, 0x9C, 0xE3, 0x42, 0x54, 0x18, 0x87, 0x87, 0xF7, 0x40, 0x28, 0xE1, 0x04,
+  0x93, 0xB1, 0xAD, 0x98, 0xC4, 0x3C, 0xE9, 0xF4, 0xB6, 0xAE, 0x9C, 0x70, 0x12, 0x8B, 0xA7, 0xA3,
+  0xFE, 0xA0, 0xD7, 0x83, 0x11, 0x2A, 0xAB, 0x0D, 0x9C, 0x69, 0xB2, 0xD6, 0x26, 0xEB, 0xAE, 0x37,
+  0xD7, 0x86, 0x52, 0xA8, 0x57, 0x60, 0x50, 0xE6, 0x91, 0x75, 0x2B, 0x89, 0x76, 0x8A, 0x48, 0xA0,
+  0x53, 0x83, 0xE3, 0x3C, 0x62, 0x75, 0xDD, 0xA9, 0xAC, 0xFD, 0x70, 0x91, 0x3F, 0xA9, 0x7A, 0x58,
+  0xF5, 0x2B, 0x1C, 0xF0, 0x24, 0x2D, 0x07, 0x8F, 0x2B, 0x1F, 0x53, 0x77, 0x1D, 0x54, 0x56, 0x6A,
+  0xBE, 0xDA, 0x38, 0xE3, 0x62, 0x01, 0x95, 0x64, 0xD6, 0xE6, 0x91, 0xA7, 0xCD, 0x84, 0x42, 0xB3,
+  0x61, 0x14, 0xF6, 0xA7, 0x49, 0xF1, 0xCF, 0x4F, 0xBF, 0xFE, 0x06, 0x47, 0x78, 0xD1, 0xF6, 0xCE,
+  0xB6, 0xDE, 0x7A, 0xB2, 0xF3, 0x32, 0x10, 0x8E, 0x8A, 0x73, 0xA4, 0x50, 0x9D, 0x98, 0x21, 0x9C,
+  0xB1, 0x89, 0x42, 0x27, 0x2A, 0x38, 0x55, 0x95, 0xE6, 0x68, 0x80, 0xB6, 0xB8, 0x50, 0x13, 0x9B,
+  0x75, 0xEB, 0xE2, 0x64, 0xE7, 0xC4, 0x13, 0x12, 0xDC, 0xC7, 0xC6, 0xDC, 0xDC, 0x46, 0x57, 0x2E,
+  0xC3, 0x23, 0x70, 0x61, 0x89, 0xA6, 0xC2, 0xCA, 0x21, 0xDF, 0xA3, 0xE9, 0x7F, 0x97, 0x3F, 0xFE,
+  0xFC, 0xF7, 0x1F, 0xDF, 0xC3, 0xB3, 0xF5, 0x36, 0x79, 0x06, 0xA7, 0xE1, 0x0B, 0x2C, 0x47, 0xBA,
+  0x7A, 0x85, 0xAE, 0xD3, 0xE9, 0xEC, 0x30, 0xBA, 0x04, 0xD2, 0xC4, 0xDC, 0xE0, 0x08, 0x35, 0xD6,
+  0x0D, 0xC7, 0x99, 0x64, 0x25, 0x4A, 0x18, 0x6B, 0x93, 0x47, 0x86, 0x39, 0x8A, 0x2A, 0xB3, 0xCE,
+  0x68, 0x35, 0x29, 0x5E, 0xD6, 0x9C, 0x9E, 0xC1, 0x2F, 0x0E, 0xB3, 0xEE, 0x66, 0x31, 0xEB, 0x06,
+  0xFB, 0x86, 0x0F, 0x8B, 0x92, 0x58, 0x85, 0xC8, 0x82, 0x0F, 0xD0, 0x8A, 0x3A, 0x4A, 0x4D, 0x30,
+  0x64, 0xCB, 0x56, 0x46, 0x94, 0xF8, 0xE0, 0x61, 0x03, 0x39, 0x9C, 0xD4, 0xB5, 0x13, 0x5A, 0xC1,
+  0x82, 0xC9, 0x39, 0x19, 0x27, 0x51, 0x91, 0xC0, 0x27, 0x5F, 0x67, 0xDD, 0xF5, 0xF2, 0xAD, 0xF6,
+  0xFD, 0xA8, 0xE8, 0xDF, 0xC5, 0x3E, 0xE9, 0x45, 0xB0, 0xE6, 0x8A, 0xBC, 0x48, 0x7A, 0x77, 0x39,
+  0x9A, 0x12, 0x56, 0x7A, 0x27, 0x30, 0xEA, 0xFD, 0xD3, 0x05, 0x9A, 0x15, 0x58, 0x36, 0xAB, 0x25,
+  0xB6, 0x9F, 0xA3, 0xC4, 0x06, 0x3E, 0xCD, 0x84, 0xD6, 0x4C, 0x5D, 0xA5, 0x33, 0x9E, 0x18, 0xA6,
+  0x42, 0x4B, 0x90, 0x35, 0x6D, 0x14, 0xAF, 0x55, 0x6B, 0x1B, 0x9A, 0xD9, 0x36, 0xCB, 0x7D, 0xCD,
+  0x22, 0xAE, 0x98, 0xE1, 0x6D, 0xA5, 0x99, 0xA6, 0xC5, 0x66, 0x20, 0x12, 0x1A, 0x85, 0xB4, 0xC5,
+  0x62, 0xCF, 0x17, 0x15, 0x5B, 0x62, 0x4C, 0x0D, 0x5C, 0x4B, 0xB6, 0x6A, 0xF1, 0x76, 0x18, 0x55,
+  0xB0, 0x4E, 0xA2, 0xC3, 0xC3, 0x21, 0x6D, 0x51, 0x11, 0xC7, 0x71, 0x33, 0xCC, 0xEB, 0x4E, 0x0E,
+  0x0E, 0xCE, 0x69, 0x5C, 0xA3, 0x82, 0xE3, 0xC4, 0x20, 0xDA, 0x63, 0x67, 0x37, 0xA9, 0xBA, 0x3D,
+  0x86, 0x92, 0x99, 0x63, 0xFC, 0xB7, 0xD3, 0x4B, 0x26, 0x4D, 0xF2, 0x63, 0x21, 0x25, 0xF5, 0x96,
+  0x7F, 0x65, 0x6D, 0xDE, 0x8C, 0x43, 0xE8, 0xBD, 0xEB, 0x2B, 0xD6, 0x0E, 0x7B, 0x3B, 0x1B, 0xC3,
+  0x96, 0xDB, 0x94, 0xB4, 0xB2, 0x39, 0x67, 0xCB, 0xE1, 0x41, 0xA3, 0x2C, 0x93, 0xFD, 0xE4, 0x41,
+  0x17, 0xDE, 0xEF, 0x7D, 0xD0, 0xBF, 0x0F, 0xE4, 0x51, 0x8D, 0xC8, 0x0F, 0xB0, 0xEB, 0xD9, 0x21,
+  0xF6, 0xF9, 0x8B, 0xB3, 0xFB, 0x00, 0xBE, 0x98, 0x1B, 0x65, 0xF7, 0x81, 0x9D, 0x5F, 0x48, 0x6E,
+  0xEC, 0x99, 0x16, 0xD8, 0xE6, 0xD4, 0xBC, 0xF1, 0x5C, 0xA4, 0xF7, 0x32, 0x17, 0xE9, 0xFF, 0x79,
+  0x2E, 0xD2, 0xFF, 0xE0, 0x5C, 0xA4, 0x6F, 0x71, 0x2E, 0xD2, 0xB7, 0x37, 0x17, 0xE9, 0x1B, 0xCE,
+  0xC5, 0x8D, 0x1F, 0x97, 0xD0, 0xA5, 0xC6, 0xB0, 0x55, 0x6C, 0xBD, 0x0E, 0xD1, 0x2A, 0x3A, 0xD0,
+  0x16, 0xDB, 0x4A, 0x6F, 0x1A, 0x7E, 0x08, 0x4A, 0xAB, 0x26, 0xEB, 0xAC, 0xBE, 0x92, 0x18, 0x9B,
+  0x39, 0x7A, 0xEA, 0x1D, 0xEE, 0x49, 0x8C, 0xBA, 0xE5, 0x9B, 0xB5, 0x03, 0x0E, 0x99, 0xB0, 0xD7,
+  0x5A, 0xE8, 0xAE, 0xBA, 0x67, 0xC7, 0xE2, 0xF2, 0xDB, 0x3F, 0xBD, 0xB6, 0xFA, 0x94, 0x8C, 0xCC,
+  0x8C, 0xF9, 0xA0, 0x86, 0x37, 0x90, 0xA9, 0x8B, 0xCB, 0x6F, 0x7E, 0xD9, 0x2A, 0xC6, 0xCD, 0x47,
+  0x16, 0x6A, 0xA3, 0x17, 0x82, 0x23, 0x24, 0x69, 0x5C, 0x0A, 0x47, 0xFA, 0xD5, 0x6A, 0x39, 0x0F,
+  0x62, 0xE0, 0x41, 0x2F, 0xF6, 0xFD, 0xF6, 0xF0, 0x98, 0xA3, 0xCF, 0x43, 0x34, 0xC0, 0x0C, 0xC2,
+  0x3C, 0x08, 0x2E, 0x4E, 0x22, 0x9A, 0x1C, 0x6C, 0x95, 0xE5, 0x42, 0xB0, 0x9D, 0xCE, 0x3B, 0xCA,
+  0xC6, 0xCF, 0x1A, 0x29, 0x35, 0x52, 0x5C, 0x34, 0x5E, 0x7F, 0xFD, 0x0E, 0x31, 0x3C, 0x1A, 0xD0,
+  0xFF, 0x81, 0xFD, 0x4D, 0x09, 0x92, 0x7A, 0x62, 0xAF, 0x2A, 0xDA, 0x80, 0x98, 0x3E, 0x22, 0x91,
+  0xFC, 0xC3, 0x77, 0x30, 0x5A, 0x59, 0x87, 0x33, 0x78, 0xAE, 0xBD, 0xAA, 0xA5, 0xC5, 0xF6, 0x1A,
+  0x05, 0x4F, 0x6D, 0x62, 0xFB, 0x08, 0x6C, 0x4C, 0x77, 0x09, 0x43, 0x6F, 0xC6, 0xE7, 0x3A, 0x08,
+  0x66, 0xF0, 0xE7, 0x49, 0xCE, 0xBE, 0x76, 0x7B, 0x36, 0x23, 0xCB, 0xBC, 0xDA, 0xAC, 0x1D, 0x58,
+  0x53, 0xAD, 0x2F, 0x0C, 0x5F, 0xF9, 0xFB, 0x42, 0x82, 0x65, 0x92, 0x8C, 0xF9, 0xA0, 0xE4, 0xFD,
+  0x3E, 0x43, 0xF6, 0x38, 0x48, 0xA9, 0x60, 0xE8, 0x2F, 0x0E, 0xEB, 0x1B, 0x03, 0x05, 0x15, 0x6E,
+  0x4B, 0xFF, 0x02, 0x49, 0x34, 0x35, 0x1A, 0x3E, 0x0D, 0x00, 0x00,
+};
+
+static const Asset ASSETS[] = {
+  { "/app.css", "text/css", "\"8c0ec5ce6d12b67c\"", "public, max-age=31536000, immutable", APP_CSS_GZ, sizeof(APP_CSS_GZ), 4038 },
+  { "/app.js", "application/javascript", "\"1eb11fd6bd55aea7\"", "public, max-age=31536000, immutable", APP_JS_GZ, sizeof(APP_JS_GZ), 5790 },
+  { "/", "text/html", "\"dbfcb28fdaf5847c\"", "no-cache", INDEX_HTML_GZ, sizeof(INDEX_HTML_GZ), 3390 },
+};
+static const size_t COUNT = sizeof(ASSETS) / sizeof(ASSETS[0]);
+
+} // namespace WebAssets
+
+#endif // WEB_ASSETS_H
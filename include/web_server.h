@@ -3,13 +3,41 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WebServer.h>
-#include <WebSocketsServer.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "change_detector.h"
+#include "config.h"
+#include "seqlock.h"
+#include "ws_message.h"
+#include "ws_scheduler.h"
+
+// ============================================================================
+// Web Server and WebSocket
+// ============================================================================
+// Event-driven: HTTP requests and WebSocket frames are handled by the
+// AsyncTCP task as data arrives, any number of connections at once, and
+// responses are streamed as the TCP window opens, so nothing in the request
+// path blocks. The WebSocket shares the HTTP port (/ws binary, /ws/json
+// JSON). Client connects, disconnects and subscriptions are queued to the
+// network task, which owns the subscription scheduler and does all sending.
 
 class WebServerManager {
 public:
+  // Calibration hooks (sensor index 0/1), provided by the application
+  struct CalibrationStatus {
+    bool active;          // Capture in progress
+    bool calibrated;      // Correction table in use
+    uint8_t progress;     // Capture progress (0-100 %)
+  };
+  typedef bool (*CalibrationStartHandler)(uint8_t sensor);
+  typedef CalibrationStatus (*CalibrationStatusHandler)(uint8_t sensor);
+
   WebServerManager();
   
+  // Register calibration hooks for the /calibrate endpoint
+  void setCalibrationHandlers(CalibrationStartHandler start, CalibrationStatusHandler status);
+  
   // Initialize WiFi and web server (only if WiFi credentials are configured)
   bool begin(const char* ssid, const char* password, uint16_t port);
   
@@ -20,29 +48,143 @@ public:
   // Get IP address
   String getIPAddress() const;
   
-  // Handle client requests (call this in loop)
+  // Apply queued WebSocket client events and clean up closed clients (call
+  // from the network task)
   void handleClient();
   
-  // Update sensor data for WebSocket broadcast
-  void updateSensorData(uint16_t angle1, uint16_t angle2);
+  // Sample producer (acquisition task): the update*() calls fill a staging
+  // set and publishSensorData() makes it visible to the network task as one
+  // snapshot, so a broadcast never mixes two samples
+  
+  // Update sensor data for WebSocket broadcast (sample instants in us,
+  // low 32 bits of esp_timer)
+  void updateSensorData(uint16_t angle1, uint16_t angle2,
+                        uint32_t time1Us = 0, uint32_t time2Us = 0);
+  
+  // Update observer velocity (counts/s) and acceleration (counts/s^2)
+  void updateMotionData(int32_t velocity1, int32_t velocity2,
+                        int32_t acceleration1, int32_t acceleration2);
+  
+  // Update multi-turn counts
+  void updateTurnData(int32_t turns1, int32_t turns2);
   
-  // Send sensor data via WebSocket
+  // Update sensor array data (N angles and their sample times) for
+  // WebSocket broadcast
+  void updateSensorArray(const uint16_t* angles, const uint32_t* timesUs, uint8_t count);
+  
+  // Publish the staged sample set (wait-free)
+  void publishSensorData();
+  
+  // Send sensor data to the clients that are due (ws_scheduler.h): one
+  // binary message (ws_message.h), plus JSON for legacy clients, each
+  // encoded once per call and only if someone is due. Call from the network
+  // task after handleClient().
   void broadcastSensorData();
+  
+  // Change-driven broadcast: skip ticks where no angle left its deadband
+  typedef ChangeDetector<2> OutputGate;
+  void setChangeDriven(bool enabled, uint16_t deadband1, uint16_t deadband2,
+                       uint32_t heartbeatMs);
+  const OutputGate::Stats& getOutputStats() const { return outputGate.getStats(); }
+  
+  // Per-client subscriptions and backpressure
+  typedef WsScheduler<WEBSOCKET_MAX_CLIENTS> Scheduler;
+  const Scheduler& getScheduler() const { return scheduler; }
+  
+  // Broadcasts that found every snapshot read overlapping a write
+  uint32_t getSnapshotMisses() const { return snapshotMisses; }
 
 private:
   bool wifiEnabled;
   uint16_t serverPort;
-  unsigned long lastBroadcast;
   
-  // Current sensor values
-  uint16_t currentAngle1;
-  uint16_t currentAngle2;
+  // One published sample set. `updates` counts fresh data per sensor group
+  // (sensor 1, sensor 2, array) so the network task can tell which changed.
+  static const uint8_t MAX_ARRAY_ANGLES = 16;
+  static const uint8_t SENSOR_GROUPS = 3;
+  struct SensorSnapshot {
+    uint16_t angle[2];
+    uint32_t timeUs[2];
+    int32_t velocity[2];
+    int32_t acceleration[2];
+    int32_t turns[2];
+    uint16_t arrayAngles[MAX_ARRAY_ANGLES];
+    uint32_t arrayTimeUs[MAX_ARRAY_ANGLES];
+    uint8_t arrayCount;       // 0 when not in array mode
+    uint32_t updates[SENSOR_GROUPS];
+  };
+  
+  SensorSnapshot staging;             // Producer only
+  Seqlock<SensorSnapshot> published;
+  SensorSnapshot latest;              // Network task only
+  uint32_t latestVersion;
+  uint32_t snapshotMisses;            // Reads that overlapped writes every try
+  
+  OutputGate outputGate;
+  bool changeDriven;
+  size_t lastMessageSize;
+  
+  // Snapshot update counters already handed to the scheduler
+  uint32_t groupSeen[SENSOR_GROUPS];
+  
+  // Scheduler slots: AsyncWebSocket client id (0 = free) and endpoint
+  // (ids are per endpoint)
+  static const uint8_t MAX_CLIENTS = WEBSOCKET_MAX_CLIENTS;
+  uint32_t clientId[MAX_CLIENTS];
+  bool clientJson[MAX_CLIENTS];
+  Scheduler scheduler;
+  
+  // Client events from the AsyncTCP task, applied by handleClient()
+  struct ClientEvent {
+    enum Type : uint8_t {
+      CONNECT,
+      DISCONNECT,
+      SUBSCRIBE
+    };
+    Type type;
+    bool json;
+    uint32_t id;
+    int16_t sensors;          // SUBSCRIBE: -1 = unchanged
+    int32_t rate;             // SUBSCRIBE: -1 = unchanged
+  };
+  static const uint8_t EVENT_QUEUE_LENGTH = 16;
+  QueueHandle_t clientEvents;
+  unsigned long lastCleanup;
+  
+  // Encoded messages, shared by reference with every due client's send
+  // queue (no per-client copy)
+  static const size_t JSON_MESSAGE_SIZE = 768;
+  AsyncWebSocketSharedBuffer binaryMessage;
+  AsyncWebSocketSharedBuffer jsonMessage;
+  uint16_t messageSequence;
+  
+  CalibrationStartHandler calibrationStart;
+  CalibrationStatusHandler calibrationStatus;
+  
+  AsyncWebServer* server;
+  AsyncWebSocket* binarySocket;       // /ws
+  AsyncWebSocket* jsonSocket;         // /ws/json (WEBSOCKET_JSON only)
+  
+  // /calibrate?sensor=N[&start=1]
+  void handleCalibrate(AsyncWebServerRequest* request);
+  
+  // Encode current sensor data into binaryMessage / jsonMessage
+  void encodeBinary();
+  void encodeJSON();
+  
+  // A buffer no send queue still references, sized `size`
+  static void prepareBuffer(AsyncWebSocketSharedBuffer& buffer, size_t size);
+  
+  // Scheduler slot of a client, or -1
+  int findSlot(uint32_t id, bool json) const;
+  AsyncWebSocketClient* getClient(uint8_t slot);
   
-  WebServer* server;
-  WebSocketsServer* webSocket;
+  // Apply one queued client event (network task)
+  void applyEvent(const ClientEvent& event);
   
-  // WebSocket event handler
-  void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+  // WebSocket event handler (AsyncTCP task): queue it for the network task
+  void webSocketEvent(AsyncWebSocket* socket, AsyncWebSocketClient* client, AwsEventType type,
+                      void* arg, uint8_t* data, size_t length);
   
   // Static instance pointer for callbacks
   static WebServerManager* instance;
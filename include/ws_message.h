@@ -0,0 +1,82 @@
+#ifndef WS_MESSAGE_H
+#define WS_MESSAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// Binary WebSocket Sensor Message
+// ============================================================================
+// Compact replacement for the JSON dashboard message, sent as a BIN frame.
+// Raw counts instead of float degrees; all fields little-endian so the
+// browser reads them with DataView(..., true):
+//
+//   offset  type   field
+//   0       u8     version (VERSION)
+//   1       u8     array count N (0 = no sensor array)
+//   2       u16    sequence (per broadcast, wraps)
+//   4       u32    sensor 1 sample time (us, esp_timer low 32 bits)
+//   8       u32    sensor 2 sample time
+//   12      u16    sensor 1 raw angle (0-4095)
+//   14      u16    sensor 2 raw angle
+//   16      i32    sensor 1 velocity (counts/s)
+//   20      i32    sensor 2 velocity
+//   24      i32    sensor 1 acceleration (counts/s^2)
+//   28      i32    sensor 2 acceleration
+//   32      i32    sensor 1 turns
+//   36      i32    sensor 2 turns
+//   40      u16    array raw angles x N
+//   40+2N   u32    array sample times x N (us, esp_timer low 32 bits)
+//
+// Arduino-free so the encoder can be benchmarked on a host.
+
+namespace WsMessage {
+
+static const uint8_t VERSION = 2;
+static const size_t HEADER_SIZE = 40;
+static const uint8_t MAX_ARRAY = 16;
+static const size_t MAX_SIZE = HEADER_SIZE + 6 * MAX_ARRAY;
+
+struct SensorData {
+  uint16_t angle[2];
+  uint32_t timeUs[2];
+  int32_t velocity[2];
+  int32_t acceleration[2];
+  int32_t turns[2];
+  const uint16_t* array;    // Sensor array angles (nullptr when arrayCount is 0)
+  const uint32_t* arrayTimeUs;  // Their sample times
+  uint8_t arrayCount;
+};
+
+inline void putU16(uint8_t* out, uint16_t v) {
+  out[0] = v & 0xFF;
+  out[1] = (v >> 8) & 0xFF;
+}
+
+inline void putU32(uint8_t* out, uint32_t v) {
+  for (uint8_t b = 0; b < 4; b++) out[b] = (v >> (8 * b)) & 0xFF;
+}
+
+// Encode into `out` (MAX_SIZE bytes); returns the message size
+inline size_t encode(const SensorData& data, uint16_t sequence, uint8_t* out) {
+  uint8_t count = data.arrayCount > MAX_ARRAY ? MAX_ARRAY : data.arrayCount;
+  out[0] = VERSION;
+  out[1] = count;
+  putU16(out + 2, sequence);
+  for (uint8_t i = 0; i < 2; i++) {
+    putU32(out + 4 + 4 * i, data.timeUs[i]);
+    putU16(out + 12 + 2 * i, data.angle[i]);
+    putU32(out + 16 + 4 * i, (uint32_t)data.velocity[i]);
+    putU32(out + 24 + 4 * i, (uint32_t)data.acceleration[i]);
+    putU32(out + 32 + 4 * i, (uint32_t)data.turns[i]);
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    putU16(out + HEADER_SIZE + 2 * i, data.array[i]);
+    putU32(out + HEADER_SIZE + 2 * count + 4 * i, data.arrayTimeUs[i]);
+  }
+  return HEADER_SIZE + 6 * count;
+}
+
+} // namespace WsMessage
+
+#endif // WS_MESSAGE_H
@@ -0,0 +1,241 @@
+#ifndef WS_SCHEDULER_H
+#define WS_SCHEDULER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// WebSocket Subscription Scheduler
+// ============================================================================
+// Decides, per client, when the next sensor message goes out. Each client
+// subscribes to a set of sensors and a rate between MIN_RATE_HZ and the
+// acquisition output rate; a message is due when one of its sensors has
+// fresh data and the client's deadline has passed. Deadlines advance on a
+// fixed grid so the average rate holds even when samples arrive with jitter.
+// With nobody due the caller skips serialization altogether.
+//
+// Backpressure: before each send the caller reports whether the client's
+// send buffer is congested. A congested client is skipped (its data stays
+// pending, the next send carries the newest sample); after DECIMATE_AFTER
+// congested attempts without RECOVER_AFTER clean sends in between its rate
+// is halved, up to MAX_DECIMATION times, and RECOVER_AFTER clean sends in a
+// row double it back. A client that gets nothing through for DROP_AFTER_US
+// of congestion is dropped.
+//
+// Times are wrapping uint32_t microseconds. Single-threaded (call from the
+// task that sends) and Arduino-free so it can be run on a host against
+// simulated client queues (tools/ws_scheduler_check.cpp).
+
+template <uint8_t Clients>
+class WsScheduler {
+public:
+  // Sensor groups (subscription mask bits)
+  static const uint8_t SENSOR_1 = 0x01;
+  static const uint8_t SENSOR_2 = 0x02;
+  static const uint8_t SENSOR_ARRAY = 0x04;
+  static const uint8_t ALL_SENSORS = SENSOR_1 | SENSOR_2 | SENSOR_ARRAY;
+
+  static const uint32_t MIN_RATE_HZ = 1;
+  static const uint8_t DECIMATE_AFTER = 3;        // Congested attempts before halving the rate
+  static const uint8_t RECOVER_AFTER = 32;        // Clean sends before doubling it back
+  static const uint8_t MAX_DECIMATION = 6;        // Rate / 64 at most
+  static const uint32_t DROP_AFTER_US = 10000000; // Nothing sent for this long: drop
+
+  enum Action : uint8_t {
+    SKIP,       // Congested: try again at the next deadline
+    SEND,       // Send now (the scheduler counts it as sent)
+    DROP        // Hopelessly slow: disconnect the client
+  };
+
+  struct ClientStats {
+    uint32_t sent;
+    uint32_t congested;       // Attempts skipped because of backpressure
+    uint8_t decimation;       // Current rate divider is 1 << decimation
+    uint32_t rateHz;          // Subscribed rate (before decimation)
+  };
+
+  struct Stats {
+    uint32_t sent;            // Messages sent, all clients
+    uint32_t congested;       // Attempts skipped, all clients
+    uint32_t decimations;     // Rate halvings
+    uint32_t recoveries;      // Rate doublings back
+    uint32_t dropped;         // Clients dropped
+    uint32_t idle;            // Fresh samples nobody was subscribed to
+  };
+
+  explicit WsScheduler(uint32_t maxRateHz) : _maxRateHz(maxRateHz ? maxRateHz : 1) {
+    for (uint8_t i = 0; i < Clients; i++) {
+      _clients[i] = Client();
+    }
+    resetStats();
+  }
+
+  // Maximum subscribable rate (the acquisition output rate)
+  uint32_t getMaxRate() const { return _maxRateHz; }
+
+  // A client connected: subscribe it with a default set and rate
+  void connect(uint8_t client, uint8_t sensors, uint32_t rateHz, uint32_t nowUs) {
+    if (client >= Clients) return;
+    Client& c = _clients[client];
+    c = Client();
+    c.connected = true;
+    c.nextUs = nowUs;
+    subscribe(client, sensors, rateHz);
+    // Send the current data right away
+    c.pending = c.sensors;
+  }
+
+  void disconnect(uint8_t client) {
+    if (client < Clients) _clients[client].connected = false;
+  }
+
+  bool isConnected(uint8_t client) const {
+    return client < Clients && _clients[client].connected;
+  }
+
+  // Change a client's subscription. `rateHz` 0 means the full rate; others
+  // are clamped to MIN_RATE_HZ..getMaxRate(). Returns the rate in effect.
+  uint32_t subscribe(uint8_t client, uint8_t sensors, uint32_t rateHz) {
+    if (client >= Clients) return 0;
+    Client& c = _clients[client];
+    if (rateHz == 0 || rateHz > _maxRateHz) rateHz = _maxRateHz;
+    if (rateHz < MIN_RATE_HZ) rateHz = MIN_RATE_HZ;
+    c.sensors = sensors & ALL_SENSORS;
+    c.pending &= c.sensors;
+    c.rateHz = rateHz;
+    // Full rate: every fresh sample, no grid (samples already arrive at it)
+    c.intervalUs = (rateHz >= _maxRateHz) ? 0 : 1000000UL / rateHz;
+    return rateHz;
+  }
+
+  uint8_t getSensors(uint8_t client) const {
+    return client < Clients ? _clients[client].sensors : 0;
+  }
+
+  // Fresh data arrived for the given sensor groups
+  void publish(uint8_t sensors) {
+    bool wanted = false;
+    for (uint8_t i = 0; i < Clients; i++) {
+      Client& c = _clients[i];
+      if (!c.connected || (c.sensors & sensors) == 0) continue;
+      c.pending |= c.sensors & sensors;
+      wanted = true;
+    }
+    if (!wanted) _stats.idle++;
+  }
+
+  bool isDue(uint8_t client, uint32_t nowUs) const {
+    if (client >= Clients) return false;
+    const Client& c = _clients[client];
+    return c.connected && c.pending != 0 && (int32_t)(nowUs - c.nextUs) >= 0;
+  }
+
+  // True if any client is due (false: skip serialization)
+  bool anyDue(uint32_t nowUs) const {
+    for (uint8_t i = 0; i < Clients; i++) {
+      if (isDue(i, nowUs)) return true;
+    }
+    return false;
+  }
+
+  // A due client is about to be sent to; `congested` is true when its send
+  // buffer has no room. Returns what to do.
+  Action attempt(uint8_t client, uint32_t nowUs, bool congested) {
+    if (!isDue(client, nowUs)) return SKIP;
+    Client& c = _clients[client];
+    uint32_t interval = periodUs(c);
+
+    if (congested) {
+      c.stats.congested++;
+      _stats.congested++;
+      c.cleanStreak = 0;
+      if (!c.stalled) {
+        c.stalled = true;
+        c.stalledSinceUs = nowUs;
+      }
+      if ((uint32_t)(nowUs - c.stalledSinceUs) >= DROP_AFTER_US) {
+        c.connected = false;
+        _stats.dropped++;
+        return DROP;
+      }
+      if (++c.congestedStreak >= DECIMATE_AFTER && c.decimation < MAX_DECIMATION) {
+        c.decimation++;
+        c.congestedStreak = 0;
+        _stats.decimations++;
+        interval = periodUs(c);
+      }
+      // Retry one (decimated) period later; at full rate, one sample later
+      c.nextUs = nowUs + (interval ? interval : 1000000UL / _maxRateHz);
+      return SKIP;
+    }
+
+    c.stats.sent++;
+    _stats.sent++;
+    c.pending = 0;
+    c.stalled = false;
+    // Congested attempts only age out after a clean run, so a client that
+    // keeps its buffer at the limit is decimated too
+    if (++c.cleanStreak >= RECOVER_AFTER) {
+      c.cleanStreak = 0;
+      c.congestedStreak = 0;
+      if (c.decimation > 0) {
+        c.decimation--;
+        _stats.recoveries++;
+        interval = periodUs(c);
+      }
+    }
+    // Next deadline on the grid; restart it after falling a period behind
+    if ((int32_t)(nowUs - c.nextUs) > (int32_t)interval) c.nextUs = nowUs;
+    c.nextUs += interval;
+    return SEND;
+  }
+
+  ClientStats getClientStats(uint8_t client) const {
+    ClientStats s = ClientStats();
+    if (client < Clients) {
+      s = _clients[client].stats;
+      s.decimation = _clients[client].decimation;
+      s.rateHz = _clients[client].rateHz;
+    }
+    return s;
+  }
+
+  uint8_t getConnectedCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < Clients; i++) {
+      if (_clients[i].connected) count++;
+    }
+    return count;
+  }
+
+  const Stats& getStats() const { return _stats; }
+  void resetStats() { _stats = Stats(); }
+
+private:
+  struct Client {
+    bool connected;
+    uint8_t sensors;          // Subscription mask
+    uint8_t pending;          // Subscribed groups with unsent data
+    uint8_t decimation;
+    uint8_t congestedStreak;
+    uint8_t cleanStreak;
+    uint32_t rateHz;
+    uint32_t intervalUs;      // 0 = every fresh sample
+    uint32_t nextUs;          // Next deadline
+    bool stalled;             // Congested since the last send
+    uint32_t stalledSinceUs;
+    ClientStats stats;
+  };
+
+  uint32_t _maxRateHz;
+  Client _clients[Clients];
+  Stats _stats;
+
+  // Time between sends including decimation (0 = every fresh sample)
+  uint32_t periodUs(const Client& c) const {
+    if (c.decimation == 0) return c.intervalUs;
+    uint32_t base = c.intervalUs ? c.intervalUs : 1000000UL / _maxRateHz;
+    return base << c.decimation;
+  }
+};
+
+#endif // WS_SCHEDULER_H
@@ -0,0 +1,135 @@
+#include "acquisition_task.h"
+#include "config.h"
+#include "logger.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+AcquisitionTask::AcquisitionTask()
+  : _scheduler(_clock, SAMPLE_INTERVAL_MS * 1000UL, ACQ_LATE_THRESHOLD_US),
+    _timer(nullptr), _task(nullptr), _callback(nullptr), _callbackArg(nullptr),
+    _triggered(false) {
+  _statsMux = portMUX_INITIALIZER_UNLOCKED;
+}
+
+// ============================================================================
+// Create Task and Start Timer
+// ============================================================================
+bool AcquisitionTask::begin(uint32_t periodUs, SampleCallback callback, void* arg) {
+  _callback = callback;
+  _callbackArg = arg;
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      taskEntry, "acquisition", ACQ_TASK_STACK_SIZE, this,
+      ACQ_TASK_PRIORITY, &_task, ACQ_TASK_CORE);
+  if (created != pdPASS) {
+    _task = nullptr;
+    LOG_ERROR("Acquisition: failed to create task");
+    return false;
+  }
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = timerCallback;
+  timerArgs.arg = this;
+  timerArgs.dispatch_method = ESP_TIMER_TASK;
+  timerArgs.name = "acq_timer";
+  if (esp_timer_create(&timerArgs, &_timer) != ESP_OK) {
+    LOG_ERROR("Acquisition: failed to create timer");
+    vTaskDelete(_task);
+    _task = nullptr;
+    return false;
+  }
+
+  setPeriod(periodUs);
+
+  LOG_INFOF("Acquisition task: core %d, period %lu us", ACQ_TASK_CORE, (unsigned long)periodUs);
+  return true;
+}
+
+// ============================================================================
+// Change Sampling Period
+// ============================================================================
+void AcquisitionTask::setPeriod(uint32_t periodUs) {
+  if (_timer == nullptr) return;
+
+  esp_timer_stop(_timer);  // Not running on first call, error is harmless
+  portENTER_CRITICAL(&_statsMux);
+  _scheduler.setPeriod(periodUs);
+  portEXIT_CRITICAL(&_statsMux);
+  if (!_triggered) {
+    esp_timer_start_periodic(_timer, periodUs);
+  }
+}
+
+// ============================================================================
+// Triggered Mode
+// ============================================================================
+void AcquisitionTask::setTriggered(bool triggered) {
+  _triggered = triggered;
+  // Restarts the timer (and the deadline schedule) when leaving triggered mode
+  setPeriod(_scheduler.getPeriodUs());
+  LOG_INFOF("Acquisition: %s", triggered ? "triggered" : "free-running");
+}
+
+void AcquisitionTask::wake() {
+  if (_task != nullptr) xTaskNotifyGive(_task);
+}
+
+void IRAM_ATTR AcquisitionTask::wakeFromISR() {
+  if (_task == nullptr) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(_task, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+DeadlineScheduler::Stats AcquisitionTask::getStats() {
+  portENTER_CRITICAL(&_statsMux);
+  DeadlineScheduler::Stats stats = _scheduler.getStats();
+  portEXIT_CRITICAL(&_statsMux);
+  return stats;
+}
+
+void AcquisitionTask::resetStats() {
+  portENTER_CRITICAL(&_statsMux);
+  _scheduler.resetStats();
+  portEXIT_CRITICAL(&_statsMux);
+}
+
+// ============================================================================
+// Timer Callback (esp_timer task)
+// ============================================================================
+void AcquisitionTask::timerCallback(void* arg) {
+  AcquisitionTask* self = static_cast<AcquisitionTask*>(arg);
+  xTaskNotifyGive(self->_task);
+}
+
+// ============================================================================
+// Task Body
+// ============================================================================
+void AcquisitionTask::taskEntry(void* arg) {
+  static_cast<AcquisitionTask*>(arg)->run();
+}
+
+void AcquisitionTask::run() {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Triggered wakeups have no deadline to be measured against
+    if (_triggered) {
+      if (_callback != nullptr) _callback(_callbackArg);
+      continue;
+    }
+
+    portENTER_CRITICAL(&_statsMux);
+    uint32_t elapsed = _scheduler.onWake();
+    portEXIT_CRITICAL(&_statsMux);
+
+    // Missed deadlines are counted, not replayed: sample once per wakeup
+    if (elapsed > 0 && _callback != nullptr) {
+      _callback(_callbackArg);
+    }
+  }
+}
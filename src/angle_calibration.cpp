@@ -0,0 +1,135 @@
+#include "angle_calibration.h"
+#include <string.h>
+
+// ============================================================================
+// Calibrator
+// ============================================================================
+AngleCalibrator::AngleCalibrator() : _active(false), _complete(false) {
+  begin();
+  _active = false;
+}
+
+void AngleCalibrator::begin() {
+  memset(_sumPosition, 0, sizeof(_sumPosition));
+  memset(_sumTime, 0, sizeof(_sumTime));
+  memset(_count, 0, sizeof(_count));
+  _position = 0;
+  _startPosition = 0;
+  _lastAngle = 0;
+  _startUs = 0;
+  _endPosition = 0;
+  _endUs = 0;
+  _haveLast = false;
+  _started = false;
+  _complete = false;
+  _active = true;
+}
+
+void AngleCalibrator::addSample(uint16_t rawAngle, uint32_t timestampUs) {
+  if (!_active || _complete) return;
+  rawAngle &= 0x0FFF;
+  size_t bin = rawAngle / BIN_WIDTH;
+
+  if (!_started) {
+    // Start on the first bin boundary crossing so every bin is covered by
+    // exactly one full pass
+    if (!_haveLast) {
+      _haveLast = true;
+      _lastAngle = rawAngle;
+      return;
+    }
+    if (bin == (size_t)(_lastAngle / BIN_WIDTH)) {
+      _lastAngle = rawAngle;
+      return;
+    }
+    _started = true;
+    _position = rawAngle;
+    _startPosition = rawAngle;
+    _startUs = timestampUs;
+  } else {
+    int32_t delta = (int32_t)((rawAngle - _lastAngle) & 0x0FFF);
+    if (delta >= 2048) delta -= 4096;
+    _position += delta;
+  }
+  _lastAngle = rawAngle;
+
+  // Back at the start boundary after one revolution
+  int64_t span = _position - _startPosition;
+  if (span < 0) span = -span;
+  if (span >= 4096 - BIN_WIDTH / 2 && bin == (size_t)(_startPosition & 0x0FFF) / BIN_WIDTH) {
+    for (size_t i = 0; i < MODEL_POINTS; i++) {
+      if (_count[i] == 0) return;
+    }
+    _endPosition = _position;
+    _endUs = timestampUs - _startUs;
+    _complete = true;
+    return;
+  }
+
+  _sumPosition[bin] += _position;
+  _sumTime[bin] += (int64_t)(uint32_t)(timestampUs - _startUs);
+  _count[bin]++;
+}
+
+uint8_t AngleCalibrator::getProgress() const {
+  if (_complete) return 100;
+  int64_t span = _position - _startPosition;
+  if (span < 0) span = -span;
+  return (uint8_t)(span >= 4096 ? 99 : (span * 100) / 4096);
+}
+
+bool AngleCalibrator::finish(int16_t model[MODEL_POINTS]) {
+  if (!_complete) return false;
+  bool ok = computeModel(model);
+  _active = false;
+  return ok;
+}
+
+bool AngleCalibrator::computeModel(int16_t model[MODEL_POINTS]) const {
+  // Reference line position = avgP + slope * (t - avgT). The slope comes
+  // from the two crossings of the start boundary (same angle, so the same
+  // sensor error); a least-squares slope would be biased by the first
+  // harmonic over a single revolution. The offset makes the mean error zero.
+  if (_endUs == 0) return false;
+  double slope = (double)(_endPosition - _startPosition) / (double)_endUs;
+  double meanT[MODEL_POINTS];
+  double meanP[MODEL_POINTS];
+  double sumT = 0, sumP = 0;
+  for (size_t i = 0; i < MODEL_POINTS; i++) {
+    meanT[i] = (double)_sumTime[i] / _count[i];
+    meanP[i] = (double)_sumPosition[i] / _count[i];
+    sumT += meanT[i];
+    sumP += meanP[i];
+  }
+  double avgT = sumT / MODEL_POINTS;
+  double avgP = sumP / MODEL_POINTS;
+
+  // Correction = reference (fitted) - measured, in Q4 counts
+  for (size_t i = 0; i < MODEL_POINTS; i++) {
+    double reference = avgP + slope * (meanT[i] - avgT);
+    double correction = (reference - meanP[i]) * 16.0;
+    if (correction > 32767) correction = 32767;
+    if (correction < -32768) correction = -32768;
+    model[i] = (int16_t)(correction >= 0 ? correction + 0.5 : correction - 0.5);
+  }
+  return true;
+}
+
+// ============================================================================
+// Correction Table
+// ============================================================================
+// Linear interpolation between model points placed at bin centres, with
+// wraparound between the last and first point.
+void AngleCorrection::build(const int16_t model[AngleCalibrator::MODEL_POINTS],
+                            uint16_t* table) {
+  const uint16_t width = AngleCalibrator::BIN_WIDTH;
+  for (uint32_t raw = 0; raw < TABLE_SIZE; raw++) {
+    uint32_t offset = (raw - width / 2) & 0x0FFF;
+    size_t i0 = offset / width;
+    size_t i1 = (i0 + 1) % AngleCalibrator::MODEL_POINTS;
+    int32_t d = offset % width;
+    int32_t correctionQ4 = ((int32_t)model[i0] * (width - d) + (int32_t)model[i1] * d) / width;
+    int32_t corrected = ((int32_t)raw << 4) + correctionQ4 + 8;
+    table[raw] = (uint16_t)((corrected >> 4) & 0x0FFF);
+  }
+}
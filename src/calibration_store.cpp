@@ -0,0 +1,47 @@
+#include "calibration_store.h"
+#include "logger.h"
+
+static const char* const CALIBRATION_KEYS[CalibrationStore::SENSORS] = { "s1", "s2" };
+static const size_t MODEL_BYTES = AngleCalibrator::MODEL_POINTS * sizeof(int16_t);
+
+// ============================================================================
+// Constructor
+// ============================================================================
+CalibrationStore::CalibrationStore() : _open(false) {
+}
+
+// ============================================================================
+// Open Namespace
+// ============================================================================
+bool CalibrationStore::begin() {
+  _open = _prefs.begin("calib", false);
+  if (!_open) {
+    LOG_ERROR("Calibration store: failed to open NVS");
+  }
+  return _open;
+}
+
+// ============================================================================
+// Load / Save / Erase
+// ============================================================================
+bool CalibrationStore::load(uint8_t sensor, int16_t model[AngleCalibrator::MODEL_POINTS]) {
+  if (!_open || sensor >= SENSORS) return false;
+  if (_prefs.getBytesLength(CALIBRATION_KEYS[sensor]) != MODEL_BYTES) return false;
+  return _prefs.getBytes(CALIBRATION_KEYS[sensor], model, MODEL_BYTES) == MODEL_BYTES;
+}
+
+bool CalibrationStore::save(uint8_t sensor, const int16_t model[AngleCalibrator::MODEL_POINTS]) {
+  if (!_open || sensor >= SENSORS) return false;
+  bool ok = _prefs.putBytes(CALIBRATION_KEYS[sensor], model, MODEL_BYTES) == MODEL_BYTES;
+  if (ok) {
+    LOG_INFOF("Calibration store: sensor %u saved", sensor + 1);
+  } else {
+    LOG_ERRORF("Calibration store: failed to save sensor %u", sensor + 1);
+  }
+  return ok;
+}
+
+void CalibrationStore::erase(uint8_t sensor) {
+  if (!_open || sensor >= SENSORS) return;
+  _prefs.remove(CALIBRATION_KEYS[sensor]);
+}
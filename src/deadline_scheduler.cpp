@@ -0,0 +1,88 @@
+#include "deadline_scheduler.h"
+#include <string.h>
+
+const uint32_t DeadlineScheduler::HISTOGRAM_EDGES_US[DeadlineScheduler::HISTOGRAM_BINS - 1] = {
+  50, 100, 200, 500, 1000, 2000, 5000
+};
+
+// ============================================================================
+// Constructor
+// ============================================================================
+DeadlineScheduler::DeadlineScheduler(Clock& clock, uint32_t periodUs, uint32_t lateThresholdUs)
+  : _clock(clock), _periodUs(periodUs > 0 ? periodUs : 1),
+    _lateThresholdUs(lateThresholdUs), _nextDeadlineUs(0), _lastLatenessUs(0) {
+  resetStats();
+}
+
+// ============================================================================
+// Start Schedule
+// ============================================================================
+void DeadlineScheduler::start() {
+  _nextDeadlineUs = _clock.nowUs() + _periodUs;
+}
+
+// ============================================================================
+// Change Period
+// ============================================================================
+void DeadlineScheduler::setPeriod(uint32_t periodUs) {
+  _periodUs = periodUs > 0 ? periodUs : 1;
+  start();
+}
+
+// ============================================================================
+// Account for a Wakeup
+// ============================================================================
+uint32_t DeadlineScheduler::onWake() {
+  int64_t now = _clock.nowUs();
+  int64_t lateness = now - _nextDeadlineUs;
+
+  // Timer wakeups may land slightly early; anything more than half a
+  // period ahead is not for this deadline
+  if (lateness < -(int64_t)(_periodUs / 2)) {
+    return 0;
+  }
+  if (lateness < 0) {
+    lateness = 0;
+  }
+
+  // Deadlines that passed entirely before this wakeup
+  uint32_t missed = (uint32_t)(lateness / _periodUs);
+  uint32_t elapsed = missed + 1;
+  _nextDeadlineUs += (int64_t)elapsed * _periodUs;
+
+  // Lateness relative to the most recent deadline
+  uint32_t latenessUs = (uint32_t)(lateness - (int64_t)missed * _periodUs);
+  _lastLatenessUs = latenessUs;
+
+  _stats.wakeups++;
+  _stats.missedDeadlines += missed;
+  if (missed > 0 || latenessUs > _lateThresholdUs) {
+    _stats.lateCount++;
+  }
+  uint32_t totalLateness = lateness > UINT32_MAX ? UINT32_MAX : (uint32_t)lateness;
+  if (totalLateness > _stats.maxLatenessUs) {
+    _stats.maxLatenessUs = totalLateness;
+  }
+  _stats.histogram[histogramBin(totalLateness)]++;
+
+  return elapsed;
+}
+
+// ============================================================================
+// Reset Statistics
+// ============================================================================
+void DeadlineScheduler::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// Histogram Bin
+// ============================================================================
+size_t DeadlineScheduler::histogramBin(uint32_t latenessUs) {
+  for (size_t i = 0; i < HISTOGRAM_BINS - 1; i++) {
+    if (latenessUs < HISTOGRAM_EDGES_US[i]) {
+      return i;
+    }
+  }
+  return HISTOGRAM_BINS - 1;
+}
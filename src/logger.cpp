@@ -5,11 +5,25 @@
 // Global logger instance
 Logger logger;
 
-Logger::Logger() : maxEntries(LOG_BUFFER_SIZE) {}
+// The mutex exists before the first log() call, which may come before begin()
+Logger::Logger() : maxEntries(LOG_BUFFER_SIZE), entryCount(0),
+                   mutex(xSemaphoreCreateMutex()) {}
 
 void Logger::begin(size_t maxEntries) {
+  lock();
   this->maxEntries = maxEntries;
   entries.reserve(maxEntries);
+  unlock();
+}
+
+// A mutex rather than a critical section: storing and copying entries
+// allocates
+void Logger::lock() const {
+  if (mutex != nullptr) xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void Logger::unlock() const {
+  if (mutex != nullptr) xSemaphoreGive(mutex);
 }
 
 void Logger::log(LogLevel level, const String& message) {
@@ -30,13 +44,40 @@ void Logger::log(LogLevel level, const String& message) {
     entry.message = message;
     
     // Add to circular buffer
+    lock();
     if (entries.size() >= maxEntries) {
       entries.erase(entries.begin());  // Remove oldest entry
     }
     entries.push_back(entry);
+    entryCount++;
+    unlock();
   }
 }
 
+uint32_t Logger::getEntryCount() const {
+  lock();
+  uint32_t count = entryCount;
+  unlock();
+  return count;
+}
+
+void Logger::getEntryRange(uint32_t& first, uint32_t& end) const {
+  lock();
+  end = entryCount;
+  first = entryCount - entries.size();
+  unlock();
+}
+
+bool Logger::copyEntry(uint32_t& number, LogEntry& entry) const {
+  lock();
+  uint32_t oldest = entryCount - entries.size();
+  if ((int32_t)(number - oldest) < 0) number = oldest;
+  bool stored = (int32_t)(entryCount - number) > 0;
+  if (stored) entry = entries[number - oldest];
+  unlock();
+  return stored;
+}
+
 String Logger::formatTimestamp(unsigned long millis) const {
   unsigned long totalSeconds = millis / 1000;
   unsigned long ms = millis % 1000;
@@ -130,28 +171,35 @@ void Logger::errorf(const char* format, ...) {
 String Logger::getEntriesJSON() const {
   String json = "[";
   
+  lock();
   for (size_t i = 0; i < entries.size(); i++) {
     if (i > 0) json += ",";
-    
-    const LogEntry& entry = entries[i];
-    String timestamp = formatTimestamp(entry.timestamp);
-    String levelName = getLevelName(entry.level);
-    
-    // Escape quotes in message
-    String escapedMessage = entry.message;
-    escapedMessage.replace("\"", "\\\"");
-    
-    json += "{";
-    json += "\"timestamp\":\"" + timestamp + "\",";
-    json += "\"level\":\"" + String(levelName) + "\",";
-    json += "\"message\":\"" + escapedMessage + "\"";
-    json += "}";
+    json += getEntryJSON(entries[i]);
   }
+  unlock();
   
   json += "]";
   return json;
 }
 
+String Logger::getEntryJSON(const LogEntry& entry) const {
+  String timestamp = formatTimestamp(entry.timestamp);
+  String levelName = getLevelName(entry.level);
+  
+  // Escape quotes in message
+  String escapedMessage = entry.message;
+  escapedMessage.replace("\"", "\\\"");
+  
+  String json = "{";
+  json += "\"timestamp\":\"" + timestamp + "\",";
+  json += "\"level\":\"" + levelName + "\",";
+  json += "\"message\":\"" + escapedMessage + "\"";
+  json += "}";
+  return json;
+}
+
 void Logger::clear() {
+  lock();
   entries.clear();
+  unlock();
 }
@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include <esp_system.h>
 #include "config.h"
 #include "logger.h"
 #include "rgb_led.h"
@@ -6,6 +7,13 @@
 #include "uart_protocol.h"
 #include "web_server.h"
 #include "ota_update.h"
+#include "acquisition_task.h"
+#include "sensor_array.h"
+#include "position_store.h"
+#include "calibration_store.h"
+#include "filter_config.h"
+#include "trigger_sampler.h"
+#include "network_task.h"
 
 // ============================================================================
 // Global Objects
@@ -16,11 +24,254 @@ SensorManager sensors;
 UartProtocol uart(Serial1);
 WebServerManager webServer;
 OTAUpdate ota;
+AcquisitionTask acquisition;
+NetworkTask network;
+PositionStore positionStore;
+CalibrationStore calibrationStore;
+Sensor1Filter sensor1Filter;
+Sensor2Filter sensor2Filter;
+TriggerSampler trigger(SAMPLE_TRIGGER_HOLDOFF_US);
+#if SENSOR_ARRAY_ENABLED
+SensorArray sensorArray;
+const SensorArray::SensorConfig sensorArrayLayout[] = SENSOR_ARRAY_LAYOUT;
+#endif
 
 // ============================================================================
 // Global Variables
 // ============================================================================
-unsigned long lastSampleTime = 0;
+unsigned long lastStatsLogTime = 0;
+
+// Output settings changed at runtime by UART commands
+uint16_t outputRateHz = SAMPLE_RATE_HZ;
+uint8_t batchSamples = UART_BATCH_SAMPLES;
+
+// ============================================================================
+// Calibration Hooks (web /calibrate endpoint)
+// ============================================================================
+bool startCalibration(uint8_t sensor) {
+  return sensors.startCalibration(sensor);
+}
+
+WebServerManager::CalibrationStatus getCalibrationStatus(uint8_t sensor) {
+  WebServerManager::CalibrationStatus status;
+  status.active = sensors.isCalibrating(sensor);
+  status.calibrated = sensors.isCalibrated(sensor);
+  status.progress = sensors.getCalibrationProgress(sensor);
+  return status;
+}
+
+#if MULTI_TURN_PERSIST
+// ============================================================================
+// Position Flush on Software Restart (OTA, esp_restart)
+// ============================================================================
+void flushPositions() {
+  const int64_t positions[2] = { sensors.getPosition1(), sensors.getPosition2() };
+  positionStore.flush(positions, 2);
+}
+#endif
+
+// ============================================================================
+// UART Command Handler (runs in the acquisition task, see serviceCommands)
+// ============================================================================
+static void putU32(uint8_t* out, uint32_t value) {
+  for (uint8_t b = 0; b < 4; b++) out[b] = (value >> (8 * b)) & 0xFF;
+}
+
+uint8_t onCommand(const Command::Request& request, uint8_t* result, uint8_t& resultLength,
+                  void* arg) {
+  const uint8_t* args = request.args;
+  switch (request.id) {
+    case Command::SET_RATE: {
+      if (request.length != 2) return Command::BAD_LENGTH;
+      uint16_t rate = (uint16_t)(args[0] | (args[1] << 8));
+      uint32_t acqRate = (uint32_t)rate * sensors.getOversampling();
+      if (rate == 0 || acqRate > MAX_ACQ_RATE_HZ) return Command::BAD_VALUE;
+      outputRateHz = rate;
+      acquisition.setPeriod(1000000UL / acqRate);
+      sensors.setAcquisitionRate(acqRate);
+      if (uart.isBatching()) {
+        uart.setBatching(batchSamples, 1000000UL / rate, UART_BATCH_FLUSH_US);
+      }
+      LOG_INFOF("Command: sample rate %u Hz", rate);
+      return Command::OK;
+    }
+
+    case Command::SET_SENSORS:
+      if (request.length != 1) return Command::BAD_LENGTH;
+      if (args[0] & ~0x03) return Command::BAD_VALUE;
+      sensors.setSensorEnabled(0, args[0] & 0x01);
+      sensors.setSensorEnabled(1, args[0] & 0x02);
+      return Command::OK;
+
+    case Command::SET_OUTPUT:
+      if (request.length != 2) return Command::BAD_LENGTH;
+      if ((args[0] != 1 && args[0] != 2) || args[1] > UART_BATCH_MAX_SAMPLES) {
+        return Command::BAD_VALUE;
+      }
+      // Triggered replies go out one by one
+      if (acquisition.isTriggered() && args[1] > 1) return Command::BAD_VALUE;
+      uart.setProtocolVersion(args[0]);
+      batchSamples = args[1];
+      uart.setBatching(batchSamples, 1000000UL / outputRateHz, UART_BATCH_FLUSH_US);
+      return Command::OK;
+
+    case Command::GET_COUNTERS: {
+      if (request.length != 0) return Command::BAD_LENGTH;
+      DeadlineScheduler::Stats acq = acquisition.getStats();
+      const UartTxQueue::Ring::Stats& tx = uart.getTxQueue().getStats();
+      const ProtocolV2::Decoder::Stats& rx = uart.getCommandParser().getFrameStats();
+      const uint32_t counters[] = {
+        acq.wakeups, acq.missedDeadlines, acq.maxLatenessUs,
+        tx.framesQueued, tx.framesDropped,
+        sensors.getHealth1().errors, sensors.getHealth2().errors,
+        rx.frames, rx.crcErrors + rx.framingErrors + rx.overruns
+      };
+      const uint8_t count = sizeof(counters) / sizeof(counters[0]);
+      for (uint8_t i = 0; i < count; i++) putU32(result + 4 * i, counters[i]);
+      resultLength = 4 * count;
+      return Command::OK;
+    }
+
+    case Command::PING:
+      // Clock sync exchange: echo the receiver's time, add ours at arrival
+      // and at reply (the ACK is queued right after this returns)
+      if (request.length != 4) return Command::BAD_LENGTH;
+      for (uint8_t b = 0; b < 4; b++) result[b] = args[b];
+      putU32(result + 4, request.receivedUs);
+      putU32(result + 8, (uint32_t)esp_timer_get_time());
+      resultLength = 12;
+      return Command::OK;
+
+    default:
+      return Command::UNKNOWN_COMMAND;
+  }
+}
+
+// ============================================================================
+// Host-Triggered Sampling (SAMPLE_TRIGGER)
+// ============================================================================
+// GPIO edge: timestamp and wake the acquisition task
+void IRAM_ATTR onTriggerEdge() {
+  if (trigger.onTrigger((uint32_t)esp_timer_get_time())) {
+    acquisition.wakeFromISR();
+  }
+}
+
+// UART byte received (UART event task): wake the acquisition task to parse it
+void onUartReceive(void* arg) {
+  acquisition.wake();
+}
+
+// Answer a pending trigger: read both sensors and send at once
+void sendTriggeredSample() {
+  uint32_t triggerUs;
+  if (!trigger.begin(triggerUs)) {
+    return;
+  }
+
+  SensorManager::AngleSample sample;
+  sensors.sampleTriggered(sample);
+  uart.transmit(sample.angle1, sample.angle2, sample.time1Us, sample.time2Us);
+  trigger.complete((uint32_t)esp_timer_get_time());
+
+  if (webServer.isEnabled()) {
+    webServer.updateSensorData(sample.angle1, sample.angle2, sample.time1Us, sample.time2Us);
+    webServer.updateTurnData(sensors.getTurns1(), sensors.getTurns2());
+    webServer.publishSensorData();
+  }
+}
+
+// ============================================================================
+// Sample Callback (runs in the acquisition task every ACQ_INTERVAL_US, or on
+// every trigger / received byte in triggered mode)
+// ============================================================================
+void onSample(void* arg) {
+  // Host commands (bounded number of bytes per tick)
+  size_t triggers = uart.serviceCommands(UART_RX_BYTES_PER_TICK);
+
+#if SAMPLE_TRIGGER
+  // The trigger bytes arrived no later than the last receive event. Only
+  // one reply goes out per wake-up; the rest of a burst are overruns.
+  if (SAMPLE_TRIGGER == 1 && triggers > 0) {
+    trigger.onTrigger(uart.getLastRxUs());
+    trigger.addOverruns(triggers - 1);
+  }
+  sendTriggeredSample();
+  return;
+#else
+  (void)triggers;
+#endif
+
+#if SENSOR_ARRAY_ENABLED
+  // Sensor array: read all N sensors (both buses in parallel)
+  sensorArray.readAll();
+  uart.transmitArray(sensorArray.getAngles(), sensorArray.getCount());
+#if UART_SEND_TIMESTAMPS
+  uart.transmitArrayTimestamps(sensorArray.getTimes(), sensorArray.getCount());
+#endif
+  if (webServer.isEnabled()) {
+    webServer.updateSensorArray(sensorArray.getAngles(), sensorArray.getTimes(),
+                                sensorArray.getCount());
+    webServer.publishSensorData();
+  }
+  return;
+#endif
+
+  // Read angles from both sensors (both buses in parallel); with
+  // oversampling only every OVERSAMPLE_FACTOR-th tick produces an output
+  SensorManager::AngleSample sample;
+  if (!sensors.sampleOversampled(sample)) {
+    return;
+  }
+
+  // Per-sensor filter chains (filter_config.h)
+  sample.angle1 = sensor1Filter.process(sample.angle1);
+  sample.angle2 = sensor2Filter.process(sample.angle2);
+  
+  // Observer estimates (updated at the acquisition rate)
+  SensorManager::Motion motion1 = sensors.getMotion1();
+  SensorManager::Motion motion2 = sensors.getMotion2();
+
+  // Transmit data via UART (extra frames follow only when the angle packet
+  // was sent, so change-driven mode gates them too)
+  if (uart.transmit(sample.angle1, sample.angle2, sample.time1Us, sample.time2Us)) {
+#if UART_SEND_TIMESTAMPS
+    const uint32_t times[2] = { sample.time1Us, sample.time2Us };
+    uart.transmitTimestamps(times, 2);
+#endif
+#if UART_SEND_POSITION
+    const int64_t positions[2] = { sensors.getPosition1(), sensors.getPosition2() };
+    uart.transmitPositions(positions, 2);
+#endif
+#if UART_SEND_MOTION
+    const uint16_t angles[2] = { motion1.angle, motion2.angle };
+    const int32_t velocities[2] = { motion1.velocity, motion2.velocity };
+    const int32_t accelerations[2] = { motion1.acceleration, motion2.acceleration };
+    uart.transmitMotion(angles, velocities, accelerations, 2);
+#endif
+  }
+  
+  // Update web server with new sensor data
+  if (webServer.isEnabled()) {
+    webServer.updateSensorData(sample.angle1, sample.angle2, sample.time1Us, sample.time2Us);
+    webServer.updateMotionData(motion1.velocity, motion2.velocity,
+                               motion1.acceleration, motion2.acceleration);
+    webServer.updateTurnData(sensors.getTurns1(), sensors.getTurns2());
+    webServer.publishSensorData();
+  }
+}
+
+// ============================================================================
+// Network Service (runs in the network task on NET_TASK_CORE, or in loop()
+// if the task could not be created)
+// ============================================================================
+void serviceNetwork(void* arg) {
+  if (webServer.isEnabled()) {
+    webServer.handleClient();
+    webServer.broadcastSensorData();
+  }
+  ota.handle();
+}
 
 // ============================================================================
 // Setup Function
@@ -49,30 +300,113 @@ void setup() {
 
   // Initialize UART for data transmission
   uart.begin(SERIAL_BAUD_RATE, SERIAL_TX_PIN, SERIAL_RX_PIN);
+  uart.setProtocolVersion(UART_PROTOCOL_VERSION);
+#if UART_TX_QUEUE
+  uart.beginTxQueue(UART_TX_OVERFLOW);
+#endif
+#if UART_COMMANDS_ENABLED
+  uart.setCommandHandler(onCommand, nullptr);
+#endif
+#if UART_BATCH_SAMPLES > 1 && !SAMPLE_TRIGGER
+  uart.setBatching(UART_BATCH_SAMPLES, SAMPLE_INTERVAL_US, UART_BATCH_FLUSH_US);
+#endif
+#if OUTPUT_CHANGE_DRIVEN && !SAMPLE_TRIGGER
+  uart.setChangeDriven(true, OUTPUT_DEADBAND_1, OUTPUT_DEADBAND_2, OUTPUT_HEARTBEAT_MS);
+#endif
 
   // Initialize I2C buses and sensors
   sensors.begin(I2C_BUS0_SDA_PIN, I2C_BUS0_SCL_PIN, I2C_BUS0_FREQ,
                 I2C_BUS1_SDA_PIN, I2C_BUS1_SCL_PIN, I2C_BUS1_FREQ);
 
+#if SENSOR_BACKEND_PWM
+  // Switch to PWM capture (no I2C traffic per sample)
+  sensors.beginPwmBackend(PWM_SENSOR1_PIN, PWM_SENSOR2_PIN, PWM_FREQ_SETTING);
+#endif
+
+  // Load stored nonlinearity calibrations
+  if (calibrationStore.begin()) {
+    for (uint8_t i = 0; i < CalibrationStore::SENSORS; i++) {
+      int16_t model[AngleCalibrator::MODEL_POINTS];
+      if (calibrationStore.load(i, model) && sensors.applyCalibration(i, model)) {
+        LOG_INFOF("Calibration: sensor %u loaded", i + 1);
+      }
+    }
+  }
+
+#if MULTI_TURN_PERSIST
+  // Resume multi-turn positions saved before the last reset
+  positionStore.begin(MULTI_TURN_SAVE_DELTA, MULTI_TURN_REST_MS);
+  for (uint8_t i = 0; i < PositionStore::SENSORS; i++) {
+    int64_t saved;
+    if (positionStore.load(i, saved)) {
+      sensors.restorePosition(i, saved);
+    }
+  }
+  esp_register_shutdown_handler(flushPositions);
+#endif
+
+#if SENSOR_ARRAY_ENABLED
+  // Probe multiplexed sensors (uses the buses initialized above)
+  sensorArray.begin(sensorArrayLayout,
+                    sizeof(sensorArrayLayout) / sizeof(sensorArrayLayout[0]));
+#endif
+
   // Initialize WiFi and web server (only if configured)
   webServer.begin(WIFI_SSID, WIFI_PASSWORD, WEB_SERVER_PORT);
 
+  webServer.setCalibrationHandlers(startCalibration, getCalibrationStatus);
+#if OUTPUT_CHANGE_DRIVEN
+  webServer.setChangeDriven(true, OUTPUT_DEADBAND_1, OUTPUT_DEADBAND_2, OUTPUT_HEARTBEAT_MS);
+#endif
+
   // Initialize OTA updates (only if WiFi is connected)
   ota.begin("esp32-as5600", "esp32-as5600");
 
   // Set status LED based on sensor connection (after WiFi/OTA to avoid being overwritten)
-  if (sensors.areBothConnected()) {
+#if SENSOR_ARRAY_ENABLED
+  bool allConnected = sensorArray.getConnectedCount() == sensorArray.getCount();
+  bool anyConnected = sensorArray.getConnectedCount() > 0;
+#else
+  bool allConnected = sensors.areBothConnected();
+  bool anyConnected = sensors.isAnyConnected();
+#endif
+  if (allConnected) {
     led.setStatus(RgbLed::OK);
-  } else if (sensors.isAnyConnected()) {
+  } else if (anyConnected) {
     led.setStatus(RgbLed::PARTIAL);
   } else {
     led.setStatus(RgbLed::ERROR);
   }
 
   LOG_INFOF("Sample rate: %d Hz (%d ms interval)", SAMPLE_RATE_HZ, SAMPLE_INTERVAL_MS);
+  if (OVERSAMPLE_FACTOR > 1) {
+    sensors.setOversampling(OVERSAMPLE_FACTOR);
+  }
   LOG_INFO("Starting main loop...");
 
-  lastSampleTime = millis();
+#if SAMPLE_TRIGGER
+  // Sampling driven by the receiver; received bytes wake the task too so
+  // commands are still serviced
+  acquisition.setTriggered(true);
+#endif
+
+  // Start timer-driven sampling
+  acquisition.begin(ACQ_INTERVAL_US, onSample, nullptr);
+
+#if SAMPLE_TRIGGER
+  uart.setReceiveHandler(onUartReceive, nullptr);
+#if SAMPLE_TRIGGER == 2
+  pinMode(SAMPLE_TRIGGER_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(SAMPLE_TRIGGER_PIN), onTriggerEdge, SAMPLE_TRIGGER_EDGE);
+#endif
+  LOG_INFOF("Triggered sampling: %s", SAMPLE_TRIGGER == 1 ? "UART 0x00" : "GPIO edge");
+#endif
+
+  // Web server, WebSocket and OTA off the acquisition core
+  if (webServer.isEnabled() || ota.isEnabled()) {
+    network.begin(serviceNetwork, nullptr);
+  }
+  lastStatsLogTime = millis();
 }
 
 // ============================================================================
@@ -81,31 +415,120 @@ void setup() {
 void loop() {
   unsigned long currentTime = millis();
 
-  // Check if it's time to sample
-  if (currentTime - lastSampleTime >= SAMPLE_INTERVAL_MS) {
-    lastSampleTime = currentTime;
-    
-    // Read angles from both sensors
-    uint16_t angle1, angle2;
-    sensors.readAngles(angle1, angle2);
-    
-    // Transmit data via UART
-    uart.transmit(angle1, angle2);
-    
-    // Update web server with new sensor data
+  // Report acquisition timing (sampling itself runs in the acquisition task)
+  if (currentTime - lastStatsLogTime >= ACQ_STATS_LOG_MS) {
+    lastStatsLogTime = currentTime;
+    DeadlineScheduler::Stats stats = acquisition.getStats();
+    LOG_DEBUGF("ACQ: wakeups=%lu late=%lu missed=%lu max=%lu us "
+               "hist=[%lu %lu %lu %lu %lu %lu %lu %lu]",
+               (unsigned long)stats.wakeups, (unsigned long)stats.lateCount,
+               (unsigned long)stats.missedDeadlines, (unsigned long)stats.maxLatenessUs,
+               (unsigned long)stats.histogram[0], (unsigned long)stats.histogram[1],
+               (unsigned long)stats.histogram[2], (unsigned long)stats.histogram[3],
+               (unsigned long)stats.histogram[4], (unsigned long)stats.histogram[5],
+               (unsigned long)stats.histogram[6], (unsigned long)stats.histogram[7]);
+#if SAMPLE_TRIGGER
+    const TriggerSampler::Stats& trig = trigger.getStats();
+    LOG_DEBUGF("TRIG: triggers=%lu responses=%lu overruns=%lu ignored=%lu "
+               "latency min/mean/max=%lu/%lu/%lu us hist=[%lu %lu %lu %lu %lu %lu %lu %lu]",
+               (unsigned long)trig.triggers, (unsigned long)trig.responses,
+               (unsigned long)trig.overruns, (unsigned long)trig.ignored,
+               (unsigned long)(trig.responses > 0 ? trig.minLatencyUs : 0),
+               (unsigned long)trigger.getMeanLatencyUs(), (unsigned long)trig.maxLatencyUs,
+               (unsigned long)trig.histogram[0], (unsigned long)trig.histogram[1],
+               (unsigned long)trig.histogram[2], (unsigned long)trig.histogram[3],
+               (unsigned long)trig.histogram[4], (unsigned long)trig.histogram[5],
+               (unsigned long)trig.histogram[6], (unsigned long)trig.histogram[7]);
+#endif
+    const SensorManager::FastReader::Stats& bus0 = sensors.getBusStats1();
+    const SensorManager::FastReader::Stats& bus1 = sensors.getBusStats2();
+    LOG_DEBUGF("I2C: bus0 tx=%lu bytes=%lu err=%lu, bus1 tx=%lu bytes=%lu err=%lu",
+               (unsigned long)bus0.transactions, (unsigned long)bus0.bytesOnBus,
+               (unsigned long)bus0.errors, (unsigned long)bus1.transactions,
+               (unsigned long)bus1.bytesOnBus, (unsigned long)bus1.errors);
+    const SensorHealth::Stats& health1 = sensors.getHealth1();
+    const SensorHealth::Stats& health2 = sensors.getHealth2();
+    LOG_DEBUGF("Health: s1 %s err=%lu drop=%lu probe=%lu rec=%lu clr=%lu, "
+               "s2 %s err=%lu drop=%lu probe=%lu rec=%lu clr=%lu",
+               sensors.isSensor1Connected() ? "up" : "down",
+               (unsigned long)health1.errors, (unsigned long)health1.dropouts,
+               (unsigned long)health1.probes, (unsigned long)health1.recoveries,
+               (unsigned long)health1.busClears,
+               sensors.isSensor2Connected() ? "up" : "down",
+               (unsigned long)health2.errors, (unsigned long)health2.dropouts,
+               (unsigned long)health2.probes, (unsigned long)health2.recoveries,
+               (unsigned long)health2.busClears);
+    if (uart.getTxQueue().isRunning()) {
+      const UartTxQueue::Ring::Stats& tx = uart.getTxQueue().getStats();
+      LOG_DEBUGF("UART TX: queued %lu frames/%lu B, sent %lu B, dropped %lu/%lu B, "
+                 "oversize %lu, peak %lu/%u frames",
+                 (unsigned long)tx.framesQueued, (unsigned long)tx.bytesQueued,
+                 (unsigned long)uart.getTxQueue().getBytesSent(),
+                 (unsigned long)tx.framesDropped, (unsigned long)tx.bytesDropped,
+                 (unsigned long)tx.framesOversize, (unsigned long)tx.peakFrames,
+                 (unsigned)UartTxQueue::SLOTS);
+    }
+#if OUTPUT_CHANGE_DRIVEN
+    const UartProtocol::OutputGate::Stats& uartOut = uart.getOutputStats();
+    const WebServerManager::OutputGate::Stats& webOut = webServer.getOutputStats();
+    LOG_DEBUGF("OUT: uart sent=%lu hb=%lu skipped=%lu saved=%lu B, "
+               "ws sent=%lu hb=%lu skipped=%lu saved=%lu B",
+               (unsigned long)uartOut.sent, (unsigned long)uartOut.heartbeats,
+               (unsigned long)uartOut.suppressed, (unsigned long)uartOut.bytesSaved,
+               (unsigned long)webOut.sent, (unsigned long)webOut.heartbeats,
+               (unsigned long)webOut.suppressed, (unsigned long)webOut.bytesSaved);
+#endif
     if (webServer.isEnabled()) {
-      webServer.updateSensorData(angle1, angle2);
+      const WebServerManager::Scheduler::Stats& ws = webServer.getScheduler().getStats();
+      LOG_DEBUGF("WS: clients %u, sent %lu, congested %lu, decimated %lu/%lu, "
+                 "dropped %lu, idle %lu, snapshot misses %lu",
+                 (unsigned)webServer.getScheduler().getConnectedCount(),
+                 (unsigned long)ws.sent, (unsigned long)ws.congested,
+                 (unsigned long)ws.decimations, (unsigned long)ws.recoveries,
+                 (unsigned long)ws.dropped, (unsigned long)ws.idle,
+                 (unsigned long)webServer.getSnapshotMisses());
+    }
+    if (network.isRunning()) {
+      const NetworkTask::Stats& net = network.getStats();
+      LOG_DEBUGF("NET: core %d, service last %lu us, max %lu us",
+                 NET_TASK_CORE, (unsigned long)net.lastServiceUs,
+                 (unsigned long)net.maxServiceUs);
+      network.resetStats();
+    }
+    if (sensors.getBackend() == SensorManager::BACKEND_PWM) {
+      const PwmCapture& pwm = sensors.getPwmCapture();
+      LOG_DEBUGF("PWM: latency %lu/%lu us (max %lu/%lu), frames %lu/%lu, "
+                 "glitches %lu/%lu, rejected %lu/%lu",
+                 (unsigned long)pwm.getLatencyUs(0), (unsigned long)pwm.getLatencyUs(1),
+                 (unsigned long)pwm.getMaxLatencyUs(0), (unsigned long)pwm.getMaxLatencyUs(1),
+                 (unsigned long)pwm.getDecoderStats(0).frames,
+                 (unsigned long)pwm.getDecoderStats(1).frames,
+                 (unsigned long)pwm.getDecoderStats(0).glitches,
+                 (unsigned long)pwm.getDecoderStats(1).glitches,
+                 (unsigned long)pwm.getDecoderStats(0).rejected,
+                 (unsigned long)pwm.getDecoderStats(1).rejected);
     }
   }
 
-  // Handle web server clients and broadcast WebSocket data
-  if (webServer.isEnabled()) {
-    webServer.handleClient();
-    webServer.broadcastSensorData();
+  // Finish completed calibration captures and store them
+  for (uint8_t i = 0; i < CalibrationStore::SENSORS; i++) {
+    int16_t model[AngleCalibrator::MODEL_POINTS];
+    if (sensors.serviceCalibration(i, model)) {
+      calibrationStore.save(i, model);
+    }
   }
 
-  // Handle OTA updates
-  ota.handle();
+#if MULTI_TURN_PERSIST
+  // Save multi-turn positions after travel or at rest (flash writes stay
+  // out of the acquisition task)
+  const int64_t positions[2] = { sensors.getPosition1(), sensors.getPosition2() };
+  positionStore.service(positions, 2);
+#endif
+
+  // Network handling lives in the network task; fall back to loop()
+  if (!network.isRunning()) {
+    serviceNetwork(nullptr);
+  }
 
   // Small delay to prevent watchdog issues
   delay(1);
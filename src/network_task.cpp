@@ -0,0 +1,54 @@
+#include "network_task.h"
+#include "config.h"
+#include "logger.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+NetworkTask::NetworkTask() : _task(nullptr), _callback(nullptr), _callbackArg(nullptr) {
+  resetStats();
+}
+
+// ============================================================================
+// Create Task
+// ============================================================================
+bool NetworkTask::begin(ServiceCallback callback, void* arg) {
+  _callback = callback;
+  _callbackArg = arg;
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      taskEntry, "network", NET_TASK_STACK_SIZE, this,
+      NET_TASK_PRIORITY, &_task, NET_TASK_CORE);
+  if (created != pdPASS) {
+    _task = nullptr;
+    LOG_ERROR("Network task: failed to create task, servicing from loop()");
+    return false;
+  }
+
+  LOG_INFOF("Network task: core %d, every %d ms", NET_TASK_CORE, NET_TASK_INTERVAL_MS);
+  return true;
+}
+
+// ============================================================================
+// Task Body
+// ============================================================================
+void NetworkTask::taskEntry(void* arg) {
+  static_cast<NetworkTask*>(arg)->run();
+}
+
+void NetworkTask::run() {
+  const TickType_t interval = pdMS_TO_TICKS(NET_TASK_INTERVAL_MS) > 0
+                                ? pdMS_TO_TICKS(NET_TASK_INTERVAL_MS) : 1;
+  for (;;) {
+    uint32_t start = micros();
+    if (_callback != nullptr) _callback(_callbackArg);
+    uint32_t elapsed = micros() - start;
+
+    _stats.iterations++;
+    _stats.lastServiceUs = elapsed;
+    if (elapsed > _stats.maxServiceUs) _stats.maxServiceUs = elapsed;
+
+    // Always block for at least a tick (lets the idle task feed the watchdog)
+    vTaskDelay(interval);
+  }
+}
@@ -0,0 +1,97 @@
+#include "position_store.h"
+#include "logger.h"
+
+static const char* const POSITION_KEYS[PositionStore::SENSORS] = { "pos1", "pos2" };
+
+// ============================================================================
+// Constructor
+// ============================================================================
+PositionStore::PositionStore()
+  : _minDelta(0), _restMs(0), _writes(0), _open(false) {
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    _stored[i] = 0;
+    _valid[i] = false;
+    _lastSeen[i] = 0;
+    _stillSince[i] = 0;
+    _restSaved[i] = true;
+  }
+}
+
+static int64_t distance(int64_t a, int64_t b) {
+  return a >= b ? a - b : b - a;
+}
+
+// ============================================================================
+// Open Namespace and Load
+// ============================================================================
+void PositionStore::begin(uint32_t minDelta, uint32_t restMs) {
+  _minDelta = minDelta;
+  _restMs = restMs;
+
+  _open = _prefs.begin("multiturn", false);
+  if (!_open) {
+    LOG_ERROR("Position store: failed to open NVS");
+    return;
+  }
+
+  for (uint8_t i = 0; i < SENSORS; i++) {
+    _valid[i] = _prefs.isKey(POSITION_KEYS[i]);
+    if (_valid[i]) {
+      _stored[i] = _prefs.getLong64(POSITION_KEYS[i], 0);
+      LOG_INFOF("Position store: sensor %u restored %lld counts", i + 1,
+                (long long)_stored[i]);
+    }
+    _lastSeen[i] = _stored[i];
+  }
+}
+
+bool PositionStore::load(uint8_t sensor, int64_t& position) const {
+  if (sensor >= SENSORS || !_valid[sensor]) return false;
+  position = _stored[sensor];
+  return true;
+}
+
+// ============================================================================
+// Travel and Rest Saves
+// ============================================================================
+void PositionStore::service(const int64_t* positions, uint8_t count) {
+  if (!_open) return;
+
+  unsigned long now = millis();
+  for (uint8_t i = 0; i < count && i < SENSORS; i++) {
+    int64_t position = positions[i];
+
+    // Travel: keep the stored value within minDelta of the shaft
+    if (!_valid[i] || distance(position, _stored[i]) >= (int64_t)_minDelta) {
+      write(i, position);
+    }
+
+    // Rest: one exact write once the shaft has been still for restMs
+    if (distance(position, _lastSeen[i]) > REST_JITTER_COUNTS) {
+      _lastSeen[i] = position;
+      _stillSince[i] = now;
+      _restSaved[i] = false;
+    } else if (!_restSaved[i] && now - _stillSince[i] >= _restMs) {
+      if (position != _stored[i]) {
+        write(i, position);
+      }
+      _restSaved[i] = true;
+    }
+  }
+}
+
+void PositionStore::flush(const int64_t* positions, uint8_t count) {
+  if (!_open) return;
+  for (uint8_t i = 0; i < count && i < SENSORS; i++) {
+    if (!_valid[i] || positions[i] != _stored[i]) {
+      write(i, positions[i]);
+    }
+  }
+}
+
+void PositionStore::write(uint8_t sensor, int64_t position) {
+  _prefs.putLong64(POSITION_KEYS[sensor], position);
+  _stored[sensor] = position;
+  _valid[sensor] = true;
+  _writes++;
+}
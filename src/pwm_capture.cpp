@@ -0,0 +1,103 @@
+#include "pwm_capture.h"
+#include "config.h"
+#include "logger.h"
+#include <esp_timer.h>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+PwmCapture::PwmCapture() : _running(false) {
+  for (uint8_t i = 0; i < CHANNELS; i++) {
+    _rings[i].head = 0;
+    _rings[i].tail = 0;
+    _rings[i].overruns = 0;
+    _frameUs[i] = 0;
+    _latencyUs[i] = 0;
+    _maxLatencyUs[i] = 0;
+  }
+}
+
+// ============================================================================
+// Start Capture
+// ============================================================================
+bool PwmCapture::begin(uint8_t pin1, uint8_t pin2, uint32_t pwmFreqHz) {
+  const uint8_t pins[CHANNELS] = { pin1, pin2 };
+  const mcpwm_io_signals_t signals[CHANNELS] = { MCPWM_CAP_0, MCPWM_CAP_1 };
+  const mcpwm_capture_channel_id_t channels[CHANNELS] = { MCPWM_SELECT_CAP0, MCPWM_SELECT_CAP1 };
+
+  for (uint8_t i = 0; i < CHANNELS; i++) {
+    if (pins[i] == 255) continue;
+
+    _decoders[i].configure(CAPTURE_CLOCK_HZ / pwmFreqHz, PWM_PERIOD_TOLERANCE);
+
+    mcpwm_capture_config_t conf = {};
+    conf.cap_edge = MCPWM_BOTH_EDGE;
+    conf.cap_prescale = 1;
+    conf.capture_cb = captureCallback;
+    conf.user_data = this;
+
+    if (mcpwm_gpio_init(MCPWM_UNIT_0, signals[i], pins[i]) != ESP_OK ||
+        mcpwm_capture_enable_channel(MCPWM_UNIT_0, channels[i], &conf) != ESP_OK) {
+      LOG_ERRORF("PWM capture: failed to start channel %u (GPIO %u)", i, pins[i]);
+      return false;
+    }
+    LOG_INFOF("PWM capture: channel %u on GPIO %u (%lu Hz)", i, pins[i],
+              (unsigned long)pwmFreqHz);
+  }
+
+  _running = true;
+  return true;
+}
+
+// ============================================================================
+// Read Latest Angle
+// ============================================================================
+bool PwmCapture::readAngle(uint8_t channel, uint16_t& angle) {
+  if (!_running || channel >= CHANNELS) return false;
+
+  EdgeRing& ring = _rings[channel];
+  PwmAngleDecoder& decoder = _decoders[channel];
+
+  // Decode all edges captured since the last read
+  uint8_t head = ring.head;
+  while (ring.tail != head) {
+    const Edge& edge = ring.edges[ring.tail];
+    if (decoder.onEdge(edge.rising, edge.ticks)) {
+      _frameUs[channel] = edge.timeUs;
+    }
+    ring.tail = (ring.tail + 1) & (EDGE_RING_SIZE - 1);
+  }
+
+  if (!decoder.hasAngle()) return false;
+
+  angle = decoder.getAngle();
+  _latencyUs[channel] = (uint32_t)esp_timer_get_time() - _frameUs[channel];
+  if (_latencyUs[channel] > _maxLatencyUs[channel]) {
+    _maxLatencyUs[channel] = _latencyUs[channel];
+  }
+  return true;
+}
+
+// ============================================================================
+// Capture ISR Callback
+// ============================================================================
+bool IRAM_ATTR PwmCapture::captureCallback(mcpwm_unit_t unit, mcpwm_capture_channel_id_t channel,
+                                           const cap_event_data_t* edata, void* arg) {
+  PwmCapture* self = static_cast<PwmCapture*>(arg);
+  uint8_t index = (channel == MCPWM_SELECT_CAP0) ? 0 : 1;
+  EdgeRing& ring = self->_rings[index];
+
+  uint8_t head = ring.head;
+  uint8_t next = (head + 1) & (EDGE_RING_SIZE - 1);
+  if (next == ring.tail) {
+    ring.overruns++;   // Reader is behind; drop the edge
+    return false;
+  }
+
+  Edge& edge = ring.edges[head];
+  edge.ticks = edata->cap_value;
+  edge.timeUs = (uint32_t)esp_timer_get_time();
+  edge.rising = (edata->cap_edge == MCPWM_POS_EDGE);
+  ring.head = next;
+  return false;
+}
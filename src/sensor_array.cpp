@@ -0,0 +1,148 @@
+#include "sensor_array.h"
+#include "config.h"
+#include "logger.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+SensorArray::SensorArray()
+  : _bus0(Wire, _clock, AS5600_I2C_ADDRESS, AS5600_FAST_READ_REGISTER,
+          I2C_REPROBE_MIN_MS, I2C_REPROBE_MAX_MS),
+    _bus1(Wire1, _clock, AS5600_I2C_ADDRESS, AS5600_FAST_READ_REGISTER,
+          I2C_REPROBE_MIN_MS, I2C_REPROBE_MAX_MS),
+    _count(0), _started(false), _cycleUs(0), _bus1Task(nullptr) {
+  for (uint8_t i = 0; i < MAX_SENSORS; i++) {
+    _angles[i] = 0;
+    _timesUs[i] = 0;
+    _connected[i] = false;
+    _fresh[i] = false;
+  }
+  for (uint8_t b = 0; b < 2; b++) {
+    _muxWrites[b] = 0;
+    _reads[b] = 0;
+  }
+}
+
+// ============================================================================
+// Probe Sensors
+// ============================================================================
+void SensorArray::begin(const SensorConfig* layout, uint8_t count) {
+  _count = count > MAX_SENSORS ? MAX_SENSORS : count;
+
+  // Each bus reader keeps its sensors in (mux, channel) order
+  for (uint8_t i = 0; i < _count; i++) {
+    BusReader& bus = layout[i].bus == 0 ? _bus0 : _bus1;
+    bus.add(i, layout[i].muxAddress, layout[i].channel);
+  }
+
+  // Probe each sensor through its channel
+  _bus0.begin();
+  _bus1.begin();
+  merge(0, _bus0, _bus0.snapshot(), true);
+  merge(1, _bus1, _bus1.snapshot(), true);
+  for (uint8_t b = 0; b < 2; b++) {
+    const BusReader& bus = b == 0 ? _bus0 : _bus1;
+    for (uint8_t n = 0; n < bus.getCount(); n++) {
+      uint8_t i = bus.indexOf(n);
+      LOG_INFOF("Array sensor %u (bus %u, mux 0x%02X ch %u): %s", i, b,
+                bus.muxOf(n), bus.channelOf(n), _connected[i] ? "CONNECTED" : "NOT FOUND");
+    }
+    uint32_t passUs = bus.estimatePassUs((b == 0 ? Wire : Wire1).getClock());
+    LOG_INFOF("Array bus %u: %u sensors, est. %lu us bus time per pass", b, bus.getCount(),
+              (unsigned long)passUs);
+  }
+
+  // Bus 1 worker (parallel reads); reports the probe results until its
+  // first pass completes
+  _bus1Worker.setLatest(_bus1.snapshot());
+  _started = true;
+  if (_bus1.getCount() > 0 && _bus0.getCount() > 0) {
+    if (!_bus1Worker.begin() ||
+        xTaskCreatePinnedToCore(bus1WorkerTask, "array_bus1", I2C_WORKER_STACK_SIZE, this,
+                                I2C_WORKER_PRIORITY, &_bus1Task, I2C_WORKER_CORE) != pdPASS) {
+      _bus1Task = nullptr;
+      LOG_ERROR("Array: failed to create bus 1 worker, using sequential reads");
+    }
+  }
+}
+
+// ============================================================================
+// Read All Sensors
+// ============================================================================
+void SensorArray::readAll() {
+  uint32_t cycleStart = micros();
+
+  if (_bus1Task != nullptr) {
+    // A pass that overran the previous cycle must finish before the worker
+    // is restarted; until then bus 1 keeps its last values
+    _bus1Worker.dispatch();
+    _bus0.readPass();
+    bool completed = _bus1Worker.collect(I2C_WORKER_TIMEOUT_MS);
+    merge(0, _bus0, _bus0.snapshot(), true);
+    merge(1, _bus1, _bus1Worker.latest(), completed);
+  } else {
+    _bus0.readPass();
+    _bus1.readPass();
+    merge(0, _bus0, _bus0.snapshot(), true);
+    merge(1, _bus1, _bus1.snapshot(), true);
+  }
+
+  _cycleUs = micros() - cycleStart;
+}
+
+// ============================================================================
+// Merge One Bus
+// ============================================================================
+// Slot order and indices are fixed after begin(), so reading them while the
+// worker runs a pass is safe; the readings come from a completed snapshot.
+void SensorArray::merge(uint8_t busIndex, const BusReader& bus,
+                        const BusReader::Snapshot& snapshot, bool completed) {
+  for (uint8_t n = 0; n < bus.getCount(); n++) {
+    uint8_t i = bus.indexOf(n);
+    const BusReader::Reading& reading = snapshot.readings[n];
+    if (_started && reading.online != _connected[i]) {
+      if (reading.online) {
+        LOG_INFOF("Array sensor %u: back online", i);
+      } else {
+        LOG_WARNF("Array sensor %u: offline after %u bus errors, re-probing",
+                  i, SensorHealth::FAULT_THRESHOLD);
+      }
+    }
+    _angles[i] = reading.angle;
+    _timesUs[i] = reading.timeUs;
+    _connected[i] = reading.online;
+    _fresh[i] = completed && reading.fresh;
+  }
+  _muxWrites[busIndex] = snapshot.muxWrites;
+  _reads[busIndex] = snapshot.reads;
+}
+
+// ============================================================================
+// Freshness
+// ============================================================================
+uint32_t SensorArray::getAgeUs(uint8_t index) const {
+  if (index >= _count || _timesUs[index] == 0) return UINT32_MAX;
+  return (uint32_t)esp_timer_get_time() - _timesUs[index];
+}
+
+uint8_t SensorArray::getConnectedCount() const {
+  uint8_t connected = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_connected[i]) connected++;
+  }
+  return connected;
+}
+
+// ============================================================================
+// Bus 1 Worker Task
+// ============================================================================
+void SensorArray::bus1WorkerTask(void* arg) {
+  SensorArray* self = static_cast<SensorArray*>(arg);
+
+  for (;;) {
+    self->_bus1Worker.serve([self]() -> BusReader::Snapshot {
+      self->_bus1.readPass();
+      return self->_bus1.snapshot();
+    });
+  }
+}
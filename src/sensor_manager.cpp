@@ -1,13 +1,39 @@
 #include "sensor_manager.h"
 #include "config.h"
 #include "logger.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 // ============================================================================
 // Constructor
 // ============================================================================
 SensorManager::SensorManager()
   : _sensor1(&Wire), _sensor2(&Wire1),
-    _sensor1Connected(false), _sensor2Connected(false) {
+    _health{ SensorHealth(I2C_REPROBE_MIN_MS, I2C_REPROBE_MAX_MS),
+             SensorHealth(I2C_REPROBE_MIN_MS, I2C_REPROBE_MAX_MS) },
+    _fast1(Wire, AS5600_I2C_ADDRESS, AS5600_FAST_READ_REGISTER),
+    _fast2(Wire1, AS5600_I2C_ADDRESS, AS5600_FAST_READ_REGISTER),
+    _fastRead(AS5600_FAST_READ),
+    _backend(BACKEND_I2C),
+    _decimator1(OVERSAMPLE_FACTOR), _decimator2(OVERSAMPLE_FACTOR),
+    _observer1(OBSERVER_THETA), _observer2(OBSERVER_THETA),
+    _acqRateHz(SAMPLE_RATE_HZ * OVERSAMPLE_FACTOR),
+    _tickUsQ4((1000000UL << 4) / (SAMPLE_RATE_HZ * OVERSAMPLE_FACTOR)),
+    _lastTickUs(0), _haveTick(false), _windowOpen(false),
+    _bus1Task(nullptr) {
+  _positionMux = portMUX_INITIALIZER_UNLOCKED;
+  _spareTable[0] = nullptr;
+  _spareTable[1] = nullptr;
+  _calibrationRequested[0] = false;
+  _calibrationRequested[1] = false;
+  _lastAngle[0] = 0;
+  _lastAngle[1] = 0;
+  _enabled[0] = true;
+  _enabled[1] = true;
+  _sampleUs[0] = 0;
+  _sampleUs[1] = 0;
+  _windowStartUs[0] = 0;
+  _windowStartUs[1] = 0;
 }
 
 // ============================================================================
@@ -15,17 +41,165 @@ SensorManager::SensorManager()
 // ============================================================================
 void SensorManager::begin(uint8_t sda0, uint8_t scl0, uint32_t freq0,
                           uint8_t sda1, uint8_t scl1, uint32_t freq1) {
+  _busConfig[0] = { sda0, scl0, freq0, false };
+  _busConfig[1] = { sda1, scl1, freq1, false };
+
   // Initialize I2C Bus 0
   Wire.begin(sda0, scl0, freq0);
+  Wire.setTimeOut(I2C_TIMEOUT_MS);
   LOG_INFOF("I2C Bus 0: SDA=%d, SCL=%d, Freq=%d Hz", sda0, scl0, freq0);
 
   // Initialize I2C Bus 1
   Wire1.begin(sda1, scl1, freq1);
+  Wire1.setTimeOut(I2C_TIMEOUT_MS);
   LOG_INFOF("I2C Bus 1: SDA=%d, SCL=%d, Freq=%d Hz", sda1, scl1, freq1);
 
-  // Initialize sensors
-  _sensor1Connected = initSensor(_sensor1, "Sensor 1 (Bus 0)");
-  _sensor2Connected = initSensor(_sensor2, "Sensor 2 (Bus 1)");
+  // Initialize sensors; missing ones are re-probed in the background
+  uint32_t now = millis();
+  _health[0].begin(initSensor(_sensor1, "Sensor 1 (Bus 0)"), now);
+  _health[1].begin(initSensor(_sensor2, "Sensor 2 (Bus 1)"), now);
+
+  // Verify bus clocks and the fast read path. Recovery restarts each bus
+  // at the clock that verified; a bus without a sensor is verified when
+  // one is first found (probeSensor).
+  if (isSensor1Connected()) {
+    verifyBus(Wire, _sensor1, _fast1, freq0, "I2C Bus 0");
+    _busConfig[0].freq = Wire.getClock();
+    _busConfig[0].verified = true;
+  }
+  if (isSensor2Connected()) {
+    verifyBus(Wire1, _sensor2, _fast2, freq1, "I2C Bus 1");
+    _busConfig[1].freq = Wire1.getClock();
+    _busConfig[1].verified = true;
+  }
+
+#if I2C_PARALLEL_READS
+  // Started even with a sensor missing so one plugged in later is read in
+  // parallel too; reads of an offline sensor cost no bus time
+  startBus1Worker();
+#endif
+}
+
+// ============================================================================
+// Verify Bus Clock and Fast Reads
+// ============================================================================
+void SensorManager::verifyBus(TwoWire& bus, AS5600& sensor, FastReader& fast,
+                              uint32_t requestedFreq, const char* name) {
+  uint32_t actualFreq = bus.getClock();
+  if (actualFreq != requestedFreq) {
+    LOG_WARNF("%s: requested %lu Hz, running at %lu Hz", name,
+              (unsigned long)requestedFreq, (unsigned long)actualFreq);
+  }
+
+  // Fast reads must match library reads (allowing for shaft movement)
+  bool ok = true;
+  for (int i = 0; i < I2C_VERIFY_READS && ok; i++) {
+    uint16_t fastAngle;
+    if (!fast.read(fastAngle)) {
+      ok = false;
+      break;
+    }
+    uint16_t libAngle = sensor.readAngle();
+    fast.invalidatePointer();
+    int16_t diff = (int16_t)((fastAngle - libAngle) & 0x0FFF);
+    if (diff >= 2048) diff -= 4096;
+    if (abs(diff) > I2C_VERIFY_TOLERANCE) {
+      ok = false;
+    }
+  }
+
+  if (!ok && actualFreq > 400000) {
+    LOG_WARNF("%s: verification failed at %lu Hz, falling back to 400 kHz",
+              name, (unsigned long)actualFreq);
+    bus.setClock(400000);
+    fast.invalidatePointer();
+  } else if (!ok) {
+    LOG_WARNF("%s: fast read verification failed", name);
+  } else {
+    LOG_INFOF("%s: verified at %lu Hz", name, (unsigned long)actualFreq);
+  }
+  fast.resetStats();
+}
+
+// ============================================================================
+// PWM Backend
+// ============================================================================
+bool SensorManager::beginPwmBackend(uint8_t pin1, uint8_t pin2, uint8_t freqSetting) {
+  static const uint32_t PWM_FREQ_HZ[4] = { 115, 230, 460, 920 };
+  freqSetting &= 0x03;
+
+  // Configure OUT as PWM via the CONF register (volatile, not burned)
+  _fast1.invalidatePointer();
+  _fast2.invalidatePointer();
+  if (isSensor1Connected()) {
+    _sensor1.setOutputMode(AS5600_OUTMODE_PWM);
+    _sensor1.setPWMFrequency(freqSetting);
+  }
+  if (isSensor2Connected()) {
+    _sensor2.setOutputMode(AS5600_OUTMODE_PWM);
+    _sensor2.setPWMFrequency(freqSetting);
+  }
+
+  if (!_pwm.begin(isSensor1Connected() ? pin1 : 255, isSensor2Connected() ? pin2 : 255,
+                  PWM_FREQ_HZ[freqSetting])) {
+    LOG_WARN("PWM backend unavailable, staying on I2C");
+    return false;
+  }
+
+  _backend = BACKEND_PWM;
+  LOG_INFO("Sensor backend: PWM capture");
+  return true;
+}
+
+// ============================================================================
+// Enable/Disable Fast Read Mode
+// ============================================================================
+void SensorManager::setFastRead(bool enabled) {
+  _fast1.invalidatePointer();
+  _fast2.invalidatePointer();
+  _fastRead = enabled;
+}
+
+// ============================================================================
+// Start Bus 1 Worker Task
+// ============================================================================
+void SensorManager::startBus1Worker() {
+  if (!_bus1Worker.begin()) {
+    LOG_ERROR("I2C worker: failed to create semaphores, using sequential reads");
+    return;
+  }
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      bus1WorkerTask, "i2c_bus1", I2C_WORKER_STACK_SIZE, this,
+      I2C_WORKER_PRIORITY, &_bus1Task, I2C_WORKER_CORE);
+  if (created != pdPASS) {
+    _bus1Task = nullptr;
+    LOG_ERROR("I2C worker: failed to create task, using sequential reads");
+    return;
+  }
+
+  LOG_INFOF("I2C worker: parallel reads enabled (core %d)", I2C_WORKER_CORE);
+}
+
+// ============================================================================
+// Bus 1 Worker Task
+// ============================================================================
+// Waits for a start signal, reads sensor 2 on Wire1 and signals completion.
+// The caller reads sensor 1 on Wire in the meantime.
+void SensorManager::bus1WorkerTask(void* arg) {
+  SensorManager* self = static_cast<SensorManager*>(arg);
+
+  for (;;) {
+    self->_bus1Worker.serve([self]() { return self->readBus1(); });
+  }
+}
+
+SensorManager::Bus1Result SensorManager::readBus1() {
+  Bus1Result result;
+  result.startUs = micros();
+  result.angle = readAngle2();
+  result.sampleUs = _sampleUs[1];
+  return result;
 }
 
 // ============================================================================
@@ -47,42 +221,453 @@ bool SensorManager::initSensor(AS5600& sensor, const char* name) {
 // Read Angle from Sensor 1
 // ============================================================================
 uint16_t SensorManager::readAngle1() {
-  if (_sensor1Connected) {
-    return _sensor1.readAngle();
+  if (!_enabled[0]) return _lastAngle[0];
+  if (_backend == BACKEND_PWM) {
+    uint16_t angle;
+    if (!isSensor1Connected() || !_pwm.readAngle(0, angle)) return _lastAngle[0];
+    // The angle was measured when its frame ended, not now
+    _sampleUs[0] = (uint32_t)esp_timer_get_time() - _pwm.getLatencyUs(0);
+    _lastAngle[0] = angle;
+    return angle;
   }
-  return 0;
+  return readSensor(0, Wire, _sensor1, _fast1);
 }
 
 // ============================================================================
 // Read Angle from Sensor 2
 // ============================================================================
 uint16_t SensorManager::readAngle2() {
-  if (_sensor2Connected) {
-    return _sensor2.readAngle();
+  if (!_enabled[1]) return _lastAngle[1];
+  if (_backend == BACKEND_PWM) {
+    uint16_t angle;
+    if (!isSensor2Connected() || !_pwm.readAngle(1, angle)) return _lastAngle[1];
+    _sampleUs[1] = (uint32_t)esp_timer_get_time() - _pwm.getLatencyUs(1);
+    _lastAngle[1] = angle;
+    return angle;
+  }
+  return readSensor(1, Wire1, _sensor2, _fast2);
+}
+
+// ============================================================================
+// Enable/Disable Sensor
+// ============================================================================
+void SensorManager::setSensorEnabled(uint8_t sensor, bool enabled) {
+  if (sensor > 1 || _enabled[sensor] == enabled) return;
+  _enabled[sensor] = enabled;
+  if (sensor == 0) {
+    _fast1.invalidatePointer();
+  } else {
+    _fast2.invalidatePointer();
+  }
+  LOG_INFOF("Sensor %u %s", sensor + 1, enabled ? "enabled" : "disabled");
+}
+
+// ============================================================================
+// Read One Sensor with Fault Tracking
+// ============================================================================
+// Runs on the acquisition task (bus 0) or the bus 1 worker, so recovery on
+// one bus never delays reads on the other. A failed read costs at most
+// I2C_TIMEOUT_MS; there is no library retry after a fast read error.
+uint16_t SensorManager::readSensor(uint8_t index, TwoWire& bus, AS5600& sensor,
+                                   FastReader& fast) {
+  SensorHealth& health = _health[index];
+  if (!health.isOnline()) {
+    if (health.shouldProbe(millis())) {
+      probeSensor(index, bus, sensor, fast);
+    }
+    if (!health.isOnline()) {
+      return _lastAngle[index];
+    }
+  }
+
+  uint16_t angle;
+  bool ok;
+  uint32_t startUs = (uint32_t)esp_timer_get_time();
+  if (_fastRead) {
+    ok = fast.read(angle);
+  } else {
+    angle = sensor.readAngle();
+    ok = (sensor.lastError() == AS5600_OK);
+  }
+
+  if (ok) {
+    health.onReadOk();
+    _lastAngle[index] = angle;
+    _sampleUs[index] = startUs;
+    return angle;
+  }
+  if (health.onReadError(millis())) {
+    LOG_WARNF("Sensor %u: offline after %u bus errors, re-probing",
+              index + 1, SensorHealth::FAULT_THRESHOLD);
+  }
+  return _lastAngle[index];
+}
+
+// ============================================================================
+// Bus Clear and Re-Probe
+// ============================================================================
+// A slave interrupted mid-byte can hold SDA low indefinitely. Clocking SCL
+// until SDA is released (at most 9 pulses) and issuing a STOP returns it to
+// idle; the controller is restarted afterwards.
+static void clearBus(uint8_t sda, uint8_t scl) {
+  pinMode(sda, INPUT_PULLUP);
+  pinMode(scl, OUTPUT_OPEN_DRAIN);
+  digitalWrite(scl, HIGH);
+  delayMicroseconds(5);
+  for (int i = 0; i < 9 && digitalRead(sda) == LOW; i++) {
+    digitalWrite(scl, LOW);
+    delayMicroseconds(5);
+    digitalWrite(scl, HIGH);
+    delayMicroseconds(5);
+  }
+
+  // STOP: SDA rises while SCL is high
+  pinMode(sda, OUTPUT_OPEN_DRAIN);
+  digitalWrite(sda, LOW);
+  delayMicroseconds(5);
+  digitalWrite(scl, HIGH);
+  delayMicroseconds(5);
+  digitalWrite(sda, HIGH);
+  delayMicroseconds(5);
+}
+
+void SensorManager::probeSensor(uint8_t index, TwoWire& bus, AS5600& sensor,
+                                FastReader& fast) {
+  BusConfig& config = _busConfig[index];
+  SensorHealth& health = _health[index];
+
+  bus.end();
+  clearBus(config.sda, config.scl);
+  health.onBusClear();
+  bus.begin(config.sda, config.scl, config.freq);
+  bus.setTimeOut(I2C_TIMEOUT_MS);
+  fast.invalidatePointer();
+
+  if (health.onProbeResult(sensor.isConnected(), millis())) {
+    LOG_INFOF("Sensor %u: back online", index + 1);
+
+    // Missing at boot: check the clock and fast reads now, once (costs
+    // I2C_VERIFY_READS reads on this bus's task)
+    if (!config.verified) {
+      verifyBus(bus, sensor, fast, config.freq, index == 0 ? "I2C Bus 0" : "I2C Bus 1");
+      config.freq = bus.getClock();
+      config.verified = true;
+    }
   }
-  return 0;
 }
 
 // ============================================================================
 // Read Both Angles
 // ============================================================================
 void SensorManager::readAngles(uint16_t& angle1, uint16_t& angle2) {
-  angle1 = readAngle1();
-  angle2 = readAngle2();
+  AngleSample sample;
+  readAngles(sample);
+  angle1 = sample.angle1;
+  angle2 = sample.angle2;
+}
+
+// ============================================================================
+// Read Both Angles (calibrated)
+// ============================================================================
+void SensorManager::readAngles(AngleSample& sample) {
+  readRawAngles(sample);
+
+  // Calibration capture sees raw angles at their sample instants. A start
+  // request is taken up here, so the sums are only ever cleared on this
+  // task, and never while serviceCalibration() is still reading them.
+  const uint16_t raw[2] = { sample.angle1, sample.angle2 };
+  const uint32_t times[2] = { sample.time1Us, sample.time2Us };
+  for (uint8_t i = 0; i < 2; i++) {
+    AngleCalibrator& calibrator = _calibrator[i];
+    if (_calibrationRequested[i] && !(calibrator.isActive() && calibrator.isComplete())) {
+      calibrator.begin();
+      _calibrationRequested[i] = false;
+    }
+    if (calibrator.isActive()) {
+      calibrator.addSample(raw[i], times[i]);
+    }
+  }
+
+  // Tables are swapped under the same lock (see applyCalibration)
+  portENTER_CRITICAL(&_positionMux);
+  sample.angle1 = _correction[0].apply(sample.angle1);
+  sample.angle2 = _correction[1].apply(sample.angle2);
+  portEXIT_CRITICAL(&_positionMux);
+}
+
+// ============================================================================
+// Read Both Angles in Parallel
+// ============================================================================
+void SensorManager::readRawAngles(AngleSample& sample) {
+  uint32_t cycleStart = micros();
+
+  if (_bus1Task == nullptr || _backend == BACKEND_PWM) {
+    // Sequential path: PWM backend (no bus traffic), worker disabled or
+    // only one sensor connected
+    uint32_t bus0Start = micros();
+    sample.angle1 = readAngle1();
+    uint32_t bus1Start = micros();
+    sample.angle2 = readAngle2();
+    sample.skewUs = (int32_t)(bus1Start - bus0Start);
+    sample.cycleUs = micros() - cycleStart;
+    sample.time1Us = _sampleUs[0];
+    sample.time2Us = _sampleUs[1];
+    return;
+  }
+
+  // A read that overran the previous cycle must finish before the worker
+  // can be restarted; until then keep reporting its last result
+  _bus1Worker.dispatch();
+
+  uint32_t bus0Start = micros();
+  sample.angle1 = readAngle1();
+  sample.time1Us = _sampleUs[0];
+
+  // Bus 1 values come only from a completed read: on overrun the worker
+  // still owns the shared result and the previous one is reported
+  _bus1Worker.collect(I2C_WORKER_TIMEOUT_MS);
+  const Bus1Result& bus1 = _bus1Worker.latest();
+  sample.angle2 = bus1.angle;
+  sample.skewUs = (int32_t)(bus1.startUs - bus0Start);
+  sample.cycleUs = micros() - cycleStart;
+  // Instants of the values actually returned: a stale angle (overrun or
+  // offline sensor) keeps its original timestamp
+  sample.time2Us = bus1.sampleUs;
+}
+
+// ============================================================================
+// Oversampling
+// ============================================================================
+void SensorManager::setOversampling(uint16_t factor) {
+  _decimator1.setFactor(factor);
+  _decimator2.setFactor(factor);
+  LOG_INFOF("Oversampling x%u (+%.1f bits effective resolution)",
+            _decimator1.getFactor(),
+            AngleDecimator::effectiveBitsGained(_decimator1.getFactor()));
+}
+
+bool SensorManager::sampleOversampled(AngleSample& sample) {
+  AngleSample raw;
+  readAngles(raw);
+  measureTick(isSensor1Connected() ? raw.time1Us : raw.time2Us);
+
+  // Observers run at the full acquisition rate
+  bool active1 = isSensor1Connected() && _enabled[0];
+  bool active2 = isSensor2Connected() && _enabled[1];
+  if (active1) _observer1.update(raw.angle1);
+  if (active2) _observer2.update(raw.angle2);
+
+  // Unwrap at the full acquisition rate (well above the shaft's Nyquist limit)
+  portENTER_CRITICAL(&_positionMux);
+  if (active1) _turns1.update(raw.angle1);
+  if (active2) _turns2.update(raw.angle2);
+  portEXIT_CRITICAL(&_positionMux);
+
+  if (!_windowOpen) {
+    _windowStartUs[0] = raw.time1Us;
+    _windowStartUs[1] = raw.time2Us;
+    _windowOpen = true;
+  }
+
+  // Both decimators share the same factor and window, so they complete together
+  _decimator1.push(raw.angle1);
+  if (!_decimator2.push(raw.angle2)) {
+    return false;
+  }
+  _windowOpen = false;
+
+  // A boxcar average describes the middle of its window
+  sample.angle1 = _decimator1.getAngle();
+  sample.angle2 = _decimator2.getAngle();
+  sample.skewUs = raw.skewUs;
+  sample.cycleUs = raw.cycleUs;
+  sample.time1Us = timestampMidpoint(_windowStartUs[0], raw.time1Us);
+  sample.time2Us = timestampMidpoint(_windowStartUs[1], raw.time2Us);
+  return true;
+}
+
+// ============================================================================
+// Triggered Sample
+// ============================================================================
+void SensorManager::sampleTriggered(AngleSample& sample) {
+  readAngles(sample);
+
+  bool active1 = isSensor1Connected() && _enabled[0];
+  bool active2 = isSensor2Connected() && _enabled[1];
+  portENTER_CRITICAL(&_positionMux);
+  if (active1) _turns1.update(sample.angle1);
+  if (active2) _turns2.update(sample.angle2);
+  portEXIT_CRITICAL(&_positionMux);
+}
+
+// ============================================================================
+// Tracking Observers
+// ============================================================================
+void SensorManager::setAcquisitionRate(uint32_t rateHz) {
+  if (rateHz == 0) return;
+  _acqRateHz = rateHz;
+  _tickUsQ4 = (1000000UL << 4) / rateHz;
+  _haveTick = false;
+}
+
+// Average tick interval from sample timestamps (1/16 weight per tick), so
+// velocities follow the real sampling instants rather than the nominal rate.
+// Ticks more than 4x off nominal (stalls, first sample) are ignored.
+void SensorManager::measureTick(uint32_t timeUs) {
+  if (_haveTick) {
+    int32_t dt = timestampDiffUs(timeUs, _lastTickUs);
+    uint32_t nominal = _tickUsQ4 >> 4;
+    if (dt > 0 && (uint32_t)dt < nominal * 4 && (uint32_t)dt > nominal / 4) {
+      _tickUsQ4 += ((int32_t)((uint32_t)dt << 4) - (int32_t)_tickUsQ4) / 16;
+      _acqRateHz = (1000000UL << 4) / _tickUsQ4;
+    }
+  }
+  _lastTickUs = timeUs;
+  _haveTick = true;
+}
+
+void SensorManager::setObserverSmoothing(float theta) {
+  _observer1.setSmoothing(theta);
+  _observer2.setSmoothing(theta);
+}
+
+SensorManager::Motion SensorManager::motionOf(const TrackingObserver& observer) const {
+  Motion motion;
+  motion.angle = observer.getAngle();
+  motion.velocity = observer.getVelocity(_acqRateHz);
+  motion.acceleration = observer.getAcceleration(_acqRateHz);
+  return motion;
+}
+
+// ============================================================================
+// Multi-Turn Positions
+// ============================================================================
+void SensorManager::restorePosition(uint8_t sensor, int64_t savedPosition) {
+  uint16_t angle = (sensor == 0) ? readAngle1() : readAngle2();
+  bool connected = (sensor == 0) ? isSensor1Connected() : isSensor2Connected();
+  if (!connected) return;
+
+  portENTER_CRITICAL(&_positionMux);
+  // The trackers are fed calibrated angles; seed them with one too
+  angle = _correction[sensor].apply(angle);
+  if (sensor == 0) {
+    _turns1.restore(savedPosition, angle);
+  } else {
+    _turns2.restore(savedPosition, angle);
+  }
+  portEXIT_CRITICAL(&_positionMux);
+}
+
+int64_t SensorManager::getPosition1() {
+  portENTER_CRITICAL(&_positionMux);
+  int64_t position = _turns1.getPosition();
+  portEXIT_CRITICAL(&_positionMux);
+  return position;
+}
+
+int64_t SensorManager::getPosition2() {
+  portENTER_CRITICAL(&_positionMux);
+  int64_t position = _turns2.getPosition();
+  portEXIT_CRITICAL(&_positionMux);
+  return position;
+}
+
+int32_t SensorManager::getTurns1() {
+  portENTER_CRITICAL(&_positionMux);
+  int32_t turns = _turns1.getTurns();
+  portEXIT_CRITICAL(&_positionMux);
+  return turns;
+}
+
+int32_t SensorManager::getTurns2() {
+  portENTER_CRITICAL(&_positionMux);
+  int32_t turns = _turns2.getTurns();
+  portEXIT_CRITICAL(&_positionMux);
+  return turns;
+}
+
+// ============================================================================
+// Calibration
+// ============================================================================
+bool SensorManager::startCalibration(uint8_t sensor) {
+  if (sensor > 1) return false;
+  if (!_health[sensor].isOnline()) return false;
+
+  _calibrationRequested[sensor] = true;
+  LOG_INFOF("Calibration: sensor %u started, turn the shaft one revolution at constant speed",
+            sensor + 1);
+  return true;
+}
+
+uint8_t SensorManager::getCalibrationProgress(uint8_t sensor) const {
+  if (sensor > 1 || _calibrationRequested[sensor]) return 0;
+  return _calibrator[sensor].getProgress();
+}
+
+bool SensorManager::isCalibrating(uint8_t sensor) const {
+  return sensor < 2 && (_calibrationRequested[sensor] || _calibrator[sensor].isActive());
+}
+
+bool SensorManager::isCalibrated(uint8_t sensor) const {
+  return sensor < 2 && _correction[sensor].isEnabled();
+}
+
+bool SensorManager::serviceCalibration(uint8_t sensor, int16_t model[AngleCalibrator::MODEL_POINTS]) {
+  if (sensor > 1 || !_calibrator[sensor].isComplete() || !_calibrator[sensor].isActive()) {
+    return false;
+  }
+  if (!_calibrator[sensor].finish(model)) {
+    LOG_WARNF("Calibration: sensor %u capture unusable", sensor + 1);
+    return false;
+  }
+  LOG_INFOF("Calibration: sensor %u complete", sensor + 1);
+  return applyCalibration(sensor, model);
+}
+
+bool SensorManager::applyCalibration(uint8_t sensor, const int16_t model[AngleCalibrator::MODEL_POINTS]) {
+  if (sensor > 1 || !allocateSpareTable(sensor)) return false;
+
+  // Build off to the side, then swap. readAngles() applies the tables under
+  // the same lock, so after the swap nothing reads the old table and it
+  // becomes the next spare.
+  uint16_t* table = _spareTable[sensor];
+  AngleCorrection::build(model, table);
+  portENTER_CRITICAL(&_positionMux);
+  _spareTable[sensor] = _correction[sensor].publish(table);
+  portEXIT_CRITICAL(&_positionMux);
+  return true;
+}
+
+bool SensorManager::allocateSpareTable(uint8_t sensor) {
+  uint16_t*& table = _spareTable[sensor];
+  if (table != nullptr) return true;
+
+  const size_t bytes = AngleCorrection::TABLE_SIZE * sizeof(uint16_t);
+  table = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (table == nullptr) {
+    table = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+  }
+  if (table == nullptr) {
+    LOG_ERRORF("Calibration: no memory for sensor %u table", sensor + 1);
+    return false;
+  }
+  return true;
 }
 
 // ============================================================================
 // Check Magnet Detection
 // ============================================================================
 bool SensorManager::isMagnet1Detected() {
-  if (_sensor1Connected) {
+  if (isSensor1Connected()) {
+    _fast1.invalidatePointer();
     return _sensor1.detectMagnet();
   }
   return false;
 }
 
 bool SensorManager::isMagnet2Detected() {
-  if (_sensor2Connected) {
+  if (isSensor2Connected()) {
+    _fast2.invalidatePointer();
     return _sensor2.detectMagnet();
   }
   return false;
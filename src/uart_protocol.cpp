@@ -1,38 +1,361 @@
 #include "uart_protocol.h"
 #include "config.h"
 #include "logger.h"
+#include "clock.h"
+#include <esp_timer.h>
 
 // ============================================================================
 // Constructor
 // ============================================================================
-UartProtocol::UartProtocol(HardwareSerial& serial) : _serial(serial) {
+UartProtocol::UartProtocol(HardwareSerial& serial)
+  : _serial(serial), _changeDriven(false), _version(1), _sequence(0), _lastTimeUs(0),
+    _batching(false), _commandHandler(nullptr), _commandArg(nullptr),
+    _receiveHandler(nullptr), _receiveArg(nullptr), _lastRxUs(0) {
 }
 
 // ============================================================================
 // Initialize UART
 // ============================================================================
 void UartProtocol::begin(uint32_t baudRate, uint8_t txPin, uint8_t rxPin) {
+  // Larger driver buffer: the TX interrupt keeps the FIFO fed from it
+  _serial.setTxBufferSize(UART_TX_DRIVER_BUFFER);
   _serial.begin(baudRate, SERIAL_8N1, rxPin, txPin);
-  LOG_INFOF("UART initialized: TX=%d, RX=%d, Baud=%d", txPin, rxPin, baudRate);
+  // Receive event per byte: command arrival times and trigger wakeups
+  _serial.setRxFIFOFull(1);
+  _serial.onReceive([this]() { onReceive(); }, false);
+  LOG_INFOF("UART initialized: TX=%d, RX=%d, Baud=%d (actual %lu)", txPin, rxPin, baudRate,
+            (unsigned long)_serial.baudRate());
+}
+
+bool UartProtocol::beginTxQueue(UartTxQueue::Ring::Policy policy) {
+  return _txQueue.begin(_serial, policy);
+}
+
+void UartProtocol::writeFrame(const uint8_t* data, size_t length) {
+  if (_txQueue.isRunning()) {
+    _txQueue.write(data, length);
+  } else {
+    _serial.write(data, length);
+  }
+}
+
+// ============================================================================
+// Command Channel
+// ============================================================================
+void UartProtocol::setCommandHandler(CommandHandler handler, void* arg) {
+  _commandHandler = handler;
+  _commandArg = arg;
+}
+
+// Reads at most `maxBytes` already-received bytes, so the cost per call is
+// bounded whatever the host sends
+size_t UartProtocol::serviceCommands(size_t maxBytes) {
+  size_t triggers = 0;
+  while (maxBytes-- > 0 && _serial.available() > 0) {
+    Command::Parser::Event event = _commands.push((uint8_t)_serial.read());
+    if (event == Command::Parser::TRIGGER) triggers++;
+    // Without a handler commands are parsed (for triggers) but not answered
+    if (event != Command::Parser::COMMAND || _commandHandler == nullptr) continue;
+
+    // The last receive event is the frame's end (or, if that event is still
+    // pending, an earlier byte of the same frame)
+    Command::Request request = _commands.request();
+    request.receivedUs = _lastRxUs;
+    uint8_t response[ProtocolV2::MAX_PAYLOAD];
+    uint8_t resultLength = 0;
+    uint8_t status = _commandHandler(request, response + 3, resultLength, _commandArg);
+    if (resultLength > Command::MAX_RESULT) resultLength = Command::MAX_RESULT;
+
+    // The reply goes out in the output format now selected (after SET_OUTPUT,
+    // the new one): a v1 extended frame does not touch the v2 sequence
+    response[0] = request.sequence & 0xFF;
+    response[1] = (request.sequence >> 8) & 0xFF;
+    response[2] = request.id;
+    if (status == Command::OK) {
+      transmitFrame(Command::TYPE_ACK, response, 3 + resultLength);
+    } else {
+      response[3] = status;
+      transmitFrame(Command::TYPE_NACK, response, 4);
+      LOG_DEBUGF("Command 0x%02X rejected (status %u)", request.id, status);
+    }
+  }
+  return triggers;
+}
+
+// ============================================================================
+// Receive Notification
+// ============================================================================
+void UartProtocol::setReceiveHandler(ReceiveHandler handler, void* arg) {
+  _receiveArg = arg;
+  _receiveHandler = handler;
+}
+
+void UartProtocol::onReceive() {
+  _lastRxUs = (uint32_t)esp_timer_get_time();
+  if (_receiveHandler != nullptr) {
+    _receiveHandler(_receiveArg);
+  }
+}
+
+// ============================================================================
+// Protocol Version
+// ============================================================================
+void UartProtocol::setProtocolVersion(uint8_t version) {
+  version = (version == 2) ? 2 : 1;
+  // The sequence restarts only on the switch to v2; selecting v2 again
+  // mid-stream must not look like 65535 lost frames to the receiver
+  if (version == 2 && _version != 2) {
+    _sequence = 0;
+  }
+  _version = version;
+  LOG_INFOF("UART protocol v%u", _version);
+}
+
+// ============================================================================
+// Batch Mode
+// ============================================================================
+void UartProtocol::setBatching(uint8_t samples, uint32_t intervalUs, uint32_t flushUs) {
+  flushBatch();
+  _batching = (samples > 1);
+  // The nominal interval only sets the zero point of the time jitter; rates
+  // below ~15 Hz still decode exactly, with larger jitter fields
+  if (intervalUs > 0xFFFF) intervalUs = 0xFFFF;
+  _batch.configure(2, samples, (uint16_t)intervalUs, flushUs);
+  if (_batching) {
+    LOG_INFOF("UART batching: up to %u samples/frame, flush after %lu us",
+              samples, (unsigned long)flushUs);
+  }
+}
+
+void UartProtocol::flushBatch() {
+  if (_batch.isEmpty()) return;
+  transmitFrame(FRAME_BATCH, _batch.getPayload(), _batch.getLength());
+  _batch.clear();
+}
+
+// ============================================================================
+// Change-Driven Output
+// ============================================================================
+void UartProtocol::setChangeDriven(bool enabled, uint16_t deadband1, uint16_t deadband2,
+                                   uint32_t heartbeatMs) {
+  _changeDriven = enabled;
+  _gate.setDeadband(0, deadband1);
+  _gate.setDeadband(1, deadband2);
+  _gate.setHeartbeat(heartbeatMs);
+  _gate.invalidate();
+  _gate.resetStats();
+  if (enabled) {
+    LOG_INFOF("UART change-driven output: deadband %u/%u counts, heartbeat %lu ms",
+              deadband1, deadband2, (unsigned long)heartbeatMs);
+  }
 }
 
 // ============================================================================
 // Transmit Sensor Data
 // ============================================================================
-void UartProtocol::transmit(uint16_t angle1, uint16_t angle2) {
-  buildPacket(angle1, angle2);
-  _serial.write((uint8_t*)&_packet, sizeof(_packet));
+bool UartProtocol::transmit(uint16_t angle1, uint16_t angle2,
+                            uint32_t time1Us, uint32_t time2Us) {
+  // The flush deadline is checked on every call, so a batch does not wait
+  // for the next sample the change gate lets through
+  if (_batching && _batch.isReady(micros())) {
+    flushBatch();
+  }
+
+  if (_changeDriven) {
+    const uint16_t angles[2] = { angle1, angle2 };
+    size_t bytes = (_version == 2) ? V2_ANGLES_FRAME_SIZE : sizeof(_packet);
+    if (!_gate.shouldSend(angles, millis(), bytes)) {
+      return false;
+    }
+  }
+
+  _lastTimeUs = time1Us;
+  if (_batching) {
+    // Sensor 1's instant stands for the pair
+    const uint16_t angles[2] = { angle1, angle2 };
+    if (!_batch.add(angles, time1Us)) {
+      flushBatch();
+      _batch.add(angles, time1Us);
+    }
+    if (_batch.isReady(time1Us)) {
+      flushBatch();
+    }
+  } else if (_version == 2) {
+    // Frame time is sensor 1's instant; sensor 2 carries its offset,
+    // saturated at +-32767 us (a stale sensor 2 value)
+    int32_t offset = timestampDiffUs(time2Us, time1Us);
+    if (offset > 32767) offset = 32767;
+    if (offset < -32767) offset = -32767;
+    uint8_t payload[V2_ANGLES_PAYLOAD];
+    payload[0] = 2;
+    payload[1] = angle1 & 0xFF;
+    payload[2] = (angle1 >> 8) & 0xFF;
+    payload[3] = 0;
+    payload[4] = 0;
+    payload[5] = angle2 & 0xFF;
+    payload[6] = (angle2 >> 8) & 0xFF;
+    payload[7] = (uint16_t)offset & 0xFF;
+    payload[8] = ((uint16_t)offset >> 8) & 0xFF;
+    transmitV2(ProtocolV2::TYPE_ANGLES, payload, sizeof(payload), time1Us);
+  } else {
+    buildPacket(angle1, angle2);
+    writeFrame((const uint8_t*)&_packet, sizeof(_packet));
+  }
 
   // Only print debug output once per 10 seconds to avoid flooding log
   static unsigned long lastDebugPrint = 0;
   unsigned long currentTime = millis();
   if (currentTime - lastDebugPrint >= 10000) {
     lastDebugPrint = currentTime;
-    LOG_DEBUGF("TX: Angle1=%4d (%.2f°), Angle2=%4d (%.2f°), Checksum=0x%02X",
-              angle1, angle1 * 360.0 / 4096.0,
-              angle2, angle2 * 360.0 / 4096.0,
-              _packet.checksum);
+    if (_version == 2) {
+      LOG_DEBUGF("TX v2 #%u: Angle1=%4d (%.2f°) @%lu us, Angle2=%4d (%.2f°) @%lu us",
+                (unsigned)(uint16_t)(_sequence - 1),
+                angle1, angle1 * 360.0 / 4096.0, (unsigned long)time1Us,
+                angle2, angle2 * 360.0 / 4096.0, (unsigned long)time2Us);
+    } else {
+      LOG_DEBUGF("TX: Angle1=%4d (%.2f°) @%lu us, Angle2=%4d (%.2f°) @%lu us, Checksum=0x%02X",
+                angle1, angle1 * 360.0 / 4096.0, (unsigned long)time1Us,
+                angle2, angle2 * 360.0 / 4096.0, (unsigned long)time2Us,
+                _packet.checksum);
+    }
+  }
+  return true;
+}
+
+// ============================================================================
+// Transmit Angle Array
+// ============================================================================
+void UartProtocol::transmitArray(const uint16_t* angles, uint8_t count) {
+  uint8_t payload[MAX_FRAME_PAYLOAD];
+  size_t maxCount = (sizeof(payload) - 1) / 2;
+  if (count > maxCount) count = maxCount;
+
+  payload[0] = count;
+  for (uint8_t i = 0; i < count; i++) {
+    payload[1 + 2 * i] = angles[i] & 0xFF;
+    payload[2 + 2 * i] = (angles[i] >> 8) & 0xFF;
+  }
+  transmitFrame(FRAME_ANGLE_ARRAY, payload, 1 + 2 * count);
+}
+
+// ============================================================================
+// Transmit Motion Estimates
+// ============================================================================
+void UartProtocol::transmitMotion(const uint16_t* angles, const int32_t* velocities,
+                                  const int32_t* accelerations, uint8_t count) {
+  uint8_t payload[MAX_FRAME_PAYLOAD];
+  size_t maxCount = (sizeof(payload) - 1) / 10;
+  if (count > maxCount) count = maxCount;
+
+  payload[0] = count;
+  uint8_t* p = payload + 1;
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t velocity = (uint32_t)velocities[i];
+    uint32_t acceleration = (uint32_t)accelerations[i];
+    *p++ = angles[i] & 0xFF;
+    *p++ = (angles[i] >> 8) & 0xFF;
+    for (uint8_t b = 0; b < 4; b++) *p++ = (velocity >> (8 * b)) & 0xFF;
+    for (uint8_t b = 0; b < 4; b++) *p++ = (acceleration >> (8 * b)) & 0xFF;
+  }
+  transmitFrame(FRAME_MOTION, payload, p - payload);
+}
+
+// ============================================================================
+// Transmit Multi-Turn Positions
+// ============================================================================
+void UartProtocol::transmitPositions(const int64_t* positions, uint8_t count) {
+  uint8_t payload[MAX_FRAME_PAYLOAD];
+  size_t maxCount = (sizeof(payload) - 1) / 8;
+  if (count > maxCount) count = maxCount;
+
+  payload[0] = count;
+  uint8_t* p = payload + 1;
+  for (uint8_t i = 0; i < count; i++) {
+    uint64_t position = (uint64_t)positions[i];
+    for (uint8_t b = 0; b < 8; b++) *p++ = (position >> (8 * b)) & 0xFF;
+  }
+  transmitFrame(FRAME_POSITION, payload, p - payload);
+}
+
+// ============================================================================
+// Transmit Sample Timestamps
+// ============================================================================
+void UartProtocol::transmitTimestamps(const uint32_t* times, uint8_t count) {
+  uint8_t payload[MAX_FRAME_PAYLOAD];
+  size_t maxCount = (sizeof(payload) - 1) / 4;
+  if (count > maxCount) count = maxCount;
+
+  payload[0] = count;
+  uint8_t* p = payload + 1;
+  for (uint8_t i = 0; i < count; i++) {
+    for (uint8_t b = 0; b < 4; b++) *p++ = (times[i] >> (8 * b)) & 0xFF;
+  }
+  transmitFrame(FRAME_TIMESTAMP, payload, p - payload);
+}
+
+// ============================================================================
+// Transmit Sensor Array Timestamps
+// ============================================================================
+void UartProtocol::transmitArrayTimestamps(const uint32_t* times, uint8_t count) {
+  uint8_t payload[MAX_FRAME_PAYLOAD];
+  size_t maxCount = (sizeof(payload) - 5) / 2;
+  if (count > maxCount) count = maxCount;
+  if (count == 0) return;
+
+  uint32_t newest = times[0];
+  for (uint8_t i = 1; i < count; i++) {
+    if (timestampDiffUs(times[i], newest) > 0) newest = times[i];
+  }
+
+  payload[0] = count;
+  for (uint8_t b = 0; b < 4; b++) payload[1 + b] = (newest >> (8 * b)) & 0xFF;
+  uint8_t* p = payload + 5;
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t age = (uint32_t)timestampDiffUs(newest, times[i]);
+    if (age > 0xFFFF) age = 0xFFFF;
+    *p++ = age & 0xFF;
+    *p++ = (age >> 8) & 0xFF;
+  }
+  transmitFrame(FRAME_ARRAY_TIMESTAMP, payload, p - payload);
+}
+
+// ============================================================================
+// Transmit Extended Frame
+// ============================================================================
+void UartProtocol::transmitFrame(uint8_t type, const uint8_t* payload, uint8_t length) {
+  if (_version == 2) {
+    transmitV2(type, payload, length, _lastTimeUs);
+    return;
+  }
+
+  uint8_t frame[MAX_FRAME_PAYLOAD + 5];
+  if (length > MAX_FRAME_PAYLOAD) length = MAX_FRAME_PAYLOAD;
+
+  uint8_t checksum = type ^ length;
+  frame[0] = PACKET_EXT_START_BYTE;
+  frame[1] = type;
+  frame[2] = length;
+  for (uint8_t i = 0; i < length; i++) {
+    frame[3 + i] = payload[i];
+    checksum ^= payload[i];
+  }
+  frame[3 + length] = checksum;
+  frame[4 + length] = PACKET_END_BYTE;
+
+  writeFrame(frame, length + 5);
+}
+
+// ============================================================================
+// Transmit v2 Frame
+// ============================================================================
+size_t UartProtocol::transmitV2(uint8_t type, const uint8_t* payload, size_t length,
+                                uint32_t timeUs) {
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  size_t size = ProtocolV2::encodeFrame(type, _sequence++, timeUs, payload, length, frame);
+  if (size > 0) {
+    writeFrame(frame, size);
   }
+  return size;
 }
 
 // ============================================================================
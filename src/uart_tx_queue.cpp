@@ -0,0 +1,62 @@
+#include "uart_tx_queue.h"
+#include "config.h"
+#include "logger.h"
+
+// ============================================================================
+// Constructor
+// ============================================================================
+UartTxQueue::UartTxQueue() : _serial(nullptr), _task(nullptr), _bytesSent(0) {
+}
+
+// ============================================================================
+// Start Drain Task
+// ============================================================================
+bool UartTxQueue::begin(HardwareSerial& serial, Ring::Policy policy) {
+  _serial = &serial;
+  _ring.setPolicy(policy);
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      taskEntry, "uart_tx", UART_TX_TASK_STACK_SIZE, this,
+      UART_TX_TASK_PRIORITY, &_task, UART_TX_TASK_CORE);
+  if (created != pdPASS) {
+    _task = nullptr;
+    LOG_ERROR("UART TX queue: failed to create task, writing directly");
+    return false;
+  }
+
+  static const char* const POLICY_NAMES[] = { "drop newest", "drop oldest", "coalesce" };
+  LOG_INFOF("UART TX queue: %u frames, %s on overflow (core %d)",
+            (unsigned)SLOTS, POLICY_NAMES[policy], UART_TX_TASK_CORE);
+  return true;
+}
+
+// ============================================================================
+// Queue Frame
+// ============================================================================
+bool UartTxQueue::write(const uint8_t* data, size_t length) {
+  bool queued = _ring.push(data, length);
+  if (_task != nullptr) {
+    xTaskNotifyGive(_task);
+  }
+  return queued;
+}
+
+// ============================================================================
+// Drain Task
+// ============================================================================
+void UartTxQueue::taskEntry(void* arg) {
+  static_cast<UartTxQueue*>(arg)->run();
+}
+
+// Writes block here, in the drain task, when the driver buffer is full
+void UartTxQueue::run() {
+  uint8_t frame[SLOT_SIZE];
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    size_t length;
+    while ((length = _ring.pop(frame)) > 0) {
+      _serial->write(frame, length);
+      _bytesSent += length;
+    }
+  }
+}
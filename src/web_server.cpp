@@ -1,426 +1,109 @@
 #include "web_server.h"
 #include "config.h"
+#include "http_cache.h"
 #include "logger.h"
+#include "web_assets.h"
 #include <ArduinoJson.h>
 
 // Static instance pointer
 WebServerManager* WebServerManager::instance = nullptr;
 
-// HTML page with WebSocket support
-const char INDEX_HTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>AS5600 Sensor Monitor</title>
-    <style>
-        * {
-            margin: 0;
-            padding: 0;
-            box-sizing: border-box;
-        }
-        
-        body {
-            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            display: flex;
-            justify-content: center;
-            align-items: center;
-            padding: 20px;
-        }
-        
-        .container {
-            background: rgba(255, 255, 255, 0.95);
-            border-radius: 20px;
-            padding: 40px;
-            box-shadow: 0 20px 60px rgba(0, 0, 0, 0.3);
-            max-width: 800px;
-            width: 100%;
-            backdrop-filter: blur(10px);
-        }
-        
-        h1 {
-            color: #333;
-            text-align: center;
-            margin-bottom: 10px;
-            font-size: 2.5em;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            -webkit-background-clip: text;
-            -webkit-text-fill-color: transparent;
-            background-clip: text;
-        }
-        
-        .subtitle {
-            text-align: center;
-            color: #666;
-            margin-bottom: 40px;
-            font-size: 1.1em;
-        }
-        
-        .status {
-            text-align: center;
-            padding: 12px;
-            border-radius: 10px;
-            margin-bottom: 30px;
-            font-weight: 600;
-            transition: all 0.3s ease;
-        }
-        
-        .status.connected {
-            background: #d4edda;
-            color: #155724;
-            border: 2px solid #c3e6cb;
-        }
-        
-        .status.disconnected {
-            background: #f8d7da;
-            color: #721c24;
-            border: 2px solid #f5c6cb;
-        }
-        
-        .sensors {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(300px, 1fr));
-            gap: 30px;
-            margin-bottom: 30px;
-        }
-        
-        .sensor-card {
-            background: linear-gradient(135deg, #f5f7fa 0%, #c3cfe2 100%);
-            border-radius: 15px;
-            padding: 30px;
-            box-shadow: 0 10px 30px rgba(0, 0, 0, 0.1);
-            transition: transform 0.3s ease, box-shadow 0.3s ease;
-        }
-        
-        .sensor-card:hover {
-            transform: translateY(-5px);
-            box-shadow: 0 15px 40px rgba(0, 0, 0, 0.2);
-        }
-        
-        .sensor-card h2 {
-            color: #667eea;
-            margin-bottom: 20px;
-            font-size: 1.5em;
-            text-align: center;
-        }
-        
-        .angle-display {
-            text-align: center;
-            margin-bottom: 20px;
-        }
-        
-        .angle-value {
-            font-size: 3.5em;
-            font-weight: bold;
-            color: #333;
-            display: block;
-            margin-bottom: 5px;
-        }
-        
-        .angle-unit {
-            font-size: 1.2em;
-            color: #666;
-        }
-        
-        .angle-bar {
-            width: 100%;
-            height: 30px;
-            background: #e0e0e0;
-            border-radius: 15px;
-            overflow: hidden;
-            position: relative;
-        }
-        
-        .angle-fill {
-            height: 100%;
-            background: linear-gradient(90deg, #667eea 0%, #764ba2 100%);
-            transition: width 0.3s ease;
-            border-radius: 15px;
-        }
-        
-        .raw-value {
-            text-align: center;
-            margin-top: 15px;
-            color: #666;
-            font-size: 0.9em;
-        }
-        
-        .info {
-            background: #e7f3ff;
-            border-left: 4px solid #2196F3;
-            padding: 15px;
-            border-radius: 5px;
-            margin-top: 20px;
-        }
-        
-        .info p {
-            color: #0c5460;
-            margin: 5px 0;
-            font-size: 0.95em;
-        }
-        
-        @keyframes pulse {
-            0%, 100% { opacity: 1; }
-            50% { opacity: 0.5; }
-        }
-        
-        .updating {
-            animation: pulse 1s ease-in-out infinite;
-        }
-        
-        .logs-section {
-            background: #f8f9fa;
-            border-radius: 10px;
-            padding: 20px;
-            margin-top: 30px;
-            max-height: 400px;
-            overflow-y: auto;
-        }
-        
-        .logs-section h3 {
-            color: #333;
-            margin-bottom: 15px;
-            font-size: 1.3em;
-        }
-        
-        .log-entry {
-            font-family: 'Courier New', monospace;
-            font-size: 0.85em;
-            padding: 5px 10px;
-            margin: 3px 0;
-            border-radius: 3px;
-            background: white;
-            border-left: 3px solid #ccc;
-        }
-        
-        .log-entry.info {
-            border-left-color: #2196F3;
-        }
-        
-        .log-entry.warn {
-            border-left-color: #ff9800;
-            background: #fff8e1;
-        }
-        
-        .log-entry.error {
-            border-left-color: #f44336;
-            background: #ffebee;
-        }
-        
-        .log-timestamp {
-            color: #666;
-            margin-right: 10px;
-        }
-        
-        .log-level {
-            font-weight: bold;
-            margin-right: 10px;
-        }
-        
-        .log-level.info {
-            color: #2196F3;
-        }
-        
-        .log-level.warn {
-            color: #ff9800;
-        }
-        
-        .log-level.error {
-            color: #f44336;
-        }
-        
-        .log-message {
-            color: #333;
-        }
-        
-        @media (max-width: 768px) {
-            .container {
-                padding: 20px;
-            }
-            
-            h1 {
-                font-size: 2em;
-            }
-            
-            .angle-value {
-                font-size: 2.5em;
-            }
-            
-            .sensors {
-                grid-template-columns: 1fr;
-            }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1>🧭 AS5600 Sensor Monitor</h1>
-        <p class="subtitle">Real-time Magnetic Encoder Readings</p>
-        
-        <div id="status" class="status disconnected">
-            ⚠️ Connecting to WebSocket...
-        </div>
-        
-        <div class="sensors">
-            <div class="sensor-card">
-                <h2>Sensor 1</h2>
-                <div class="angle-display">
-                    <span id="angle1" class="angle-value">---</span>
-                    <span class="angle-unit">degrees</span>
-                </div>
-                <div class="angle-bar">
-                    <div id="bar1" class="angle-fill" style="width: 0%"></div>
-                </div>
-                <div class="raw-value">
-                    Raw: <span id="raw1">---</span> / 4095
-                </div>
-            </div>
-            
-            <div class="sensor-card">
-                <h2>Sensor 2</h2>
-                <div class="angle-display">
-                    <span id="angle2" class="angle-value">---</span>
-                    <span class="angle-unit">degrees</span>
-                </div>
-                <div class="angle-bar">
-                    <div id="bar2" class="angle-fill" style="width: 0%"></div>
-                </div>
-                <div class="raw-value">
-                    Raw: <span id="raw2">---</span> / 4095
-                </div>
-            </div>
-        </div>
-        
-        <div class="info">
-            <p><strong>ℹ️ Information:</strong></p>
-            <p>• AS5600 sensors provide 12-bit resolution (0-4095)</p>
-            <p>• Values are updated in real-time via WebSocket</p>
-            <p>• Angle range: 0° - 360°</p>
-        </div>
-        
-        <div class="logs-section">
-            <h3>📋 System Logs</h3>
-            <div id="logs-container">
-                <div class="log-entry">Loading logs...</div>
-            </div>
-        </div>
-    </div>
-    
-    <script>
-        let ws;
-        let reconnectInterval;
-        
-        function connectWebSocket() {
-            const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
-            const wsUrl = `${protocol}//${window.location.hostname}:81/`;
-            
-            ws = new WebSocket(wsUrl);
-            
-            ws.onopen = function() {
-                console.log('WebSocket connected');
-                document.getElementById('status').className = 'status connected';
-                document.getElementById('status').innerHTML = '✅ Connected';
-                clearInterval(reconnectInterval);
-            };
-            
-            ws.onmessage = function(event) {
-                try {
-                    const data = JSON.parse(event.data);
-                    updateSensor(1, data.angle1, data.raw1);
-                    updateSensor(2, data.angle2, data.raw2);
-                } catch (e) {
-                    console.error('Error parsing WebSocket data:', e);
-                }
-            };
-            
-            ws.onclose = function() {
-                console.log('WebSocket disconnected');
-                document.getElementById('status').className = 'status disconnected';
-                document.getElementById('status').innerHTML = '⚠️ Disconnected - Reconnecting...';
-                
-                // Try to reconnect every 3 seconds
-                reconnectInterval = setInterval(connectWebSocket, 3000);
-            };
-            
-            ws.onerror = function(error) {
-                console.error('WebSocket error:', error);
-            };
-        }
-        
-        function updateSensor(sensorNum, angle, raw) {
-            const angleElement = document.getElementById(`angle${sensorNum}`);
-            const rawElement = document.getElementById(`raw${sensorNum}`);
-            const barElement = document.getElementById(`bar${sensorNum}`);
-            
-            // Convert raw value (0-4095) to degrees (0-360)
-            const degrees = ((raw / 4095) * 360).toFixed(1);
-            const percentage = (raw / 4095 * 100).toFixed(1);
-            
-            angleElement.textContent = degrees;
-            rawElement.textContent = raw;
-            barElement.style.width = percentage + '%';
-            
-            // Add pulse animation on update
-            angleElement.classList.add('updating');
-            setTimeout(() => angleElement.classList.remove('updating'), 300);
-        }
-        
-        // Load and display system logs
-        function loadLogs() {
-            fetch('/logs')
-                .then(response => response.json())
-                .then(logs => {
-                    const container = document.getElementById('logs-container');
-                    
-                    if (logs.length === 0) {
-                        container.innerHTML = '<div class="log-entry">No logs available</div>';
-                        return;
-                    }
-                    
-                    container.innerHTML = '';
-                    
-                    // Display logs in reverse order (newest first)
-                    logs.reverse().forEach(log => {
-                        const entry = document.createElement('div');
-                        const levelClass = log.level.trim().toLowerCase();
-                        entry.className = `log-entry ${levelClass}`;
-                        
-                        entry.innerHTML = `
-                            <span class="log-timestamp">${log.timestamp}</span>
-                            <span class="log-level ${levelClass}">[${log.level.trim()}]</span>
-                            <span class="log-message">${log.message}</span>
-                        `;
-                        
-                        container.appendChild(entry);
-                    });
-                })
-                .catch(error => {
-                    console.error('Error loading logs:', error);
-                    document.getElementById('logs-container').innerHTML = 
-                        '<div class="log-entry error">Failed to load logs</div>';
-                });
-        }
-        
-        // Connect on page load
-        connectWebSocket();
-        loadLogs();
-    </script>
-</body>
-</html>
-)rawliteral";
+// Send an embedded dashboard asset, or 304 if the browser's copy is current
+static void sendAsset(AsyncWebServerRequest* request, const WebAssets::Asset& asset) {
+  AsyncWebServerResponse* response;
+  if (request->hasHeader("If-None-Match") &&
+      HttpCache::etagMatches(request->header("If-None-Match").c_str(), asset.etag)) {
+    response = request->beginResponse(304);
+  } else {
+    // Stored gzipped; every browser accepts it, and there is no plain copy
+    response = request->beginResponse(200, asset.contentType, asset.data, asset.size);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", asset.cacheControl);
+  request->send(response);
+}
+
+// Send the stored log entries as a JSON array, one entry per chunk as the
+// TCP window allows instead of one String holding the whole buffer. Only
+// entries stored before the request are sent; any dropped from the buffer
+// before their turn are skipped.
+struct LogStream {
+  uint32_t next;              // Number of the next entry (Logger::getEntryRange())
+  uint32_t end;
+  bool first;
+  String pending;             // Formatted but not yet sent
+  size_t offset;
+};
+
+static size_t fillLogs(LogStream& stream, uint8_t* buffer, size_t maxLen) {
+  size_t written = 0;
+  while (written < maxLen) {
+    if (stream.offset >= stream.pending.length()) {
+      if (stream.next == stream.end + 1) break;     // "]" sent
+      stream.offset = 0;
+      // Copied under the logger's lock: other tasks log meanwhile
+      LogEntry entry;
+      bool more = (int32_t)(stream.next - stream.end) < 0 &&
+                  logger.copyEntry(stream.next, entry) &&
+                  (int32_t)(stream.next - stream.end) < 0;
+      if (!more) {
+        stream.pending = "]";
+        stream.next = stream.end + 1;
+      } else {
+        stream.pending = stream.first ? "" : ",";
+        stream.pending += logger.getEntryJSON(entry);
+        stream.first = false;
+        stream.next++;
+      }
+    }
+    size_t count = stream.pending.length() - stream.offset;
+    if (count > maxLen - written) count = maxLen - written;
+    memcpy(buffer + written, stream.pending.c_str() + stream.offset, count);
+    stream.offset += count;
+    written += count;
+  }
+  return written;
+}
+
+static void sendLogs(AsyncWebServerRequest* request) {
+  std::shared_ptr<LogStream> stream(new LogStream());
+  logger.getEntryRange(stream->next, stream->end);
+  stream->first = true;
+  stream->pending = "[";
+  stream->offset = 0;
+  request->send(request->beginChunkedResponse("application/json",
+      [stream](uint8_t* buffer, size_t maxLen, size_t) -> size_t {
+        return fillLogs(*stream, buffer, maxLen);
+      }));
+}
 
 WebServerManager::WebServerManager() 
   : wifiEnabled(false), 
     serverPort(80), 
-    lastBroadcast(0),
-    currentAngle1(0), 
-    currentAngle2(0),
+    staging(),
+    latest(),
+    latestVersion(0),
+    snapshotMisses(0),
+    changeDriven(false),
+    lastMessageSize(0),
+    scheduler(SAMPLE_RATE_HZ),
+    clientEvents(nullptr),
+    lastCleanup(0),
+    messageSequence(0),
+    calibrationStart(nullptr),
+    calibrationStatus(nullptr),
     server(nullptr),
-    webSocket(nullptr) {
+    binarySocket(nullptr),
+    jsonSocket(nullptr) {
   instance = this;
+  for (uint8_t i = 0; i < SENSOR_GROUPS; i++) {
+    groupSeen[i] = 0;
+  }
+  for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+    clientId[i] = 0;
+    clientJson[i] = false;
+  }
 }
 
 bool WebServerManager::begin(const char* ssid, const char* password, uint16_t port) {
@@ -457,44 +140,110 @@ bool WebServerManager::begin(const char* ssid, const char* password, uint16_t po
   LOG_INFO("WiFi connected!");
   LOG_INFOF("IP Address: %s", WiFi.localIP().toString().c_str());
   
+  // Client events are applied by the network task
+  clientEvents = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(ClientEvent));
+  if (clientEvents == nullptr) {
+    LOG_ERROR("Failed to create WebSocket event queue");
+    wifiEnabled = false;
+    return false;
+  }
+  
   // Initialize web server
-  server = new WebServer(serverPort);
+  server = new AsyncWebServer(serverPort);
   
-  // Set up routes
-  server->on("/", []() {
-    instance->server->send_P(200, "text/html", INDEX_HTML);
-  });
+  // Set up routes (run in the AsyncTCP task). Dashboard page, stylesheet
+  // and script are gzipped at build time (tools/embed_web_assets.py) and
+  // streamed from flash as the TCP window allows.
+  for (size_t i = 0; i < WebAssets::COUNT; i++) {
+    const WebAssets::Asset* asset = &WebAssets::ASSETS[i];
+    server->on(asset->path, HTTP_GET, [asset](AsyncWebServerRequest* request) {
+      sendAsset(request, *asset);
+    });
+  }
   
-  // Logs endpoint - returns stored log entries as JSON
-  server->on("/logs", []() {
-    String logsJSON = logger.getEntriesJSON();
-    instance->server->send(200, "application/json", logsJSON);
+  // Logs endpoint - streams stored log entries as JSON
+  server->on("/logs", HTTP_GET, [](AsyncWebServerRequest* request) {
+    sendLogs(request);
   });
   
-  server->onNotFound([]() {
-    instance->server->send(404, "text/plain", "404: Not Found");
+  // Calibration endpoint - start a capture / query progress
+  server->on("/calibrate", HTTP_GET, [](AsyncWebServerRequest* request) {
+    instance->handleCalibrate(request);
   });
   
-  server->begin();
-  
-  LOG_INFOF("Web server started on port %d", serverPort);
-  
-  // Initialize WebSocket server on port 81
-  webSocket = new WebSocketsServer(81);
-  webSocket->begin();
-  webSocket->onEvent([](uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
+  // WebSocket endpoints on the same port: /ws binary, /ws/json JSON
+  AwsEventHandler onEvent = [](AsyncWebSocket* socket, AsyncWebSocketClient* client,
+                               AwsEventType type, void* arg, uint8_t* data, size_t length) {
     if (instance) {
-      instance->webSocketEvent(num, type, payload, length);
+      instance->webSocketEvent(socket, client, type, arg, data, length);
     }
+  };
+  binarySocket = new AsyncWebSocket("/ws");
+  binarySocket->onEvent(onEvent);
+  server->addHandler(binarySocket);
+  if (WEBSOCKET_JSON) {
+    jsonSocket = new AsyncWebSocket("/ws/json");
+    jsonSocket->onEvent(onEvent);
+    server->addHandler(jsonSocket);
+  }
+  
+  server->onNotFound([](AsyncWebServerRequest* request) {
+    request->send(404, "text/plain", "404: Not Found");
   });
   
-  LOG_INFO("WebSocket server started on port 81");
+  server->begin();
+  
+  LOG_INFOF("Web server started on port %d", serverPort);
+  LOG_INFOF("WebSocket on port %d: /ws%s", serverPort, jsonSocket ? ", /ws/json" : "");
   LOG_INFO("==========================");
   
   wifiEnabled = true;
   return true;
 }
 
+void WebServerManager::setChangeDriven(bool enabled, uint16_t deadband1, uint16_t deadband2,
+                                       uint32_t heartbeatMs) {
+  changeDriven = enabled;
+  outputGate.setDeadband(0, deadband1);
+  outputGate.setDeadband(1, deadband2);
+  outputGate.setHeartbeat(heartbeatMs);
+  outputGate.invalidate();
+  outputGate.resetStats();
+}
+
+void WebServerManager::setCalibrationHandlers(CalibrationStartHandler start,
+                                              CalibrationStatusHandler status) {
+  calibrationStart = start;
+  calibrationStatus = status;
+}
+
+void WebServerManager::handleCalibrate(AsyncWebServerRequest* request) {
+  if (!calibrationStart || !calibrationStatus) {
+    request->send(503, "text/plain", "Calibration not available");
+    return;
+  }
+  
+  int sensor = request->hasParam("sensor") ? request->getParam("sensor")->value().toInt() : 0;
+  if (sensor < 1 || sensor > 2) {
+    request->send(400, "text/plain", "sensor must be 1 or 2");
+    return;
+  }
+  
+  StaticJsonDocument<128> doc;
+  doc["sensor"] = sensor;
+  if (request->hasParam("start")) {
+    doc["started"] = calibrationStart(sensor - 1);
+  }
+  CalibrationStatus status = calibrationStatus(sensor - 1);
+  doc["active"] = status.active;
+  doc["calibrated"] = status.calibrated;
+  doc["progress"] = status.progress;
+  
+  String json;
+  serializeJson(doc, json);
+  request->send(200, "application/json", json);
+}
+
 String WebServerManager::getIPAddress() const {
   if (!wifiEnabled || WiFi.status() != WL_CONNECTED) {
     return "Not connected";
@@ -505,75 +254,323 @@ String WebServerManager::getIPAddress() const {
 void WebServerManager::handleClient() {
   if (!wifiEnabled) return;
   
-  if (server) {
-    server->handleClient();
+  ClientEvent event;
+  while (xQueueReceive(clientEvents, &event, 0) == pdTRUE) {
+    applyEvent(event);
   }
   
-  if (webSocket) {
-    webSocket->loop();
+  // Free closed clients' memory once a second
+  if (millis() - lastCleanup >= 1000) {
+    lastCleanup = millis();
+    binarySocket->cleanupClients();
+    if (jsonSocket) jsonSocket->cleanupClients();
   }
 }
 
-void WebServerManager::updateSensorData(uint16_t angle1, uint16_t angle2) {
-  currentAngle1 = angle1;
-  currentAngle2 = angle2;
+void WebServerManager::updateSensorData(uint16_t angle1, uint16_t angle2,
+                                        uint32_t time1Us, uint32_t time2Us) {
+  staging.angle[0] = angle1;
+  staging.angle[1] = angle2;
+  // A sensor whose time did not move (offline) has nothing new
+  if (time1Us == 0 || time1Us != staging.timeUs[0]) staging.updates[0]++;
+  if (time2Us == 0 || time2Us != staging.timeUs[1]) staging.updates[1]++;
+  staging.timeUs[0] = time1Us;
+  staging.timeUs[1] = time2Us;
+}
+
+void WebServerManager::updateMotionData(int32_t velocity1, int32_t velocity2,
+                                        int32_t acceleration1, int32_t acceleration2) {
+  staging.velocity[0] = velocity1;
+  staging.velocity[1] = velocity2;
+  staging.acceleration[0] = acceleration1;
+  staging.acceleration[1] = acceleration2;
+}
+
+void WebServerManager::updateTurnData(int32_t turns1, int32_t turns2) {
+  staging.turns[0] = turns1;
+  staging.turns[1] = turns2;
+}
+
+void WebServerManager::updateSensorArray(const uint16_t* angles, const uint32_t* timesUs,
+                                         uint8_t count) {
+  if (count > MAX_ARRAY_ANGLES) count = MAX_ARRAY_ANGLES;
+  for (uint8_t i = 0; i < count; i++) {
+    staging.arrayAngles[i] = angles[i];
+    staging.arrayTimeUs[i] = timesUs[i];
+  }
+  staging.arrayCount = count;
+  if (count >= 2) {
+    staging.angle[0] = angles[0];
+    staging.angle[1] = angles[1];
+    staging.timeUs[0] = timesUs[0];
+    staging.timeUs[1] = timesUs[1];
+    staging.updates[0]++;
+    staging.updates[1]++;
+  }
+  staging.updates[2]++;
+}
+
+void WebServerManager::publishSensorData() {
+  published.write(staging);
+}
+
+void WebServerManager::encodeBinary() {
+  WsMessage::SensorData data;
+  for (uint8_t i = 0; i < 2; i++) {
+    data.angle[i] = latest.angle[i];
+    data.timeUs[i] = latest.timeUs[i];
+    data.velocity[i] = latest.velocity[i];
+    data.acceleration[i] = latest.acceleration[i];
+    data.turns[i] = latest.turns[i];
+  }
+  data.array = latest.arrayAngles;
+  data.arrayTimeUs = latest.arrayTimeUs;
+  data.arrayCount = latest.arrayCount;
+  prepareBuffer(binaryMessage, WsMessage::MAX_SIZE);
+  binaryMessage->resize(WsMessage::encode(data, messageSequence, binaryMessage->data()));
+}
+
+void WebServerManager::encodeJSON() {
+  StaticJsonDocument<1024> doc;
+  doc["angle1"] = ((float)latest.angle[0] / 4095.0f) * 360.0f;
+  doc["angle2"] = ((float)latest.angle[1] / 4095.0f) * 360.0f;
+  doc["raw1"] = latest.angle[0];
+  doc["raw2"] = latest.angle[1];
+  doc["t1"] = latest.timeUs[0];
+  doc["t2"] = latest.timeUs[1];
+  doc["vel1"] = latest.velocity[0];
+  doc["vel2"] = latest.velocity[1];
+  doc["acc1"] = latest.acceleration[0];
+  doc["acc2"] = latest.acceleration[1];
+  doc["turns1"] = latest.turns[0];
+  doc["turns2"] = latest.turns[1];
+  
+  // Sensor array mode: all N raw angles and their sample times
+  if (latest.arrayCount > 0) {
+    JsonArray raw = doc.createNestedArray("raw");
+    JsonArray times = doc.createNestedArray("t");
+    for (uint8_t i = 0; i < latest.arrayCount; i++) {
+      raw.add(latest.arrayAngles[i]);
+      times.add(latest.arrayTimeUs[i]);
+    }
+  }
+  
+  prepareBuffer(jsonMessage, JSON_MESSAGE_SIZE);
+  jsonMessage->resize(serializeJson(doc, (char*)jsonMessage->data(), JSON_MESSAGE_SIZE));
+}
+
+void WebServerManager::prepareBuffer(AsyncWebSocketSharedBuffer& buffer, size_t size) {
+  // Still queued to a slow client: leave it alone and encode into a new one
+  if (!buffer || buffer.use_count() > 1) {
+    buffer = std::make_shared<std::vector<uint8_t>>(size);
+  } else {
+    buffer->resize(size);
+  }
 }
 
 void WebServerManager::broadcastSensorData() {
-  if (!wifiEnabled || !webSocket) return;
+  if (!wifiEnabled || !binarySocket) return;
   
-  // Check if it's time to broadcast
-  unsigned long currentTime = millis();
-  if (currentTime - lastBroadcast < WEBSOCKET_UPDATE_MS) {
-    return;
+  uint32_t nowUs = micros();
+  
+  // Take the newest sample set; on a miss (every try overlapped a write)
+  // keep the previous one, the next call catches up
+  uint32_t version = published.version();
+  if (version != latestVersion) {
+    if (published.read(latest)) {
+      latestVersion = version;
+    } else {
+      snapshotMisses++;
+    }
   }
   
-  lastBroadcast = currentTime;
+  // Sensor groups with fresh data since the last call
+  uint8_t fresh = 0;
+  for (uint8_t i = 0; i < SENSOR_GROUPS; i++) {
+    if (latest.updates[i] != groupSeen[i]) {
+      groupSeen[i] = latest.updates[i];
+      fresh |= 1 << i;
+    }
+  }
   
-  // Create JSON document
-  StaticJsonDocument<128> doc;
-  doc["angle1"] = ((float)currentAngle1 / 4095.0f) * 360.0f;
-  doc["angle2"] = ((float)currentAngle2 / 4095.0f) * 360.0f;
-  doc["raw1"] = currentAngle1;
-  doc["raw2"] = currentAngle2;
+  // Change-driven: angle updates that stayed inside the deadband are not
+  // news (heartbeat excepted)
+  const uint8_t pair = Scheduler::SENSOR_1 | Scheduler::SENSOR_2;
+  if (changeDriven && (fresh & pair)) {
+    if (!outputGate.shouldSend(latest.angle, millis(), lastMessageSize)) {
+      fresh &= ~pair;
+    }
+  }
+  if (fresh) {
+    scheduler.publish(fresh);
+  }
+  
+  // Nobody due: no serialization at all
+  if (!scheduler.anyDue(nowUs)) {
+    return;
+  }
   
-  String jsonString;
-  serializeJson(doc, jsonString);
+  // Encode only the formats a due client receives, once each
+  bool anyBinary = false;
+  bool anyJson = false;
+  for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+    if (!scheduler.isDue(i, nowUs)) continue;
+    if (clientJson[i]) anyJson = true;
+    else anyBinary = true;
+  }
+  messageSequence++;
+  if (anyBinary) encodeBinary();
+  if (anyJson) encodeJSON();
+  lastMessageSize = anyBinary ? binaryMessage->size() : jsonMessage->size();
   
-  // Broadcast to all connected clients
-  webSocket->broadcastTXT(jsonString);
+  for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+    if (!scheduler.isDue(i, nowUs)) continue;
+    AsyncWebSocketClient* client = getClient(i);
+    if (client == nullptr) {
+      // Gone without a queued disconnect (event queue was full)
+      scheduler.disconnect(i);
+      clientId[i] = 0;
+      continue;
+    }
+    
+    // Congested: frames still queued in the library or no TCP window left
+    bool congested = client->queueLen() >= WEBSOCKET_QUEUE_LIMIT || !client->canSend();
+    switch (scheduler.attempt(i, nowUs, congested)) {
+      case Scheduler::SEND:
+        // Queues a reference to the shared buffer, no copy
+        if (clientJson[i]) {
+          client->text(jsonMessage);
+        } else {
+          client->binary(binaryMessage);
+        }
+        break;
+      case Scheduler::DROP:
+        LOG_WARNF("WebSocket #%lu dropped: send buffer full for %lu ms",
+                  (unsigned long)clientId[i], (unsigned long)(Scheduler::DROP_AFTER_US / 1000));
+        client->close();
+        clientId[i] = 0;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+int WebServerManager::findSlot(uint32_t id, bool json) const {
+  for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+    if (clientId[i] != 0 && clientId[i] == id && clientJson[i] == json) return i;
+  }
+  return -1;
+}
+
+AsyncWebSocketClient* WebServerManager::getClient(uint8_t slot) {
+  AsyncWebSocket* socket = clientJson[slot] ? jsonSocket : binarySocket;
+  if (socket == nullptr || clientId[slot] == 0) return nullptr;
+  return socket->client(clientId[slot]);
 }
 
-void WebServerManager::webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
-  switch(type) {
-    case WStype_DISCONNECTED:
-      LOG_DEBUGF("WebSocket [%u] disconnected", num);
+void WebServerManager::applyEvent(const ClientEvent& event) {
+  int slot = findSlot(event.id, event.json);
+  
+  switch (event.type) {
+    case ClientEvent::CONNECT:
+      {
+        AsyncWebSocket* socket = event.json ? jsonSocket : binarySocket;
+        AsyncWebSocketClient* client = socket->client(event.id);
+        if (client == nullptr || slot >= 0) break;
+        for (uint8_t i = 0; i < MAX_CLIENTS && slot < 0; i++) {
+          if (clientId[i] == 0) slot = i;
+        }
+        if (slot < 0) {
+          LOG_WARNF("WebSocket #%lu rejected: %u clients connected",
+                    (unsigned long)event.id, MAX_CLIENTS);
+          client->close();
+          break;
+        }
+        
+        IPAddress ip = client->remoteIP();
+        LOG_DEBUGF("WebSocket #%lu connected from %d.%d.%d.%d (%s)", (unsigned long)event.id,
+                   ip[0], ip[1], ip[2], ip[3], event.json ? "json" : "binary");
+        clientId[slot] = event.id;
+        clientJson[slot] = event.json;
+        
+        // All sensors at the default rate until the client subscribes; the
+        // current data goes out on the next broadcast
+        scheduler.connect(slot, Scheduler::ALL_SENSORS, 1000 / WEBSOCKET_UPDATE_MS, micros());
+      }
+      break;
+      
+    case ClientEvent::DISCONNECT:
+      if (slot < 0) break;
+      LOG_DEBUGF("WebSocket #%lu disconnected", (unsigned long)event.id);
+      scheduler.disconnect(slot);
+      clientId[slot] = 0;
       break;
       
-    case WStype_CONNECTED:
+    case ClientEvent::SUBSCRIBE:
       {
-        IPAddress ip = webSocket->remoteIP(num);
-        LOG_DEBUGF("WebSocket [%u] connected from %d.%d.%d.%d", 
-                   num, ip[0], ip[1], ip[2], ip[3]);
-        
-        // Send initial data to newly connected client
-        StaticJsonDocument<128> doc;
-        doc["angle1"] = ((float)currentAngle1 / 4095.0f) * 360.0f;
-        doc["angle2"] = ((float)currentAngle2 / 4095.0f) * 360.0f;
-        doc["raw1"] = currentAngle1;
-        doc["raw2"] = currentAngle2;
-        
-        String jsonString;
-        serializeJson(doc, jsonString);
-        webSocket->sendTXT(num, jsonString);
+        if (slot < 0) break;
+        uint8_t sensors = event.sensors >= 0 ? (uint8_t)event.sensors : scheduler.getSensors(slot);
+        uint32_t rate = event.rate >= 0 ? (uint32_t)event.rate : scheduler.getClientStats(slot).rateHz;
+        rate = scheduler.subscribe(slot, sensors, rate);
+        LOG_DEBUGF("WebSocket #%lu subscribed: sensors 0x%02X at %lu Hz", (unsigned long)event.id,
+                   scheduler.getSensors(slot), (unsigned long)rate);
+        
+        StaticJsonDocument<128> reply;
+        reply["sensors"] = scheduler.getSensors(slot);
+        reply["rate"] = rate;
+        reply["maxRate"] = scheduler.getMaxRate();
+        char json[96];
+        size_t jsonSize = serializeJson(reply, json, sizeof(json));
+        AsyncWebSocketClient* client = getClient(slot);
+        if (client) client->text(json, jsonSize);
       }
       break;
+  }
+}
+
+void WebServerManager::webSocketEvent(AsyncWebSocket* socket, AsyncWebSocketClient* client,
+                                      AwsEventType type, void* arg, uint8_t* data, size_t length) {
+  ClientEvent event;
+  event.json = (socket == jsonSocket);
+  event.id = client->id();
+  event.sensors = -1;
+  event.rate = -1;
+  
+  switch (type) {
+    case WS_EVT_CONNECT:
+      event.type = ClientEvent::CONNECT;
+      break;
       
-    case WStype_TEXT:
-      LOG_DEBUGF("WebSocket [%u] received text: %s", num, payload);
+    case WS_EVT_DISCONNECT:
+      event.type = ClientEvent::DISCONNECT;
       break;
       
-    default:
+    case WS_EVT_DATA:
+      {
+        // {"sensors":mask,"rate":hz} in a single text frame
+        AwsFrameInfo* info = (AwsFrameInfo*)arg;
+        if (!info->final || info->index != 0 || info->len != length || info->opcode != WS_TEXT) {
+          return;
+        }
+        StaticJsonDocument<128> request;
+        if (deserializeJson(request, data, length)) {
+          LOG_WARNF("WebSocket #%lu bad subscription request", (unsigned long)event.id);
+          return;
+        }
+        event.type = ClientEvent::SUBSCRIBE;
+        if (request.containsKey("sensors")) event.sensors = request["sensors"].as<uint8_t>();
+        if (request.containsKey("rate")) event.rate = request["rate"].as<int32_t>();
+      }
       break;
+      
+    default:
+      return;
+  }
+  
+  // Queue full: a connect is refused, a lost disconnect is noticed by the
+  // broadcast (the client lookup fails)
+  if (xQueueSend(clientEvents, &event, 0) != pdTRUE) {
+    if (type == WS_EVT_CONNECT) client->close();
   }
 }
@@ -0,0 +1,197 @@
+// ============================================================================
+// Change Gate Trace - ChangeDetector on synthetic sensor traces
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/change_gate_trace.cpp -o change_gate_trace
+//
+// Usage:
+//
+//   change_gate_trace [--rate HZ] [--seconds S] [--deadband COUNTS] [--heartbeat MS]
+//
+// Drives ChangeDetector<2> (the UART/WebSocket output gate) with traces of
+// two sensors sampled at --rate: a still shaft with +-1 count noise, slow
+// and fast rotation through the 4095 -> 0 wrap, steps, and a mix of idle
+// and motion. On every sample it checks that:
+//   - a suppressed sample is within the deadband of the last sent value on
+//     both sensors (wrap-aware), so a receiver is never further off;
+//   - no two sends are more than the heartbeat apart, including across
+//     the 32-bit millisecond counter wrap;
+//   - the counters add up (sent + heartbeats + suppressed = samples, bytes
+//     sent + saved = samples * message size).
+// It also checks that noise inside the deadband sends nothing but
+// heartbeats, and that invalidate() forces the next send. Prints the share
+// of messages and bytes saved per trace. Exits non-zero on any failure.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "change_detector.h"
+#include "check.h"
+
+static const uint32_t MESSAGE_BYTES = 7;
+
+static int32_t wrapDelta(uint16_t to, uint16_t from) {
+  int32_t delta = (int32_t)((to - from) & 0x0FFF);
+  return delta >= 2048 ? delta - 4096 : delta;
+}
+
+struct Config {
+  uint32_t rate;
+  uint32_t seconds;
+  uint16_t deadband;
+  uint32_t heartbeatMs;
+};
+
+// Angle of one sensor at sample i, in counts (may leave 0..4095)
+typedef double (*TraceFn)(uint32_t i, uint8_t sensor, const Config& config, std::mt19937& rng);
+
+static double still(uint32_t, uint8_t sensor, const Config&, std::mt19937& rng) {
+  std::uniform_int_distribution<int> noise(-1, 1);
+  return (sensor == 0 ? 4095.0 : 1000.0) + noise(rng);
+}
+
+static double slow(uint32_t i, uint8_t sensor, const Config& config, std::mt19937&) {
+  // 0.1 turn/s forward and backward, both through the wrap
+  double turns = 0.1 * i / config.rate;
+  return 4000.0 + (sensor == 0 ? 1.0 : -1.0) * turns * 4096.0;
+}
+
+static double fast(uint32_t i, uint8_t sensor, const Config& config, std::mt19937&) {
+  double turns = 5.0 * i / config.rate;
+  return (sensor == 0 ? 0.0 : 2048.0) + turns * 4096.0;
+}
+
+static double steps(uint32_t i, uint8_t sensor, const Config& config, std::mt19937&) {
+  // A jump of 100 counts every half second, otherwise still
+  uint32_t step = i / (config.rate / 2);
+  return 4050.0 + (sensor == 0 ? 100.0 : 30.0) * step;
+}
+
+static double mixed(uint32_t i, uint8_t sensor, const Config& config, std::mt19937& rng) {
+  // Moves for 1 s out of every 5 s, noisy throughout
+  std::normal_distribution<double> noise(0.0, 0.4);
+  double t = (double)i / config.rate;
+  double cycle = fmod(t, 5.0);
+  double position = floor(t / 5.0) * 2048.0 + (cycle < 1.0 ? cycle : 1.0) * 2048.0;
+  return position + (sensor == 0 ? 0.0 : 300.0) + noise(rng);
+}
+
+static void runTrace(const char* name, TraceFn trace, const Config& config, uint32_t startMs) {
+  ChangeDetector<2> gate;
+  gate.setDeadband(0, config.deadband);
+  gate.setDeadband(1, config.deadband);
+  gate.setHeartbeat(config.heartbeatMs);
+
+  std::mt19937 rng(1);
+  uint32_t samples = config.rate * config.seconds;
+  uint16_t lastSent[2] = { 0, 0 };
+  uint32_t lastSendMs = startMs;
+  uint32_t maxGapMs = 0;
+  bool outsideDeadband = false;
+  bool gapTooLong = false;
+
+  for (uint32_t i = 0; i < samples; i++) {
+    // Millisecond clock as the firmware sees it (wraps)
+    uint32_t nowMs = startMs + (uint32_t)((uint64_t)i * 1000 / config.rate);
+    uint16_t angles[2];
+    for (uint8_t s = 0; s < 2; s++) {
+      long counts = lround(trace(i, s, config, rng));
+      angles[s] = (uint16_t)(counts & 0x0FFF);
+    }
+
+    if (gate.shouldSend(angles, nowMs, MESSAGE_BYTES)) {
+      uint32_t gap = nowMs - lastSendMs;
+      if (i > 0 && gap > maxGapMs) maxGapMs = gap;
+      lastSendMs = nowMs;
+      lastSent[0] = angles[0];
+      lastSent[1] = angles[1];
+    } else {
+      for (uint8_t s = 0; s < 2; s++) {
+        int32_t delta = wrapDelta(angles[s], lastSent[s]);
+        if (delta > config.deadband || delta < -(int32_t)config.deadband) {
+          outsideDeadband = true;
+        }
+      }
+      // The next sample can at the latest go out as a heartbeat
+      if (nowMs - lastSendMs > config.heartbeatMs) gapTooLong = true;
+    }
+  }
+
+  const ChangeDetector<2>::Stats& stats = gate.getStats();
+  uint32_t total = stats.sent + stats.heartbeats + stats.suppressed;
+  double saved = 100.0 * stats.suppressed / samples;
+  printf("%-7s %7u samples  motion %6u  heartbeat %4u  suppressed %6u (%5.1f%%)  "
+         "max gap %u ms\n", name, samples, stats.sent, stats.heartbeats, stats.suppressed,
+         saved, maxGapMs);
+
+  check(!outsideDeadband, "suppressed samples stay within the deadband", name);
+  check(!gapTooLong && maxGapMs <= config.heartbeatMs + 1000 / config.rate + 1,
+        "sends at least every heartbeat", name);
+  check(total == samples, "sent + heartbeats + suppressed = samples", name);
+  check(stats.bytesSent + stats.bytesSaved == samples * MESSAGE_BYTES, "bytes add up", name);
+  check(stats.bytesSaved == stats.suppressed * MESSAGE_BYTES, "bytes saved", name);
+
+  if (trace == still) {
+    check(stats.sent == 1, "noise inside the deadband sends only heartbeats", name);
+    uint32_t expected = config.seconds * 1000 / config.heartbeatMs;
+    check(stats.heartbeats + 1 >= expected && stats.heartbeats <= expected,
+          "one heartbeat per interval", name);
+  }
+  if (trace == fast) {
+    check(stats.suppressed == 0 || config.deadband >= 4096 * 5 / config.rate,
+          "fast rotation sends every sample", name);
+  }
+}
+
+static void checkInvalidate(const Config& config) {
+  ChangeDetector<2> gate;
+  gate.setDeadband(0, config.deadband);
+  gate.setDeadband(1, config.deadband);
+  gate.setHeartbeat(config.heartbeatMs);
+  const uint16_t angles[2] = { 10, 20 };
+  check(gate.shouldSend(angles, 0, MESSAGE_BYTES), "first sample is sent", "invalidate");
+  check(!gate.shouldSend(angles, 1, MESSAGE_BYTES), "unchanged sample suppressed", "invalidate");
+  gate.invalidate();
+  check(gate.shouldSend(angles, 2, MESSAGE_BYTES), "invalidate forces a send", "invalidate");
+  check(gate.getStats().sent == 2 && gate.getStats().heartbeats == 0,
+        "forced send counted as motion", "invalidate");
+}
+
+int main(int argc, char** argv) {
+  Config config;
+  config.rate = 1000;
+  config.seconds = 20;
+  config.deadband = 2;
+  config.heartbeatMs = 1000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--rate") && i + 1 < argc) config.rate = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) config.seconds = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--deadband") && i + 1 < argc) config.deadband = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--heartbeat") && i + 1 < argc) config.heartbeatMs = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--rate HZ] [--seconds S] [--deadband COUNTS] "
+              "[--heartbeat MS]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (config.rate < 10) config.rate = 10;
+  if (config.seconds < 2) config.seconds = 2;
+  if (config.heartbeatMs < 1) config.heartbeatMs = 1;
+
+  printf("%u Hz, %u s per trace, deadband %u counts, heartbeat %u ms\n", config.rate,
+         config.seconds, config.deadband, config.heartbeatMs);
+  runTrace("still", still, config, 0);
+  runTrace("slow", slow, config, 0);
+  runTrace("fast", fast, config, 0);
+  runTrace("steps", steps, config, 0);
+  runTrace("mixed", mixed, config, 0);
+  // Same idle trace with the millisecond counter wrapping halfway
+  runTrace("ms wrap", still, config, 0xFFFFFFFFu - config.seconds * 500);
+  checkInvalidate(config);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// ============================================================================
+// Failure Counting for Host Tools
+// ============================================================================
+// check() prints a FAIL line for every condition that does not hold, with
+// the trace, scenario or policy it belongs to when one is given, and counts
+// it in `failures`; a tool ends by printing PASS or FAIL and exits non-zero
+// on any failure. One translation unit per tool, so the counter is static.
+
+#include <stdio.h>
+
+static int failures = 0;
+
+static inline void check(bool condition, const char* what) {
+  if (!condition) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static inline void check(bool condition, const char* what, const char* subject) {
+  if (!condition) {
+    printf("FAIL (%s): %s\n", subject, what);
+    failures++;
+  }
+}
+
+#endif // CHECK_H
@@ -0,0 +1,202 @@
+// ============================================================================
+// Clock Sync Check - ClockSync against simulated skewed clocks
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/clock_sync_check.cpp -o clock_sync_check
+//
+// Usage:
+//
+//   clock_sync_check [--pings N] [--interval MS]
+//
+// Simulates a receiver and a sender whose clocks run at different rates
+// (up to +-100 ppm each) from arbitrary offsets, both wrapping their 32-bit
+// microsecond counters during the run. Every --interval the receiver pings
+// (t1..t4 as in clock_sync.h) over a link with a fixed wire time plus
+// queueing delay, and a sample taken by the sender between pings is
+// converted with toLocal()/toRemote() and compared with the true instant.
+// For each scenario it checks that:
+//   - the offset is available from the first exchange and the drift is
+//     fitted once the window spans MIN_DRIFT_SPAN_US;
+//   - the fitted drift is within 5 ppm of the true relative rate, or within
+//     twice the conversion bound over the window span if that is looser
+//     (short windows with queueing);
+//   - once synced, conversions are within a bound set by the path
+//     asymmetry: 5 us on a symmetric path, 600 us with asymmetric
+//     queueing (mean 3 ms one way, 0.6 ms the other);
+//   - recordLatency() reports the true sample age within the same bound;
+//   - exchanges with a negative or excessive delay are rejected and leave
+//     the estimate unchanged.
+// --interval is clamped so the window spans between twice MIN_DRIFT_SPAN_US
+// and half the wrap. Exits non-zero on any failure.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "clock_sync.h"
+
+// A clock reading rate * t + offset microseconds at true time t, wrapping
+struct SimClock {
+  double rate;
+  double offsetUs;
+
+  uint32_t at(double t) const {
+    return (uint32_t)(uint64_t)(int64_t)llround(t * rate + offsetUs);
+  }
+};
+
+struct Scenario {
+  const char* name;
+  double receiverPpm;
+  double senderPpm;
+  double receiverOffsetUs;
+  double senderOffsetUs;
+  double forwardQueueUs;        // Mean queueing delay, receiver -> sender
+  double returnQueueUs;         // Mean queueing delay, sender -> receiver
+  double boundUs;               // Allowed conversion error once synced
+};
+
+static const double WIRE_US = 700;          // ~8 bytes at 115200 baud
+static const double PROCESSING_US = 40;     // Sender, t2 -> t3
+static const double SAMPLE_AGE_US = 1500;   // Sample taken -> received
+
+static void runScenario(const Scenario& s, uint32_t pings, double intervalUs) {
+  double windowUs = ClockSync::WINDOW * ClockSync::BUCKET * intervalUs;
+  SimClock receiver = { 1 + s.receiverPpm * 1e-6, s.receiverOffsetUs };
+  SimClock sender = { 1 + s.senderPpm * 1e-6, s.senderOffsetUs };
+  std::mt19937 rng(1);
+  std::exponential_distribution<double> forward(1.0 / fmax(s.forwardQueueUs, 1));
+  std::exponential_distribution<double> back(1.0 / fmax(s.returnQueueUs, 1));
+
+  ClockSync sync;
+  double t = 1e6;
+  double worstSynced = 0;
+  double worstOffsetOnly = 0;
+  double sumSquares = 0;
+  uint32_t synced = 0;
+  int syncedAt = -1;
+  bool offsetFromFirst = true;
+  for (uint32_t i = 0; i < pings; i++) {
+    t += intervalUs;
+    double t1 = t;
+    double t2 = t1 + WIRE_US + (s.forwardQueueUs > 0 ? forward(rng) : 0);
+    double t3 = t2 + PROCESSING_US;
+    double t4 = t3 + WIRE_US + (s.returnQueueUs > 0 ? back(rng) : 0);
+    sync.addExchange(receiver.at(t1), sender.at(t2), sender.at(t3), receiver.at(t4));
+    if (!sync.hasOffset()) offsetFromFirst = false;
+    if (sync.isSynced() && syncedAt < 0) syncedAt = (int)i;
+
+    // A sample taken half way to the next ping, received SAMPLE_AGE_US later
+    double sampleT = t + intervalUs / 2;
+    uint32_t senderUs = sender.at(sampleT);
+    uint32_t receiverUs = receiver.at(sampleT);
+    double toLocalError = (int32_t)(sync.toLocal(senderUs) - receiverUs);
+    double toRemoteError = (int32_t)(sync.toRemote(receiverUs) - senderUs);
+    double error = fabs(toLocalError) > fabs(toRemoteError) ? toLocalError : toRemoteError;
+    if (!sync.isSynced()) {
+      if (fabs(error) > worstOffsetOnly) worstOffsetOnly = fabs(error);
+      continue;
+    }
+    if (fabs(error) > worstSynced) worstSynced = fabs(error);
+    sumSquares += error * error;
+    synced++;
+    sync.recordLatency(senderUs, receiver.at(sampleT + SAMPLE_AGE_US));
+  }
+
+  double trueDriftPpb = (sender.rate / receiver.rate - 1) * 1e9;
+  double driftError = sync.getDriftPpb() - trueDriftPpb;
+  const ClockSync::LatencyStats& latency = sync.getLatencyStats();
+  double rms = synced > 0 ? sqrt(sumSquares / synced) : 0;
+  double ageUs = SAMPLE_AGE_US * receiver.rate;    // On the receiver's clock
+  printf("%-11s drift %7d ppb (true %7.0f), synced after %3d pings, error rms %5.1f us, "
+         "worst %5.0f us (%5.0f before sync), age %d..%d us (true %.0f)\n", s.name,
+         sync.getDriftPpb(), trueDriftPpb, syncedAt + 1, rms, worstSynced, worstOffsetOnly,
+         latency.minUs, latency.maxUs, ageUs);
+
+  // Drift is fitted once there are three points (two closed buckets and the
+  // open one) spanning MIN_DRIFT_SPAN_US from the oldest bucket's best
+  // exchange (at worst its last ping)
+  int expectedSync = (int)ceil(ClockSync::MIN_DRIFT_SPAN_US / intervalUs) + ClockSync::BUCKET;
+  if (expectedSync < 2 * (int)ClockSync::BUCKET) expectedSync = 2 * ClockSync::BUCKET;
+  check(offsetFromFirst, "offset available from the first exchange", s.name);
+  check(syncedAt >= 0 && syncedAt <= expectedSync, "drift fitted once the window spans enough",
+        s.name);
+  // An offset error of up to the bound at either end of the window
+  double driftBoundPpb = fmax(5000, 2 * s.boundUs / windowUs * 1e9);
+  check(fabs(driftError) <= driftBoundPpb, "drift within the bound", s.name);
+  check(worstSynced <= s.boundUs, "conversions within the bound once synced", s.name);
+  check(latency.minUs >= ageUs - s.boundUs && latency.maxUs <= ageUs + s.boundUs &&
+        latency.negative == 0, "sample ages within the bound", s.name);
+}
+
+static void checkRejection() {
+  ClockSync sync;
+  // A clean exchange: 1000 us each way, sender 5000 us ahead
+  check(sync.addExchange(0, 6000, 6040, 2040), "clean exchange accepted", "rejection");
+  uint32_t offset = sync.getOffsetUs(1000);
+  check(offset == 5000, "offset from one exchange", "rejection");
+
+  // Reply before the ping, processing negative, delay over MAX_DELAY_US
+  check(!sync.addExchange(10000, 16000, 16040, 9000), "reply before ping", "rejection");
+  check(!sync.addExchange(10000, 16040, 16000, 12000), "negative processing", "rejection");
+  check(!sync.addExchange(10000, 15000, 15000 + 500, 10000 + 100),
+        "negative delay", "rejection");
+  check(!sync.addExchange(10000, 16000, 16040, 10000 + ClockSync::MAX_DELAY_US + 100),
+        "excessive delay", "rejection");
+  check(sync.getStats().rejected == 4 && sync.getStats().exchanges == 1, "rejections counted",
+        "rejection");
+  check(sync.getOffsetUs(1000) == offset, "rejected exchanges leave the estimate", "rejection");
+
+  sync.reset();
+  check(!sync.hasOffset() && !sync.isSynced() && sync.getStats().exchanges == 0, "reset",
+        "rejection");
+  printf("rejection 4 bad exchanges rejected, estimate unchanged\n");
+}
+
+int main(int argc, char** argv) {
+  uint32_t pings = 600;
+  double intervalMs = 500;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--pings") && i + 1 < argc) pings = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--interval") && i + 1 < argc) intervalMs = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--pings N] [--interval MS]\n", argv[0]);
+      return 2;
+    }
+  }
+  // The window (WINDOW x BUCKET pings) must span more than MIN_DRIFT_SPAN_US
+  // (twice, so drift is fitted before it fills) and less than half the wrap
+  double pingsPerWindow = ClockSync::WINDOW * ClockSync::BUCKET;
+  double minIntervalMs = 2.0 * ClockSync::MIN_DRIFT_SPAN_US / 1000 / pingsPerWindow;
+  double maxIntervalMs = 2000e6 / 1000 / pingsPerWindow;
+  if (intervalMs < minIntervalMs) intervalMs = minIntervalMs;
+  if (intervalMs > maxIntervalMs) intervalMs = maxIntervalMs;
+  // Long enough to fit drift and fill the window
+  uint32_t minPings = (uint32_t)(ClockSync::MIN_DRIFT_SPAN_US / (intervalMs * 1000)) +
+                      ClockSync::WINDOW * ClockSync::BUCKET;
+  if (pings < minPings) pings = minPings;
+  double runUs = pings * intervalMs * 1000;
+
+  // Offsets chosen so each clock wraps half way through the run
+  double wrapUs = 4294967296.0;
+  double midWrap = wrapUs - runUs / 2;
+  const Scenario scenarios[] = {
+    { "same clock", 0, 0, 0, 0, 0, 0, 5 },
+    { "symmetric", 20, -15, midWrap, 12345, 0, 0, 5 },
+    { "fast/slow", 100, -100, 123456, midWrap, 0, 0, 5 },
+    { "queueing", -40, 35, midWrap, midWrap - 3e6, 3000, 600, 600 },
+    { "reversed", 80, -80, 987654, midWrap, 600, 3000, 600 },
+  };
+
+  printf("%u pings every %.0f ms\n", pings, intervalMs);
+  for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+    runScenario(scenarios[i], pings, intervalMs * 1000);
+  }
+  checkRejection();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
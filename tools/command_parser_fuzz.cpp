@@ -0,0 +1,266 @@
+// ============================================================================
+// Command Parser Fuzz - Command::Parser on mixed, corrupted and random input
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/command_parser_fuzz.cpp -o command_parser_fuzz
+//
+// Usage:
+//
+//   command_parser_fuzz [--events N] [--random BYTES]
+//
+// Feeds Command::Parser (the UART command channel) byte by byte:
+//   - triggers: a lone 0x00 at the start, after a frame and after another
+//     trigger is a trigger; the delimiter ending a frame or a fragment is not;
+//   - mixed stream: --events of valid commands (random ids, 0-63 argument
+//     bytes), lone triggers, frames of other types, zero-free line noise,
+//     truncated frames and bursts longer than MAX_ENCODED, each damaged frame
+//     followed by a delimiter as a resyncing host sends one. Every command
+//     and trigger must come out exactly once, in order, with its sequence,
+//     id and arguments, and nothing else;
+//   - corruption: every single-bit flip of a set of command frames is
+//     rejected, never delivered as a (different) command;
+//   - random bytes: --random bytes of noise (zeros ten times as common as
+//     other values) never yield a request whose arguments run past the
+//     frame buffer.
+// Prints the parser and frame counters and ns per byte. Exits non-zero on any
+// failure. Build with -fsanitize=address,undefined to check memory safety.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "check.h"
+#include "command_parser.h"
+
+// What the parser should report, in order
+struct Expected {
+  bool trigger;
+  uint16_t sequence;
+  uint8_t id;
+  std::vector<uint8_t> args;
+
+  Expected() : trigger(false), sequence(0), id(0) {}
+};
+
+struct Counts {
+  uint32_t commands;
+  uint32_t triggers;
+};
+
+static Counts feed(Command::Parser& parser, const std::vector<uint8_t>& bytes,
+                   std::vector<Expected>* expected, bool& mismatch) {
+  Counts counts = { 0, 0 };
+  size_t next = 0;
+  for (size_t i = 0; i < bytes.size(); i++) {
+    Command::Parser::Event event = parser.push(bytes[i]);
+    if (event == Command::Parser::NONE) continue;
+    if (event == Command::Parser::TRIGGER) counts.triggers++;
+    if (event == Command::Parser::COMMAND) counts.commands++;
+    if (expected == nullptr) continue;
+    if (next >= expected->size()) {
+      mismatch = true;
+      continue;
+    }
+    const Expected& want = (*expected)[next++];
+    if (want.trigger != (event == Command::Parser::TRIGGER)) {
+      mismatch = true;
+      continue;
+    }
+    if (want.trigger) continue;
+    const Command::Request& request = parser.request();
+    if (request.sequence != want.sequence || request.id != want.id ||
+        request.length != want.args.size() ||
+        (!want.args.empty() &&
+         memcmp(request.args, want.args.data(), want.args.size()) != 0)) {
+      mismatch = true;
+    }
+  }
+  if (expected != nullptr && next != expected->size()) mismatch = true;
+  return counts;
+}
+
+static void append(std::vector<uint8_t>& bytes, const uint8_t* data, size_t length) {
+  bytes.insert(bytes.end(), data, data + length);
+}
+
+static void checkTriggers() {
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  const uint8_t args[2] = { 100, 0 };
+  size_t length = Command::encodeCommand(7, Command::SET_RATE, args, 2, frame);
+
+  std::vector<uint8_t> bytes;
+  bytes.push_back(0);                             // Trigger at the start
+  append(bytes, frame, length);                   // Command
+  bytes.push_back(0);                             // Trigger after a frame
+  bytes.push_back(0);                             // Trigger after a trigger
+  append(bytes, frame, length - 4);               // Fragment...
+  bytes.push_back(0);                             // ...ended: not a trigger
+  append(bytes, frame, length);                   // Command
+
+  Command::Parser parser;
+  bool mismatch = false;
+  Counts counts = feed(parser, bytes, nullptr, mismatch);
+  printf("triggers  %u commands, %u triggers (expected 2, 3)\n", counts.commands,
+         counts.triggers);
+  check(counts.commands == 2 && counts.triggers == 3, "trigger and delimiter cases");
+}
+
+static void checkMixed(uint32_t events) {
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> kind(0, 99);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<int> nonZero(1, 255);
+  std::uniform_int_distribution<int> argLength(0, (int)ProtocolV2::MAX_PAYLOAD - 1);
+
+  std::vector<uint8_t> bytes;
+  std::vector<Expected> expected;
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  uint16_t sequence = 0;
+  uint32_t commands = 0;
+  uint32_t triggers = 0;
+  uint32_t damaged = 0;
+
+  for (uint32_t e = 0; e < events; e++) {
+    int k = kind(rng);
+    if (k < 50) {
+      // Valid command
+      Expected want;
+      want.trigger = false;
+      want.sequence = sequence++;
+      want.id = (uint8_t)byte(rng);
+      want.args.resize(argLength(rng));
+      for (size_t i = 0; i < want.args.size(); i++) want.args[i] = (uint8_t)byte(rng);
+      size_t length = Command::encodeCommand(want.sequence, want.id, want.args.data(),
+                                             (uint8_t)want.args.size(), frame);
+      append(bytes, frame, length);
+      expected.push_back(want);
+      commands++;
+    } else if (k < 70) {
+      // Lone trigger: every event ends on a delimiter, so the parser is
+      // between frames here
+      bytes.push_back(0);
+      Expected want;
+      want.trigger = true;
+      expected.push_back(want);
+      triggers++;
+    } else if (k < 80) {
+      // Valid frame of another type (device output echoed back): ignored
+      uint8_t payload[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      append(bytes, frame, ProtocolV2::encodeFrame(ProtocolV2::TYPE_ANGLES, sequence, 0,
+                                                   payload, sizeof(payload), frame));
+    } else {
+      // Damage: line noise, a truncated command, or an over-long burst,
+      // then the delimiter a resyncing host sends
+      int damage = k % 3;
+      if (damage == 0) {
+        int n = 1 + byte(rng) % 40;
+        for (int i = 0; i < n; i++) bytes.push_back((uint8_t)nonZero(rng));
+      } else if (damage == 1) {
+        const uint8_t args[3] = { 1, 2, 3 };
+        size_t length = Command::encodeCommand(sequence, Command::SET_SENSORS, args, 3, frame);
+        append(bytes, frame, 1 + byte(rng) % (length - 2));
+      } else {
+        size_t n = ProtocolV2::MAX_ENCODED + 1 + byte(rng);
+        for (size_t i = 0; i < n; i++) bytes.push_back((uint8_t)nonZero(rng));
+      }
+      bytes.push_back(0);
+      damaged++;
+    }
+  }
+
+  Command::Parser parser;
+  bool mismatch = false;
+  auto start = std::chrono::steady_clock::now();
+  Counts counts = feed(parser, bytes, &expected, mismatch);
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                       start).count();
+  const Command::Parser::Stats& stats = parser.getStats();
+  const ProtocolV2::Decoder::Stats& frames = parser.getFrameStats();
+  printf("mixed     %zu bytes: %u/%u commands, %u/%u triggers, %u damaged frames -> "
+         "crc %u, framing %u, overrun %u, ignored %u (%.1f ns/byte)\n", bytes.size(),
+         counts.commands, commands, counts.triggers, triggers, damaged, frames.crcErrors,
+         frames.framingErrors, frames.overruns, stats.ignored, ns / bytes.size());
+  check(!mismatch, "every command and trigger delivered exactly, in order");
+  check(frames.crcErrors + frames.framingErrors + frames.overruns == damaged,
+        "every damaged frame rejected and counted once");
+}
+
+static void checkBitFlips() {
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<int> byte(0, 255);
+  uint32_t flips = 0;
+  uint32_t delivered = 0;
+  for (int f = 0; f < 200; f++) {
+    uint8_t args[ProtocolV2::MAX_PAYLOAD - 1];
+    uint8_t argLength = (uint8_t)(f % (int)sizeof(args));
+    for (uint8_t i = 0; i < argLength; i++) {
+      // Plenty of zeros so the COBS code bytes vary
+      args[i] = (byte(rng) < 64) ? 0 : (uint8_t)byte(rng);
+    }
+    uint8_t frame[ProtocolV2::MAX_ENCODED];
+    size_t length = Command::encodeCommand((uint16_t)f, (uint8_t)byte(rng), args, argLength,
+                                           frame);
+    // Every bit of every byte before the delimiter
+    for (size_t i = 0; i + 1 < length; i++) {
+      for (int bit = 0; bit < 8; bit++) {
+        std::vector<uint8_t> bytes(frame, frame + length);
+        bytes[i] ^= (uint8_t)(1 << bit);
+        Command::Parser parser;
+        bool mismatch = false;
+        Counts counts = feed(parser, bytes, nullptr, mismatch);
+        flips++;
+        delivered += counts.commands;
+      }
+    }
+  }
+  printf("bit flips %u single-bit errors in command frames, %u delivered as commands\n",
+         flips, delivered);
+  check(delivered == 0, "single-bit errors never delivered");
+}
+
+static void checkRandom(size_t count) {
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> byte(0, 255);
+  Command::Parser parser;
+  uint32_t commands = 0;
+  bool outOfBounds = false;
+  for (size_t i = 0; i < count; i++) {
+    // Zeros ten times as likely as other bytes, so short frames are common
+    int value = byte(rng);
+    if (value < 25) value = 0;
+    if (parser.push((uint8_t)value) == Command::Parser::COMMAND) {
+      commands++;
+      const Command::Request& request = parser.request();
+      if (request.length + 1u > ProtocolV2::MAX_PAYLOAD) outOfBounds = true;
+    }
+  }
+  const ProtocolV2::Decoder::Stats& frames = parser.getFrameStats();
+  printf("random    %zu bytes: %u triggers, %u commands, crc %u, framing %u, overrun %u\n",
+         count, parser.getStats().triggers, commands, frames.crcErrors, frames.framingErrors,
+         frames.overruns);
+  check(!outOfBounds, "requests from noise stay within the frame");
+}
+
+int main(int argc, char** argv) {
+  uint32_t events = 200000;
+  size_t random = 20000000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--events") && i + 1 < argc) events = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--random") && i + 1 < argc) random = (size_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--events N] [--random BYTES]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  checkTriggers();
+  checkMixed(events);
+  checkBitFlips();
+  checkRandom(random);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// ============================================================================
+// Deadline Scheduler Check - lateness, missed periods and stats on a fake clock
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/deadline_scheduler_check.cpp src/deadline_scheduler.cpp -o deadline_scheduler_check
+//
+// Usage:
+//
+//   deadline_scheduler_check [--wakeups N]
+//
+// Drives DeadlineScheduler (the acquisition task's timing) through the Clock
+// interface with a fake clock:
+//   - wakeups: on time, slightly early, more than half a period early
+//     (spurious, not counted), just over the late threshold, and several
+//     periods late; checks the return value, the lateness of the last
+//     wakeup, late/missed counts, the worst lateness and the next deadline;
+//   - histogram: a lateness one below and exactly at each bin edge;
+//   - setPeriod() restarts the schedule from now, resetStats() clears;
+//   - model: --wakeups wakeups with random jitter and occasional stalls of
+//     up to 20 periods, starting past 2^32 us, against a reference; the
+//     deadlines stay on the start + n * period grid (no drift) and every
+//     elapsed period is counted once as a wakeup or a missed deadline.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "deadline_scheduler.h"
+
+class FakeClock : public Clock {
+public:
+  int64_t now;
+
+  FakeClock() : now(0) {}
+  int64_t nowUs() override { return now; }
+};
+
+static const uint32_t PERIOD_US = 1000;
+static const uint32_t LATE_US = 500;
+
+static void checkWakeups() {
+  FakeClock clock;
+  clock.now = 10000;
+  DeadlineScheduler scheduler(clock, PERIOD_US, LATE_US);
+  scheduler.start();
+  check(scheduler.getNextDeadlineUs() == 11000, "first deadline one period after start");
+
+  clock.now = 11020;
+  check(scheduler.onWake() == 1 && scheduler.getLastLatenessUs() == 20, "on time");
+  clock.now = 11990;
+  check(scheduler.onWake() == 1 && scheduler.getLastLatenessUs() == 0,
+        "slightly early counts as on time");
+  check(scheduler.getNextDeadlineUs() == 13000, "early wakeup keeps the grid");
+  clock.now = 12400;
+  check(scheduler.onWake() == 0, "more than half a period early is spurious");
+  check(scheduler.getNextDeadlineUs() == 13000 && scheduler.getStats().wakeups == 2,
+        "spurious wakeup not counted");
+  clock.now = 13000 + LATE_US;
+  check(scheduler.onWake() == 1 && scheduler.getStats().lateCount == 0,
+        "lateness at the threshold is not late");
+  clock.now = 14000 + LATE_US + 1;
+  check(scheduler.onWake() == 1 && scheduler.getStats().lateCount == 1,
+        "lateness over the threshold is late");
+
+  // 3 periods and 250 us after the 15000 deadline: 15000..18000 elapsed
+  clock.now = 18250;
+  check(scheduler.onWake() == 4, "stalled wakeup returns the elapsed deadlines");
+  check(scheduler.getLastLatenessUs() == 250, "lateness from the most recent deadline");
+  check(scheduler.getNextDeadlineUs() == 19000, "next deadline after the stall on the grid");
+
+  const DeadlineScheduler::Stats& stats = scheduler.getStats();
+  printf("wakeups   %u wakeups, %u late, %u missed, max lateness %u us\n", stats.wakeups,
+         stats.lateCount, stats.missedDeadlines, stats.maxLatenessUs);
+  check(stats.wakeups == 5 && stats.missedDeadlines == 3 && stats.lateCount == 2,
+        "wakeup, late and missed counters");
+  check(stats.maxLatenessUs == 3250, "worst lateness measured from the first missed deadline");
+
+  clock.now = 50000;
+  scheduler.setPeriod(2000);
+  check(scheduler.getNextDeadlineUs() == 52000 && scheduler.getPeriodUs() == 2000,
+        "setPeriod restarts from now");
+  scheduler.resetStats();
+  check(scheduler.getStats().wakeups == 0 && scheduler.getStats().maxLatenessUs == 0,
+        "resetStats");
+  DeadlineScheduler zero(clock, 0, LATE_US);
+  check(zero.getPeriodUs() == 1, "zero period clamped");
+}
+
+static void checkHistogram() {
+  FakeClock clock;
+  // A long period so every edge is below it
+  DeadlineScheduler scheduler(clock, 100000, LATE_US);
+  scheduler.start();
+  uint32_t expected[DeadlineScheduler::HISTOGRAM_BINS] = { 0 };
+  for (size_t bin = 0; bin + 1 < DeadlineScheduler::HISTOGRAM_BINS; bin++) {
+    uint32_t edge = DeadlineScheduler::HISTOGRAM_EDGES_US[bin];
+    const uint32_t lateness[2] = { edge - 1, edge };
+    for (int k = 0; k < 2; k++) {
+      clock.now = scheduler.getNextDeadlineUs() + lateness[k];
+      scheduler.onWake();
+      expected[k == 0 ? bin : bin + 1]++;
+    }
+  }
+  const DeadlineScheduler::Stats& stats = scheduler.getStats();
+  printf("histogram bins");
+  for (size_t bin = 0; bin < DeadlineScheduler::HISTOGRAM_BINS; bin++) {
+    printf(" %u", stats.histogram[bin]);
+  }
+  printf("\n");
+  check(memcmp(stats.histogram, expected, sizeof(expected)) == 0, "histogram bins at the edges");
+}
+
+static void checkModel(uint32_t wakeups) {
+  FakeClock clock;
+  clock.now = (1LL << 32) - 5000;
+  DeadlineScheduler scheduler(clock, PERIOD_US, LATE_US);
+  scheduler.start();
+  const int64_t origin = scheduler.getNextDeadlineUs();
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> jitter(-200, 400);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<int> stall(1, 20 * (int)PERIOD_US);
+  uint64_t elapsedTotal = 0;
+  uint32_t late = 0;
+  uint32_t missed = 0;
+  uint32_t maxLateness = 0;
+  bool mismatch = false;
+  for (uint32_t i = 0; i < wakeups; i++) {
+    int64_t deadline = scheduler.getNextDeadlineUs();
+    int64_t lateness = jitter(rng);
+    if (percent(rng) == 0) lateness = stall(rng);
+    clock.now = deadline + lateness;
+
+    // Reference
+    int64_t clamped = lateness < 0 ? 0 : lateness;
+    uint32_t expectedMissed = (uint32_t)(clamped / PERIOD_US);
+    uint32_t expectedLateness = (uint32_t)(clamped % PERIOD_US);
+    if (expectedMissed > 0 || expectedLateness > LATE_US) late++;
+    if ((uint32_t)clamped > maxLateness) maxLateness = (uint32_t)clamped;
+    missed += expectedMissed;
+
+    uint32_t elapsed = scheduler.onWake();
+    if (elapsed != expectedMissed + 1 || scheduler.getLastLatenessUs() != expectedLateness) {
+      mismatch = true;
+    }
+    elapsedTotal += elapsed;
+  }
+
+  const DeadlineScheduler::Stats& stats = scheduler.getStats();
+  int64_t span = scheduler.getNextDeadlineUs() - origin;
+  uint32_t binned = 0;
+  for (size_t bin = 0; bin < DeadlineScheduler::HISTOGRAM_BINS; bin++) {
+    binned += stats.histogram[bin];
+  }
+  printf("model     %u wakeups from 2^32 - 5 ms: %u late, %u missed, max lateness %u us\n",
+         stats.wakeups, stats.lateCount, stats.missedDeadlines, stats.maxLatenessUs);
+  check(!mismatch, "elapsed deadlines and lateness match the reference");
+  check(stats.wakeups == wakeups && stats.lateCount == late && stats.missedDeadlines == missed &&
+        stats.maxLatenessUs == maxLateness, "counters match the reference");
+  check(span == (int64_t)elapsedTotal * PERIOD_US, "deadlines stay on the grid");
+  check(elapsedTotal == (uint64_t)stats.wakeups + stats.missedDeadlines,
+        "every period counted once");
+  check(binned == stats.wakeups, "one histogram entry per wakeup");
+}
+
+int main(int argc, char** argv) {
+  uint32_t wakeups = 1000000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--wakeups") && i + 1 < argc) wakeups = (uint32_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--wakeups N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (wakeups < 100) wakeups = 100;
+
+  checkWakeups();
+  checkHistogram();
+  checkModel(wakeups);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
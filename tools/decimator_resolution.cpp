@@ -0,0 +1,109 @@
+// ============================================================================
+// Decimator Resolution - AngleDecimator on synthetic noisy traces
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/decimator_resolution.cpp -o decimator_resolution
+//
+// Usage:
+//
+//   decimator_resolution [--noise LSB] [--samples N] [--seed S]
+//
+// Feeds AngleDecimator 12-bit samples of a fixed angle between two codes
+// plus Gaussian noise (--noise, standard deviation in LSB; the AS5600's
+// noise is about 1-2 LSB) for oversampling factors 1..64, and measures the
+// RMS error of the outputs against the true angle. Averaging white noise
+// should gain 0.5 * log2(N) bits; the measured gain must stay within
+// 0.3 bits of that. A slow ramp through 4095 -> 0 then checks that windows
+// straddling the wrap average to the right angle instead of ~2048. Exits
+// non-zero on any failure.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "angle_decimator.h"
+
+static const double TRUE_ANGLE = 1000.3;
+
+// Error in LSB between a fixed-point output and the true angle, across the
+// wrap
+static double fixedError(uint32_t fixed, double truth) {
+  double angle = fixed / (double)(1 << AngleDecimator::FRACTION_BITS);
+  double error = fmod(angle - truth + 6144.0, 4096.0) - 2048.0;
+  return error;
+}
+
+int main(int argc, char** argv) {
+  double noise = 1.5;
+  int samples = 200000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--noise") && i + 1 < argc) noise = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--samples") && i + 1 < argc) samples = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--noise LSB] [--samples N] [--seed S]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  bool ok = true;
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> gaussian(0.0, noise);
+
+  printf("noise %.2f LSB, %d samples per factor\n", noise, samples);
+  printf("factor  raw rms   out rms   gained  expected\n");
+  double rawRms = 0;
+  for (uint16_t factor = 1; factor <= 64; factor *= 2) {
+    AngleDecimator decimator(factor);
+    double rawSum = 0;
+    double outSum = 0;
+    int outputs = 0;
+    for (int i = 0; i < samples; i++) {
+      double value = TRUE_ANGLE + gaussian(rng);
+      uint16_t code = (uint16_t)((long)lround(value) & 0x0FFF);
+      double rawError = code - TRUE_ANGLE;
+      rawSum += rawError * rawError;
+      if (decimator.push(code)) {
+        double error = fixedError(decimator.getAngleFixed(), TRUE_ANGLE);
+        outSum += error * error;
+        outputs++;
+      }
+    }
+    double raw = sqrt(rawSum / samples);
+    double out = sqrt(outSum / outputs);
+    if (factor == 1) rawRms = raw;
+    double gained = log2(rawRms / out);
+    double expected = AngleDecimator::effectiveBitsGained(factor);
+    bool pass = fabs(gained - expected) <= 0.3;
+    printf("%6u  %7.3f   %7.3f   %6.2f  %8.2f%s\n", factor, raw, out, gained, expected,
+           pass ? "" : "  FAIL");
+    ok = ok && pass;
+  }
+
+  // Slow ramp across the wrap: every output must be near the ramp's mean
+  // over its window
+  AngleDecimator decimator(16);
+  double worst = 0;
+  int outputs = 0;
+  for (int i = 0; i < 4000; i++) {
+    double truth = fmod(4000.0 + i * 0.05, 4096.0);
+    double value = truth + gaussian(rng);
+    uint16_t code = (uint16_t)((long)lround(value) & 0x0FFF);
+    if (decimator.push(code)) {
+      double windowMean = fmod(4000.0 + (i - 7.5) * 0.05, 4096.0);
+      double error = fabs(fixedError(decimator.getAngleFixed(), windowMean));
+      if (error > worst) worst = error;
+      outputs++;
+    }
+  }
+  bool wrapOk = worst < 4.0 * noise / sqrt(16.0) + 0.5;
+  printf("wrap ramp: %d outputs, worst error %.3f LSB%s\n", outputs, worst,
+         wrapOk ? "" : "  FAIL");
+  ok = ok && wrapOk;
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+# ============================================================================
+# Embed Web Assets - gzip the dashboard into include/web_assets.h
+# ============================================================================
+# Runs before every PlatformIO build (extra_scripts = pre:... in
+# platformio.ini), or by hand from the repository root:
+#
+#   python3 tools/embed_web_assets.py           regenerate the header
+#   python3 tools/embed_web_assets.py --check   exit 1 if it is out of date
+#
+# Each file in web/ is gzipped (level 9, no timestamp, so the output only
+# changes with the content) and written as a byte array with its content
+# type, a content-hash ETag and a Cache-Control policy. The page is
+# revalidated on every load (a 304 costs a few bytes); the stylesheet and
+# script are referenced from the page with their hash in the query string,
+# so browsers may keep them for a year and still pick up a new build at
+# once. The header is only rewritten when its content changes, so an
+# unchanged dashboard does not trigger a rebuild.
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+# (file in web/, URL path, content type, Cache-Control)
+PAGE_CACHE = "no-cache"
+ASSET_CACHE = "public, max-age=31536000, immutable"
+ASSETS = [
+    ("app.css", "/app.css", "text/css", ASSET_CACHE),
+    ("app.js", "/app.js", "application/javascript", ASSET_CACHE),
+    ("index.html", "/", "text/html", PAGE_CACHE),       # Last: refers to the others
+]
+
+HEADER = "include/web_assets.h"
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def symbol(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper() + "_GZ"
+
+
+def fingerprint(page, hashes):
+    """Point href="app.css" / src="app.js" at app.css?v=<hash>."""
+    def replace(match):
+        name = match.group(2)
+        if name not in hashes:
+            return match.group(0)
+        return '%s="%s?v=%s"' % (match.group(1), name, hashes[name])
+    text = re.sub(r'(href|src)="([^"?]+)"', replace, page.decode("utf-8"))
+    return text.encode("utf-8")
+
+
+def byte_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate(project_dir):
+    web_dir = os.path.join(project_dir, "web")
+    hashes = {}
+    arrays = []
+    entries = []
+    for name, path, content_type, cache_control in ASSETS:
+        with open(os.path.join(web_dir, name), "rb") as f:
+            data = f.read()
+        if content_type == "text/html":
+            data = fingerprint(data, hashes)
+        hashes[name] = content_hash(data)
+        compressed = gzip.compress(data, 9, mtime=0)
+        arrays.append("// %s: %d bytes, %d gzipped\nstatic const uint8_t %s[] = {\n%s\n};\n"
+                      % (name, len(data), len(compressed), symbol(name), byte_array(compressed)))
+        entries.append('  { "%s", "%s", "\\"%s\\"", "%s", %s, sizeof(%s), %d },'
+                       % (path, content_type, hashes[name], cache_control,
+                          symbol(name), symbol(name), len(data)))
+
+    return """// Generated by tools/embed_web_assets.py from web/ - do not edit
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace WebAssets {
+
+struct Asset {
+  const char* path;           // URL path
+  const char* contentType;
+  const char* etag;           // Quoted content hash
+  const char* cacheControl;
+  const uint8_t* data;        // gzip
+  size_t size;
+  size_t originalSize;
+};
+
+%s
+static const Asset ASSETS[] = {
+%s
+};
+static const size_t COUNT = sizeof(ASSETS) / sizeof(ASSETS[0]);
+
+} // namespace WebAssets
+
+#endif // WEB_ASSETS_H
+""" % ("\n".join(arrays), "\n".join(entries))
+
+
+def embed(project_dir, check=False):
+    header_path = os.path.join(project_dir, HEADER)
+    text = generate(project_dir)
+    try:
+        with open(header_path) as f:
+            current = f.read()
+    except IOError:
+        current = None
+    if current == text:
+        return 0
+    if check:
+        print("%s is out of date, run tools/embed_web_assets.py" % HEADER)
+        return 1
+    with open(header_path, "w") as f:
+        f.write(text)
+    print("Embedded web assets into %s" % HEADER)
+    return 0
+
+
+if __name__ == "__main__":
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    sys.exit(embed(root, "--check" in sys.argv[1:]))
+else:
+    # PlatformIO (SCons) pre-build script
+    Import("env")  # noqa: F821
+    embed(env.subst("$PROJECT_DIR"))  # noqa: F821
@@ -0,0 +1,292 @@
+#ifndef FAKE_WIRE_H
+#define FAKE_WIRE_H
+
+// ============================================================================
+// Fake I2C Bus for Host Tools
+// ============================================================================
+// A TwoWire-compatible bus (beginTransmission/write/endTransmission,
+// requestFrom/available/read) with simulated devices, so bus code templated
+// on the bus type (AS5600FastReader, the bus worker hand-off, the sensor
+// array's bus reader) runs unchanged on a host.
+//
+// Each transaction costs its bit time at the bus clock (9 clocks per byte
+// plus START/STOP) and an optional fixed overhead. The cost is added to a
+// virtual bus clock, and with `realTime` set the calling thread also sleeps
+// for it, the way a task blocks on the I2C interrupt, so two buses driven
+// from two threads overlap in wall-clock time.
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+
+class FakeI2cDevice {
+public:
+  virtual ~FakeI2cDevice() {}
+  // False NACKs the address (device unplugged)
+  virtual bool present() const { return true; }
+  // Master write of `length` bytes; false NACKs
+  virtual bool onWrite(const uint8_t* data, size_t length) = 0;
+  // Master read; returns the number of bytes supplied
+  virtual size_t onRead(uint8_t* data, size_t length) = 0;
+};
+
+// AS5600 register file as seen by a reader: the address pointer persists
+// between transactions and wraps from ANGLE low back to ANGLE high (same for
+// RAW ANGLE), so a reader may skip the pointer write after the first read
+class FakeAS5600 : public FakeI2cDevice {
+public:
+  FakeAS5600() : angle(0), reads(0), online(true), _pointer(0x0E) {}
+
+  uint16_t angle;             // Current 12-bit angle
+  uint32_t reads;             // Data reads served
+  bool online;
+
+  bool present() const override { return online; }
+
+  // Plug back in: the address pointer resets to 0
+  void powerOn() {
+    online = true;
+    _pointer = 0;
+  }
+
+  bool onWrite(const uint8_t* data, size_t length) override {
+    if (length > 0) _pointer = data[0];
+    return true;
+  }
+
+  size_t onRead(uint8_t* data, size_t length) override {
+    reads++;
+    for (size_t i = 0; i < length; i++) {
+      data[i] = registerAt(_pointer);
+      if (_pointer == 0x0D || _pointer == 0x0F) {
+        _pointer--;           // Wrap to the high byte
+      } else {
+        _pointer++;
+      }
+    }
+    return length;
+  }
+
+private:
+  uint8_t _pointer;
+
+  uint8_t registerAt(uint8_t reg) const {
+    switch (reg) {
+      case 0x0C: case 0x0E: return (angle >> 8) & 0x0F;
+      case 0x0D: case 0x0F: return angle & 0xFF;
+      default: return 0;
+    }
+  }
+};
+
+class FakeWire {
+public:
+  static const uint8_t MAX_DEVICES = 16;
+
+  explicit FakeWire(uint32_t freqHz = 400000)
+    : realTime(false), overheadUs(0), busyNs(0), transactions(0),
+      _freqHz(freqHz), _deviceCount(0), _txAddress(0), _txLength(0),
+      _rxLength(0), _rxIndex(0) {}
+
+  bool realTime;              // Sleep for the bus time of each transaction
+  uint32_t overheadUs;        // Fixed cost per transaction (driver, ISR)
+  uint64_t busyNs;            // Virtual bus time used so far
+  uint32_t transactions;
+
+  bool attach(uint8_t address, FakeI2cDevice* device) {
+    if (_deviceCount >= MAX_DEVICES) return false;
+    _addresses[_deviceCount] = address;
+    _devices[_deviceCount] = device;
+    _deviceCount++;
+    return true;
+  }
+
+  void setClock(uint32_t freqHz) { _freqHz = freqHz; }
+  uint32_t getClock() const { return _freqHz; }
+
+  void beginTransmission(uint8_t address) {
+    _txAddress = address;
+    _txLength = 0;
+  }
+
+  size_t write(uint8_t value) {
+    if (_txLength >= sizeof(_txBuffer)) return 0;
+    _txBuffer[_txLength++] = value;
+    return 1;
+  }
+
+  // 0 = ACK, 2 = address NACK (TwoWire codes)
+  uint8_t endTransmission(bool sendStop = true) {
+    (void)sendStop;
+    FakeI2cDevice* device = find(_txAddress);
+    if (device == nullptr || !device->present()) {
+      spend(1);
+      return 2;
+    }
+    spend(1 + _txLength);
+    return device->onWrite(_txBuffer, _txLength) ? 0 : 3;
+  }
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true) {
+    (void)sendStop;
+    _rxIndex = 0;
+    _rxLength = 0;
+    FakeI2cDevice* device = find(address);
+    if (device == nullptr || !device->present()) {
+      spend(1);
+      return 0;
+    }
+    if (quantity > sizeof(_rxBuffer)) quantity = sizeof(_rxBuffer);
+    _rxLength = device->onRead(_rxBuffer, quantity);
+    spend(1 + _rxLength);
+    return (uint8_t)_rxLength;
+  }
+
+  int available() { return (int)(_rxLength - _rxIndex); }
+  int read() { return _rxIndex < _rxLength ? _rxBuffer[_rxIndex++] : -1; }
+
+  // Bus time of a transaction carrying `bytes` bytes (address included)
+  uint64_t transactionNs(size_t bytes) const {
+    uint64_t clocks = 9 * bytes + 2;
+    uint64_t ns = (uint64_t)overheadUs * 1000;
+    if (_freqHz > 0) ns += clocks * 1000000000ULL / _freqHz;
+    return ns;
+  }
+
+private:
+  uint32_t _freqHz;
+  uint8_t _addresses[MAX_DEVICES];
+  FakeI2cDevice* _devices[MAX_DEVICES];
+  uint8_t _deviceCount;
+  uint8_t _txAddress;
+  uint8_t _txBuffer[32];
+  size_t _txLength;
+  uint8_t _rxBuffer[32];
+  size_t _rxLength;
+  size_t _rxIndex;
+
+  FakeI2cDevice* find(uint8_t address) {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+      if (_addresses[i] == address) return _devices[i];
+    }
+    return nullptr;
+  }
+
+  void spend(size_t bytes) {
+    uint64_t ns = transactionNs(bytes);
+    busyNs += ns;
+    transactions++;
+    if (realTime) std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+  }
+};
+
+// ============================================================================
+// Fake TCA9548A Multiplexers
+// ============================================================================
+// A TCA9548A is a one-byte control register (bit n connects downstream
+// channel n). Devices behind muxes share one address, so they are attached
+// to the bus through a FakeMuxFabric at that address: it routes each
+// transaction to every device whose channel is connected (or that is wired
+// directly), NACKs when there is none, and counts collisions when more than
+// one answers (open-drain: the read data is the AND of all of them).
+
+class FakeTCA9548A : public FakeI2cDevice {
+public:
+  FakeTCA9548A() : control(0), writes(0), online(true) {}
+
+  uint8_t control;
+  uint32_t writes;
+  bool online;
+
+  bool present() const override { return online; }
+
+  // Power cycle: all channels disconnected
+  void reset() { control = 0; }
+
+  bool onWrite(const uint8_t* data, size_t length) override {
+    if (length > 0) {
+      control = data[length - 1];
+      writes++;
+    }
+    return true;
+  }
+
+  size_t onRead(uint8_t* data, size_t length) override {
+    for (size_t i = 0; i < length; i++) data[i] = control;
+    return length;
+  }
+};
+
+class FakeMuxFabric : public FakeI2cDevice {
+public:
+  static const uint8_t MAX_ROUTES = 32;
+
+  FakeMuxFabric() : collisions(0), _routeCount(0) {}
+
+  uint32_t collisions;        // Transactions more than one device answered
+
+  // `mux` nullptr: wired directly to the bus
+  bool attach(FakeTCA9548A* mux, uint8_t channel, FakeI2cDevice* device) {
+    if (_routeCount >= MAX_ROUTES) return false;
+    _routes[_routeCount].mux = mux;
+    _routes[_routeCount].channel = channel;
+    _routes[_routeCount].device = device;
+    _routeCount++;
+    return true;
+  }
+
+  bool present() const override { return responders() > 0; }
+
+  bool onWrite(const uint8_t* data, size_t length) override {
+    bool ok = true;
+    countCollision();
+    for (uint8_t i = 0; i < _routeCount; i++) {
+      if (connected(_routes[i])) ok = _routes[i].device->onWrite(data, length) && ok;
+    }
+    return ok;
+  }
+
+  size_t onRead(uint8_t* data, size_t length) override {
+    uint8_t scratch[32];
+    if (length > sizeof(scratch)) length = sizeof(scratch);
+    for (size_t i = 0; i < length; i++) data[i] = 0xFF;
+    countCollision();
+    for (uint8_t r = 0; r < _routeCount; r++) {
+      if (!connected(_routes[r])) continue;
+      size_t got = _routes[r].device->onRead(scratch, length);
+      for (size_t i = 0; i < got; i++) data[i] &= scratch[i];
+    }
+    return length;
+  }
+
+private:
+  struct Route {
+    FakeTCA9548A* mux;
+    uint8_t channel;
+    FakeI2cDevice* device;
+  };
+
+  Route _routes[MAX_ROUTES];
+  uint8_t _routeCount;
+
+  static bool connected(const Route& route) {
+    if (!route.device->present()) return false;
+    if (route.mux == nullptr) return true;
+    return route.mux->online && (route.mux->control & (1 << route.channel)) != 0;
+  }
+
+  uint8_t responders() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < _routeCount; i++) {
+      if (connected(_routes[i])) count++;
+    }
+    return count;
+  }
+
+  void countCollision() {
+    if (responders() > 1) collisions++;
+  }
+};
+
+#endif // FAKE_WIRE_H
@@ -0,0 +1,129 @@
+// ============================================================================
+// Fast Read Check - AS5600FastReader bus counters against a fake bus
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/fast_read_check.cpp -o fast_read_check
+//
+// Usage:
+//
+//   fast_read_check [--reads N] [--freq HZ]
+//
+// Reads a fake AS5600 (tools/fake_wire.h) with AS5600FastReader and with
+// the library's register-write-then-read sequence, and compares what each
+// puts on the bus. Checks that:
+//   - every fast read returns the current angle (ANGLE and RAW ANGLE);
+//   - the reader's counters agree with the transactions the bus saw: one
+//     pointer write, then one 3-byte transaction per read;
+//   - an unplugged sensor fails the read, invalidates the pointer, and the
+//     first read after it comes back reprograms it.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "as5600_fast_reader.h"
+#include "check.h"
+#include "fake_wire.h"
+
+static const uint8_t AS5600_ADDRESS = 0x36;
+
+// What the AS5600 library does per angle read
+static bool libraryRead(FakeWire& wire, uint8_t reg, uint16_t& angle) {
+  wire.beginTransmission(AS5600_ADDRESS);
+  wire.write(reg);
+  if (wire.endTransmission() != 0) return false;
+  if (wire.requestFrom(AS5600_ADDRESS, (uint8_t)2) != 2) return false;
+  uint8_t high = wire.read();
+  uint8_t low = wire.read();
+  angle = (((uint16_t)high << 8) | low) & 0x0FFF;
+  return true;
+}
+
+static void checkRegister(uint8_t reg, const char* name, uint32_t reads, uint32_t freq) {
+  FakeWire wire(freq);
+  FakeAS5600 sensor;
+  wire.attach(AS5600_ADDRESS, &sensor);
+  AS5600FastReader<FakeWire> fast(wire, AS5600_ADDRESS, reg);
+
+  uint32_t wrong = 0;
+  for (uint32_t i = 0; i < reads; i++) {
+    sensor.angle = (i * 37) & 0x0FFF;
+    uint16_t angle = 0xFFFF;
+    if (!fast.read(angle) || angle != sensor.angle) wrong++;
+  }
+  const AS5600FastReader<FakeWire>::Stats& stats = fast.getStats();
+  uint64_t fastNs = wire.busyNs;
+
+  FakeWire libWire(freq);
+  FakeAS5600 libSensor;
+  libWire.attach(AS5600_ADDRESS, &libSensor);
+  for (uint32_t i = 0; i < reads; i++) {
+    libSensor.angle = (i * 37) & 0x0FFF;
+    uint16_t angle = 0xFFFF;
+    if (!libraryRead(libWire, reg, angle) || angle != libSensor.angle) wrong++;
+  }
+
+  printf("%-9s fast: %u transactions, %u bytes, %llu us | library: %u transactions, "
+         "%llu us\n", name, stats.transactions, stats.bytesOnBus,
+         (unsigned long long)(fastNs / 1000), libWire.transactions,
+         (unsigned long long)(libWire.busyNs / 1000));
+
+  check(wrong == 0, "angle read back");
+  check(stats.reads == reads && stats.errors == 0, "read/error counters");
+  check(stats.pointerWrites == 1, "pointer written once");
+  check(stats.transactions == reads + 1, "transactions counted");
+  check(stats.transactions == wire.transactions, "counters match the bus");
+  check(stats.bytesOnBus == 2 + 3 * reads, "bytes on bus");
+  check(libWire.transactions == 2 * reads, "library transactions");
+  check(fastNs < libWire.busyNs, "fast read uses less bus time");
+}
+
+static void checkUnplug(uint32_t freq) {
+  FakeWire wire(freq);
+  FakeAS5600 sensor;
+  wire.attach(AS5600_ADDRESS, &sensor);
+  AS5600FastReader<FakeWire> fast(wire, AS5600_ADDRESS);
+
+  uint16_t angle;
+  sensor.angle = 1234;
+  check(fast.read(angle) && angle == 1234, "read before unplug");
+  check(fast.isPointerValid(), "pointer valid after read");
+
+  sensor.online = false;
+  check(!fast.read(angle), "read fails while unplugged");
+  check(!fast.isPointerValid(), "pointer invalidated by the failed read");
+  check(!fast.read(angle), "pointer write fails while unplugged");
+
+  // Power-on resets the sensor's pointer; the reader must set it again
+  sensor.powerOn();
+  sensor.angle = 2345;
+  uint32_t writesBefore = fast.getStats().pointerWrites;
+  check(fast.read(angle) && angle == 2345, "read after replug");
+  check(fast.getStats().pointerWrites == writesBefore + 1, "pointer reprogrammed after replug");
+  check(fast.getStats().errors == 2, "two errors counted");
+  printf("unplug    errors %u, pointer writes %u\n", fast.getStats().errors,
+         fast.getStats().pointerWrites);
+}
+
+int main(int argc, char** argv) {
+  uint32_t reads = 1000;
+  uint32_t freq = 400000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--reads") && i + 1 < argc) reads = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--freq") && i + 1 < argc) freq = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--reads N] [--freq HZ]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (reads < 1) reads = 1;
+
+  printf("%u reads at %u Hz\n", reads, freq);
+  checkRegister(AS5600FastReader<FakeWire>::REG_ANGLE, "ANGLE", reads, freq);
+  checkRegister(AS5600FastReader<FakeWire>::REG_RAW_ANGLE, "RAW ANGLE", reads, freq);
+  checkUnplug(freq);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
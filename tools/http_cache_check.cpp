@@ -0,0 +1,159 @@
+// ============================================================================
+// HTTP Cache Check - If-None-Match matching and the embedded dashboard assets
+// ============================================================================
+// Build from the repository root (needs zlib):
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/http_cache_check.cpp -lz -o http_cache_check
+//
+// Usage (from the repository root, it reads web/):
+//
+//   http_cache_check
+//
+// Checks HttpCache::etagMatches() against If-None-Match values a browser or
+// proxy may send: single and listed tags, weak tags on either side, "*",
+// odd whitespace, commas inside quotes, and malformed or truncated values
+// that must not match. Then checks every asset in web_assets.h as
+// tools/embed_web_assets.py left it: the gzip stream inflates to exactly
+// the file in web/ (the page with its ?v=<hash> references removed), has
+// no timestamp, matches the recorded original size, and the page refers to
+// the current ETag of each asset it loads. Prints each asset's size before
+// and after compression. Exits non-zero on any failure; a stale header
+// means tools/embed_web_assets.py was not run.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <zlib.h>
+#include "check.h"
+#include "http_cache.h"
+#include "web_assets.h"
+
+struct MatchCase {
+  const char* ifNoneMatch;
+  const char* etag;
+  bool matches;
+};
+
+static void checkMatching() {
+  const char* e = "\"abc123\"";
+  const MatchCase cases[] = {
+    { "\"abc123\"", e, true },
+    { "W/\"abc123\"", e, true },                  // Weak comparison
+    { "\"abc123\"", "W/\"abc123\"", true },
+    { "\"x\", \"abc123\"", e, true },
+    { "\"x\",W/\"abc123\"", e, true },
+    { "  \"x\" ,\t\"abc123\"  ", e, true },
+    { "\"abc123\",", e, true },
+    { "*", e, true },
+    { "\"a,b\", \"abc123\"", e, true },           // Comma inside a tag
+    { "\"abc12\"", e, false },
+    { "\"abc1234\"", e, false },
+    { "\"ABC123\"", e, false },                   // Case-sensitive
+    { "\"abc123", e, false },                     // Unterminated
+    { "abc123", e, false },                       // Unquoted
+    { "\"abc123,\"", e, false },
+    { "\"x\", \"y\"", e, false },
+    { "", e, false },
+    { " , ,", e, false },
+    { nullptr, e, false },
+    { "\"abc123\"", nullptr, false },
+  };
+  size_t count = sizeof(cases) / sizeof(cases[0]);
+  for (size_t i = 0; i < count; i++) {
+    const MatchCase& c = cases[i];
+    bool matches = HttpCache::etagMatches(c.ifNoneMatch, c.etag);
+    if (matches != c.matches) {
+      printf("FAIL (matching): If-None-Match %s%s%s vs %s: %s\n",
+             c.ifNoneMatch ? "'" : "", c.ifNoneMatch ? c.ifNoneMatch : "(none)",
+             c.ifNoneMatch ? "'" : "", c.etag ? c.etag : "(none)",
+             matches ? "matched" : "did not match");
+      failures++;
+    }
+  }
+  printf("matching  %zu If-None-Match cases\n", count);
+}
+
+static bool readFile(const std::string& path, std::string& out) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) return false;
+  std::stringstream text;
+  text << file.rdbuf();
+  out = text.str();
+  return true;
+}
+
+static bool gunzip(const uint8_t* data, size_t size, std::string& out) {
+  z_stream z;
+  memset(&z, 0, sizeof(z));
+  if (inflateInit2(&z, 16 + MAX_WBITS) != Z_OK) return false;
+  z.next_in = (Bytef*)data;
+  z.avail_in = (uInt)size;
+  char buffer[4096];
+  int result;
+  do {
+    z.next_out = (Bytef*)buffer;
+    z.avail_out = sizeof(buffer);
+    result = inflate(&z, Z_NO_FLUSH);
+    out.append(buffer, sizeof(buffer) - z.avail_out);
+  } while (result == Z_OK);
+  bool complete = result == Z_STREAM_END && z.avail_in == 0;
+  inflateEnd(&z);
+  return complete;
+}
+
+// The ETag without its quotes
+static std::string etagHash(const char* etag) {
+  return std::string(etag + 1, strlen(etag) - 2);
+}
+
+static void checkAssets() {
+  const WebAssets::Asset* page = nullptr;
+  for (size_t i = 0; i < WebAssets::COUNT; i++) {
+    const WebAssets::Asset& asset = WebAssets::ASSETS[i];
+    bool isPage = strcmp(asset.path, "/") == 0;
+    if (isPage) page = &asset;
+    std::string plain;
+    check(gunzip(asset.data, asset.size, plain), "valid gzip stream", asset.path);
+    check(asset.size >= 10 && asset.data[4] == 0 && asset.data[5] == 0 && asset.data[6] == 0 &&
+          asset.data[7] == 0, "no timestamp in the gzip header", asset.path);
+    check(plain.size() == asset.originalSize, "original size recorded", asset.path);
+    check(asset.etag[0] == '"' && asset.etag[strlen(asset.etag) - 1] == '"' &&
+          HttpCache::etagMatches(asset.etag, asset.etag), "quoted ETag matches itself",
+          asset.path);
+
+    // The page is served with ?v=<hash> after each asset it loads
+    std::string source;
+    std::string file = std::string("web/") + (isPage ? "index.html" : asset.path + 1);
+    check(readFile(file, source), "source file readable (run from the repository root)",
+          asset.path);
+    if (isPage) {
+      for (size_t j = 0; j < WebAssets::COUNT; j++) {
+        if (&WebAssets::ASSETS[j] == &asset) continue;
+        std::string ref = "?v=" + etagHash(WebAssets::ASSETS[j].etag);
+        size_t at = plain.find(ref);
+        check(at != std::string::npos, "page loads the current asset version", asset.path);
+        if (at != std::string::npos) plain.erase(at, ref.size());
+      }
+    }
+    check(plain == source, "inflates to the file in web/", asset.path);
+    printf("asset     %-9s %5zu -> %5zu bytes (%2.0f%%)  ETag %s  %s\n", asset.path,
+           asset.originalSize, asset.size, 100.0 * asset.size / asset.originalSize, asset.etag,
+           asset.cacheControl);
+  }
+  check(page != nullptr, "page embedded", "/");
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    fprintf(stderr, "usage: %s\n", argv[0]);
+    return 2;
+  }
+
+  checkMatching();
+  checkAssets();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+// ============================================================================
+// Latency Monitor - live clock sync and sample age over the UART link (Linux)
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/latency_monitor.cpp -o latency_monitor
+//
+// Usage:
+//
+//   latency_monitor DEVICE [BAUD] [--ping-ms N]
+//
+// Switches the sender to protocol v2 (samples carry sender timestamps), pings
+// it every N ms (default 500) and feeds the exchanges to ClockSync. Every
+// received sample's age is its arrival time minus its sender timestamp
+// converted to the local clock. Once per second it prints offset, drift,
+// round trip and the one-way latency distribution.
+//
+// The host's arrival time includes the USB-serial adapter's latency timer
+// (often 1-16 ms); a receiving ESP32 running the same ClockSync code sees
+// the link itself.
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include "clock_sync.h"
+#include "command_parser.h"
+#include "stream_decoder.h"
+
+struct Monitor {
+  ClockSync sync;
+  uint32_t chunkUs;           // Arrival time of the chunk being decoded
+  uint32_t pongs;
+};
+
+static uint32_t nowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+static void onSample(const StreamDecoder::Sample& sample, void* context) {
+  Monitor* monitor = static_cast<Monitor*>(context);
+  if (sample.hasTime && monitor->sync.hasOffset()) {
+    monitor->sync.recordLatency(sample.timeUs, monitor->chunkUs);
+  }
+}
+
+static void onFrame(uint8_t type, const uint8_t* payload, size_t length, void* context) {
+  Monitor* monitor = static_cast<Monitor*>(context);
+  uint32_t t1, t2, t3;
+  if (type == Command::TYPE_ACK && Command::parsePong(payload, length, t1, t2, t3)) {
+    monitor->sync.addExchange(t1, t2, t3, monitor->chunkUs);
+    monitor->pongs++;
+  }
+}
+
+static speed_t baudConstant(long baud) {
+  switch (baud) {
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    case 3000000: return B3000000;
+    case 4000000: return B4000000;
+    default: return 0;
+  }
+}
+
+static int openPort(const char* device, long baud) {
+  int fd = open(device, O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    perror(device);
+    return -1;
+  }
+  termios tty;
+  if (tcgetattr(fd, &tty) != 0) {
+    perror("tcgetattr");
+    close(fd);
+    return -1;
+  }
+  cfmakeraw(&tty);
+  speed_t speed = baudConstant(baud);
+  if (speed == 0) {
+    fprintf(stderr, "unsupported baud rate %ld\n", baud);
+    close(fd);
+    return -1;
+  }
+  cfsetispeed(&tty, speed);
+  cfsetospeed(&tty, speed);
+  tty.c_cc[VMIN] = 0;
+  tty.c_cc[VTIME] = 0;
+  if (tcsetattr(fd, TCSANOW, &tty) != 0) {
+    perror("tcsetattr");
+    close(fd);
+    return -1;
+  }
+  tcflush(fd, TCIOFLUSH);
+  return fd;
+}
+
+static void printReport(Monitor& monitor) {
+  const ClockSync::Stats& s = monitor.sync.getStats();
+  const ClockSync::LatencyStats& l = monitor.sync.getLatencyStats();
+  printf("sync %s offset %+ld us drift %+.2f ppm rtt %lu us (min %lu) pongs %lu rejected %lu\n",
+         monitor.sync.isSynced() ? "locked" : "acquiring",
+         (long)(int32_t)monitor.sync.getOffsetUs(nowUs()), monitor.sync.getDriftPpb() / 1000.0,
+         (unsigned long)s.lastDelayUs, (unsigned long)s.minDelayUs,
+         (unsigned long)monitor.pongs, (unsigned long)s.rejected);
+  if (l.count == 0) return;
+  printf("latency n=%lu min/mean/max %ld/%ld/%ld us, negative %lu\n", (unsigned long)l.count,
+         (long)l.minUs, (long)monitor.sync.getMeanLatencyUs(), (long)l.maxUs,
+         (unsigned long)l.negative);
+  printf("  ");
+  for (size_t bin = 0; bin < ClockSync::HISTOGRAM_BINS; bin++) {
+    if (bin < ClockSync::HISTOGRAM_BINS - 1) {
+      printf("<%lu:%lu ", (unsigned long)ClockSync::latencyEdge(bin),
+             (unsigned long)l.histogram[bin]);
+    } else {
+      printf(">=%lu:%lu\n", (unsigned long)ClockSync::latencyEdge(bin - 1),
+             (unsigned long)l.histogram[bin]);
+    }
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+  const char* device = nullptr;
+  long baud = 115200;
+  long pingMs = 500;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--ping-ms") == 0 && i + 1 < argc) pingMs = atol(argv[++i]);
+    else if (device == nullptr) device = argv[i];
+    else baud = atol(argv[i]);
+  }
+  if (device == nullptr || pingMs <= 0) {
+    fprintf(stderr, "usage: latency_monitor DEVICE [BAUD] [--ping-ms N]\n");
+    return 2;
+  }
+
+  int fd = openPort(device, baud);
+  if (fd < 0) return 1;
+
+  Monitor monitor;
+  monitor.chunkUs = 0;
+  monitor.pongs = 0;
+  StreamDecoder decoder(2);
+  decoder.setCallbacks(onSample, onFrame, &monitor);
+
+  // Flush any partial frame, then switch the output to v2 without batching
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  uint16_t sequence = 0;
+  const uint8_t output[2] = { 2, 0 };
+  uint8_t flush = ProtocolV2::DELIMITER;
+  if (write(fd, &flush, 1) != 1) perror("write");
+  size_t size = Command::encodeCommand(sequence++, Command::SET_OUTPUT, output, 2, frame);
+  if (write(fd, frame, size) != (ssize_t)size) perror("write");
+
+  uint32_t lastPing = nowUs();
+  uint32_t lastReport = lastPing;
+  uint8_t buffer[4096];
+  for (;;) {
+    uint32_t now = nowUs();
+    if ((uint32_t)(now - lastPing) >= (uint32_t)pingMs * 1000) {
+      lastPing = now;
+      size = Command::encodePing(sequence++, nowUs(), frame);
+      if (write(fd, frame, size) != (ssize_t)size) perror("write");
+    }
+    if ((uint32_t)(now - lastReport) >= 1000000) {
+      lastReport = now;
+      printReport(monitor);
+    }
+
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(fd, &readable);
+    timeval timeout = { 0, 10000 };
+    if (select(fd + 1, &readable, nullptr, nullptr, &timeout) <= 0) continue;
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n < 0 && errno != EAGAIN && errno != EINTR) {
+      perror("read");
+      return 1;
+    }
+    if (n > 0) {
+      monitor.chunkUs = nowUs();
+      decoder.feed(buffer, (size_t)n);
+    }
+  }
+}
@@ -0,0 +1,190 @@
+// ============================================================================
+// Multi-Turn Check - MultiTurnTracker near the aliasing limit
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/multi_turn_check.cpp -o multi_turn_check
+//
+// Usage:
+//
+//   multi_turn_check [--samples N]
+//
+// Feeds MultiTurnTracker 12-bit angles of a simulated shaft and compares the
+// unwrapped position with the true one:
+//   - wrapDelta(): every (to, from) pair against a reference in
+//     [-2048, 2047];
+//   - constant speed: --samples samples at speeds up to and past half a turn
+//     per sample in both directions, from random starting angles. Up to
+//     2047 counts/sample (and -2048) the position is exact over many turns;
+//     +2048 is indistinguishable from -2048 and faster steps alias
+//     backwards, as documented. Steps above NEAR_ALIAS_COUNTS are counted
+//     as near-aliasing, steps at it are not (nor is a step so fast that it
+//     folds below it: 3000 counts looks like -1096);
+//   - jittered speed: 1900 +-140 counts/sample stays exact;
+//   - restore(): a saved position at positive and negative turns with the
+//     shaft moved -2047..+2047 counts while off resumes exactly; a move of
+//     +2048 resumes half a turn back;
+//   - getTurns(): floor division for positions around every turn boundary,
+//     negative ones included.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "multi_turn_tracker.h"
+
+typedef MultiTurnTracker Tracker;
+
+static uint16_t angleOf(int64_t position) {
+  return (uint16_t)(position & 0x0FFF);
+}
+
+static int64_t floorDiv(int64_t a, int64_t b) {
+  int64_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static void checkWrapDelta() {
+  bool mismatch = false;
+  for (int32_t from = 0; from < Tracker::COUNTS_PER_TURN; from++) {
+    for (int32_t to = 0; to < Tracker::COUNTS_PER_TURN; to++) {
+      int32_t expected = to - from;
+      if (expected >= 2048) expected -= 4096;
+      if (expected < -2048) expected += 4096;
+      if (Tracker::wrapDelta((uint16_t)to, (uint16_t)from) != expected) mismatch = true;
+    }
+  }
+  printf("wrapDelta all 4096 x 4096 pairs\n");
+  check(!mismatch, "wrapDelta is the shortest signed distance");
+}
+
+static void checkSpeeds(uint32_t samples) {
+  const int32_t speeds[] = {
+    1, -1, 100, -100, 1535, -1535, 1536, -1536, 1537, -1537, 2000, -2000,
+    2047, -2047, -2048, 2048, 2049, -2049, 3000, -3000
+  };
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> start(-1000000, 1000000);
+  for (size_t s = 0; s < sizeof(speeds) / sizeof(speeds[0]); s++) {
+    int32_t speed = speeds[s];
+    int64_t truth = start(rng);
+    Tracker tracker;
+    tracker.restore(truth, angleOf(truth));
+    int64_t first = tracker.getPosition();
+    for (uint32_t i = 0; i < samples; i++) {
+      truth += speed;
+      tracker.update(angleOf(truth));
+    }
+
+    // What a tracker can see: the step folded into [-2048, 2047]
+    int32_t seen = Tracker::wrapDelta((uint16_t)(speed & 0x0FFF), 0);
+    int64_t expected = first + (int64_t)seen * samples;
+    bool nearAlias = seen > Tracker::NEAR_ALIAS_COUNTS || seen < -Tracker::NEAR_ALIAS_COUNTS;
+    printf("speed     %5d counts/sample: moved %+lld counts (%+.0f turns), seen as %5d, "
+           "near-alias %u\n", speed, (long long)(tracker.getPosition() - first),
+           (double)(tracker.getPosition() - first) / Tracker::COUNTS_PER_TURN, seen,
+           tracker.getNearAliasCount());
+    check(tracker.getPosition() == expected, "position follows the folded step");
+    if (speed >= -2048 && speed <= 2047) {
+      check(tracker.getPosition() == truth, "exact up to half a turn per sample");
+    } else {
+      check(tracker.getPosition() != truth, "aliased beyond half a turn per sample");
+    }
+    check(tracker.getNearAliasCount() == (nearAlias ? samples : 0), "near-alias count");
+  }
+}
+
+static void checkJitter(uint32_t samples) {
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<int> jitter(-140, 140);
+  for (int direction = -1; direction <= 1; direction += 2) {
+    int64_t truth = 12345;
+    Tracker tracker;
+    tracker.update(angleOf(truth));
+    truth = angleOf(truth);
+    uint32_t expectedNear = 0;
+    bool lost = false;
+    for (uint32_t i = 0; i < samples; i++) {
+      int32_t step = direction * (1900 + jitter(rng));
+      if (step > Tracker::NEAR_ALIAS_COUNTS || step < -Tracker::NEAR_ALIAS_COUNTS) expectedNear++;
+      truth += step;
+      tracker.update(angleOf(truth));
+      if (tracker.getPosition() != truth) lost = true;
+    }
+    printf("jitter    %+d x 1900 +-140 counts/sample: %u samples, near-alias %u\n", direction,
+           samples, tracker.getNearAliasCount());
+    check(!lost, "jittered steps near the limit tracked exactly");
+    check(tracker.getNearAliasCount() == expectedNear, "near-alias count with jitter");
+  }
+}
+
+static void checkRestore() {
+  const int64_t saved[] = { 0, 2047, 4096 * 5 + 17, -1, -4096 * 3 - 2048, 4096LL * 100000 + 4095 };
+  bool mismatch = false;
+  for (size_t i = 0; i < sizeof(saved) / sizeof(saved[0]); i++) {
+    for (int32_t moved = -2047; moved <= 2047; moved++) {
+      Tracker tracker;
+      tracker.restore(saved[i], angleOf(saved[i] + moved));
+      if (tracker.getPosition() != saved[i] + moved) mismatch = true;
+      if (tracker.getNearAliasCount() != 0 || !tracker.isInitialized()) mismatch = true;
+    }
+    Tracker tracker;
+    tracker.restore(saved[i], angleOf(saved[i] + 2048));
+    check(tracker.getPosition() == saved[i] - 2048, "half a turn away resumes backwards");
+  }
+  printf("restore   %zu saved positions, moved -2047..+2047 counts while off\n",
+         sizeof(saved) / sizeof(saved[0]));
+  check(!mismatch, "restore within half a turn");
+
+  // Tracking continues from the restored position
+  Tracker tracker;
+  tracker.restore(-4096 * 2 + 10, 4000);
+  tracker.update(100);
+  check(tracker.getPosition() == -4096 * 2 + 10 - 106 + 196, "update after restore");
+}
+
+static void checkTurns() {
+  bool mismatch = false;
+  for (int64_t turn = -50; turn <= 50; turn++) {
+    const int64_t offsets[] = { -1, 0, 1, 2047, 2048, 4095 };
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++) {
+      int64_t position = turn * Tracker::COUNTS_PER_TURN + offsets[k];
+      Tracker tracker;
+      tracker.restore(position, angleOf(position));
+      if (tracker.getPosition() != position ||
+          tracker.getTurns() != floorDiv(position, Tracker::COUNTS_PER_TURN)) {
+        mismatch = true;
+      }
+    }
+  }
+  Tracker tracker;
+  tracker.update(0);
+  tracker.update(4095);
+  printf("turns     positions around turns -50..50; one count back from 0 is turn %d\n",
+         tracker.getTurns());
+  check(!mismatch, "getTurns floors");
+  check(tracker.getPosition() == -1 && tracker.getTurns() == -1, "-1 count is turn -1");
+}
+
+int main(int argc, char** argv) {
+  uint32_t samples = 100000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--samples") && i + 1 < argc) samples = (uint32_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--samples N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (samples < 100) samples = 100;
+
+  checkWrapDelta();
+  checkSpeeds(samples);
+  checkJitter(samples);
+  checkRestore();
+  checkTurns();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
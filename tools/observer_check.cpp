@@ -0,0 +1,192 @@
+// ============================================================================
+// Observer Check - TrackingObserver step, ramp and acceleration response
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/observer_check.cpp -o observer_check
+//
+// Usage:
+//
+//   observer_check [--theta T] [--rate HZ] [--updates N]
+//
+// Feeds TrackingObserver synthetic angle traces at --rate samples per
+// second and checks:
+//   - step: the estimate settles on a new angle and the velocity returns
+//     to rest (within the fixed-point dead zone, REST_VELOCITY_Q16);
+//   - ramp: at constant speed through many 4095 -> 0 wraps (both
+//     directions, including a reversal) the angle tracks with no lag and the
+//     mean velocity matches the true speed;
+//   - acceleration: under constant acceleration the acceleration estimate,
+//     averaged over a second, converges to the true value (an
+//     alpha-beta-gamma filter has no steady-state error here);
+//   - noise: on a still shaft with Gaussian noise the angle estimate is
+//     smoother than the raw samples.
+// Then times --updates calls to update() and prints ns per update. Exits
+// non-zero on any failure.
+//
+// The defaults (theta 0.8, OBSERVER_THETA in config.h) pass at any rate up
+// to 10 kHz. Heavier smoothing (theta 0.95) fails the step check: its
+// fixed-point dead zone leaves more velocity than REST_VELOCITY_Q16.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "tracking_observer.h"
+
+// Residuals too small to move the state through the Q16 gains are not
+// corrected, so a still shaft may rest with this much velocity left
+// (counts per sample, Q16: 1/1024 count per sample)
+static const int32_t REST_VELOCITY_Q16 = 64;
+
+static uint16_t code(double counts) {
+  return (uint16_t)((long)floor(counts + 0.5) & 0x0FFF);
+}
+
+// Wrapped angle error in counts
+static double angleError(uint16_t estimate, double truth) {
+  return fmod(estimate - truth + 4096.0 * 64 + 2048.0, 4096.0) - 2048.0;
+}
+
+static void checkStep(float theta, uint32_t rate) {
+  TrackingObserver observer(theta);
+  for (int i = 0; i < 200; i++) observer.update(100);
+  int settled = -1;
+  int32_t peak = 0;
+  for (int i = 0; i < 10000; i++) {
+    observer.update(600);
+    int32_t error = (int32_t)angleError(observer.getAngle(), 600);
+    if (error > peak) peak = error;
+    bool still = abs(observer.getVelocityQ16()) <= REST_VELOCITY_Q16;
+    if (error == 0 && still) {
+      if (settled < 0) settled = i;
+    } else {
+      settled = -1;
+    }
+  }
+  printf("step      100 -> 600: settled after %d samples, overshoot %d counts, final %u, "
+         "velocity %.3f counts/s\n", settled, peak, observer.getAngle(),
+         observer.getVelocityQ16() * (double)rate / 65536.0);
+  check(settled >= 0, "step settles with the velocity back at rest");
+}
+
+static void checkRamp(float theta, uint32_t rate) {
+  TrackingObserver observer(theta);
+  double speed = 2000.0;            // counts/s
+  double position = 4000.0;
+  double worstAngle = 0;
+  double velocitySum[2] = { 0, 0 };
+  int velocityCount[2] = { 0, 0 };
+  for (int i = 0; i < 6 * (int)rate; i++) {
+    // Reverse at 3 s; skip the transient after the start and the reversal
+    if (i == 3 * (int)rate) speed = -3000.0;
+    observer.update(code(position));
+    int leg = i / (3 * (int)rate);
+    if (i % (3 * (int)rate) > (int)rate) {
+      double angle = fabs(angleError(observer.getAngle(), position));
+      if (angle > worstAngle) worstAngle = angle;
+      velocitySum[leg] += observer.getVelocity(rate);
+      velocityCount[leg]++;
+    }
+    position += speed / rate;
+  }
+  // Single velocity estimates carry the samples' quantization; their mean
+  // over each leg must match the speed
+  double forward = velocitySum[0] / velocityCount[0];
+  double reverse = velocitySum[1] / velocityCount[1];
+  printf("ramp      +2000 / -3000 counts/s: worst angle error %.1f counts, "
+         "mean velocity %.1f / %.1f counts/s\n", worstAngle, forward, reverse);
+  check(worstAngle <= 1.0, "ramp angle tracks through the wrap");
+  check(fabs(forward - 2000.0) <= 20.0 && fabs(reverse + 3000.0) <= 30.0,
+        "ramp velocity within 1%");
+}
+
+static void checkAcceleration(float theta, uint32_t rate) {
+  TrackingObserver observer(theta);
+  double acceleration = 4000.0;     // counts/s^2
+  double speed = 0;
+  double position = 0;
+  double sum = 0;
+  double worst = 0;
+  for (int i = 0; i < 3 * (int)rate; i++) {
+    observer.update(code(position));
+    position += speed / rate + 0.5 * acceleration / ((double)rate * rate);
+    speed += acceleration / rate;
+    if (i >= 2 * (int)rate) {
+      double estimate = observer.getAcceleration(rate);
+      sum += estimate;
+      if (fabs(estimate - acceleration) > worst) worst = fabs(estimate - acceleration);
+    }
+  }
+  // 12-bit quantization makes single estimates noisy; their mean over the
+  // last second must converge
+  double mean = sum / rate;
+  printf("accel     %.0f counts/s^2: mean estimate %.0f (worst single %.0f off)\n",
+         acceleration, mean, worst);
+  check(fabs(mean - acceleration) <= 0.1 * acceleration, "mean acceleration within 10%");
+}
+
+static void checkNoise(float theta) {
+  std::mt19937 rng(1);
+  std::normal_distribution<double> gaussian(0.0, 2.0);
+  TrackingObserver observer(theta);
+  const double truth = 2000.3;
+  double rawSum = 0;
+  double outSum = 0;
+  int count = 0;
+  for (int i = 0; i < 20000; i++) {
+    uint16_t sample = code(truth + gaussian(rng));
+    observer.update(sample);
+    if (i < 1000) continue;
+    double raw = angleError(sample, truth);
+    double out = observer.getAngleQ16() / 65536.0 - truth;
+    rawSum += raw * raw;
+    outSum += out * out;
+    count++;
+  }
+  double raw = sqrt(rawSum / count);
+  double out = sqrt(outSum / count);
+  printf("noise     raw rms %.2f counts, estimate rms %.2f counts\n", raw, out);
+  check(out < raw, "estimate smoother than the samples");
+}
+
+static void benchmark(float theta, uint32_t updates) {
+  TrackingObserver observer(theta);
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < updates; i++) observer.update((uint16_t)(i * 7) & 0x0FFF);
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                       start).count();
+  volatile int32_t sink = observer.getAngleQ16();
+  (void)sink;
+  printf("update    %.2f ns per call (%u calls, host)\n", ns / updates, updates);
+}
+
+int main(int argc, char** argv) {
+  float theta = 0.8f;
+  uint32_t rate = 1000;
+  uint32_t updates = 10000000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--theta") && i + 1 < argc) theta = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "--rate") && i + 1 < argc) rate = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--updates") && i + 1 < argc) updates = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--theta T] [--rate HZ] [--updates N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (rate < 100) rate = 100;
+  if (updates < 1) updates = 1;
+
+  printf("theta %.2f, %u samples/s\n", theta, rate);
+  checkStep(theta, rate);
+  checkRamp(theta, rate);
+  checkAcceleration(theta, rate);
+  checkNoise(theta);
+  benchmark(theta, updates);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
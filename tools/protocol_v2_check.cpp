@@ -0,0 +1,313 @@
+// ============================================================================
+// Protocol v2 Check - framing, corruption, sequence accounting and throughput
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/protocol_v2_check.cpp -o protocol_v2_check
+//
+// Usage:
+//
+//   protocol_v2_check [--frames N] [--runs R]
+//
+// Encodes frames with ProtocolV2::encodeFrame() and feeds them to
+// ProtocolV2::Decoder. Checks that:
+//   - CRC-16/CCITT-FALSE gives the standard check value (0x29B1);
+//   - every payload length 0..MAX_PAYLOAD (random bytes, all zeros, all
+//     0xFF) round trips through push() and decodeFrame(), with no 0x00
+//     before the delimiter and within MAX_ENCODED; a longer payload is
+//     refused;
+//   - every single-bit flip of an encoded frame is rejected (as a CRC or
+//     framing error, or as two fragments when the flip makes a 0x00), and
+//     the next frame decodes;
+//   - every truncation of a frame, from either end, is rejected and the
+//     next frame decodes;
+//   - sequence gaps count lost frames, also across the 16-bit wrap; a
+//     repeated frame counts as a duplicate and a step back as a sequence
+//     reset, neither as lost.
+// Then times --frames TYPE_ANGLES frames (two sensors), best of --runs:
+// encoding, decoding byte by byte with push(), and whole frames with
+// decodeFrame(); prints frames/s. Exits non-zero on any failure.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "check.h"
+#include "protocol_v2.h"
+
+using namespace ProtocolV2;
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes encode(uint8_t type, uint16_t sequence, uint32_t timestampUs, const Bytes& payload) {
+  uint8_t out[MAX_ENCODED];
+  size_t size = encodeFrame(type, sequence, timestampUs, payload.data(), payload.size(), out);
+  return Bytes(out, out + size);
+}
+
+// Feed bytes; returns the number of frames completed
+static uint32_t feed(Decoder& decoder, const Bytes& bytes) {
+  uint32_t frames = 0;
+  for (size_t i = 0; i < bytes.size(); i++) {
+    if (decoder.push(bytes[i])) frames++;
+  }
+  return frames;
+}
+
+static bool sameFrame(const Frame& frame, uint8_t type, uint16_t sequence, uint32_t timestampUs,
+                      const Bytes& payload) {
+  return frame.type == type && frame.sequence == sequence && frame.timestampUs == timestampUs &&
+         frame.length == payload.size() &&
+         (payload.empty() || memcmp(frame.payload, payload.data(), payload.size()) == 0);
+}
+
+static void checkRoundTrip() {
+  const uint8_t check1[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  check(crc16(check1, sizeof(check1)) == 0x29B1, "CRC-16/CCITT-FALSE check value");
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> byte(0, 255);
+  uint32_t frames = 0;
+  size_t largest = 0;
+  bool pushMismatch = false, directMismatch = false, badEncoding = false;
+  for (int fill = 0; fill < 3; fill++) {
+    for (size_t length = 0; length <= MAX_PAYLOAD; length++) {
+      Bytes payload(length);
+      for (size_t i = 0; i < length; i++) {
+        payload[i] = fill == 0 ? (uint8_t)byte(rng) : fill == 1 ? 0x00 : 0xFF;
+      }
+      uint8_t type = (uint8_t)byte(rng);
+      uint16_t sequence = (uint16_t)(byte(rng) << 8 | byte(rng));
+      uint32_t timestampUs = 0xFFFFFF00u + (uint32_t)length;
+      Bytes encoded = encode(type, sequence, timestampUs, payload);
+      if (encoded.empty() || encoded.size() > MAX_ENCODED || encoded.back() != DELIMITER ||
+          memchr(encoded.data(), DELIMITER, encoded.size() - 1) != nullptr) {
+        badEncoding = true;
+        continue;
+      }
+      if (encoded.size() > largest) largest = encoded.size();
+
+      Decoder decoder;
+      if (feed(decoder, encoded) != 1 ||
+          !sameFrame(decoder.frame(), type, sequence, timestampUs, payload)) {
+        pushMismatch = true;
+      }
+      Decoder direct;
+      if (!direct.decodeFrame(encoded.data(), encoded.size() - 1) ||
+          !sameFrame(direct.frame(), type, sequence, timestampUs, payload)) {
+        directMismatch = true;
+      }
+      frames++;
+    }
+  }
+  printf("roundtrip %u frames, payload 0..%zu bytes, largest %zu encoded (MAX_ENCODED %zu)\n",
+         frames, MAX_PAYLOAD, largest, MAX_ENCODED);
+  check(!badEncoding, "encoded frame: no 0x00 before the delimiter, within MAX_ENCODED");
+  check(!pushMismatch, "push() round trip");
+  check(!directMismatch, "decodeFrame() round trip");
+
+  uint8_t out[MAX_ENCODED];
+  uint8_t tooLong[MAX_PAYLOAD + 1] = { 0 };
+  check(encodeFrame(TYPE_ANGLES, 0, 0, tooLong, sizeof(tooLong), out) == 0,
+        "payload over MAX_PAYLOAD refused");
+}
+
+// A frame with zeros and non-zeros in the header, payload and CRC
+static Bytes samplePayload(size_t length, uint8_t seed) {
+  Bytes payload(length);
+  for (size_t i = 0; i < length; i++) payload[i] = (i % 5 == 0) ? 0 : (uint8_t)(seed + 31 * i);
+  return payload;
+}
+
+static void checkBitFlips() {
+  const size_t lengths[] = { 0, 1, 9, 40, MAX_PAYLOAD };
+  Bytes next = encode(TYPE_ANGLES, 7, 1234, samplePayload(9, 3));
+  uint32_t flips = 0, crc = 0, framing = 0, split = 0;
+  bool accepted = false, lostSync = false;
+  for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+    Bytes encoded = encode(TYPE_MOTION, 0x0100, 0, samplePayload(lengths[l], (uint8_t)l));
+    for (size_t at = 0; at + 1 < encoded.size(); at++) {
+      for (int bit = 0; bit < 8; bit++) {
+        Bytes corrupted = encoded;
+        corrupted[at] ^= (uint8_t)(1 << bit);
+        if (corrupted[at] == DELIMITER) split++;
+        Decoder decoder;
+        if (feed(decoder, corrupted) != 0) accepted = true;
+        if (feed(decoder, next) != 1 || decoder.frame().sequence != 7) lostSync = true;
+        const Decoder::Stats& stats = decoder.getStats();
+        crc += stats.crcErrors;
+        framing += stats.framingErrors;
+        flips++;
+      }
+    }
+  }
+  printf("bit flips %u single-bit flips: %u CRC errors, %u framing errors, %u made a 0x00\n",
+         flips, crc, framing, split);
+  check(!accepted, "no corrupted frame accepted");
+  check(!lostSync, "next frame decodes after a corrupted one");
+  check(crc + framing >= flips, "every flip counted as an error");
+}
+
+static void checkTruncation() {
+  Bytes next = encode(TYPE_ANGLES, 9, 5678, samplePayload(9, 5));
+  uint32_t cuts = 0;
+  bool accepted = false, lostSync = false;
+  const size_t lengths[] = { 0, 9, MAX_PAYLOAD };
+  for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+    Bytes encoded = encode(TYPE_POSITION, 3, 99, samplePayload(lengths[l], 7));
+    size_t body = encoded.size() - 1;
+    for (size_t keep = 1; keep < body; keep++) {
+      // Tail lost (line dropped) and head lost (receiver joined mid-frame)
+      Bytes head(encoded.begin(), encoded.begin() + keep);
+      Bytes tail(encoded.begin() + (body - keep), encoded.end() - 1);
+      const Bytes* parts[2] = { &head, &tail };
+      for (int p = 0; p < 2; p++) {
+        Decoder decoder;
+        Bytes cut = *parts[p];
+        cut.push_back(DELIMITER);
+        if (feed(decoder, cut) != 0) accepted = true;
+        if (feed(decoder, next) != 1 || decoder.frame().sequence != 9) lostSync = true;
+        cuts++;
+      }
+    }
+  }
+  printf("truncate  %u truncated frames\n", cuts);
+  check(!accepted, "no truncated frame accepted");
+  check(!lostSync, "next frame decodes after a truncated one");
+}
+
+struct SequenceCase {
+  const char* name;
+  std::vector<uint16_t> sequences;
+  uint32_t lost;
+  uint32_t duplicates;
+  uint32_t resets;
+};
+
+static void checkSequences() {
+  const SequenceCase cases[] = {
+    { "in order", { 0, 1, 2, 3 }, 0, 0, 0 },
+    { "gap", { 0, 1, 2, 5, 6 }, 2, 0, 0 },
+    { "wrap", { 65534, 65535, 0, 1 }, 0, 0, 0 },
+    { "gap over wrap", { 65534, 65535, 2 }, 2, 0, 0 },
+    { "duplicate", { 10, 11, 11, 12 }, 0, 1, 0 },
+    { "duplicate at wrap", { 65535, 65535, 0 }, 0, 1, 0 },
+    { "restart", { 1000, 1001, 0, 1, 2 }, 0, 0, 1 },
+    { "largest gap", { 0, 32767 }, 32766, 0, 0 },
+  };
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    const SequenceCase& sc = cases[c];
+    Decoder decoder;
+    uint32_t frames = 0;
+    for (size_t i = 0; i < sc.sequences.size(); i++) {
+      frames += feed(decoder, encode(TYPE_ANGLES, sc.sequences[i], 0, samplePayload(5, 1)));
+    }
+    const Decoder::Stats& stats = decoder.getStats();
+    check(frames == sc.sequences.size() && stats.frames == frames, "every frame delivered",
+          sc.name);
+    check(stats.lost == sc.lost && stats.duplicates == sc.duplicates &&
+          stats.sequenceResets == sc.resets, "lost, duplicate and reset counts", sc.name);
+    printf("sequence  %-17s lost %u, duplicates %u, resets %u\n", sc.name, stats.lost,
+           stats.duplicates, stats.sequenceResets);
+  }
+}
+
+template <typename F>
+static double bestSeconds(int runs, F body) {
+  double best = 1e30;
+  for (int r = 0; r < runs; r++) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (s < best) best = s;
+  }
+  return best;
+}
+
+static void bench(uint32_t frames, int runs) {
+  // TYPE_ANGLES for two sensors: [count][angle u16, offset i16] x 2
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> angle(0, 4095);
+  std::vector<Bytes> payloads(256);
+  for (size_t i = 0; i < payloads.size(); i++) {
+    uint16_t a = (uint16_t)angle(rng), b = (uint16_t)angle(rng);
+    int16_t offset = (int16_t)(i % 400);
+    payloads[i] = { 2, (uint8_t)(a & 0xFF), (uint8_t)(a >> 8), 0, 0, (uint8_t)(b & 0xFF),
+                    (uint8_t)(b >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(offset >> 8) };
+  }
+
+  Bytes stream;
+  std::vector<size_t> starts;
+  stream.reserve((size_t)frames * 20);
+  uint8_t out[MAX_ENCODED];
+  volatile size_t sink = 0;
+  double encodeS = bestSeconds(runs, [&]() {
+    size_t total = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+      const Bytes& payload = payloads[i & 0xFF];
+      total += encodeFrame(TYPE_ANGLES, (uint16_t)i, i * 1000, payload.data(), payload.size(),
+                           out);
+    }
+    sink = total;
+  });
+  for (uint32_t i = 0; i < frames; i++) {
+    const Bytes& payload = payloads[i & 0xFF];
+    size_t size = encodeFrame(TYPE_ANGLES, (uint16_t)i, i * 1000, payload.data(),
+                              payload.size(), out);
+    starts.push_back(stream.size());
+    stream.insert(stream.end(), out, out + size);
+  }
+  starts.push_back(stream.size());
+
+  uint32_t pushed = 0, direct = 0, lost = 0;
+  double pushS = bestSeconds(runs, [&]() {
+    Decoder decoder;
+    uint32_t count = 0;
+    for (size_t i = 0; i < stream.size(); i++) {
+      if (decoder.push(stream[i])) count++;
+    }
+    pushed = count;
+    lost = decoder.getStats().lost;
+  });
+  double directS = bestSeconds(runs, [&]() {
+    Decoder decoder;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+      if (decoder.decodeFrame(&stream[starts[i]], starts[i + 1] - starts[i] - 1)) count++;
+    }
+    direct = count;
+  });
+
+  printf("bench     %u frames of %zu bytes (%.1f bytes/frame on the wire)\n", frames,
+         HEADER_SIZE + payloads[0].size() + CRC_SIZE, (double)stream.size() / frames);
+  printf("bench     encode %.2f M frames/s, decode push() %.2f M frames/s, decodeFrame() "
+         "%.2f M frames/s\n", frames / encodeS / 1e6, frames / pushS / 1e6,
+         frames / directS / 1e6);
+  check(pushed == frames && direct == frames && lost == 0, "bench stream decodes completely");
+}
+
+int main(int argc, char** argv) {
+  uint32_t frames = 1000000;
+  int runs = 5;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--runs") && i + 1 < argc) runs = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--frames N] [--runs R]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (frames < 1000) frames = 1000;
+  if (runs < 1) runs = 1;
+
+  checkRoundTrip();
+  checkBitFlips();
+  checkTruncation();
+  checkSequences();
+  bench(frames, runs);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
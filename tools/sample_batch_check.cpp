@@ -0,0 +1,225 @@
+// ============================================================================
+// Sample Batch Check - SampleBatch round trip, size and malformed payloads
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/sample_batch_check.cpp -o sample_batch_check
+//
+// Usage:
+//
+//   sample_batch_check [--samples N]
+//
+// Batches synthetic 1 kHz traces (still shaft with noise, slow sine, 300 rpm
+// through the 4095 -> 0 wrap, random jumps, timing jitter and gaps, the
+// 32-bit microsecond wrap) for 1 to 4 sensors and batch sizes 1 to 32,
+// sending on isReady() or when add() refuses a sample, as UartProtocol does.
+// Checks that:
+//   - every batch decodes to exactly the samples that went in, in order;
+//   - no batch exceeds MAX_PAYLOAD and no sample is lost at a refused add();
+//   - a batch is ready once full or once its first sample is flushUs old;
+//   - every truncation of a batch, and random bytes, decode to -1 or to at
+//     most maxOut samples (never out of bounds).
+// Prints bytes per sample on the wire (v2 frames) against one
+// TYPE_ANGLE_ARRAY frame per sample. Exits non-zero on any failure.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "check.h"
+#include "protocol_v2.h"
+#include "sample_batch.h"
+
+struct Trace {
+  const char* name;
+  uint8_t sensors;
+  std::vector<uint32_t> times;
+  std::vector<uint16_t> angles;     // sensors per sample
+};
+
+static Trace makeTrace(const char* name, uint8_t sensors, size_t samples, int kind) {
+  Trace trace;
+  trace.name = name;
+  trace.sensors = sensors;
+  std::mt19937 rng(kind + 1);
+  std::uniform_int_distribution<int> noise(-2, 2);
+  std::uniform_int_distribution<int> jitter(-20, 20);
+  std::uniform_int_distribution<int> angle(0, 4095);
+  std::uniform_int_distribution<int> rare(0, 999);
+  // Start 100 ms before the microsecond counter wraps
+  uint32_t timeUs = 0xFFFFFFFFu - 100000;
+  for (size_t i = 0; i < samples; i++) {
+    timeUs += 1000 + jitter(rng);
+    if (kind == 3 && rare(rng) == 0) timeUs += 70000;     // Missed samples
+    trace.times.push_back(timeUs);
+    for (uint8_t s = 0; s < sensors; s++) {
+      double value;
+      switch (kind) {
+        case 0: value = 1000.0 + 700.0 * s; break;                          // Still
+        case 1: value = 2048.0 + 1500.0 * sin(i * 0.001 + s); break;        // Slow sine
+        case 2: value = i * 4096.0 * 5 / 1000 + 1024.0 * s; break;          // 300 rpm
+        default: value = rare(rng) < 20 ? angle(rng) : 3000.0 + 40.0 * s; break;  // Jumps
+      }
+      trace.angles.push_back((uint16_t)(((long)lround(value) + noise(rng)) & 0x0FFF));
+    }
+  }
+  return trace;
+}
+
+struct Receiver {
+  const Trace* trace;
+  size_t next;                      // Next sample expected
+  bool mismatch;
+  bool malformed;
+  size_t frames;
+  size_t wireBytes;
+  size_t maxLength;
+};
+
+static void send(Receiver& rx, const SampleBatch& batch, uint8_t maxSamples) {
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  rx.wireBytes += ProtocolV2::encodeFrame(0x05, (uint16_t)rx.frames, 0, batch.getPayload(),
+                                          batch.getLength(), frame);
+  rx.frames++;
+  if (batch.getLength() > rx.maxLength) rx.maxLength = batch.getLength();
+
+  SampleBatch::Sample out[64];
+  uint8_t sensors = 0;
+  int count = SampleBatch::decode(batch.getPayload(), batch.getLength(), out, maxSamples,
+                                  sensors);
+  if (count != batch.getSampleCount() || sensors != rx.trace->sensors) {
+    rx.malformed = true;
+    return;
+  }
+  for (int k = 0; k < count; k++, rx.next++) {
+    if (out[k].timeUs != rx.trace->times[rx.next]) rx.mismatch = true;
+    for (uint8_t s = 0; s < sensors; s++) {
+      if (out[k].angles[s] != rx.trace->angles[rx.next * sensors + s]) rx.mismatch = true;
+    }
+  }
+}
+
+static void runTrace(const Trace& trace, uint8_t maxSamples, bool print) {
+  const uint32_t flushUs = 20000;
+  SampleBatch batch;
+  batch.configure(trace.sensors, maxSamples, 1000, flushUs);
+  Receiver rx = { &trace, 0, false, false, 0, 0, 0 };
+  bool lostOnRefusal = false;
+  bool readyEarly = false;
+  bool readyLate = false;
+  size_t samples = trace.times.size();
+
+  for (size_t i = 0; i < samples; i++) {
+    const uint16_t* angles = &trace.angles[i * trace.sensors];
+    uint32_t timeUs = trace.times[i];
+    if (!batch.add(angles, timeUs)) {
+      send(rx, batch, maxSamples);
+      batch.clear();
+      if (!batch.add(angles, timeUs)) lostOnRefusal = true;
+    }
+    // isReady() exactly when full or at the flush deadline
+    uint32_t age = timeUs - trace.times[rx.next];
+    bool due = batch.getSampleCount() >= maxSamples || age >= flushUs;
+    if (batch.isReady(timeUs) && !due) readyEarly = true;
+    if (!batch.isReady(timeUs) && due) readyLate = true;
+    if (batch.isReady(timeUs)) {
+      send(rx, batch, maxSamples);
+      batch.clear();
+    }
+  }
+  if (!batch.isEmpty()) send(rx, batch, maxSamples);
+
+  // One TYPE_ANGLE_ARRAY frame per sample: [count][angle u16] x sensors
+  uint8_t payload[1 + 2 * SampleBatch::MAX_SENSORS] = { trace.sensors };
+  uint8_t frame[ProtocolV2::MAX_ENCODED];
+  size_t single = ProtocolV2::encodeFrame(ProtocolV2::TYPE_ANGLE_ARRAY, 0x1234, 0x89ABCDEF,
+                                          payload, 1 + 2 * trace.sensors, frame);
+  if (print) {
+    printf("%-6s %u sensor%s  K=%2u  %6zu frames  %5.2f bytes/sample (unbatched %zu)  "
+           "max payload %zu\n", trace.name, trace.sensors, trace.sensors == 1 ? " " : "s",
+           maxSamples, rx.frames, (double)rx.wireBytes / samples, single, rx.maxLength);
+  }
+
+  check(!rx.malformed, "every batch decodes", trace.name);
+  check(!rx.mismatch && rx.next == samples, "decoded samples match the trace", trace.name);
+  check(rx.maxLength <= SampleBatch::MAX_PAYLOAD, "payload within MAX_PAYLOAD", trace.name);
+  check(!lostOnRefusal, "a refused sample fits an empty batch", trace.name);
+  check(!readyEarly && !readyLate, "ready when full or at the flush deadline", trace.name);
+}
+
+static void checkMalformed() {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<int> angle(0, 4095);
+  SampleBatch::Sample out[64];
+  uint8_t sensors;
+  uint32_t truncations = 0;
+  uint32_t accepted = 0;
+
+  // Every truncation of a full batch of large deltas is rejected
+  for (uint8_t n = 1; n <= SampleBatch::MAX_SENSORS; n++) {
+    SampleBatch batch;
+    batch.configure(n, 64, 1000, 1000000);
+    uint16_t angles[SampleBatch::MAX_SENSORS];
+    uint32_t timeUs = 0;
+    for (;;) {
+      for (uint8_t s = 0; s < n; s++) angles[s] = (uint16_t)angle(rng);
+      timeUs += 1000 + byte(rng);
+      if (!batch.add(angles, timeUs)) break;
+    }
+    for (size_t length = 0; length < batch.getLength(); length++) {
+      truncations++;
+      if (SampleBatch::decode(batch.getPayload(), length, out, 64, sensors) >= 0) accepted++;
+    }
+    // And a decode into too small a buffer
+    check(SampleBatch::decode(batch.getPayload(), batch.getLength(), out,
+                              batch.getSampleCount() - 1, sensors) == -1,
+          "more samples than maxOut rejected", "malformed");
+  }
+  check(accepted == 0, "truncated batches rejected", "malformed");
+
+  // Random payloads never decode more than maxOut samples
+  bool overrun = false;
+  uint32_t decoded = 0;
+  for (int i = 0; i < 200000; i++) {
+    uint8_t payload[SampleBatch::MAX_PAYLOAD];
+    size_t length = (size_t)byte(rng) % (SampleBatch::MAX_PAYLOAD + 1);
+    for (size_t k = 0; k < length; k++) payload[k] = (uint8_t)byte(rng);
+    if (length > 1 && (i & 1)) payload[1] %= 8;     // Plausible sample counts
+    size_t maxOut = 1 + i % 16;
+    int count = SampleBatch::decode(payload, length, out, maxOut, sensors);
+    if (count > (int)maxOut) overrun = true;
+    if (count >= 0) decoded++;
+  }
+  printf("malformed %u truncations rejected, %u of 200000 random payloads decoded, "
+         "none past maxOut\n", truncations - accepted, decoded);
+  check(!overrun, "random payloads stay within maxOut", "malformed");
+}
+
+int main(int argc, char** argv) {
+  size_t samples = 20000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--samples") && i + 1 < argc) samples = (size_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--samples N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (samples < 100) samples = 100;
+
+  static const char* NAMES[4] = { "still", "sine", "300rpm", "jumps" };
+  static const uint8_t SIZES[5] = { 1, 4, 8, 16, 32 };
+  for (int kind = 0; kind < 4; kind++) {
+    for (uint8_t sensors = 1; sensors <= SampleBatch::MAX_SENSORS; sensors++) {
+      Trace trace = makeTrace(NAMES[kind], sensors, samples, kind);
+      // All are checked; sizes are printed for two sensors (the firmware)
+      for (uint8_t k = 0; k < 5; k++) runTrace(trace, SIZES[k], sensors == 2);
+    }
+  }
+  checkMalformed();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+// ============================================================================
+// Sensor Array Simulation - ArrayBusReader against fake TCA9548A muxes
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/sensor_array_sim.cpp -o sensor_array_sim
+//
+// Usage:
+//
+//   sensor_array_sim [--passes N] [--freq HZ] [--overhead-us US]
+//
+// Builds sensor array layouts of N = 2..16 sensors (split across two
+// buses, up to four channels on mux 0x70 and the rest on 0x71, added in
+// reverse order) out of fake AS5600s and TCA9548As
+// (tools/fake_wire.h), and runs each bus through ArrayBusReader on a
+// virtual clock. For every N it checks that:
+//   - every pass returns each sensor's current angle, with no two sensors
+//     ever answering at once;
+//   - the mux writes per pass are what select batching should leave
+//     (one per channel change, one release per mux change);
+//   - the bus time of a pass matches estimatePassUs() to within 1 us
+//     (skipped with --overhead-us, which adds a per-transaction driver
+//     cost the estimate leaves out, to show the gap);
+//   - each reading's timestamp is the instant its read went on the bus.
+// It prints the per-bus estimate and the cycle time with both buses read in
+// parallel (the slower bus) against reading them in turn (the sum).
+//
+// With 16 sensors it then unplugs one sensor and checks it goes offline
+// after SensorHealth::FAULT_THRESHOLD errors while the others keep reading,
+// and comes back on a re-probe once it is plugged in again. Finally a mux
+// that lost its channel selection must cost one error, not a dropout.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "array_bus_reader.h"
+#include "check.h"
+#include "fake_wire.h"
+
+static const uint8_t AS5600_ADDRESS = 0x36;
+static const uint8_t MAX_PER_BUS = 8;
+
+static void check(bool condition, const char* what, unsigned n) {
+  char subject[16];
+  snprintf(subject, sizeof(subject), "N=%u", n);
+  check(condition, what, subject);
+}
+
+// Bus time as seen by the reader, plus idle time between passes
+class VirtualClock : public Clock {
+public:
+  explicit VirtualClock(const FakeWire& wire) : idleUs(0), _wire(wire) {}
+
+  int64_t idleUs;
+
+  int64_t nowUs() override { return idleUs + (int64_t)(_wire.busyNs / 1000); }
+
+private:
+  const FakeWire& _wire;
+};
+
+// Records the clock when a read goes on the bus
+class TimedAS5600 : public FakeAS5600 {
+public:
+  TimedAS5600() : clock(nullptr), lastReadUs(0) {}
+
+  Clock* clock;
+  uint32_t lastReadUs;
+
+  size_t onRead(uint8_t* data, size_t length) override {
+    lastReadUs = (uint32_t)clock->nowUs();
+    return FakeAS5600::onRead(data, length);
+  }
+};
+
+// One I2C bus with its muxes, sensors and reader
+struct SimBus {
+  typedef ArrayBusReader<FakeWire> Reader;
+
+  FakeWire wire;
+  VirtualClock clock;
+  FakeTCA9548A muxes[2];
+  FakeMuxFabric fabric;
+  TimedAS5600 sensors[MAX_PER_BUS];
+  Reader reader;
+  uint8_t count;
+  uint8_t perMux[2];
+
+  SimBus(uint32_t freq, uint32_t overheadUs)
+    : wire(freq), clock(wire), reader(wire, clock, AS5600_ADDRESS, 0x0E), count(0) {
+    wire.overheadUs = overheadUs;
+    wire.attach(0x70, &muxes[0]);
+    wire.attach(0x71, &muxes[1]);
+    wire.attach(AS5600_ADDRESS, &fabric);
+    perMux[0] = perMux[1] = 0;
+  }
+
+  static uint8_t muxAddress(uint8_t k) { return k < 4 ? 0x70 : 0x71; }
+  static uint8_t channel(uint8_t k) { return k < 4 ? k : k - 4; }
+
+  // Sensor `k` on this bus, array index `index`
+  void add(uint8_t k, uint8_t index) {
+    sensors[k].clock = &clock;
+    fabric.attach(&muxes[k < 4 ? 0 : 1], channel(k), &sensors[k]);
+    reader.add(index, muxAddress(k), channel(k));
+    perMux[k < 4 ? 0 : 1]++;
+    count++;
+  }
+
+  // Mux writes of a steady-state pass: one select per slot unless a
+  // single slot stays selected, plus a release per mux change
+  uint32_t expectedMuxWrites() const {
+    if (perMux[1] == 0) return perMux[0] > 1 ? perMux[0] : 0;
+    if (perMux[0] == 0) return perMux[1] > 1 ? perMux[1] : 0;
+    return perMux[0] + perMux[1] + 2;
+  }
+
+  TimedAS5600& sensorAt(uint8_t slot) {
+    uint8_t mux = reader.muxOf(slot) == 0x70 ? 0 : 4;
+    return sensors[mux + reader.channelOf(slot)];
+  }
+};
+
+// Run passes on one bus and check what each returns; returns the bus time
+// of the last pass (us)
+static double runPasses(SimBus& bus, unsigned n, uint32_t passes, bool checkEstimate,
+                        uint32_t pass0) {
+  double lastUs = 0;
+  for (uint32_t p = 0; p < passes; p++) {
+    for (uint8_t k = 0; k < bus.count; k++) {
+      bus.sensors[k].angle = ((pass0 + p) * 131 + k * 509) & 0x0FFF;
+    }
+    uint32_t writesBefore = bus.reader.snapshot().muxWrites;
+    uint64_t busyBefore = bus.wire.busyNs;
+    bus.reader.readPass();
+    bus.clock.idleUs += 1000;
+
+    const SimBus::Reader::Snapshot& snapshot = bus.reader.snapshot();
+    bool anglesOk = true;
+    bool timesOk = true;
+    for (uint8_t s = 0; s < bus.count; s++) {
+      const SimBus::Reader::Reading& reading = snapshot.readings[s];
+      TimedAS5600& sensor = bus.sensorAt(s);
+      anglesOk = anglesOk && reading.fresh && reading.online && reading.angle == sensor.angle;
+      timesOk = timesOk && reading.timeUs == sensor.lastReadUs;
+    }
+    check(anglesOk, "angles read back", n);
+    check(timesOk, "timestamps are the read instants", n);
+    lastUs = (bus.wire.busyNs - busyBefore) / 1000.0;
+    // The first pass starts from the muxes begin() left selected
+    if (p > 0 || pass0 > 0) {
+      check(snapshot.muxWrites - writesBefore == bus.expectedMuxWrites(),
+            "mux writes per pass", n);
+    }
+  }
+  if (checkEstimate && bus.count > 0) {
+    double estimate = bus.reader.estimatePassUs(bus.wire.getClock());
+    check(estimate >= lastUs - 1.0 && estimate <= lastUs + 1.0,
+          "bus time matches estimatePassUs", n);
+  }
+  check(bus.fabric.collisions == 0, "no two sensors answer at once", n);
+  return lastUs;
+}
+
+static void buildLayout(SimBus& bus0, SimBus& bus1, unsigned n) {
+  // Alternate buses, and add each bus's sensors in reverse order so the
+  // reader has to sort them
+  uint8_t perBus[2] = { (uint8_t)((n + 1) / 2), (uint8_t)(n / 2) };
+  uint8_t next[2] = { 0, 0 };
+  for (unsigned i = 0; i < n; i++) {
+    uint8_t b = i % 2;
+    uint8_t k = (uint8_t)(perBus[b] - 1 - next[b]++);
+    (b == 0 ? bus0 : bus1).add(k, (uint8_t)i);
+  }
+}
+
+static void runLayouts(uint32_t passes, uint32_t freq, uint32_t overheadUs) {
+  bool checkEstimate = overheadUs == 0;
+  printf("%u passes per layout at %u Hz, %u us driver overhead per transaction\n",
+         passes, freq, overheadUs);
+  printf(" N  bus0 est/sim (us)  bus1 est/sim (us)  mux writes  parallel  sequential\n");
+  for (unsigned n = 2; n <= 16; n++) {
+    SimBus bus0(freq, overheadUs);
+    SimBus bus1(freq, overheadUs);
+    buildLayout(bus0, bus1, n);
+    bus0.reader.begin();
+    bus1.reader.begin();
+
+    double sim0 = runPasses(bus0, n, passes, checkEstimate, 0);
+    double sim1 = runPasses(bus1, n, passes, checkEstimate, 0);
+    uint32_t est0 = bus0.reader.estimatePassUs(freq);
+    uint32_t est1 = bus1.reader.estimatePassUs(freq);
+    double parallel = sim0 > sim1 ? sim0 : sim1;
+    printf("%2u  %6u / %7.1f   %6u / %7.1f   %4u + %-4u  %6.1f   %8.1f\n", n, est0, sim0,
+           est1, sim1, bus0.expectedMuxWrites(), bus1.expectedMuxWrites(), parallel,
+           sim0 + sim1);
+  }
+}
+
+static void runFaults(uint32_t freq) {
+  const unsigned n = 16;
+  SimBus bus0(freq, 0);
+  SimBus bus1(freq, 0);
+  buildLayout(bus0, bus1, n);
+  bus0.reader.begin();
+  bus1.reader.begin();
+  runPasses(bus0, n, 2, false, 0);
+
+  // Unplug the sensor in slot 5 (mux 0x71)
+  const uint8_t victim = 5;
+  TimedAS5600& sensor = bus0.sensorAt(victim);
+  sensor.online = false;
+  uint32_t errorPasses = 0;
+  bool othersOk = true;
+  for (uint32_t p = 0; p < 10 && bus0.reader.snapshot().readings[victim].online; p++) {
+    bus0.reader.readPass();
+    bus0.clock.idleUs += 1000;
+    errorPasses++;
+    for (uint8_t s = 0; s < bus0.count; s++) {
+      if (s != victim) othersOk = othersOk && bus0.reader.snapshot().readings[s].fresh;
+    }
+  }
+  check(errorPasses == SensorHealth::FAULT_THRESHOLD, "offline after the fault threshold", n);
+  check(othersOk, "other sensors keep reading", n);
+  uint16_t staleAngle = bus0.reader.snapshot().readings[victim].angle;
+
+  // Offline: re-probed right away, then on the backoff schedule
+  uint32_t probesBefore = bus0.reader.getHealth(victim).probes;
+  for (uint32_t p = 0; p < 50; p++) {
+    bus0.reader.readPass();
+    bus0.clock.idleUs += 1000;
+  }
+  uint32_t probes = bus0.reader.getHealth(victim).probes - probesBefore;
+  check(probes >= 1 && probes <= 2, "re-probes follow the backoff", n);
+  check(!bus0.reader.snapshot().readings[victim].fresh &&
+        bus0.reader.snapshot().readings[victim].angle == staleAngle,
+        "offline sensor keeps its last angle", n);
+
+  // Plug it back in: picked up by the next due re-probe
+  sensor.powerOn();
+  sensor.angle = 777;
+  bool recovered = false;
+  uint32_t waitedMs = 0;
+  for (; waitedMs < 1000 && !recovered; waitedMs += 10) {
+    bus0.reader.readPass();
+    bus0.clock.idleUs += 10000;
+    const SimBus::Reader::Reading& reading = bus0.reader.snapshot().readings[victim];
+    recovered = reading.online && reading.fresh && reading.angle == 777;
+  }
+  check(recovered, "back online after replug", n);
+  check(bus0.reader.getHealth(victim).recoveries == 1, "one recovery counted", n);
+  printf("unplug: offline after %u passes, %u re-probes while unplugged, back after %u ms\n",
+         errorPasses, probes, waitedMs);
+
+  check(bus0.fabric.collisions == 0, "no collisions", n);
+}
+
+static void runMuxGlitch(uint32_t freq) {
+  // N = 2 leaves one sensor per bus, selected once and never rewritten;
+  // if its mux resets, the next read NACKs and must force a reselect
+  const unsigned n = 2;
+  SimBus bus0(freq, 0);
+  SimBus bus1(freq, 0);
+  buildLayout(bus0, bus1, n);
+  bus0.reader.begin();
+  runPasses(bus0, n, 2, false, 0);
+
+  bus0.muxes[0].reset();
+  uint32_t writesBefore = bus0.muxes[0].writes;
+  for (uint32_t p = 0; p < 3; p++) {
+    bus0.reader.readPass();
+    bus0.clock.idleUs += 1000;
+  }
+  const SensorHealth::Stats& health = bus0.reader.getHealth(0);
+  check(health.errors == 1, "mux glitch costs one error", n);
+  check(health.dropouts == 0 && bus0.reader.snapshot().readings[0].fresh,
+        "mux glitch causes no dropout", n);
+  check(bus0.muxes[0].writes == writesBefore + 1, "mux reselected once", n);
+  printf("mux glitch: %u error, %u dropouts, %u reselect\n", health.errors, health.dropouts,
+         bus0.muxes[0].writes - writesBefore);
+}
+
+int main(int argc, char** argv) {
+  uint32_t passes = 20;
+  uint32_t freq = 400000;
+  uint32_t overheadUs = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--passes") && i + 1 < argc) passes = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--freq") && i + 1 < argc) freq = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--overhead-us") && i + 1 < argc) overheadUs = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--passes N] [--freq HZ] [--overhead-us US]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (passes < 2) passes = 2;
+
+  runLayouts(passes, freq, overheadUs);
+  runFaults(freq);
+  runMuxGlitch(freq);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
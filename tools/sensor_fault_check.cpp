@@ -0,0 +1,307 @@
+// ============================================================================
+// Sensor Fault Check - SensorHealth recovery with injected bus faults
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/sensor_fault_check.cpp -o sensor_fault_check
+//
+// Usage:
+//
+//   sensor_fault_check
+//
+// Runs the read and re-probe sequence of SensorManager::readSensor() and
+// probeSensor() (with the Arduino calls replaced by a fake bus and a fake
+// millisecond clock) over AS5600FastReader and a fake AS5600 that injects
+// faults, one read per ms:
+//   - NACK bursts: bursts shorter than SensorHealth::FAULT_THRESHOLD keep
+//     the sensor online and report the last angle; a longer one takes it
+//     offline and the immediate re-probe brings it back;
+//   - stuck SDA: a sensor interrupted mid-byte fails every transaction,
+//     including presence checks, until the bus clear clocks it out (at most
+//     9 SCL pulses); the re-probe then finds it;
+//   - unplug/replug: while unplugged, reads do not touch the bus and the
+//     only transactions are re-probes; after replug (register pointer reset
+//     by power-on) the next re-probe recovers and the first read returns
+//     the current angle;
+//   - backoff: re-probe intervals double from I2C_REPROBE_MIN_MS up to
+//     I2C_REPROBE_MAX_MS and reset after a recovery, also with the clock
+//     wrapping past 2^32 ms.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "as5600_fast_reader.h"
+#include "check.h"
+#include "fake_wire.h"
+#include "sensor_health.h"
+
+static const uint8_t AS5600_ADDRESS = 0x36;
+static const uint32_t MIN_BACKOFF_MS = 100;     // I2C_REPROBE_MIN_MS
+static const uint32_t MAX_BACKOFF_MS = 5000;    // I2C_REPROBE_MAX_MS
+
+// FakeAS5600 with injected faults
+class FaultyAS5600 : public FakeAS5600 {
+public:
+  FaultyAS5600() : nackBurst(0), stuckBits(0) {}
+
+  uint32_t nackBurst;         // Transactions still to NACK
+  uint32_t stuckBits;         // Clocks until SDA is released; 0 = bus idle
+
+  bool present() const override { return FakeAS5600::present() && stuckBits == 0; }
+
+  bool onWrite(const uint8_t* data, size_t length) override {
+    if (nackBurst > 0) {
+      nackBurst--;
+      return false;
+    }
+    return FakeAS5600::onWrite(data, length);
+  }
+
+  size_t onRead(uint8_t* data, size_t length) override {
+    if (nackBurst > 0) {
+      nackBurst--;
+      return 0;
+    }
+    return FakeAS5600::onRead(data, length);
+  }
+
+  // One SCL pulse of the bus clear; returns true while SDA is still low
+  bool clockPulse() {
+    if (stuckBits > 0) stuckBits--;
+    return stuckBits > 0;
+  }
+};
+
+// One sensor as SensorManager drives it
+struct Link {
+  FakeWire wire;
+  FaultyAS5600 sensor;
+  AS5600FastReader<FakeWire> fast;
+  SensorHealth health;
+  uint16_t lastAngle;
+  uint32_t lastClearPulses;
+  std::vector<uint32_t> probeTimes;
+
+  Link() : fast(wire, AS5600_ADDRESS), health(MIN_BACKOFF_MS, MAX_BACKOFF_MS), lastAngle(0),
+           lastClearPulses(0) {
+    wire.attach(AS5600_ADDRESS, &sensor);
+  }
+
+  // AS5600::isConnected()
+  bool isConnected() {
+    wire.beginTransmission(AS5600_ADDRESS);
+    return wire.endTransmission() == 0;
+  }
+
+  void begin(uint32_t nowMs) { health.begin(isConnected(), nowMs); }
+
+  // clearBus(): clock SCL until SDA is released, at most 9 pulses
+  void clearBus() {
+    lastClearPulses = 0;
+    for (int i = 0; i < 9 && sensor.stuckBits > 0; i++) {
+      sensor.clockPulse();
+      lastClearPulses++;
+    }
+  }
+
+  // SensorManager::probeSensor()
+  void probe(uint32_t nowMs) {
+    probeTimes.push_back(nowMs);
+    clearBus();
+    health.onBusClear();
+    fast.invalidatePointer();
+    health.onProbeResult(isConnected(), nowMs);
+  }
+
+  // SensorManager::readSensor()
+  uint16_t read(uint32_t nowMs) {
+    if (!health.isOnline()) {
+      if (health.shouldProbe(nowMs)) probe(nowMs);
+      if (!health.isOnline()) return lastAngle;
+    }
+    uint16_t angle;
+    if (fast.read(angle)) {
+      health.onReadOk();
+      lastAngle = angle;
+      return angle;
+    }
+    health.onReadError(nowMs);
+    return lastAngle;
+  }
+};
+
+static void checkNackBursts() {
+  Link link;
+  uint32_t now = 1000;
+  link.begin(now);
+  check(link.health.isOnline(), "online at start");
+  link.sensor.angle = 100;
+  check(link.read(now++) == 100, "first read");
+
+  // Short bursts: errors counted, last angle reported, still online
+  for (uint32_t burst = 1; burst < SensorHealth::FAULT_THRESHOLD; burst++) {
+    uint16_t before = link.lastAngle;
+    link.sensor.nackBurst = burst;
+    link.sensor.angle = 200 + burst;
+    bool held = true;
+    for (uint32_t i = 0; i < burst; i++) {
+      if (link.read(now++) != before) held = false;
+    }
+    check(held, "last angle reported during a short burst");
+    check(link.health.isOnline(), "short burst keeps the sensor online");
+    check(link.read(now++) == 200 + burst, "read after a short burst");
+  }
+  check(link.health.getStats().errors == 3 && link.health.getStats().dropouts == 0,
+        "short bursts: errors counted, no dropout");
+
+  // A burst of FAULT_THRESHOLD takes it offline; the next read re-probes at once
+  link.sensor.nackBurst = SensorHealth::FAULT_THRESHOLD;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) link.read(now++);
+  check(!link.health.isOnline(), "threshold burst takes the sensor offline");
+  link.sensor.angle = 300;
+  uint32_t dropAt = now - 1;
+  check(link.read(now++) == 300, "immediate re-probe recovers and reads");
+  const SensorHealth::Stats& stats = link.health.getStats();
+  printf("nack      errors %u, dropouts %u, probes %u (first %u ms after the dropout), "
+         "pointer writes %u\n", stats.errors, stats.dropouts, stats.probes,
+         link.probeTimes.empty() ? 0 : link.probeTimes[0] - dropAt,
+         link.fast.getStats().pointerWrites);
+  check(stats.dropouts == 1 && stats.probes == 1 && stats.recoveries == 1, "one recovery");
+  check(link.probeTimes.size() == 1 && link.probeTimes[0] == dropAt + 1,
+        "re-probe on the first read after the dropout");
+}
+
+static void checkStuckSda() {
+  Link link;
+  uint32_t now = 0;
+  link.begin(now);
+  link.sensor.angle = 1111;
+  link.read(now++);
+
+  // Interrupted mid-byte: 7 more clocks before it lets go of SDA
+  link.sensor.stuckBits = 7;
+  link.sensor.angle = 2222;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) {
+    check(link.read(now++) == 1111, "last angle while SDA is stuck");
+  }
+  check(!link.health.isOnline(), "stuck SDA takes the sensor offline");
+  bool stillStuck = true;
+  for (int i = 0; i < 100; i++) {
+    if (link.isConnected()) stillStuck = false;
+  }
+  check(stillStuck, "without a bus clear the sensor never answers");
+
+  check(link.read(now++) == 2222, "bus clear + re-probe recovers");
+  printf("stuck SDA released after %u SCL pulses, bus clears %u, recoveries %u\n",
+         link.lastClearPulses, link.health.getStats().busClears,
+         link.health.getStats().recoveries);
+  check(link.lastClearPulses == 7 && link.sensor.stuckBits == 0, "bus clear clocks SDA free");
+  check(link.health.getStats().busClears == 1 && link.health.getStats().recoveries == 1,
+        "one bus clear, one recovery");
+
+  // Held for longer than 9 clocks (a hung sensor): the clear gives up, backoff applies
+  link.sensor.stuckBits = 30;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) link.read(now++);
+  uint32_t dropAt = now - 1;
+  for (uint32_t t = 0; t < 1000; t++) link.read(now++);
+  check(link.health.isOnline(), "released by a later bus clear");
+  check(link.probeTimes.size() == 5 && link.probeTimes[1] == dropAt + 1 &&
+        link.probeTimes[4] == dropAt + 1 + 7 * MIN_BACKOFF_MS,
+        "9 pulses per clear, re-probed with backoff until released");
+}
+
+static void checkUnplug() {
+  Link link;
+  uint32_t now = 50000;
+  link.begin(now);
+  link.sensor.angle = 10;
+  link.read(now++);
+
+  link.sensor.online = false;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) link.read(now++);
+  check(!link.health.isOnline(), "unplug detected");
+  uint32_t unplugged = now - 1;
+
+  // 12 s unplugged: only re-probes touch the bus
+  uint32_t transactionsBefore = link.wire.transactions;
+  size_t probesBefore = link.probeTimes.size();
+  bool held = true;
+  for (uint32_t t = 0; t < 12000; t++) {
+    if (link.read(now++) != 10) held = false;
+  }
+  size_t probes = link.probeTimes.size() - probesBefore;
+  check(held, "last angle while unplugged");
+  check(link.wire.transactions - transactionsBefore == probes,
+        "one bus transaction per re-probe while unplugged");
+
+  // Replug: the sensor's register pointer is reset; the reader reprograms it
+  link.sensor.powerOn();
+  link.sensor.angle = 3210;
+  uint32_t replugged = now;
+  uint32_t writes = link.fast.getStats().pointerWrites;
+  while (link.read(now) != 3210 && now - replugged < 2 * MAX_BACKOFF_MS) now++;
+  printf("unplug    %zu re-probes over 12 s (%u bus transactions), back %u ms after replug\n",
+         probes, link.wire.transactions - transactionsBefore, now - replugged);
+  check(link.health.isOnline(), "replug recovered");
+  check(now - replugged <= MAX_BACKOFF_MS, "recovered within the backoff cap");
+  check(link.fast.getStats().pointerWrites == writes + 1, "pointer reprogrammed after replug");
+  check(probesBefore == 0 && link.probeTimes[0] == unplugged + 1,
+        "first re-probe right after the dropout");
+}
+
+static void checkBackoff(uint32_t start, const char* name) {
+  Link link;
+  uint32_t now = start;
+  link.begin(now);
+  link.read(now++);
+  link.sensor.online = false;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) link.read(now++);
+  uint32_t dropAt = now - 1;
+  for (uint32_t t = 0; t < 30000; t++) link.read(now++);
+
+  // Expected: at the dropout (next read), then 100, 200, ... capped at 5000
+  std::vector<uint32_t> expected;
+  uint32_t at = dropAt + 1;
+  uint32_t backoff = MIN_BACKOFF_MS;
+  while ((int32_t)(now - at) > 0) {
+    expected.push_back(at);
+    at += backoff;
+    backoff = backoff >= MAX_BACKOFF_MS / 2 ? MAX_BACKOFF_MS : backoff * 2;
+  }
+  printf("backoff   %-7s intervals", name);
+  for (size_t i = 1; i < link.probeTimes.size() && i < 10; i++) {
+    printf(" %u", link.probeTimes[i] - link.probeTimes[i - 1]);
+  }
+  printf(" ms\n");
+  check(link.probeTimes == expected, "re-probe times double up to the cap", name);
+  check(link.health.getBackoffMs() == MAX_BACKOFF_MS, "backoff capped", name);
+
+  // Recovery resets the backoff: the next dropout re-probes at 100 ms again
+  link.sensor.powerOn();
+  while (!link.health.isOnline()) link.read(now++);
+  link.sensor.online = false;
+  for (uint32_t i = 0; i < SensorHealth::FAULT_THRESHOLD; i++) link.read(now++);
+  size_t first = link.probeTimes.size();
+  for (uint32_t t = 0; t < 400; t++) link.read(now++);
+  check(link.probeTimes.size() == first + 3 &&
+        link.probeTimes[first + 1] - link.probeTimes[first] == MIN_BACKOFF_MS &&
+        link.probeTimes[first + 2] - link.probeTimes[first + 1] == 2 * MIN_BACKOFF_MS,
+        "backoff restarts after a recovery", name);
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    fprintf(stderr, "usage: %s\n", argv[0]);
+    return 2;
+  }
+
+  checkNackBursts();
+  checkStuckSda();
+  checkUnplug();
+  checkBackoff(0, "from 0");
+  checkBackoff(0xFFFFFFFFu - 10000, "wrap");
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
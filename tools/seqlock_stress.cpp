@@ -0,0 +1,156 @@
+// ============================================================================
+// Seqlock Stress - concurrent writers/readers against seqlock.h (Linux)
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -pthread -Iinclude tools/seqlock_stress.cpp -o seqlock_stress
+//
+// Usage:
+//
+//   seqlock_stress [--seconds N] [--writers W] [--readers R]
+//
+// Each writer thread owns one Seqlock cell and publishes a sample set in
+// which every field is derived from one counter; readers spread over the
+// cells check that each copy comes from a single write (no torn pairs) and
+// that the counter and version never go backwards. Exits non-zero on any
+// violation.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "seqlock.h"
+
+// Same shape as the web server's sensor snapshot
+struct Sample {
+  uint16_t angle[2];
+  uint32_t timeUs[2];
+  int32_t velocity[2];
+  int32_t acceleration[2];
+  int32_t turns[2];
+  uint16_t arrayAngles[16];
+  uint8_t arrayCount;
+  uint32_t counter;
+};
+
+static void fill(Sample& s, uint32_t n) {
+  s.angle[0] = n & 0x0FFF;
+  s.angle[1] = (n * 7) & 0x0FFF;
+  s.timeUs[0] = n * 20000u;
+  s.timeUs[1] = n * 20000u + 130u;
+  s.velocity[0] = (int32_t)n;
+  s.velocity[1] = -(int32_t)n;
+  s.acceleration[0] = (int32_t)(n ^ 0x5555);
+  s.acceleration[1] = (int32_t)(n ^ 0xAAAA);
+  s.turns[0] = (int32_t)(n >> 12);
+  s.turns[1] = -(int32_t)(n >> 12);
+  for (uint8_t i = 0; i < 16; i++) s.arrayAngles[i] = (n + i) & 0x0FFF;
+  s.arrayCount = n & 0x0F;
+  s.counter = n;
+}
+
+// Samples are zeroed before filling, so padding compares equal too
+static bool consistent(const Sample& s) {
+  Sample expected;
+  memset(&expected, 0, sizeof(expected));
+  fill(expected, s.counter);
+  return memcmp(&s, &expected, sizeof(Sample)) == 0;
+}
+
+struct Cell {
+  Seqlock<Sample> lock;
+  std::atomic<uint32_t> written;
+  Cell() : written(0) {}
+};
+
+struct ReaderStats {
+  uint64_t reads = 0;
+  uint64_t misses = 0;      // read() gave up (every try overlapped a write)
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+};
+
+int main(int argc, char** argv) {
+  int seconds = 5;
+  int writers = 2;
+  int readers = 4;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--writers") && i + 1 < argc) writers = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--readers") && i + 1 < argc) readers = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--seconds N] [--writers W] [--readers R]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (writers < 1) writers = 1;
+  if (readers < 1) readers = 1;
+
+  std::vector<Cell> cells(writers);
+  std::atomic<bool> stop(false);
+  std::vector<ReaderStats> stats(readers);
+  std::vector<std::thread> threads;
+
+  for (int w = 0; w < writers; w++) {
+    threads.emplace_back([&, w]() {
+      Sample s;
+      memset(&s, 0, sizeof(s));
+      uint32_t n = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        fill(s, ++n);
+        cells[w].lock.write(s);
+        cells[w].written.store(n, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  for (int r = 0; r < readers; r++) {
+    threads.emplace_back([&, r]() {
+      Cell& cell = cells[r % writers];
+      ReaderStats& st = stats[r];
+      uint32_t lastCounter = 0;
+      uint32_t lastVersion = 0;
+      Sample s;
+      while (!stop.load(std::memory_order_relaxed)) {
+        uint32_t version = cell.lock.version();
+        if (version < lastVersion) st.backwards++;
+        lastVersion = version;
+        if (!cell.lock.read(s)) {
+          st.misses++;
+          continue;
+        }
+        st.reads++;
+        if (!consistent(s)) st.torn++;
+        if (s.counter < lastCounter) st.backwards++;
+        lastCounter = s.counter;
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  stop.store(true);
+  for (std::thread& t : threads) t.join();
+
+  ReaderStats total;
+  for (const ReaderStats& st : stats) {
+    total.reads += st.reads;
+    total.misses += st.misses;
+    total.torn += st.torn;
+    total.backwards += st.backwards;
+  }
+  uint64_t writes = 0;
+  for (const Cell& cell : cells) writes += cell.written.load();
+
+  printf("%d writers, %d readers, %d s, %zu-byte sample\n", writers, readers, seconds,
+         sizeof(Sample));
+  printf("writes %llu, reads %llu, misses %llu, torn %llu, backwards %llu\n",
+         (unsigned long long)writes, (unsigned long long)total.reads,
+         (unsigned long long)total.misses, (unsigned long long)total.torn,
+         (unsigned long long)total.backwards);
+  bool ok = total.torn == 0 && total.backwards == 0 && total.reads > 0;
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// ============================================================================
+// Timestamp Check - 32-bit sample timestamp arithmetic across the wrap
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/timestamp_check.cpp -o timestamp_check
+//
+// Usage:
+//
+//   timestamp_check [--pairs N]
+//
+// Samples carry the low 32 bits of the microsecond clock (clock.h), which
+// wrap every ~71.6 minutes. Checks against 64-bit reference instants that:
+//   - timestampDiffUs() gives the exact signed difference for --pairs
+//     random pairs up to ~35 minutes apart, many straddling the wrap, and
+//     changes sign exactly at the documented 2^31 us limit;
+//   - timestampMidpoint() gives the exact (truncated) midpoint of a window,
+//     in either order;
+//   - a decimated stream (4 jittered raw samples per output, stamped at the
+//     window midpoint as SensorManager does) keeps increasing, evenly spaced
+//     stamps while the counter wraps.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "clock.h"
+
+static const int64_t WRAP_US = 1LL << 32;
+static const int64_t LIMIT_US = (1LL << 31) - 1;    // ~35.8 minutes
+
+static void checkDifferences(uint32_t pairs) {
+  std::mt19937_64 rng(1);
+  // Instants over several wraps, and pairs placed right around one
+  std::uniform_int_distribution<int64_t> instant(0, 8 * WRAP_US);
+  std::uniform_int_distribution<int64_t> offset(-LIMIT_US, LIMIT_US);
+  std::uniform_int_distribution<int64_t> nearWrap(-100000, 100000);
+  uint32_t diffErrors = 0;
+  uint32_t midErrors = 0;
+  uint32_t straddling = 0;
+  for (uint32_t i = 0; i < pairs; i++) {
+    int64_t earlier = (i & 1) ? instant(rng) : 3 * WRAP_US + nearWrap(rng);
+    int64_t later = earlier + ((i & 2) ? offset(rng) : nearWrap(rng));
+    if (later < 0) later = -later;
+    uint32_t a = (uint32_t)earlier;
+    uint32_t b = (uint32_t)later;
+    if ((earlier >> 32) != (later >> 32)) straddling++;
+
+    if (timestampDiffUs(b, a) != later - earlier) diffErrors++;
+
+    // Midpoint of a window, given in order of the samples
+    int64_t first = earlier < later ? earlier : later;
+    int64_t last = earlier < later ? later : earlier;
+    uint32_t expected = (uint32_t)(first + (last - first) / 2);
+    if (timestampMidpoint((uint32_t)first, (uint32_t)last) != expected) midErrors++;
+  }
+  printf("pairs     %u random pairs (%u straddle the wrap): %u difference errors, "
+         "%u midpoint errors\n", pairs, straddling, diffErrors, midErrors);
+  check(diffErrors == 0, "timestampDiffUs exact within the limit");
+  check(midErrors == 0, "timestampMidpoint exact within the limit");
+
+  // The documented limit: one microsecond past it the sign flips
+  check(timestampDiffUs((uint32_t)LIMIT_US + 5u, 5u) == (int32_t)LIMIT_US,
+        "difference of 2^31 - 1 us still positive");
+  check(timestampDiffUs((uint32_t)(LIMIT_US + 1) + 5u, 5u) < 0,
+        "difference of 2^31 us wraps negative");
+  check(timestampDiffUs(5u, 0xFFFFFFF0u) == 21 && timestampDiffUs(0xFFFFFFF0u, 5u) == -21,
+        "difference across the wrap, both directions");
+  check(timestampMidpoint(0xFFFFFFF0u, 16u) == 0, "midpoint across the wrap");
+}
+
+static void checkDecimatedStream() {
+  // 4 kHz raw, decimated by 4 to 1 kHz, starting 2 s before the wrap
+  const int64_t rawPeriodUs = 250;
+  const int factor = 4;
+  const int outputs = 4000;
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<int> jitter(-20, 20);
+
+  int64_t now = WRAP_US - 2000000;
+  uint32_t previous = 0;
+  bool increasing = true;
+  int32_t minSpacing = 1 << 30;
+  int32_t maxSpacing = -(1 << 30);
+  int64_t spacingSum = 0;
+  int64_t worstError = 0;
+  for (int i = 0; i < outputs; i++) {
+    int64_t windowStart = 0;
+    int64_t windowEnd = 0;
+    for (int k = 0; k < factor; k++) {
+      int64_t sampleUs = now + jitter(rng);
+      if (k == 0) windowStart = sampleUs;
+      windowEnd = sampleUs;
+      now += rawPeriodUs;
+    }
+    uint32_t stamp = timestampMidpoint((uint32_t)windowStart, (uint32_t)windowEnd);
+    int64_t truth = windowStart + (windowEnd - windowStart) / 2;
+    int64_t error = (int64_t)timestampDiffUs(stamp, (uint32_t)truth);
+    if (llabs(error) > worstError) worstError = llabs(error);
+    if (i > 0) {
+      int32_t spacing = timestampDiffUs(stamp, previous);
+      if (spacing <= 0) increasing = false;
+      if (spacing < minSpacing) minSpacing = spacing;
+      if (spacing > maxSpacing) maxSpacing = spacing;
+      spacingSum += spacing;
+    }
+    previous = stamp;
+  }
+  double meanSpacing = (double)spacingSum / (outputs - 1);
+  printf("decimated %d outputs through the wrap: spacing %d..%d us (mean %.2f), "
+         "worst stamp error %lld us\n", outputs, minSpacing, maxSpacing, meanSpacing,
+         (long long)worstError);
+  check(increasing, "decimated stamps keep increasing through the wrap");
+  check(worstError == 0, "decimated stamps at the window midpoint");
+  check(meanSpacing > 999.9 && meanSpacing < 1000.1, "decimated stamps 1 ms apart on average");
+  check(minSpacing >= 1000 - 40 && maxSpacing <= 1000 + 40, "spacing within the raw jitter");
+}
+
+int main(int argc, char** argv) {
+  uint32_t pairs = 10000000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--pairs") && i + 1 < argc) pairs = (uint32_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--pairs N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (pairs < 4) pairs = 4;
+
+  checkDifferences(pairs);
+  checkDecimatedStream();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+// ============================================================================
+// Trigger Sampler Check - TriggerSampler state machine, holdoff and latency
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -pthread -Iinclude tools/trigger_sampler_check.cpp -o trigger_sampler_check
+//
+// Usage:
+//
+//   trigger_sampler_check [--events N]
+//
+// Exercises TriggerSampler (host-triggered sampling):
+//   - transitions: every event in every state (trigger, begin, complete),
+//     overruns while pending and while sampling, begin/complete out of turn,
+//     addOverruns() for a burst of UART triggers;
+//   - holdoff: a trigger exactly at the holdoff is accepted, one before it
+//     ignored, measured from the last accepted trigger, across the 32-bit
+//     microsecond wrap;
+//   - latency: min/max/mean and the histogram bin of each edge value;
+//   - model: --events random events on one thread against a reference
+//     state machine, all counters compared;
+//   - threads: a trigger thread (standing in for the GPIO interrupt) and a
+//     sampling thread; every accepted trigger is claimed exactly once, in
+//     order, and triggers = responses (+1 if one is still pending).
+// Exits non-zero on any failure.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include "check.h"
+#include "trigger_sampler.h"
+
+static void checkTransitions() {
+  TriggerSampler sampler(50);
+  uint32_t triggerUs = 0;
+  check(!sampler.begin(triggerUs), "begin without a trigger");
+  sampler.complete(100);
+  check(sampler.getStats().responses == 0, "complete without begin ignored");
+
+  check(sampler.onTrigger(1000), "trigger accepted when idle");
+  check(sampler.getState() == TriggerSampler::TRIGGERED, "IDLE -> TRIGGERED");
+  check(!sampler.onTrigger(1100), "trigger while pending rejected");
+  sampler.complete(1150);
+  check(sampler.getState() == TriggerSampler::TRIGGERED, "complete before begin ignored");
+  check(sampler.begin(triggerUs) && triggerUs == 1000, "begin claims the trigger time");
+  check(sampler.getState() == TriggerSampler::SAMPLING, "TRIGGERED -> SAMPLING");
+  check(!sampler.begin(triggerUs), "second begin rejected");
+  check(!sampler.onTrigger(1200), "trigger while sampling rejected");
+  sampler.complete(1180);
+  check(sampler.getState() == TriggerSampler::IDLE, "SAMPLING -> IDLE");
+  check(!sampler.begin(triggerUs), "begin after complete rejected");
+
+  sampler.addOverruns(3);
+  const TriggerSampler::Stats& stats = sampler.getStats();
+  printf("states    triggers %u, overruns %u, ignored %u, responses %u\n", stats.triggers,
+         stats.overruns, stats.ignored, stats.responses);
+  check(stats.triggers == 1 && stats.overruns == 2 + 3 && stats.ignored == 0 &&
+        stats.responses == 1, "transition counters");
+}
+
+static void checkHoldoff() {
+  TriggerSampler sampler(50);
+  uint32_t triggerUs;
+  // Accepted 60 us before the wrap
+  uint32_t first = 0xFFFFFFFFu - 59;
+  check(sampler.onTrigger(first), "first trigger accepted");
+  sampler.begin(triggerUs);
+  sampler.complete(first + 5);
+  check(!sampler.onTrigger(first + 49), "trigger inside the holdoff ignored");
+  check(!sampler.onTrigger(first + 30), "holdoff measured from the accepted trigger");
+  check(sampler.onTrigger(first + 50), "trigger at the holdoff accepted (across the wrap)");
+  sampler.begin(triggerUs);
+  sampler.complete(first + 60);
+  check(!sampler.onTrigger(first + 99), "holdoff restarts at the new trigger");
+  check(sampler.onTrigger(first + 100), "trigger after the new holdoff accepted");
+
+  TriggerSampler noHoldoff(0);
+  check(noHoldoff.onTrigger(5), "no holdoff: accepted");
+  noHoldoff.begin(triggerUs);
+  noHoldoff.complete(5);
+  check(noHoldoff.onTrigger(5), "no holdoff: same instant accepted again");
+
+  const TriggerSampler::Stats& stats = sampler.getStats();
+  printf("holdoff   triggers %u, ignored %u (50 us holdoff across the wrap)\n",
+         stats.triggers, stats.ignored);
+  check(stats.triggers == 3 && stats.ignored == 3 && stats.overruns == 0, "holdoff counters");
+}
+
+static void checkLatency() {
+  TriggerSampler sampler(0);
+  uint32_t triggerUs;
+  uint32_t expected[TriggerSampler::HISTOGRAM_BINS] = { 0 };
+  uint64_t total = 0;
+  uint32_t now = 0xFFFFFF00u;       // Latencies measured across the wrap too
+  // Each edge and one below it
+  for (size_t bin = 0; bin + 1 < TriggerSampler::HISTOGRAM_BINS; bin++) {
+    uint32_t edge = TriggerSampler::histogramEdge(bin);
+    const uint32_t latencies[2] = { edge - 1, edge };
+    for (int k = 0; k < 2; k++) {
+      sampler.onTrigger(now);
+      sampler.begin(triggerUs);
+      sampler.complete(now + latencies[k]);
+      expected[k == 0 ? bin : bin + 1]++;
+      total += latencies[k];
+      now += 5000;
+    }
+  }
+  const TriggerSampler::Stats& stats = sampler.getStats();
+  bool binsMatch = memcmp(stats.histogram, expected, sizeof(expected)) == 0;
+  uint32_t last = TriggerSampler::histogramEdge(TriggerSampler::HISTOGRAM_BINS - 2);
+  printf("latency   %u responses: min %u, max %u, mean %u us; bins", stats.responses,
+         stats.minLatencyUs, stats.maxLatencyUs, sampler.getMeanLatencyUs());
+  for (size_t bin = 0; bin < TriggerSampler::HISTOGRAM_BINS; bin++) {
+    printf(" %u", stats.histogram[bin]);
+  }
+  printf("\n");
+  check(binsMatch, "histogram bins at the edges");
+  check(stats.minLatencyUs == TriggerSampler::histogramEdge(0) - 1 &&
+        stats.maxLatencyUs == last, "min and max latency");
+  check(sampler.getMeanLatencyUs() == (uint32_t)(total / stats.responses), "mean latency");
+
+  sampler.resetStats();
+  check(sampler.getStats().responses == 0 && sampler.getMeanLatencyUs() == 0 &&
+        sampler.getStats().minLatencyUs == UINT32_MAX, "reset");
+}
+
+// Reference state machine
+struct Model {
+  uint32_t holdoffUs;
+  int state;                        // 0 idle, 1 triggered, 2 sampling
+  bool haveTrigger;
+  uint32_t lastTriggerUs;
+  uint32_t triggerUs;
+  TriggerSampler::Stats stats;
+
+  bool onTrigger(uint32_t nowUs) {
+    if (haveTrigger && nowUs - lastTriggerUs < holdoffUs) {
+      stats.ignored++;
+      return false;
+    }
+    if (state != 0) {
+      stats.overruns++;
+      return false;
+    }
+    haveTrigger = true;
+    lastTriggerUs = triggerUs = nowUs;
+    stats.triggers++;
+    state = 1;
+    return true;
+  }
+};
+
+static void checkModel(uint32_t events) {
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> action(0, 2);
+  std::uniform_int_distribution<int> step(0, 120);
+  TriggerSampler sampler(50);
+  Model model;
+  memset(&model, 0, sizeof(model));
+  model.holdoffUs = 50;
+  uint32_t now = 0xFFFFFFFFu - 1000000;
+  uint32_t claimedUs = 0;
+  bool mismatch = false;
+  for (uint32_t e = 0; e < events; e++) {
+    now += step(rng);
+    uint32_t triggerUs = 0;
+    switch (action(rng)) {
+      case 0:
+        if (sampler.onTrigger(now) != model.onTrigger(now)) mismatch = true;
+        break;
+      case 1: {
+        bool claimed = sampler.begin(triggerUs);
+        if (claimed != (model.state == 1)) mismatch = true;
+        if (claimed) {
+          if (triggerUs != model.triggerUs) mismatch = true;
+          model.state = 2;
+          claimedUs = triggerUs;
+        }
+        break;
+      }
+      default:
+        if (model.state == 2) {
+          model.stats.responses++;
+          model.stats.totalLatencyUs += now - claimedUs;
+          model.state = 0;
+        }
+        sampler.complete(now);
+        break;
+    }
+    if ((int)sampler.getState() != model.state) mismatch = true;
+  }
+  const TriggerSampler::Stats& stats = sampler.getStats();
+  printf("model     %u events: triggers %u, overruns %u, ignored %u, responses %u\n", events,
+         stats.triggers, stats.overruns, stats.ignored, stats.responses);
+  check(!mismatch, "states and results match the reference");
+  check(stats.triggers == model.stats.triggers && stats.overruns == model.stats.overruns &&
+        stats.ignored == model.stats.ignored && stats.responses == model.stats.responses &&
+        stats.totalLatencyUs == model.stats.totalLatencyUs, "counters match the reference");
+}
+
+static void checkThreads(uint32_t events) {
+  TriggerSampler sampler(0);
+  std::atomic<uint32_t> clock(0);
+  std::atomic<bool> done(false);
+  std::vector<uint32_t> accepted;
+  std::vector<uint32_t> claimed;
+  accepted.reserve(events);
+  claimed.reserve(events);
+
+  std::thread sampling([&]() {
+    uint32_t triggerUs;
+    for (;;) {
+      if (sampler.begin(triggerUs)) {
+        claimed.push_back(triggerUs);
+        sampler.complete(clock.fetch_add(1));
+      } else if (done.load()) {
+        break;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<int> burst(1, 8);
+  int untilYield = burst(rng);
+  for (uint32_t e = 0; e < events; e++) {
+    uint32_t now = clock.fetch_add(1);
+    if (sampler.onTrigger(now)) accepted.push_back(now);
+    // Yield now and then so the threads interleave on a single core too
+    if (--untilYield == 0) {
+      std::this_thread::yield();
+      untilYield = burst(rng);
+    }
+  }
+  done.store(true);
+  sampling.join();
+
+  // A trigger accepted after the sampling thread's last look stays pending
+  bool pending = sampler.getState() == TriggerSampler::TRIGGERED;
+  bool inOrder = claimed.size() + (pending ? 1 : 0) == accepted.size();
+  for (size_t i = 0; inOrder && i < claimed.size(); i++) {
+    if (claimed[i] != accepted[i]) inOrder = false;
+  }
+  const TriggerSampler::Stats& stats = sampler.getStats();
+  printf("threads   %u triggers: %u accepted, %u overruns, %u responses%s\n", events,
+         stats.triggers, stats.overruns, stats.responses, pending ? ", 1 pending" : "");
+  check(inOrder, "every accepted trigger claimed once, in order");
+  check(stats.triggers == stats.responses + (pending ? 1 : 0), "triggers = responses");
+  check(stats.triggers + stats.overruns == events, "every trigger counted once");
+  check(stats.responses > 0, "sampling thread ran alongside");
+}
+
+int main(int argc, char** argv) {
+  uint32_t events = 2000000;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--events") && i + 1 < argc) events = (uint32_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--events N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (events < 100) events = 100;
+
+  checkTransitions();
+  checkHoldoff();
+  checkLatency();
+  checkModel(events);
+  checkThreads(events);
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
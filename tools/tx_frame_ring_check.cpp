@@ -0,0 +1,268 @@
+// ============================================================================
+// TX Frame Ring Check - overflow policies, wraparound and concurrent use
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -pthread -Iinclude tools/tx_frame_ring_check.cpp -o tx_frame_ring_check
+//
+// Usage:
+//
+//   tx_frame_ring_check [--frames N] [--index-wrap]
+//
+// Exercises TxFrameRing (the UART transmit queue) for each overflow policy:
+//   - policies: 12 frames into 8 slots leave exactly the frames each policy
+//     promises (DROP_NEWEST the first 8, DROP_OLDEST the last 8,
+//     COALESCE_LATEST the first 7 and the last), oversize frames are
+//     counted and never queued;
+//   - interleaving: random runs of pushes and pops on one thread, slot
+//     positions wrapping round the ring many times, compared frame by frame
+//     against a reference queue with the same policy, stats included;
+//   - concurrency: a producer and a consumer thread (fast and slow
+//     consumer) pass --frames frames, the producer yielding after short
+//     bursts; no frame is torn, frames arrive in order, and frames popped +
+//     dropped = frames pushed.
+// --index-wrap also runs 2^32 push/pop pairs so the free-running indices
+// wrap (several minutes). Exits non-zero on any failure.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+#include "check.h"
+#include "tx_frame_ring.h"
+
+typedef TxFrameRing<8, 80> Ring;
+
+static const char* POLICY_NAMES[3] = { "DROP_NEWEST", "DROP_OLDEST", "COALESCE_LATEST" };
+
+static void check(bool condition, const char* what, int policy) {
+  check(condition, what, POLICY_NAMES[policy]);
+}
+
+// Frame n: its number, then a pattern of a length that depends on n
+static size_t makeFrame(uint32_t n, uint8_t* out) {
+  size_t length = 4 + n % 70;
+  memcpy(out, &n, 4);
+  for (size_t i = 4; i < length; i++) out[i] = (uint8_t)(n * 31 + i);
+  return length;
+}
+
+// Frame number, or -1 if the frame is torn
+static int64_t frameNumber(const uint8_t* data, size_t length) {
+  uint32_t n;
+  if (length < 4) return -1;
+  memcpy(&n, data, 4);
+  if (length != 4 + n % 70) return -1;
+  for (size_t i = 4; i < length; i++) {
+    if (data[i] != (uint8_t)(n * 31 + i)) return -1;
+  }
+  return n;
+}
+
+static void checkPolicies() {
+  static const uint32_t EXPECTED[3][8] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7 },
+    { 4, 5, 6, 7, 8, 9, 10, 11 },
+    { 0, 1, 2, 3, 4, 5, 6, 11 }
+  };
+  for (int p = 0; p < 3; p++) {
+    Ring ring((Ring::Policy)p);
+    uint8_t frame[80];
+    for (uint32_t n = 0; n < 12; n++) {
+      bool queued = ring.push(frame, makeFrame(n, frame));
+      check(queued == (n < 8 || p != Ring::DROP_NEWEST), "push result", p);
+    }
+    uint8_t big[100] = { 0 };
+    check(!ring.push(big, sizeof(big)), "oversize frame refused", p);
+
+    uint32_t got[8];
+    size_t count = 0;
+    size_t length;
+    bool torn = false;
+    while ((length = ring.pop(frame)) != 0) {
+      int64_t n = frameNumber(frame, length);
+      if (n < 0) torn = true;
+      if (count < 8) got[count] = (uint32_t)n;
+      count++;
+    }
+    printf("policy    %-15s 12 frames into 8 slots:", POLICY_NAMES[p]);
+    for (size_t i = 0; i < count && i < 8; i++) printf(" %u", got[i]);
+    const Ring::Stats& stats = ring.getStats();
+    printf("  (dropped %u, oversize %u, peak %u)\n", stats.framesDropped,
+           stats.framesOversize, stats.peakFrames);
+    check(!torn && count == 8 && memcmp(got, EXPECTED[p], sizeof(got)) == 0,
+          "frames kept by the policy", p);
+    check(stats.framesDropped == 4 && stats.framesOversize == 1 && stats.peakFrames == 8,
+          "drop, oversize and peak counters", p);
+    check(ring.size() == 0, "empty after draining", p);
+  }
+}
+
+// Reference model of the ring on one thread
+struct ModelRing {
+  int policy;
+  std::deque<uint32_t> frames;
+  uint32_t dropped;
+
+  bool push(uint32_t n) {
+    if (frames.size() == Ring::capacity()) {
+      dropped++;
+      if (policy == Ring::DROP_NEWEST) return false;
+      if (policy == Ring::DROP_OLDEST) {
+        frames.pop_front();
+      } else {
+        frames.back() = n;
+        return true;
+      }
+    }
+    frames.push_back(n);
+    return true;
+  }
+};
+
+static void checkInterleaving(uint32_t frames) {
+  for (int p = 0; p < 3; p++) {
+    Ring ring((Ring::Policy)p);
+    ModelRing model = { p, std::deque<uint32_t>(), 0 };
+    std::mt19937 rng(p + 1);
+    std::uniform_int_distribution<int> burst(0, 12);
+    uint8_t frame[80];
+    uint32_t next = 0;
+    uint32_t popped = 0;
+    bool mismatch = false;
+    bool pushMismatch = false;
+    while (next < frames) {
+      // A burst of pushes, then of pops, each up to 1.5 rings long
+      for (int k = burst(rng); k > 0 && next < frames; k--, next++) {
+        if (ring.push(frame, makeFrame(next, frame)) != model.push(next)) pushMismatch = true;
+      }
+      for (int k = burst(rng); k > 0; k--) {
+        size_t length = ring.pop(frame);
+        if (model.frames.empty()) {
+          if (length != 0) mismatch = true;
+          continue;
+        }
+        if (length == 0 || frameNumber(frame, length) != model.frames.front()) mismatch = true;
+        model.frames.pop_front();
+        popped++;
+      }
+      if (ring.size() != model.frames.size()) mismatch = true;
+    }
+    const Ring::Stats& stats = ring.getStats();
+    printf("interleave %-15s %u frames: %u popped, %u dropped, %u left\n", POLICY_NAMES[p],
+           frames, popped, stats.framesDropped, (unsigned)ring.size());
+    check(!pushMismatch, "push results match the reference", p);
+    check(!mismatch, "popped frames match the reference", p);
+    check(stats.framesDropped == model.dropped, "dropped count matches the reference", p);
+    check(popped + stats.framesDropped + ring.size() == frames, "no frame unaccounted", p);
+  }
+}
+
+static void checkConcurrent(uint32_t frames, bool slowConsumer) {
+  for (int p = 0; p < 3; p++) {
+    Ring ring((Ring::Policy)p);
+    std::atomic<bool> done(false);
+    uint32_t popped = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+
+    std::thread consumer([&]() {
+      uint8_t frame[80];
+      int64_t last = -1;
+      for (;;) {
+        size_t length = ring.pop(frame);
+        if (length == 0) {
+          if (done.load() && ring.size() == 0) break;
+          std::this_thread::yield();
+          continue;
+        }
+        popped++;
+        int64_t n = frameNumber(frame, length);
+        if (n < 0) {
+          torn++;
+        } else {
+          if (n <= last) outOfOrder++;
+          last = n;
+        }
+        if (slowConsumer && (popped & 63) == 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+      }
+    });
+
+    // The producer yields after short random bursts so the threads also
+    // interleave on a single core
+    std::mt19937 rng(p + 1);
+    std::uniform_int_distribution<int> burst(1, 16);
+    uint8_t frame[80];
+    int untilYield = burst(rng);
+    for (uint32_t n = 0; n < frames; n++) {
+      ring.push(frame, makeFrame(n, frame));
+      if (--untilYield == 0) {
+        std::this_thread::yield();
+        untilYield = burst(rng);
+      }
+    }
+    done.store(true);
+    consumer.join();
+
+    const Ring::Stats& stats = ring.getStats();
+    printf("threads   %-15s %s consumer: %u popped, %u dropped, %u torn, %u out of order, "
+           "peak %u\n", POLICY_NAMES[p], slowConsumer ? "slow" : "fast", popped,
+           stats.framesDropped, torn, outOfOrder, stats.peakFrames);
+    check(torn == 0, "no torn frames", p);
+    check(outOfOrder == 0, "frames in order", p);
+    check(popped + stats.framesDropped == frames, "popped + dropped = pushed", p);
+    check(popped > 0, "consumer ran alongside the producer", p);
+    if (slowConsumer) check(stats.framesDropped > 0, "slow consumer overflows the ring", p);
+  }
+}
+
+static void checkIndexWrap() {
+  Ring ring(Ring::DROP_OLDEST);
+  uint8_t frame[80];
+  uint8_t out[80];
+  bool mismatch = false;
+  // Keep 3 frames queued while the indices pass 2^32
+  for (uint32_t n = 0; n < 3; n++) ring.push(frame, makeFrame(n, frame));
+  uint32_t expected = 0;
+  for (uint64_t i = 0; i < (1ULL << 32) + 100; i++) {
+    uint32_t n = (uint32_t)i + 3;
+    ring.push(frame, makeFrame(n, frame));
+    size_t length = ring.pop(out);
+    if (frameNumber(out, length) != expected) mismatch = true;
+    expected++;
+  }
+  printf("index wrap 2^32 + 100 push/pop pairs, %u frames queued at the end\n",
+         (unsigned)ring.size());
+  check(!mismatch && ring.size() == 3 && ring.getStats().framesDropped == 0,
+        "frames pass the index wrap", Ring::DROP_OLDEST);
+}
+
+int main(int argc, char** argv) {
+  uint32_t frames = 2000000;
+  bool indexWrap = false;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = (uint32_t)atol(argv[++i]);
+    else if (!strcmp(argv[i], "--index-wrap")) indexWrap = true;
+    else {
+      fprintf(stderr, "usage: %s [--frames N] [--index-wrap]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (frames < 1000) frames = 1000;
+
+  checkPolicies();
+  checkInterleaving(frames);
+  checkConcurrent(frames, false);
+  checkConcurrent(frames / 10, true);
+  if (indexWrap) checkIndexWrap();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,381 @@
+// ============================================================================
+// Web Stall Probe - WebSocket stream gaps under concurrent page loads (Linux)
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -pthread -Iinclude tools/web_stall_probe.cpp -o web_stall_probe
+//
+// Usage:
+//
+//   web_stall_probe HOST [--port N] [--ws-port N] [--ws-path PATH]
+//                        [--loaders N] [--page PATH] [--seconds N]
+//
+// Subscribes to every sample on the binary WebSocket stream (default
+// ws://HOST/ws), records it idle for N seconds (default 10), then again while
+// N threads (default 4) fetch the page (default /) back to back over fresh
+// connections. For each phase it prints the largest gaps between frames on
+// the host clock and between consecutive sample times on the device clock:
+// a device sample-time step above one sample period means broadcasts were
+// late and samples were merged. Page load times show how long the loaders
+// were made to wait.
+//
+// To compare firmware versions run it against both; the synchronous server
+// had the stream on its own port: --ws-port 81 --ws-path /bin. Combine with
+// the device's NET: (longest service pass) and ACQ: debug lines. That
+// comparison has not been made on hardware yet: the probe has only been run
+// against local stand-in servers (one blocking per page, one concurrent), so
+// it is known to tell them apart, not what either firmware does.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "ws_message.h"
+
+struct Options {
+  const char* host;
+  const char* port;
+  const char* wsPort;
+  const char* wsPath;
+  const char* page;
+  int loaders;
+  int seconds;
+};
+
+struct PhaseStats {
+  std::vector<uint32_t> arrivalGapsUs;    // Host clock
+  std::vector<uint32_t> sampleStepsUs;    // Device clock (sample time deltas)
+  uint32_t frames;
+  uint32_t sequenceGaps;                  // Broadcasts this client did not get
+};
+
+struct LoadStats {
+  std::atomic<uint32_t> pages;
+  std::atomic<uint32_t> failures;
+  std::atomic<uint64_t> totalUs;
+  std::atomic<uint32_t> maxUs;
+};
+
+static std::atomic<bool> loading(false);
+static std::atomic<bool> stopping(false);
+
+static uint64_t nowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static int connectTo(const char* host, const char* port) {
+  addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  if (getaddrinfo(host, port, &hints, &result) != 0) return -1;
+
+  int fd = -1;
+  for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) continue;
+    if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(result);
+  if (fd >= 0) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  return fd;
+}
+
+static bool sendAll(int fd, const void* data, size_t length) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  while (length > 0) {
+    ssize_t n = send(fd, p, length, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    length -= n;
+  }
+  return true;
+}
+
+static bool recvAll(int fd, void* data, size_t length) {
+  uint8_t* p = static_cast<uint8_t*>(data);
+  while (length > 0) {
+    ssize_t n = recv(fd, p, length, 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    length -= n;
+  }
+  return true;
+}
+
+// ============================================================================
+// Page Loaders
+// ============================================================================
+
+static void loadPages(const Options* options, LoadStats* stats) {
+  std::string request = std::string("GET ") + options->page + " HTTP/1.1\r\nHost: " +
+                        options->host + "\r\nConnection: close\r\n\r\n";
+  uint8_t buffer[4096];
+  while (!stopping) {
+    if (!loading) {
+      usleep(10000);
+      continue;
+    }
+    uint64_t start = nowUs();
+    int fd = connectTo(options->host, options->port);
+    bool ok = fd >= 0 && sendAll(fd, request.data(), request.size());
+    bool status200 = false;
+    size_t received = 0;
+    while (ok) {
+      ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n < 0 && errno == EINTR) continue;
+      if (n < 0) ok = false;
+      if (n <= 0) break;
+      if (received == 0) status200 = n >= 12 && memcmp(buffer, "HTTP/1.1 200", 12) == 0;
+      received += n;
+    }
+    if (fd >= 0) close(fd);
+    if (!ok || !status200) {
+      stats->failures++;
+      usleep(100000);
+      continue;
+    }
+    uint32_t elapsed = (uint32_t)(nowUs() - start);
+    stats->pages++;
+    stats->totalUs += elapsed;
+    uint32_t previous = stats->maxUs;
+    while (elapsed > previous && !stats->maxUs.compare_exchange_weak(previous, elapsed)) {
+    }
+  }
+}
+
+// ============================================================================
+// WebSocket Client
+// ============================================================================
+
+static int openWebSocket(const Options& options) {
+  int fd = connectTo(options.host, options.wsPort);
+  if (fd < 0) return -1;
+
+  std::string request = std::string("GET ") + options.wsPath + " HTTP/1.1\r\nHost: " +
+                        options.host + "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                        "Sec-WebSocket-Version: 13\r\n\r\n";
+  if (!sendAll(fd, request.data(), request.size())) {
+    close(fd);
+    return -1;
+  }
+
+  // Response headers, byte by byte so no frame data is consumed
+  std::string response;
+  char c;
+  while (response.size() < 4096 && recvAll(fd, &c, 1)) {
+    response += c;
+    if (response.size() >= 4 && response.compare(response.size() - 4, 4, "\r\n\r\n") == 0) break;
+  }
+  if (response.compare(0, 12, "HTTP/1.1 101") != 0) {
+    fprintf(stderr, "WebSocket upgrade refused: %.*s\n",
+            (int)response.find('\r'), response.c_str());
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Client frames must be masked (RFC 6455); an all-zero mask keeps the
+// payload as is
+static bool sendFrame(int fd, uint8_t opcode, const void* payload, size_t length) {
+  if (length > 125) return false;
+  uint8_t header[6] = { (uint8_t)(0x80 | opcode), (uint8_t)(0x80 | length), 0, 0, 0, 0 };
+  return sendAll(fd, header, 6) && sendAll(fd, payload, length);
+}
+
+// Next frame; false when the connection closed
+static bool readFrame(int fd, uint8_t& opcode, std::vector<uint8_t>& payload) {
+  uint8_t header[2];
+  if (!recvAll(fd, header, 2)) return false;
+  opcode = header[0] & 0x0F;
+  uint64_t length = header[1] & 0x7F;
+  if (length == 126) {
+    uint8_t ext[2];
+    if (!recvAll(fd, ext, 2)) return false;
+    length = ((uint64_t)ext[0] << 8) | ext[1];
+  } else if (length == 127) {
+    uint8_t ext[8];
+    if (!recvAll(fd, ext, 8)) return false;
+    length = 0;
+    for (int i = 0; i < 8; i++) length = (length << 8) | ext[i];
+  }
+  uint8_t mask[4] = { 0, 0, 0, 0 };
+  if ((header[1] & 0x80) && !recvAll(fd, mask, 4)) return false;
+  if (length > (1 << 20)) return false;
+  payload.resize((size_t)length);
+  if (length > 0 && !recvAll(fd, payload.data(), payload.size())) return false;
+  for (size_t i = 0; i < payload.size(); i++) payload[i] ^= mask[i & 3];
+  return true;
+}
+
+static uint32_t getU32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+static uint32_t percentile(std::vector<uint32_t> values, double p) {
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+  return values[index];
+}
+
+// `periodUs`: the idle sample step, so late steps count against the rate
+// the device streams at when nothing else is going on
+static void report(const char* name, const PhaseStats& phase, const LoadStats* load,
+                   int seconds, uint32_t periodUs) {
+  uint32_t late = 0;
+  for (size_t i = 0; i < phase.sampleStepsUs.size(); i++) {
+    if (phase.sampleStepsUs[i] > periodUs + periodUs / 2) late++;
+  }
+  printf("%s: %u frames (%.1f/s), %u sequence gaps\n", name, phase.frames,
+         (double)phase.frames / seconds, phase.sequenceGaps);
+  printf("  arrival gap  p50 %6.2f  p99 %7.2f  max %8.2f ms\n",
+         percentile(phase.arrivalGapsUs, 0.5) / 1000.0,
+         percentile(phase.arrivalGapsUs, 0.99) / 1000.0,
+         percentile(phase.arrivalGapsUs, 1.0) / 1000.0);
+  printf("  sample step  p50 %6.2f  p99 %7.2f  max %8.2f ms, %u late (> 1.5 x idle p50)\n",
+         percentile(phase.sampleStepsUs, 0.5) / 1000.0,
+         percentile(phase.sampleStepsUs, 0.99) / 1000.0,
+         percentile(phase.sampleStepsUs, 1.0) / 1000.0, late);
+  if (load) {
+    uint32_t pages = load->pages;
+    printf("  page loads   %u (%u failed), mean %.1f ms, max %.1f ms\n", pages,
+           (uint32_t)load->failures, pages ? load->totalUs / 1000.0 / pages : 0.0,
+           load->maxUs / 1000.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options = { nullptr, "80", nullptr, "/ws", "/", 4, 10 };
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--port") && i + 1 < argc) options.port = argv[++i];
+    else if (!strcmp(argv[i], "--ws-port") && i + 1 < argc) options.wsPort = argv[++i];
+    else if (!strcmp(argv[i], "--ws-path") && i + 1 < argc) options.wsPath = argv[++i];
+    else if (!strcmp(argv[i], "--loaders") && i + 1 < argc) options.loaders = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--page") && i + 1 < argc) options.page = argv[++i];
+    else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) options.seconds = atoi(argv[++i]);
+    else if (argv[i][0] != '-' && options.host == nullptr) options.host = argv[i];
+    else {
+      options.host = nullptr;
+      break;
+    }
+  }
+  if (options.host == nullptr || options.seconds <= 0 || options.loaders < 0) {
+    fprintf(stderr, "usage: %s HOST [--port N] [--ws-port N] [--ws-path PATH]\n"
+                    "       [--loaders N] [--page PATH] [--seconds N]\n", argv[0]);
+    return 2;
+  }
+  if (options.wsPort == nullptr) options.wsPort = options.port;
+
+  int ws = openWebSocket(options);
+  if (ws < 0) {
+    fprintf(stderr, "Cannot open ws://%s:%s%s\n", options.host, options.wsPort, options.wsPath);
+    return 1;
+  }
+  const char subscribe[] = "{\"sensors\":7,\"rate\":0}";
+  sendFrame(ws, 0x1, subscribe, sizeof(subscribe) - 1);
+
+  LoadStats load;
+  load.pages = 0;
+  load.failures = 0;
+  load.totalUs = 0;
+  load.maxUs = 0;
+  std::vector<std::thread> loaders;
+  for (int i = 0; i < options.loaders; i++) {
+    loaders.push_back(std::thread(loadPages, &options, &load));
+  }
+
+  PhaseStats phases[2];
+  for (int p = 0; p < 2; p++) phases[p].frames = phases[p].sequenceGaps = 0;
+  int phase = 0;
+  uint64_t phaseEnd = nowUs() + (uint64_t)options.seconds * 1000000ULL;
+  uint64_t lastArrival = 0;
+  uint32_t lastSampleUs = 0;
+  uint16_t lastSequence = 0;
+  bool haveSample = false;
+  bool ok = true;
+
+  std::vector<uint8_t> payload;
+  uint8_t opcode;
+  while (ok) {
+    // A silent stream still ends the phase: the frame that breaks the
+    // silence records the gap
+    ok = readFrame(ws, opcode, payload);
+    uint64_t arrival = nowUs();
+    if (!ok) {
+      fprintf(stderr, "WebSocket closed\n");
+      break;
+    }
+
+    if (opcode == 0x9) {
+      sendFrame(ws, 0xA, payload.data(), payload.size() > 125 ? 125 : payload.size());
+      continue;
+    }
+    if (opcode == 0x1) {
+      printf("server: %.*s\n", (int)payload.size(), (const char*)payload.data());
+      continue;
+    }
+    if (opcode != 0x2 || payload.size() < WsMessage::HEADER_SIZE ||
+        payload[0] != WsMessage::VERSION) {
+      continue;
+    }
+
+    PhaseStats& stats = phases[phase];
+    uint16_t sequence = payload[2] | (payload[3] << 8);
+    uint32_t sampleUs = getU32(&payload[4]);
+    if (haveSample) {
+      stats.arrivalGapsUs.push_back((uint32_t)(arrival - lastArrival));
+      stats.sampleStepsUs.push_back(sampleUs - lastSampleUs);
+      if ((uint16_t)(sequence - lastSequence) != 1) stats.sequenceGaps++;
+    }
+    stats.frames++;
+    haveSample = true;
+    lastArrival = arrival;
+    lastSampleUs = sampleUs;
+    lastSequence = sequence;
+
+    if (arrival >= phaseEnd) {
+      if (++phase >= 2) break;
+      printf("idle phase done, starting %d page loaders\n", options.loaders);
+      phaseEnd = arrival + (uint64_t)options.seconds * 1000000ULL;
+      haveSample = false;         // Do not count the switch-over gap
+      loading = true;
+    }
+  }
+
+  stopping = true;
+  for (size_t i = 0; i < loaders.size(); i++) loaders[i].join();
+  close(ws);
+
+  uint32_t periodUs = percentile(phases[0].sampleStepsUs, 0.5);
+  report("idle", phases[0], nullptr, options.seconds, periodUs);
+  report("loaded", phases[1], &load, options.seconds, periodUs);
+  return ok ? 0 : 1;
+}
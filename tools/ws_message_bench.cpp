@@ -0,0 +1,123 @@
+// ============================================================================
+// WebSocket Message Benchmark - binary vs JSON encode cost (Linux)
+// ============================================================================
+// Build from the repository root, with the ArduinoJson copy PlatformIO
+// downloaded (the JSON path then matches the firmware's exactly):
+//
+//   g++ -std=c++11 -O2 -Iinclude -I.pio/libdeps/com/ArduinoJson/src
+//       tools/ws_message_bench.cpp -o ws_message_bench
+//
+// Without ArduinoJson on the include path, the JSON side falls back to an
+// snprintf encoder producing the same document (reported as such).
+//
+// Usage: ws_message_bench [ITERATIONS] [ARRAY_SENSORS]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "ws_message.h"
+
+#if __has_include(<ArduinoJson.h>)
+#include <ArduinoJson.h>
+#define JSON_ENCODER "ArduinoJson"
+
+// Same document as WebServerManager::encodeJSON()
+static size_t encodeJson(const WsMessage::SensorData& d, char* out, size_t size) {
+  StaticJsonDocument<1024> doc;
+  doc["angle1"] = ((float)d.angle[0] / 4095.0f) * 360.0f;
+  doc["angle2"] = ((float)d.angle[1] / 4095.0f) * 360.0f;
+  doc["raw1"] = d.angle[0];
+  doc["raw2"] = d.angle[1];
+  doc["t1"] = d.timeUs[0];
+  doc["t2"] = d.timeUs[1];
+  doc["vel1"] = d.velocity[0];
+  doc["vel2"] = d.velocity[1];
+  doc["acc1"] = d.acceleration[0];
+  doc["acc2"] = d.acceleration[1];
+  doc["turns1"] = d.turns[0];
+  doc["turns2"] = d.turns[1];
+  if (d.arrayCount > 0) {
+    JsonArray raw = doc.createNestedArray("raw");
+    JsonArray times = doc.createNestedArray("t");
+    for (uint8_t i = 0; i < d.arrayCount; i++) {
+      raw.add(d.array[i]);
+      times.add(d.arrayTimeUs[i]);
+    }
+  }
+  return serializeJson(doc, out, size);
+}
+#else
+#define JSON_ENCODER "snprintf (ArduinoJson not found)"
+
+static size_t encodeJson(const WsMessage::SensorData& d, char* out, size_t size) {
+  int n = snprintf(out, size,
+                   "{\"angle1\":%g,\"angle2\":%g,\"raw1\":%u,\"raw2\":%u,\"t1\":%u,\"t2\":%u,"
+                   "\"vel1\":%d,\"vel2\":%d,\"acc1\":%d,\"acc2\":%d,\"turns1\":%d,\"turns2\":%d",
+                   (double)(((float)d.angle[0] / 4095.0f) * 360.0f),
+                   (double)(((float)d.angle[1] / 4095.0f) * 360.0f), d.angle[0], d.angle[1],
+                   d.timeUs[0], d.timeUs[1], d.velocity[0], d.velocity[1], d.acceleration[0],
+                   d.acceleration[1], d.turns[0], d.turns[1]);
+  if (d.arrayCount > 0) {
+    n += snprintf(out + n, size - n, ",\"raw\":[");
+    for (uint8_t i = 0; i < d.arrayCount; i++) {
+      n += snprintf(out + n, size - n, i ? ",%u" : "%u", d.array[i]);
+    }
+    n += snprintf(out + n, size - n, "],\"t\":[");
+    for (uint8_t i = 0; i < d.arrayCount; i++) {
+      n += snprintf(out + n, size - n, i ? ",%u" : "%u", d.arrayTimeUs[i]);
+    }
+    n += snprintf(out + n, size - n, "]");
+  }
+  n += snprintf(out + n, size - n, "}");
+  return (size_t)n;
+}
+#endif
+
+template <typename Encode>
+static double nsPerMessage(long iterations, Encode encode, size_t& bytes) {
+  volatile size_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; i++) sink += encode(i);
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+                  .count();
+  bytes = encode(0);
+  (void)sink;
+  return ns / iterations;
+}
+
+int main(int argc, char** argv) {
+  long iterations = argc > 1 ? atol(argv[1]) : 1000000;
+  uint8_t arrayCount = argc > 2 ? (uint8_t)atoi(argv[2]) : 0;
+  if (iterations <= 0) iterations = 1;
+  if (arrayCount > WsMessage::MAX_ARRAY) arrayCount = WsMessage::MAX_ARRAY;
+
+  uint16_t array[WsMessage::MAX_ARRAY];
+  uint32_t arrayTimes[WsMessage::MAX_ARRAY];
+  for (uint8_t i = 0; i < WsMessage::MAX_ARRAY; i++) {
+    array[i] = (uint16_t)(i * 251 % 4096);
+    arrayTimes[i] = 81234567u + 63u * i;
+  }
+  WsMessage::SensorData data = {
+    { 1234, 3071 }, { 81234567u, 81234612u }, { 20480, -4096 }, { 512, -77 }, { 12, -3 },
+    array, arrayTimes, arrayCount
+  };
+
+  uint8_t binary[WsMessage::MAX_SIZE];
+  char json[768];
+  size_t binaryBytes, jsonBytes;
+  double binaryNs = nsPerMessage(iterations, [&](long i) {
+    data.angle[0] = (uint16_t)(i & 0x0FFF);
+    return WsMessage::encode(data, (uint16_t)i, binary);
+  }, binaryBytes);
+  double jsonNs = nsPerMessage(iterations, [&](long i) {
+    data.angle[0] = (uint16_t)(i & 0x0FFF);
+    return encodeJson(data, json, sizeof(json));
+  }, jsonBytes);
+
+  printf("array sensors: %u, JSON encoder: %s\n", arrayCount, JSON_ENCODER);
+  printf("binary: %7.1f ns/message %4zu bytes\n", binaryNs, binaryBytes);
+  printf("json:   %7.1f ns/message %4zu bytes\n", jsonNs, jsonBytes);
+  printf("binary is %.1fx faster to encode and %.1fx smaller\n", jsonNs / binaryNs,
+         (double)jsonBytes / binaryBytes);
+  return 0;
+}
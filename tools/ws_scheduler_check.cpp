@@ -0,0 +1,223 @@
+// ============================================================================
+// WS Scheduler Check - WsScheduler against simulated client queues
+// ============================================================================
+// Build from the repository root:
+//
+//   g++ -std=c++11 -O2 -Iinclude tools/ws_scheduler_check.cpp -o ws_scheduler_check
+//
+// Usage:
+//
+//   ws_scheduler_check [--seconds N]      (at least 120)
+//
+// Runs WsScheduler (the WebSocket send scheduler) as the web server does:
+// fresh samples arrive at 100 Hz with jitter, and every millisecond the due
+// clients are offered a message. Each client has a send queue that counts as
+// congested at WEBSOCKET_QUEUE_LIMIT frames and drains at its own rate. The
+// microsecond clock wraps half way through the run. Checks that:
+//   - rates: clients at 1 Hz, 10 Hz and the full rate receive that rate
+//     (within one message) over the last half of the run;
+//   - slow reader: a client draining 20 frames/s at the full rate is
+//     decimated, never dropped, and its queue never passes the limit;
+//   - stalled: a client that never drains is dropped DROP_AFTER_US after
+//     its first congested attempt (within one decimated period);
+//   - recovery: a client stalled for 2 s is decimated and then back at the
+//     full rate with no decimation by the end;
+//   - subscriptions: a client subscribed to sensors that never get fresh
+//     data only receives the initial message, a disconnected client
+//     nothing, rates are clamped, and data nobody wants counts as idle.
+// Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include "check.h"
+#include "ws_scheduler.h"
+
+typedef WsScheduler<8> Scheduler;
+
+static const uint32_t MAX_RATE_HZ = 100;
+static const uint32_t QUEUE_LIMIT = 4;          // As WEBSOCKET_QUEUE_LIMIT
+
+// A client's send queue, in frames
+struct SimClient {
+  const char* name;
+  uint8_t sensors;
+  uint32_t rateHz;
+  double drainPerSecond;
+  uint32_t stallUntilMs;      // Drains nothing before this
+  double queued;
+  uint32_t peakQueued;
+  uint32_t sentLate;          // Sent in the last half of the run
+  int64_t firstCongestedMs;
+  int64_t droppedMs;
+};
+
+enum {
+  TEN_HZ, FULL_RATE, ONE_HZ, SLOW_READER, STALLED, RECOVERS, ARRAY_ONLY, DISCONNECTED,
+  CLIENTS
+};
+
+static void checkQueues(uint32_t seconds) {
+  SimClient clients[CLIENTS] = {
+    { "10 Hz", Scheduler::ALL_SENSORS, 10, 1000, 0, 0, 0, 0, -1, -1 },
+    { "full rate", Scheduler::ALL_SENSORS, 0, 1000, 0, 0, 0, 0, -1, -1 },
+    { "1 Hz", Scheduler::ALL_SENSORS, 1, 1000, 0, 0, 0, 0, -1, -1 },
+    { "slow reader", Scheduler::ALL_SENSORS, 0, 20, 0, 0, 0, 0, -1, -1 },
+    { "stalled", Scheduler::ALL_SENSORS, 0, 0, 0, 0, 0, 0, -1, -1 },
+    { "recovers", Scheduler::ALL_SENSORS, 0, 1000, 2000, 0, 0, 0, -1, -1 },
+    { "array only", Scheduler::SENSOR_ARRAY, 0, 1000, 0, 0, 0, 0, -1, -1 },
+    { "disconnected", Scheduler::ALL_SENSORS, 0, 1000, 0, 0, 0, 0, -1, -1 },
+  };
+  const uint32_t runMs = seconds * 1000;
+  const uint32_t disconnectMs = runMs / 4;
+  const uint32_t lateMs = runMs / 2;
+  uint32_t startUs = 0xFFFFFFFFu - lateMs * 1000 + 1;
+  Scheduler scheduler(MAX_RATE_HZ);
+  for (uint8_t i = 0; i < CLIENTS; i++) {
+    scheduler.connect(i, clients[i].sensors, clients[i].rateHz, startUs);
+  }
+
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> jitter(0, 4);
+  uint32_t nextSampleMs = 0;
+  uint32_t samplesLate = 0;
+  uint32_t serializations = 0;
+  bool sentAfterDisconnect = false;
+  for (uint32_t ms = 0; ms < runMs; ms++) {
+    uint32_t nowUs = startUs + ms * 1000 + (uint32_t)jitter(rng) * 37;
+    for (uint8_t i = 0; i < CLIENTS; i++) {
+      SimClient& c = clients[i];
+      if (ms < c.stallUntilMs) continue;
+      c.queued -= c.drainPerSecond / 1000;
+      if (c.queued < 0) c.queued = 0;
+    }
+    if (ms == disconnectMs) scheduler.disconnect(DISCONNECTED);
+    // Samples every 10 ms, each up to 4 ms late
+    if (ms >= nextSampleMs) {
+      scheduler.publish(Scheduler::SENSOR_1 | Scheduler::SENSOR_2);
+      if (ms >= lateMs) samplesLate++;
+      nextSampleMs += 1000 / MAX_RATE_HZ;
+      if (jitter(rng) == 0) nextSampleMs += (uint32_t)jitter(rng);
+    }
+    if (!scheduler.anyDue(nowUs)) continue;
+    serializations++;
+
+    for (uint8_t i = 0; i < CLIENTS; i++) {
+      if (!scheduler.isDue(i, nowUs)) continue;
+      SimClient& c = clients[i];
+      bool congested = c.queued >= QUEUE_LIMIT;
+      if (congested && c.firstCongestedMs < 0) c.firstCongestedMs = ms;
+      switch (scheduler.attempt(i, nowUs, congested)) {
+        case Scheduler::SEND:
+          c.queued += 1;
+          if ((uint32_t)c.queued > c.peakQueued) c.peakQueued = (uint32_t)c.queued;
+          if (ms >= lateMs) c.sentLate++;
+          if (i == DISCONNECTED && ms >= disconnectMs) sentAfterDisconnect = true;
+          break;
+        case Scheduler::DROP:
+          c.droppedMs = ms;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  double lateSeconds = (runMs - lateMs) / 1000.0;
+  for (uint8_t i = 0; i < CLIENTS; i++) {
+    const SimClient& c = clients[i];
+    Scheduler::ClientStats stats = scheduler.getClientStats(i);
+    printf("%-12s rate %3u Hz, last %.0f s %5.1f Hz, sent %5u, congested %4u, decimation %u, "
+           "peak queue %u", c.name, stats.rateHz, lateSeconds, c.sentLate / lateSeconds,
+           stats.sent, stats.congested, stats.decimation, c.peakQueued);
+    if (c.droppedMs >= 0) printf(", dropped at %lld ms", (long long)c.droppedMs);
+    printf("\n");
+  }
+  const Scheduler::Stats& stats = scheduler.getStats();
+  printf("total        sent %u, congested %u, decimations %u, recoveries %u, dropped %u, "
+         "%u serializations in %u ms\n", stats.sent, stats.congested, stats.decimations,
+         stats.recoveries, stats.dropped, serializations, runMs);
+
+  const double expected[3] = { 10 * lateSeconds, (double)samplesLate, 1 * lateSeconds };
+  const uint8_t rated[3] = { TEN_HZ, FULL_RATE, ONE_HZ };
+  for (int k = 0; k < 3; k++) {
+    const SimClient& c = clients[rated[k]];
+    check(c.sentLate + 1 >= expected[k] && c.sentLate <= expected[k] + 1,
+          "subscribed rate held through jitter and the wrap");
+    check(c.droppedMs < 0 && c.firstCongestedMs < 0, "fast clients never congested");
+  }
+
+  const SimClient& slow = clients[SLOW_READER];
+  check(slow.droppedMs < 0, "slow reader kept");
+  check(scheduler.getClientStats(SLOW_READER).congested > 0 && stats.decimations > 0,
+        "slow reader decimated");
+  check(slow.peakQueued <= QUEUE_LIMIT, "slow reader's queue stays within the limit");
+  check(slow.sentLate / lateSeconds >= slow.drainPerSecond / 4 &&
+        slow.sentLate / lateSeconds <= slow.drainPerSecond + 1,
+        "slow reader gets about what it drains");
+
+  const SimClient& stalled = clients[STALLED];
+  uint32_t maxPeriodMs = (1000 / MAX_RATE_HZ) << Scheduler::MAX_DECIMATION;
+  int64_t stalledFor = stalled.droppedMs - stalled.firstCongestedMs;
+  check(stalled.droppedMs >= 0 && stalledFor >= Scheduler::DROP_AFTER_US / 1000 &&
+        stalledFor <= Scheduler::DROP_AFTER_US / 1000 + maxPeriodMs,
+        "stalled client dropped after DROP_AFTER_US");
+  check(!scheduler.isConnected(STALLED), "dropped client disconnected");
+
+  const SimClient& recovers = clients[RECOVERS];
+  check(recovers.droppedMs < 0 && recovers.firstCongestedMs >= 0, "stalled client kept");
+  check(scheduler.getClientStats(RECOVERS).decimation == 0 && stats.recoveries > 0,
+        "decimation undone after the stall");
+  check(recovers.sentLate + 1 >= samplesLate, "full rate again after the stall");
+
+  check(scheduler.getClientStats(ARRAY_ONLY).sent == 1, "only the initial message "
+        "without fresh data");
+  check(!sentAfterDisconnect && !scheduler.isConnected(DISCONNECTED),
+        "nothing sent after a disconnect");
+  check(stats.dropped == 1, "one client dropped");
+}
+
+static void checkSubscriptions() {
+  Scheduler scheduler(MAX_RATE_HZ);
+  scheduler.publish(Scheduler::SENSOR_1);
+  check(!scheduler.anyDue(0) && scheduler.getStats().idle == 1,
+        "data with no clients counts as idle");
+
+  scheduler.connect(0, Scheduler::SENSOR_1 | Scheduler::SENSOR_2, 25, 0);
+  check(scheduler.attempt(0, 0, false) == Scheduler::SEND, "initial message sent on connect");
+  check(scheduler.subscribe(0, Scheduler::SENSOR_1, 0) == MAX_RATE_HZ, "rate 0 is the full rate");
+  check(scheduler.subscribe(0, Scheduler::SENSOR_1, 5000) == MAX_RATE_HZ, "rate clamped to max");
+  check(scheduler.subscribe(0, 0xFF, 25) == 25 &&
+        scheduler.getSensors(0) == Scheduler::ALL_SENSORS, "unknown sensor bits masked");
+  check(scheduler.subscribe(9, Scheduler::SENSOR_1, 10) == 0, "out of range client ignored");
+
+  scheduler.subscribe(0, Scheduler::SENSOR_2, 25);
+  scheduler.publish(Scheduler::SENSOR_1);
+  check(!scheduler.isDue(0, 1000000) && scheduler.getStats().idle == 2,
+        "unsubscribed sensor neither due nor wanted");
+  scheduler.publish(Scheduler::SENSOR_2);
+  check(!scheduler.isDue(0, 39999) && scheduler.isDue(0, 40000), "due on the 25 Hz grid");
+  check(scheduler.getConnectedCount() == 1, "connected count");
+  printf("subscribe    rates clamped, sensors masked, idle data counted\n");
+}
+
+int main(int argc, char** argv) {
+  uint32_t seconds = 120;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = (uint32_t)atol(argv[++i]);
+    else {
+      fprintf(stderr, "usage: %s [--seconds N]\n", argv[0]);
+      return 2;
+    }
+  }
+  // Long enough to drop the stalled client and for the recovered one to
+  // climb back from the deepest decimation
+  if (seconds < 120) seconds = 120;
+
+  checkQueues(seconds);
+  checkSubscriptions();
+
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+let ws;
+let reconnectInterval;
+
+function connectWebSocket() {
+    const protocol = window.location.protocol === 'https:' ? 'wss:' : 'ws:';
+    const wsUrl = `${protocol}//${window.location.host}/ws`;
+
+    ws = new WebSocket(wsUrl);
+    ws.binaryType = 'arraybuffer';
+
+    ws.onopen = function() {
+        console.log('WebSocket connected');
+        document.getElementById('status').className = 'status connected';
+        document.getElementById('status').innerHTML = '✅ Connected';
+        clearInterval(reconnectInterval);
+        subscribe();
+    };
+
+    ws.onmessage = function(event) {
+        try {
+            const data = (typeof event.data === 'string')
+                ? JSON.parse(event.data) : decodeBinary(event.data);
+            if (!data) return;
+            if (data.maxRate !== undefined) {
+                // Subscription reply
+                document.getElementById('rate-granted').textContent =
+                    `(${data.rate} of max ${data.maxRate} Hz)`;
+                return;
+            }
+            updateSensor(1, data.angle1, data.raw1);
+            updateSensor(2, data.angle2, data.raw2);
+            updateSpeed(1, data.vel1);
+            updateSpeed(2, data.vel2);
+            if (data.turns1 !== undefined) {
+                document.getElementById('turns1').textContent = data.turns1;
+                document.getElementById('turns2').textContent = data.turns2;
+            }
+            if (Array.isArray(data.raw)) {
+                updateArray(data.raw);
+            }
+        } catch (e) {
+            console.error('Error parsing WebSocket data:', e);
+        }
+    };
+
+    ws.onclose = function() {
+        console.log('WebSocket disconnected');
+        document.getElementById('status').className = 'status disconnected';
+        document.getElementById('status').innerHTML = '⚠️ Disconnected - Reconnecting...';
+
+        // Try to reconnect every 3 seconds
+        reconnectInterval = setInterval(connectWebSocket, 3000);
+    };
+
+    ws.onerror = function(error) {
+        console.error('WebSocket error:', error);
+    };
+}
+
+function subscribe() {
+    if (ws && ws.readyState === WebSocket.OPEN) {
+        const rate = parseInt(document.getElementById('rate').value);
+        ws.send(JSON.stringify({ rate: rate }));
+    }
+}
+
+// Binary sensor message (ws_message.h), little-endian
+function decodeBinary(buffer) {
+    const v = new DataView(buffer);
+    if (v.byteLength < 40 || v.getUint8(0) !== 2) return null;
+    const count = v.getUint8(1);
+    const data = {
+        seq: v.getUint16(2, true),
+        t1: v.getUint32(4, true),
+        t2: v.getUint32(8, true),
+        raw1: v.getUint16(12, true),
+        raw2: v.getUint16(14, true),
+        vel1: v.getInt32(16, true),
+        vel2: v.getInt32(20, true),
+        acc1: v.getInt32(24, true),
+        acc2: v.getInt32(28, true),
+        turns1: v.getInt32(32, true),
+        turns2: v.getInt32(36, true)
+    };
+    if (count > 0 && v.byteLength >= 40 + 6 * count) {
+        data.raw = [];
+        data.t = [];
+        for (let i = 0; i < count; i++) {
+            data.raw.push(v.getUint16(40 + 2 * i, true));
+            data.t.push(v.getUint32(40 + 2 * count + 4 * i, true));
+        }
+    }
+    return data;
+}
+
+function updateSensor(sensorNum, angle, raw) {
+    const angleElement = document.getElementById(`angle${sensorNum}`);
+    const rawElement = document.getElementById(`raw${sensorNum}`);
+    const barElement = document.getElementById(`bar${sensorNum}`);
+
+    // Convert raw value (0-4095) to degrees (0-360)
+    const degrees = ((raw / 4095) * 360).toFixed(1);
+    const percentage = (raw / 4095 * 100).toFixed(1);
+
+    angleElement.textContent = degrees;
+    rawElement.textContent = raw;
+    barElement.style.width = percentage + '%';
+
+    // Add pulse animation on update
+    angleElement.classList.add('updating');
+    setTimeout(() => angleElement.classList.remove('updating'), 300);
+}
+
+function updateSpeed(sensorNum, velocity) {
+    if (velocity === undefined) return;
+    // counts/s -> revolutions per minute
+    document.getElementById(`rpm${sensorNum}`).textContent =
+        (velocity * 60 / 4096).toFixed(1);
+}
+
+function updateArray(raw) {
+    document.getElementById('array-section').style.display = 'block';
+    document.getElementById('array-values').innerHTML = raw
+        .map((r, i) => `<p>• Sensor ${i + 1}: ${((r / 4095) * 360).toFixed(1)}° (raw ${r})</p>`)
+        .join('');
+}
+
+// Load and display system logs
+function loadLogs() {
+    fetch('/logs')
+        .then(response => response.json())
+        .then(logs => {
+            const container = document.getElementById('logs-container');
+
+            if (logs.length === 0) {
+                container.innerHTML = '<div class="log-entry">No logs available</div>';
+                return;
+            }
+
+            container.innerHTML = '';
+
+            // Display logs in reverse order (newest first)
+            logs.reverse().forEach(log => {
+                const entry = document.createElement('div');
+                const levelClass = log.level.trim().toLowerCase();
+                entry.className = `log-entry ${levelClass}`;
+
+                entry.innerHTML = `
+                    <span class="log-timestamp">${log.timestamp}</span>
+                    <span class="log-level ${levelClass}">[${log.level.trim()}]</span>
+                    <span class="log-message">${log.message}</span>
+                `;
+
+                container.appendChild(entry);
+            });
+        })
+        .catch(error => {
+            console.error('Error loading logs:', error);
+            document.getElementById('logs-container').innerHTML = 
+                '<div class="log-entry error">Failed to load logs</div>';
+        });
+}
+
+// Connect on page load
+connectWebSocket();
+loadLogs();